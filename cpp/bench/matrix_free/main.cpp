@@ -0,0 +1,137 @@
+// Copyright (C) 2026 agent
+//
+// This file is part of DOLFIN (https://www.fenicsproject.org)
+//
+// SPDX-License-Identifier:    LGPL-3.0-or-later
+//
+// Benchmark of the Laplace operator applied as an assembled matrix
+// (SpMV) and matrix-free (fem::MatrixFreeOperator) for Lagrange
+// elements of degree 1 to 4 on a box mesh of tetrahedra. For each
+// degree the number of degrees-of-freedom processed per second by each
+// approach and the number of non-zeros in the assembled matrix are
+// reported.
+//
+// Usage: bench_matrix_free [n] [num_applications]
+//
+// where n is the number of cells in each direction (default 16) and
+// num_applications the number of operator applications to time
+// (default 20).
+
+#include "matrix_free_p1.h"
+#include "matrix_free_p2.h"
+#include "matrix_free_p3.h"
+#include "matrix_free_p4.h"
+#include <cstdlib>
+#include <dolfin.h>
+#include <dolfin/fem/MatrixFreeOperator.h>
+#include <dolfin/mesh/Ordering.h>
+#include <iostream>
+
+using namespace dolfin;
+
+namespace
+{
+// Return time (s) for num_applications of y = A x
+double time_mult(Mat A, Vec x, Vec y, int num_applications)
+{
+  common::Timer t;
+  for (int i = 0; i < num_applications; ++i)
+    MatMult(A, x, y);
+  return t.stop();
+}
+
+void run(std::shared_ptr<mesh::Mesh> mesh, int degree,
+         ufc_function_space* (*create_space)(void),
+         ufc_form* (*create_a)(void), ufc_form* (*create_L)(void),
+         int num_applications)
+{
+  ufc_function_space* space = create_space();
+  ufc_dofmap* ufc_map = space->create_dofmap();
+  ufc_finite_element* ufc_element = space->create_element();
+  auto V = std::make_shared<function::FunctionSpace>(
+      mesh, std::make_shared<fem::FiniteElement>(*ufc_element),
+      std::make_shared<fem::DofMap>(*ufc_map, *mesh));
+  std::free(ufc_element);
+  std::free(ufc_map);
+  std::free(space);
+
+  ufc_form* bilinear_form = create_a();
+  auto a = std::make_shared<fem::Form>(
+      *bilinear_form,
+      std::initializer_list<std::shared_ptr<const function::FunctionSpace>>{V,
+                                                                            V});
+  std::free(bilinear_form);
+
+  ufc_form* linear_form = create_L();
+  auto L = std::make_shared<fem::Form>(
+      *linear_form,
+      std::initializer_list<std::shared_ptr<const function::FunctionSpace>>{V});
+  std::free(linear_form);
+
+  auto cmap = a->coordinate_mapping();
+  mesh->geometry().coord_mapping = cmap;
+
+  auto w = std::make_shared<function::Function>(V);
+  L->set_coefficients({{"w", w}});
+
+  // Assembled matrix
+  la::PETScMatrix A = fem::create_matrix(*a);
+  MatZeroEntries(A.mat());
+  fem::assemble_matrix(A.mat(), *a, {});
+  MatAssemblyBegin(A.mat(), MAT_FINAL_ASSEMBLY);
+  MatAssemblyEnd(A.mat(), MAT_FINAL_ASSEMBLY);
+
+  // Matrix-free operator
+  fem::MatrixFreeOperator A_mf(a, L, w, {});
+
+  la::PETScVector x = A.create_vector(1);
+  la::PETScVector y = A.create_vector(0);
+  VecSet(x.vec(), 1.0);
+
+  const double t_spmv = time_mult(A.mat(), x.vec(), y.vec(), num_applications);
+  const double t_mf = time_mult(A_mf.mat(), x.vec(), y.vec(), num_applications);
+
+  MatInfo info;
+  MatGetInfo(A.mat(), MAT_GLOBAL_SUM, &info);
+  const std::int64_t num_dofs = A.size()[0];
+  if (MPI::rank(MPI_COMM_WORLD) == 0)
+  {
+    std::cout << "P" << degree << ": dofs " << num_dofs << ", matrix nnz "
+              << (std::int64_t)info.nz_used << ", SpMV "
+              << num_dofs * num_applications / t_spmv
+              << " dofs/s, matrix-free "
+              << num_dofs * num_applications / t_mf << " dofs/s" << std::endl;
+  }
+}
+} // namespace
+
+int main(int argc, char* argv[])
+{
+  common::SubSystemsManager::init_logging(argc, argv);
+  common::SubSystemsManager::init_petsc(argc, argv);
+
+  const std::size_t n = (argc > 1) ? std::atoi(argv[1]) : 16;
+  const int num_applications = (argc > 2) ? std::atoi(argv[2]) : 20;
+
+  std::array<Eigen::Vector3d, 2> pt{Eigen::Vector3d(0.0, 0.0, 0.0),
+                                    Eigen::Vector3d(1.0, 1.0, 1.0)};
+  auto mesh = std::make_shared<mesh::Mesh>(generation::BoxMesh::create(
+      MPI_COMM_WORLD, pt, {{n, n, n}}, mesh::CellType::Type::tetrahedron,
+      mesh::GhostMode::none));
+  mesh::Ordering::order_simplex(*mesh);
+
+  run(mesh, 1, matrix_free_p1_functionspace_create,
+      matrix_free_p1_bilinearform_create, matrix_free_p1_linearform_create,
+      num_applications);
+  run(mesh, 2, matrix_free_p2_functionspace_create,
+      matrix_free_p2_bilinearform_create, matrix_free_p2_linearform_create,
+      num_applications);
+  run(mesh, 3, matrix_free_p3_functionspace_create,
+      matrix_free_p3_bilinearform_create, matrix_free_p3_linearform_create,
+      num_applications);
+  run(mesh, 4, matrix_free_p4_functionspace_create,
+      matrix_free_p4_bilinearform_create, matrix_free_p4_linearform_create,
+      num_applications);
+
+  return 0;
+}
@@ -0,0 +1,62 @@
+// Copyright (C) 2026 agent
+//
+// This file is part of DOLFIN (https://www.fenicsproject.org)
+//
+// SPDX-License-Identifier:    LGPL-3.0-or-later
+//
+// Benchmark for parallel mesh refinement. A box mesh of tetrahedra is
+// refined uniformly and with markers on half of the cells, which
+// exercises propagation of edge markers between processes.
+//
+// Usage: bench_refinement [n] [levels]
+//
+// where n is the number of cells in each direction of the initial mesh
+// (default 32) and levels the number of uniform refinements (default 1).
+
+#include <cstdlib>
+#include <dolfin.h>
+#include <iostream>
+
+using namespace dolfin;
+
+int main(int argc, char* argv[])
+{
+  common::SubSystemsManager::init_logging(argc, argv);
+  common::SubSystemsManager::init_petsc(argc, argv);
+
+  const std::size_t n = (argc > 1) ? std::atoi(argv[1]) : 32;
+  const int levels = (argc > 2) ? std::atoi(argv[2]) : 1;
+
+  std::array<Eigen::Vector3d, 2> pt{Eigen::Vector3d(0.0, 0.0, 0.0),
+                                    Eigen::Vector3d(1.0, 1.0, 1.0)};
+  auto mesh = std::make_shared<mesh::Mesh>(generation::BoxMesh::create(
+      MPI_COMM_WORLD, pt, {{n, n, n}}, mesh::CellType::Type::tetrahedron,
+      mesh::GhostMode::none));
+
+  // Uniform refinement
+  for (int i = 0; i < levels; ++i)
+  {
+    common::Timer t("Bench: uniform refinement");
+    mesh = std::make_shared<mesh::Mesh>(refinement::refine(*mesh));
+  }
+
+  // Refinement of cells with x < 0.5
+  {
+    const int tdim = mesh->topology().dim();
+    mesh::MeshFunction<bool> markers(mesh, tdim, false);
+    for (const auto& cell : mesh::MeshRange<mesh::Cell>(*mesh))
+      markers[cell] = cell.midpoint()[0] < 0.5;
+
+    common::Timer t("Bench: marker refinement");
+    mesh = std::make_shared<mesh::Mesh>(refinement::refine(*mesh, markers));
+  }
+
+  const std::int64_t num_cells
+      = mesh->num_entities_global(mesh->topology().dim());
+  if (MPI::rank(MPI_COMM_WORLD) == 0)
+    std::cout << "Number of cells: " << num_cells << std::endl;
+
+  list_timings({TimingType::wall});
+
+  return 0;
+}
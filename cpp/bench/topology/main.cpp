@@ -0,0 +1,74 @@
+// Copyright (C) 2026 agent
+//
+// This file is part of DOLFIN (https://www.fenicsproject.org)
+//
+// SPDX-License-Identifier:    LGPL-3.0-or-later
+//
+// Benchmark for mesh topology computation. Entities and connectivity
+// of a box mesh of tetrahedra are computed, followed by graphs built
+// from the mesh connectivity, which exercise the entity loops in
+// TopologyComputation and GraphBuilder.
+//
+// Usage: bench_topology [n]
+//
+// where n is the number of cells in each direction (default 32).
+
+#include <cstdlib>
+#include <dolfin.h>
+#include <iostream>
+
+using namespace dolfin;
+
+int main(int argc, char* argv[])
+{
+  common::SubSystemsManager::init_logging(argc, argv);
+  common::SubSystemsManager::init_petsc(argc, argv);
+
+  const std::size_t n = (argc > 1) ? std::atoi(argv[1]) : 32;
+
+  std::array<Eigen::Vector3d, 2> pt{Eigen::Vector3d(0.0, 0.0, 0.0),
+                                    Eigen::Vector3d(1.0, 1.0, 1.0)};
+  auto mesh = std::make_shared<mesh::Mesh>(generation::BoxMesh::create(
+      MPI_COMM_WORLD, pt, {{n, n, n}}, mesh::CellType::Type::tetrahedron,
+      mesh::GhostMode::none));
+
+  // Entities
+  for (int d = 1; d < 3; ++d)
+  {
+    common::Timer t("Bench: create entities of dim " + std::to_string(d));
+    mesh->create_entities(d);
+  }
+
+  // Connectivity from map and from transpose
+  {
+    common::Timer t("Bench: create connectivity 2-1");
+    mesh->create_connectivity(2, 1);
+  }
+  {
+    common::Timer t("Bench: create connectivity 1-2");
+    mesh->create_connectivity(1, 2);
+  }
+  {
+    common::Timer t("Bench: create connectivity 0-3");
+    mesh->create_connectivity(0, 3);
+  }
+
+  // Graphs from connectivity
+  {
+    common::Timer t("Bench: cell-vertex-cell graph");
+    graph::GraphBuilder::local_graph(*mesh, 3, 0);
+  }
+  {
+    common::Timer t("Bench: cell-facet-cell graph");
+    graph::GraphBuilder::local_graph(*mesh, {3, 2, 3});
+  }
+
+  const std::int64_t num_cells
+      = mesh->num_entities_global(mesh->topology().dim());
+  if (MPI::rank(MPI_COMM_WORLD) == 0)
+    std::cout << "Number of cells: " << num_cells << std::endl;
+
+  list_timings({TimingType::wall});
+
+  return 0;
+}
@@ -30,7 +30,7 @@ if complex_mode is True:
     skip.update(["hyperelasticity.ufl"])
 
 # Directories to scan
-subdirs = ["demo", "test"]
+subdirs = ["demo", "test", "bench"]
 
 # Compile all form files
 topdir = os.getcwd()
@@ -105,6 +105,12 @@ void IndexMap::scatter_fwd(const std::vector<std::int32_t>& local_data,
   scatter_fwd_impl(local_data, remote_data, n);
 }
 //-----------------------------------------------------------------------------
+void IndexMap::scatter_fwd(const std::vector<double>& local_data,
+                           std::vector<double>& remote_data, int n) const
+{
+  scatter_fwd_impl(local_data, remote_data, n);
+}
+//-----------------------------------------------------------------------------
 std::vector<std::int64_t>
 IndexMap::scatter_fwd(const std::vector<std::int64_t>& local_data, int n) const
 {
@@ -121,6 +127,14 @@ IndexMap::scatter_fwd(const std::vector<std::int32_t>& local_data, int n) const
   return remote_data;
 }
 //-----------------------------------------------------------------------------
+std::vector<double>
+IndexMap::scatter_fwd(const std::vector<double>& local_data, int n) const
+{
+  std::vector<double> remote_data;
+  scatter_fwd_impl(local_data, remote_data, n);
+  return remote_data;
+}
+//-----------------------------------------------------------------------------
 void IndexMap::scatter_rev(std::vector<std::int64_t>& local_data,
                            const std::vector<std::int64_t>& remote_data, int n,
                            MPI_Op op) const
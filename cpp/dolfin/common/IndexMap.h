@@ -105,11 +105,15 @@ public:
                    std::vector<std::int64_t>& remote_data, int n) const;
   void scatter_fwd(const std::vector<std::int32_t>& local_data,
                    std::vector<std::int32_t>& remote_data, int n) const;
+  void scatter_fwd(const std::vector<double>& local_data,
+                   std::vector<double>& remote_data, int n) const;
 
   std::vector<std::int64_t>
   scatter_fwd(const std::vector<std::int64_t>& local_data, int n) const;
   std::vector<std::int32_t>
   scatter_fwd(const std::vector<std::int32_t>& local_data, int n) const;
+  std::vector<double> scatter_fwd(const std::vector<double>& local_data,
+                                  int n) const;
 
   /// Send n values for each ghost index to owning to processes. The size
   /// of the input array remote_data must be the same as num_ghosts().
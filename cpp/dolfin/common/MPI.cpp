@@ -125,6 +125,56 @@ std::size_t dolfin::MPI::global_offset(const MPI_Comm comm, std::size_t range,
   return offset;
 }
 //-----------------------------------------------------------------------------
+MPI_Comm dolfin::MPI::create_neighbour_comm(MPI_Comm comm,
+                                           const std::vector<int>& neighbours)
+{
+  MPI_Comm neighbour_comm;
+  MPI_Dist_graph_create_adjacent(comm, neighbours.size(), neighbours.data(),
+                                 MPI_UNWEIGHTED, neighbours.size(),
+                                 neighbours.data(), MPI_UNWEIGHTED,
+                                 MPI_INFO_NULL, false, &neighbour_comm);
+  return neighbour_comm;
+}
+//-----------------------------------------------------------------------------
+MPI_Comm
+dolfin::MPI::create_neighbour_comm(MPI_Comm comm,
+                                   const std::vector<int>& sources,
+                                   const std::vector<int>& destinations)
+{
+  MPI_Comm neighbour_comm;
+  MPI_Dist_graph_create_adjacent(comm, sources.size(), sources.data(),
+                                 MPI_UNWEIGHTED, destinations.size(),
+                                 destinations.data(), MPI_UNWEIGHTED,
+                                 MPI_INFO_NULL, false, &neighbour_comm);
+  return neighbour_comm;
+}
+//-----------------------------------------------------------------------------
+MPI_Comm dolfin::MPI::create_sparse_comm(MPI_Comm comm,
+                                         const std::vector<int>& destinations)
+{
+  // Each process specifies only its own outgoing edges
+  const int rank = MPI::rank(comm);
+  const int degree = destinations.size();
+  MPI_Comm neighbour_comm;
+  MPI_Dist_graph_create(comm, 1, &rank, &degree, destinations.data(),
+                        MPI_UNWEIGHTED, MPI_INFO_NULL, false,
+                        &neighbour_comm);
+  return neighbour_comm;
+}
+//-----------------------------------------------------------------------------
+std::pair<std::vector<int>, std::vector<int>>
+dolfin::MPI::neighbours(MPI_Comm neighbour_comm)
+{
+  int num_sources(0), num_destinations(0), weighted(0);
+  MPI_Dist_graph_neighbors_count(neighbour_comm, &num_sources,
+                                 &num_destinations, &weighted);
+  std::vector<int> sources(num_sources), destinations(num_destinations);
+  MPI_Dist_graph_neighbors(neighbour_comm, num_sources, sources.data(),
+                           MPI_UNWEIGHTED, num_destinations,
+                           destinations.data(), MPI_UNWEIGHTED);
+  return {std::move(sources), std::move(destinations)};
+}
+//-----------------------------------------------------------------------------
 std::array<std::int64_t, 2> dolfin::MPI::local_range(const MPI_Comm comm,
                                                      std::int64_t N)
 {
@@ -106,6 +106,15 @@ private:
                                 std::vector<T>& out_values,
                                 std::vector<std::int32_t>& offsets);
 
+  // Implementation of neighbour_all_to_all, returning a flat array
+  // and the offset of the data from each source neighbour
+  template <typename T>
+  static void
+  neighbour_all_to_all_common(MPI_Comm neighbour_comm,
+                              const std::vector<std::vector<T>>& in_values,
+                              std::vector<T>& out_values,
+                              std::vector<std::int32_t>& offsets);
+
 public:
   /// Send in_values[p0] to process p0 and receive values from
   /// process p1 in out_values[p1]
@@ -121,6 +130,54 @@ public:
                          const std::vector<std::vector<T>>& in_values,
                          std::vector<T>& out_values);
 
+  /// Create communicator with a distributed graph topology in which
+  /// this process is connected to the processes in neighbours. The
+  /// neighbour relation must be symmetric. The caller must free the
+  /// returned communicator.
+  static MPI_Comm create_neighbour_comm(MPI_Comm comm,
+                                        const std::vector<int>& neighbours);
+
+  /// Create communicator with a distributed graph topology in which
+  /// this process receives from the processes in sources and sends to
+  /// the processes in destinations (in the given order). The caller
+  /// must free the returned communicator.
+  static MPI_Comm create_neighbour_comm(MPI_Comm comm,
+                                        const std::vector<int>& sources,
+                                        const std::vector<int>& destinations);
+
+  /// Create communicator with a distributed graph topology in which
+  /// this process sends to the processes in destinations. The
+  /// processes that send to this process are determined by MPI without
+  /// dense communication, and can be obtained with neighbours. The
+  /// caller must free the returned communicator.
+  static MPI_Comm create_sparse_comm(MPI_Comm comm,
+                                     const std::vector<int>& destinations);
+
+  /// Return (sources, destinations) of a communicator with a
+  /// distributed graph topology, in the order used for neighbourhood
+  /// communication
+  static std::pair<std::vector<int>, std::vector<int>>
+  neighbours(MPI_Comm neighbour_comm);
+
+  /// Send in_values[i] to the ith neighbour of a communicator created
+  /// by create_neighbour_comm, and receive values from all neighbours
+  /// in out_values (ordered by neighbour). Only neighbours take part
+  /// in the exchange.
+  template <typename T>
+  static void
+  neighbour_all_to_all(MPI_Comm neighbour_comm,
+                       const std::vector<std::vector<T>>& in_values,
+                       std::vector<T>& out_values);
+
+  /// Send in_values[i] to the ith neighbour of a communicator created
+  /// by create_neighbour_comm, and receive values from the ith source
+  /// neighbour in out_values[i]
+  template <typename T>
+  static void
+  neighbour_all_to_all(MPI_Comm neighbour_comm,
+                       const std::vector<std::vector<T>>& in_values,
+                       std::vector<std::vector<T>>& out_values);
+
   /// Broadcast vector of value from broadcaster to all processes
   template <typename T>
   static void broadcast(MPI_Comm comm, std::vector<T>& value,
@@ -459,6 +516,74 @@ void dolfin::MPI::all_to_all(MPI_Comm comm,
   all_to_all_common(comm, in_values, out_values, offsets);
 }
 //---------------------------------------------------------------------------
+template <typename T>
+void dolfin::MPI::neighbour_all_to_all_common(
+    MPI_Comm neighbour_comm, const std::vector<std::vector<T>>& in_values,
+    std::vector<T>& out_values, std::vector<std::int32_t>& offsets)
+{
+  int num_sources(0), num_destinations(0), weighted(0);
+  MPI_Dist_graph_neighbors_count(neighbour_comm, &num_sources,
+                                 &num_destinations, &weighted);
+  assert((int)in_values.size() == num_destinations);
+
+  // Pack data
+  std::vector<int> data_size_send(num_destinations);
+  std::vector<int> data_offset_send(num_destinations + 1, 0);
+  for (int p = 0; p < num_destinations; ++p)
+  {
+    data_size_send[p] = in_values[p].size();
+    data_offset_send[p + 1] = data_offset_send[p] + data_size_send[p];
+  }
+  std::vector<T> data_send(data_offset_send.back());
+  for (int p = 0; p < num_destinations; ++p)
+  {
+    std::copy(in_values[p].begin(), in_values[p].end(),
+              data_send.begin() + data_offset_send[p]);
+  }
+
+  // Get received data sizes from neighbours
+  std::vector<int> data_size_recv(num_sources);
+  MPI_Neighbor_alltoall(data_size_send.data(), 1, mpi_type<int>(),
+                        data_size_recv.data(), 1, mpi_type<int>(),
+                        neighbour_comm);
+
+  offsets.assign(num_sources + 1, 0);
+  for (int p = 0; p < num_sources; ++p)
+    offsets[p + 1] = offsets[p] + data_size_recv[p];
+
+  // Send/receive data
+  out_values.resize(offsets.back());
+  MPI_Neighbor_alltoallv(data_send.data(), data_size_send.data(),
+                         data_offset_send.data(), mpi_type<T>(),
+                         out_values.data(), data_size_recv.data(),
+                         offsets.data(), mpi_type<T>(), neighbour_comm);
+}
+//---------------------------------------------------------------------------
+template <typename T>
+void dolfin::MPI::neighbour_all_to_all(
+    MPI_Comm neighbour_comm, const std::vector<std::vector<T>>& in_values,
+    std::vector<T>& out_values)
+{
+  std::vector<std::int32_t> offsets;
+  neighbour_all_to_all_common(neighbour_comm, in_values, out_values, offsets);
+}
+//---------------------------------------------------------------------------
+template <typename T>
+void dolfin::MPI::neighbour_all_to_all(
+    MPI_Comm neighbour_comm, const std::vector<std::vector<T>>& in_values,
+    std::vector<std::vector<T>>& out_values)
+{
+  std::vector<T> out_vec;
+  std::vector<std::int32_t> offsets;
+  neighbour_all_to_all_common(neighbour_comm, in_values, out_vec, offsets);
+  out_values.resize(offsets.size() - 1);
+  for (std::size_t i = 0; i < out_values.size(); ++i)
+  {
+    out_values[i].assign(out_vec.data() + offsets[i],
+                         out_vec.data() + offsets[i + 1]);
+  }
+}
+//---------------------------------------------------------------------------
 #ifndef DOXYGEN_IGNORE
 template <>
 inline void
@@ -500,6 +625,24 @@ dolfin::MPI::all_to_all(MPI_Comm comm,
   out_values.assign(recv.begin(), recv.end());
 }
 
+template <>
+inline void dolfin::MPI::neighbour_all_to_all(
+    MPI_Comm neighbour_comm, const std::vector<std::vector<bool>>& in_values,
+    std::vector<bool>& out_values)
+{
+  // Copy to short int
+  std::vector<std::vector<short int>> send(in_values.size());
+  for (std::size_t i = 0; i < in_values.size(); ++i)
+    send[i].assign(in_values[i].begin(), in_values[i].end());
+
+  // Communicate data
+  std::vector<short int> recv;
+  neighbour_all_to_all(neighbour_comm, send, recv);
+
+  // Copy back to bool
+  out_values.assign(recv.begin(), recv.end());
+}
+
 #endif
 //---------------------------------------------------------------------------
 template <typename T>
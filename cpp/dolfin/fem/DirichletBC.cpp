@@ -7,6 +7,7 @@
 #include "DirichletBC.h"
 #include "FiniteElement.h"
 #include "GenericDofMap.h"
+#include <algorithm>
 #include <array>
 #include <dolfin/common/IndexMap.h>
 #include <dolfin/fem/CoordinateMapping.h>
@@ -362,6 +363,27 @@ DirichletBC::DirichletBC(std::shared_ptr<const function::FunctionSpace> V,
 
   // Note: _dof_indices must be sorted
   _dof_indices = _dofs.col(0);
+
+  // Find cells with at least one constrained dof, so that assemblers
+  // can restrict bc application to these cells
+  auto map = V->dofmap()->index_map();
+  std::vector<bool> markers(
+      map->block_size() * (map->size_local() + map->num_ghosts()), false);
+  mark_dofs(markers);
+  const mesh::Mesh& mesh = *V->mesh();
+  const int tdim = mesh.topology().dim();
+  for (std::int32_t c = 0; c < (std::int32_t)mesh.num_entities(tdim); ++c)
+  {
+    auto dofs = V->dofmap()->cell_dofs(c);
+    for (Eigen::Index i = 0; i < dofs.size(); ++i)
+    {
+      if (markers[dofs[i]])
+      {
+        _cells.push_back(c);
+        break;
+      }
+    }
+  }
 }
 //-----------------------------------------------------------------------------
 std::shared_ptr<const function::FunctionSpace>
@@ -445,6 +467,24 @@ void DirichletBC::mark_dofs(std::vector<bool>& markers) const
   }
 }
 //-----------------------------------------------------------------------------
+const std::vector<std::int32_t>& DirichletBC::cells() const { return _cells; }
+//-----------------------------------------------------------------------------
+std::vector<std::int32_t>
+fem::bc_cells(const std::vector<std::shared_ptr<const DirichletBC>>& bcs)
+{
+  std::vector<std::int32_t> cells;
+  for (const auto& bc : bcs)
+  {
+    assert(bc);
+    const std::vector<std::int32_t>& c = bc->cells();
+    const std::size_t n = cells.size();
+    cells.insert(cells.end(), c.begin(), c.end());
+    std::inplace_merge(cells.begin(), cells.begin() + n, cells.end());
+  }
+  cells.erase(std::unique(cells.begin(), cells.end()), cells.end());
+  return cells;
+}
+//-----------------------------------------------------------------------------
 // std::set<PetscInt>
 // DirichletBC::compute_bc_dofs_geometric(const function::FunctionSpace& V,
 //                                        const function::FunctionSpace* Vg,
@@ -7,6 +7,7 @@
 #pragma once
 
 #include <Eigen/Dense>
+#include <cstdint>
 #include <memory>
 #include <petscsys.h>
 #include <vector>
@@ -195,6 +196,10 @@ public:
   /// Value of markers[i] is not changed otherwise.
   void mark_dofs(std::vector<bool>& markers) const;
 
+  /// Get the (process-local) cells, including ghost cells, that have
+  /// at least one dof to which the bc is applied. The list is sorted.
+  const std::vector<std::int32_t>& cells() const;
+
 private:
   // // Compute boundary values dofs (geometrical approach)
   // static std::set<PetscInt>
@@ -215,6 +220,14 @@ private:
 
   // Indices in _function_space to which bcs are applied. Must be sorted.
   Eigen::Array<PetscInt, Eigen::Dynamic, 1> _dof_indices;
+
+  // Cells with at least one dof in _dof_indices. Sorted.
+  std::vector<std::int32_t> _cells;
 };
+
+/// Return the sorted union of the cells of the boundary conditions
+/// (see DirichletBC::cells)
+std::vector<std::int32_t>
+bc_cells(const std::vector<std::shared_ptr<const DirichletBC>>& bcs);
 } // namespace fem
 } // namespace dolfin
@@ -7,6 +7,7 @@
 #include "DofMapBuilder.h"
 #include "DofMap.h"
 #include "ElementDofLayout.h"
+#include <algorithm>
 #include <cstdlib>
 #include <dolfin/common/IndexMap.h>
 #include <dolfin/common/MPI.h>
@@ -15,14 +16,15 @@
 #include <dolfin/graph/BoostGraphOrdering.h>
 #include <dolfin/graph/GraphBuilder.h>
 #include <dolfin/graph/SCOTCH.h>
-#include <dolfin/mesh/Cell.h>
+#include <dolfin/mesh/Connectivity.h>
 #include <dolfin/mesh/DistributedMeshTools.h>
-#include <dolfin/mesh/Facet.h>
 #include <dolfin/mesh/Mesh.h>
-#include <dolfin/mesh/MeshIterator.h>
+#include <dolfin/mesh/Topology.h>
+#include <map>
 #include <memory>
 #include <numeric>
 #include <random>
+#include <set>
 #include <utility>
 
 using namespace dolfin;
@@ -72,30 +74,33 @@ struct DofMapStructure
 void get_cell_entities(
     std::vector<std::vector<std::int32_t>>& entity_indices_local,
     std::vector<std::vector<std::int64_t>>& entity_indices_global,
-    const mesh::Cell& cell, const std::vector<bool>& needs_mesh_entities)
+    const std::vector<const mesh::Connectivity*>& cell_entities,
+    const std::vector<const std::vector<std::int64_t>*>& global_indices,
+    std::int32_t cell)
 {
-  const mesh::Topology& topology = cell.mesh().topology();
-  const int D = topology.dim();
+  const int D = cell_entities.size() - 1;
   for (int d = 0; d < D; ++d)
   {
-    if (needs_mesh_entities[d])
+    if (global_indices[d])
     {
-      assert(topology.have_global_indices(d));
-      const std::vector<std::int64_t>& global_indices
-          = topology.global_indices(d);
-      const std::int32_t* entities = cell.entities(d);
-      for (std::size_t i = 0; i < cell.num_entities(d); ++i)
+      assert(cell_entities[d]);
+      const std::vector<std::int64_t>& global = *global_indices[d];
+      const std::int32_t* entities = cell_entities[d]->connections(cell);
+      const std::size_t num_entities = cell_entities[d]->size(cell);
+      for (std::size_t i = 0; i < num_entities; ++i)
       {
         entity_indices_local[d][i] = entities[i];
-        entity_indices_global[d][i] = global_indices[entities[i]];
+        entity_indices_global[d][i] = global[entities[i]];
       }
     }
   }
-  // Handle cell index separately because cell.entities(D) doesn't work.
-  if (needs_mesh_entities[D])
+  // Handle cell index separately because there is no cell-cell
+  // connectivity
+  if (global_indices[D])
   {
-    entity_indices_global[D][0] = cell.global_index();
-    entity_indices_local[D][0] = cell.index();
+    const std::vector<std::int64_t>& global = *global_indices[D];
+    entity_indices_global[D][0] = global.empty() ? -1 : global[cell];
+    entity_indices_local[D][0] = cell;
   }
 }
 //-----------------------------------------------------------------------------
@@ -332,16 +337,34 @@ DofMapStructure build_basic_dofmap(const mesh::Mesh& mesh,
     entity_indices_global[d].resize(mesh.type().num_entities(d));
   }
 
+  // Get cell-entity connectivity and global entity indices for entity
+  // dimensions with dofs
+  const mesh::Topology& topology = mesh.topology();
+  std::vector<const mesh::Connectivity*> cell_entities(D + 1, nullptr);
+  std::vector<const std::vector<std::int64_t>*> global_indices(D + 1,
+                                                               nullptr);
+  for (int d = 0; d <= D; ++d)
+  {
+    if (needs_entities[d])
+    {
+      assert(topology.have_global_indices(d));
+      global_indices[d] = &topology.global_indices(d);
+      if (d < D)
+        cell_entities[d] = topology.connectivity(D, d).get();
+    }
+  }
+
+  // Entity dofs on cell (dof = entity_dofs[dim][entity][index])
+  const std::vector<std::vector<std::set<int>>>& entity_dofs
+      = element_dof_layout.entity_dofs();
+
   // Build dofmaps from ElementDofmap
-  for (auto& cell : mesh::MeshRange<mesh::Cell>(mesh, mesh::MeshRangeType::ALL))
+  const std::int32_t num_cells = mesh.num_entities(D);
+  for (std::int32_t cell = 0; cell < num_cells; ++cell)
   {
     // Get local (process) and global cell entity indices
-    get_cell_entities(entity_indices_local, entity_indices_global, cell,
-                      needs_entities);
-
-    // Entity dofs on cell (dof = entity_dofs[dim][entity][index])
-    const std::vector<std::vector<std::set<int>>>& entity_dofs
-        = element_dof_layout.entity_dofs();
+    get_cell_entities(entity_indices_local, entity_indices_global,
+                      cell_entities, global_indices, cell);
 
     // Iterate over topological dimensions
     std::int32_t offset_local = 0;
@@ -371,7 +394,7 @@ DofMapStructure build_basic_dofmap(const mesh::Mesh& mesh,
           const std::int32_t count = std::distance(e_dofs->begin(), dof_local);
           const std::int32_t dof
               = offset_local + num_entity_dofs * e_index_local + count;
-          dofmap.dof(cell.index(), *dof_local) = dof;
+          dofmap.dof(cell, *dof_local) = dof;
           dofmap.global_indices[dof]
               = offset_global + num_entity_dofs * e_index_global + count;
         }
@@ -402,17 +425,36 @@ compute_sharing_markers(const DofMapStructure& dofmap,
   const std::vector<std::set<int>>& facet_table
       = element_dof_layout.entity_closure_dofs()[D - 1];
 
+  // Get cell-facet and facet-cell connectivity, and shared cells and
+  // facets
+  const mesh::Topology& topology = mesh.topology();
+  assert(topology.connectivity(D, D - 1));
+  assert(topology.connectivity(D - 1, D));
+  const mesh::Connectivity& cell_facets = *topology.connectivity(D, D - 1);
+  const mesh::Connectivity& facet_cells = *topology.connectivity(D - 1, D);
+  const std::map<std::int32_t, std::set<std::int32_t>> no_shared;
+  const std::map<std::int32_t, std::set<std::int32_t>>& shared_cells
+      = topology.have_shared_entities(D) ? topology.shared_entities(D)
+                                         : no_shared;
+  const std::map<std::int32_t, std::set<std::int32_t>>& shared_facets
+      = topology.have_shared_entities(D - 1) ? topology.shared_entities(D - 1)
+                                             : no_shared;
+  const std::int32_t cell_ghost_offset = topology.ghost_offset(D);
+  const std::int32_t facet_ghost_offset = topology.ghost_offset(D - 1);
+
   // Mark dofs associated ghost cells as ghost dofs, provisionally
   bool has_ghost_cells = false;
-  for (auto& c : mesh::MeshRange<mesh::Cell>(mesh, mesh::MeshRangeType::ALL))
+  const std::int32_t num_cells = mesh.num_entities(D);
+  for (std::int32_t c = 0; c < num_cells; ++c)
   {
-    const PetscInt* cell_nodes = dofmap.dofs(c.index());
-    if (c.is_shared())
+    const PetscInt* cell_nodes = dofmap.dofs(c);
+    const bool ghost = c >= cell_ghost_offset;
+    if (shared_cells.find(c) != shared_cells.end())
     {
-      const sharing_marker status = (c.is_ghost())
+      const sharing_marker status = ghost
                                         ? sharing_marker::ghost
                                         : sharing_marker::interior_ghost_layer;
-      for (std::int32_t i = 0; i < dofmap.num_dofs(c.index()); ++i)
+      for (std::int32_t i = 0; i < dofmap.num_dofs(c); ++i)
       {
         // Ensure not already set (for R space)
         if (shared_nodes[cell_nodes[i]] == sharing_marker::interior)
@@ -421,14 +463,15 @@ compute_sharing_markers(const DofMapStructure& dofmap,
     }
 
     // Change all non-ghost facet dofs of ghost cells to boundary dofs
-    if (c.is_ghost())
+    if (ghost)
     {
       has_ghost_cells = true;
-      for (auto& f : mesh::EntityRange<mesh::Facet>(c))
+      const std::int32_t* facets = cell_facets.connections(c);
+      for (std::size_t i = 0; i < cell_facets.size(c); ++i)
       {
-        if (!f.is_ghost())
+        if (facets[i] < facet_ghost_offset)
         {
-          const std::set<int>& facet_nodes = facet_table[c.index(f)];
+          const std::set<int>& facet_nodes = facet_table[i];
           for (auto facet_node : facet_nodes)
           {
             const int facet_node_local = cell_nodes[facet_node];
@@ -443,21 +486,31 @@ compute_sharing_markers(const DofMapStructure& dofmap,
     return shared_nodes;
 
   // Mark nodes on inter-process boundary
-  for (auto& f : mesh::MeshRange<mesh::Facet>(mesh, mesh::MeshRangeType::ALL))
+  const std::int32_t num_facets = mesh.num_entities(D - 1);
+  for (std::int32_t f = 0; f < num_facets; ++f)
   {
     // Skip if facet is not shared
     // NOTE: second test is for periodic problems
-    if (!f.is_shared() and f.num_entities(D) == 2)
+    if (shared_facets.find(f) == shared_facets.end()
+        and facet_cells.size(f) == 2)
+    {
       continue;
+    }
 
     // Get cell to which facet belongs (pick first)
-    const mesh::Cell cell0(mesh, f.entities(D)[0]);
+    const std::int32_t cell0 = facet_cells.connections(f)[0];
 
     // Get dofs (process-wise indices) on cell
-    const PetscInt* cell_nodes = dofmap.dofs(cell0.index());
+    const PetscInt* cell_nodes = dofmap.dofs(cell0);
+
+    // Get local index of facet with respect to the cell
+    const std::int32_t* facets = cell_facets.connections(cell0);
+    const std::size_t local_facet
+        = std::find(facets, facets + cell_facets.size(cell0), f) - facets;
+    assert(local_facet < cell_facets.size(cell0));
 
     // Get dofs which are on the facet
-    const std::set<int>& facet_nodes = facet_table[cell0.index(f)];
+    const std::set<int>& facet_nodes = facet_table[local_facet];
 
     // Mark boundary nodes and insert into map
     for (auto facet_node : facet_nodes)
@@ -0,0 +1,345 @@
+// Copyright (C) 2026 agent
+//
+// This file is part of DOLFIN (https://www.fenicsproject.org)
+//
+// SPDX-License-Identifier:    LGPL-3.0-or-later
+
+#include "MatrixFreeOperator.h"
+#include "DirichletBC.h"
+#include "Form.h"
+#include "GenericDofMap.h"
+#include "assemble_matrix_impl.h"
+#include "assemble_vector_impl.h"
+#include "utils.h"
+#include <Eigen/Dense>
+#include <dolfin/common/IndexMap.h>
+#include <dolfin/common/Timer.h>
+#include <dolfin/function/Function.h>
+#include <dolfin/function/FunctionSpace.h>
+#include <dolfin/la/PETScVector.h>
+#include <dolfin/la/utils.h>
+#include <dolfin/mesh/Mesh.h>
+#include <petscmat.h>
+
+using namespace dolfin;
+using namespace dolfin::fem;
+
+namespace
+{
+// Data attached to the MATSHELL. It is owned by the Mat and deleted
+// when the Mat is destroyed.
+struct ShellData
+{
+  // Bilinear form and its action
+  std::shared_ptr<const Form> a, action;
+
+  // Coefficient of action that a is applied to
+  std::shared_ptr<function::Function> u;
+
+  // Position of u in the packed coefficients of action
+  int u_offset;
+
+  // Packed coefficients of action, one row per cell. The entries for u
+  // are updated on each application of the operator.
+  Eigen::Array<PetscScalar, Eigen::Dynamic, Eigen::Dynamic, Eigen::RowMajor>
+      coeffs;
+
+  // Markers for (local) columns with Dirichlet conditions
+  std::vector<bool> bc_markers1;
+
+  // Cells with Dirichlet conditions on columns
+  std::vector<std::int32_t> bc_cells1;
+
+  // Owned rows with Dirichlet conditions
+  std::vector<PetscInt> bc_rows;
+
+  // True if test and trial spaces are the same
+  bool square;
+
+  // Ghosted vector for assembling y = Ax
+  std::unique_ptr<la::PETScVector> y;
+
+  // Diagonal of the operator (computed when first requested)
+  std::unique_ptr<la::PETScVector> diagonal;
+};
+//-----------------------------------------------------------------------------
+ShellData* get_data(Mat A)
+{
+  ShellData* data = nullptr;
+  PetscErrorCode ierr = MatShellGetContext(A, (void**)&data);
+  if (ierr != 0)
+    la::petsc_error(ierr, __FILE__, "MatShellGetContext");
+  assert(data);
+  return data;
+}
+//-----------------------------------------------------------------------------
+// Add diagonal of the element tensors of a to d, excluding rows and
+// columns with bcs
+void add_diagonal(Eigen::Ref<Eigen::Matrix<PetscScalar, Eigen::Dynamic, 1>> d,
+                  const Form& a, const std::vector<bool>& bc_markers,
+                  const std::vector<std::int32_t>& bc_cells)
+{
+  auto add = [&d](std::int32_t m, const PetscInt* rows, std::int32_t n,
+                  const PetscInt* cols, const PetscScalar* vals) {
+    for (std::int32_t i = 0; i < m; ++i)
+      for (std::int32_t j = 0; j < n; ++j)
+        if (rows[i] == cols[j])
+          d[rows[i]] += vals[i * n + j];
+    return 0;
+  };
+  impl::assemble_matrix(add, a, bc_markers, bc_markers, bc_cells);
+}
+//-----------------------------------------------------------------------------
+// The functions below are MATSHELL operations, which are called from
+// PETSc. They return PETSc error codes and must not throw, so C++
+// exceptions are caught and turned into PETSc errors.
+//-----------------------------------------------------------------------------
+// Compute y = A x
+PetscErrorCode mult(Mat A, Vec x, Vec y)
+{
+  ShellData* data = nullptr;
+  PetscErrorCode ierr = MatShellGetContext(A, (void**)&data);
+  CHKERRQ(ierr);
+
+  try
+  {
+    // Copy x into u and update ghost values
+    Vec u = data->u->vector().vec();
+    ierr = VecCopy(x, u);
+    CHKERRQ(ierr);
+    ierr = VecGhostUpdateBegin(u, INSERT_VALUES, SCATTER_FORWARD);
+    CHKERRQ(ierr);
+    ierr = VecGhostUpdateEnd(u, INSERT_VALUES, SCATTER_FORWARD);
+    CHKERRQ(ierr);
+
+    // Pack u for each cell, with entries in constrained columns zeroed
+    const GenericDofMap& dofmap = *data->u->function_space()->dofmap();
+    Eigen::Map<const Eigen::Array<PetscInt, Eigen::Dynamic, 1>> dof_array
+        = dofmap.dof_array();
+    const int num_dofs_per_cell = dofmap.num_element_dofs(0);
+    {
+      la::VecReadWrapper _u(u);
+      for (Eigen::Index c = 0; c < data->coeffs.rows(); ++c)
+      {
+        for (int i = 0; i < num_dofs_per_cell; ++i)
+        {
+          const PetscInt dof = dof_array[c * num_dofs_per_cell + i];
+          if (!data->bc_markers1.empty() and data->bc_markers1[dof])
+            data->coeffs(c, data->u_offset + i) = 0.0;
+          else
+            data->coeffs(c, data->u_offset + i) = _u.x[dof];
+        }
+      }
+    }
+
+    // Assemble action and accumulate ghost contributions
+    Vec _y = data->y->vec();
+    {
+      la::VecWrapper y_local(_y);
+      y_local.x.setZero();
+      impl::assemble_vector(y_local.x, *data->action, data->coeffs);
+    }
+    ierr = VecGhostUpdateBegin(_y, ADD_VALUES, SCATTER_REVERSE);
+    CHKERRQ(ierr);
+    ierr = VecGhostUpdateEnd(_y, ADD_VALUES, SCATTER_REVERSE);
+    CHKERRQ(ierr);
+    ierr = VecCopy(_y, y);
+    CHKERRQ(ierr);
+
+    // Set constrained rows
+    if (!data->bc_rows.empty())
+    {
+      la::VecWrapper y_owned(y, false);
+      la::VecReadWrapper x_owned(x, false);
+      for (PetscInt row : data->bc_rows)
+        y_owned.x[row] = data->square ? x_owned.x[row] : 0.0;
+    }
+  }
+  catch (const std::exception& e)
+  {
+    SETERRQ1(PETSC_COMM_SELF, PETSC_ERR_LIB, "%s", e.what());
+  }
+
+  return 0;
+}
+//-----------------------------------------------------------------------------
+PetscErrorCode get_diagonal(Mat A, Vec d)
+{
+  ShellData* data = nullptr;
+  PetscErrorCode ierr = MatShellGetContext(A, (void**)&data);
+  CHKERRQ(ierr);
+  if (!data->square)
+  {
+    SETERRQ(PetscObjectComm((PetscObject)A), PETSC_ERR_SUP,
+            "Cannot compute diagonal of matrix-free operator. Test and "
+            "trial spaces differ.");
+  }
+
+  try
+  {
+    if (!data->diagonal)
+    {
+      common::Timer t("Compute matrix-free operator diagonal");
+      auto diagonal = std::make_unique<la::PETScVector>(
+          *data->a->function_space(0)->dofmap()->index_map());
+      {
+        la::VecWrapper _d(diagonal->vec());
+        _d.x.setZero();
+        add_diagonal(_d.x, *data->a, data->bc_markers1, data->bc_cells1);
+      }
+      ierr = VecGhostUpdateBegin(diagonal->vec(), ADD_VALUES,
+                                 SCATTER_REVERSE);
+      CHKERRQ(ierr);
+      ierr = VecGhostUpdateEnd(diagonal->vec(), ADD_VALUES, SCATTER_REVERSE);
+      CHKERRQ(ierr);
+      if (!data->bc_rows.empty())
+      {
+        la::VecWrapper _d(diagonal->vec(), false);
+        for (PetscInt row : data->bc_rows)
+          _d.x[row] = 1.0;
+      }
+      data->diagonal = std::move(diagonal);
+    }
+  }
+  catch (const std::exception& e)
+  {
+    SETERRQ1(PETSC_COMM_SELF, PETSC_ERR_LIB, "%s", e.what());
+  }
+
+  ierr = VecCopy(data->diagonal->vec(), d);
+  CHKERRQ(ierr);
+  return 0;
+}
+//-----------------------------------------------------------------------------
+PetscErrorCode destroy(Mat A)
+{
+  ShellData* data = nullptr;
+  PetscErrorCode ierr = MatShellGetContext(A, (void**)&data);
+  CHKERRQ(ierr);
+  try
+  {
+    delete data;
+  }
+  catch (const std::exception& e)
+  {
+    SETERRQ1(PETSC_COMM_SELF, PETSC_ERR_LIB, "%s", e.what());
+  }
+  return 0;
+}
+//-----------------------------------------------------------------------------
+Mat create_shell(std::shared_ptr<const Form> a,
+                 std::shared_ptr<const Form> action,
+                 std::shared_ptr<function::Function> u,
+                 std::vector<std::shared_ptr<const DirichletBC>> bcs)
+{
+  assert(a);
+  assert(action);
+  assert(u);
+  if (a->rank() != 2 or action->rank() != 1)
+  {
+    throw std::runtime_error("Cannot create matrix-free operator. Forms must "
+                             "be a bilinear form and its action.");
+  }
+  if (!(*action->function_space(0) == *a->function_space(0))
+      or !(*u->function_space() == *a->function_space(1)))
+  {
+    throw std::runtime_error("Cannot create matrix-free operator. Function "
+                             "spaces of forms and Function do not match.");
+  }
+
+  auto data = std::make_unique<ShellData>();
+  data->a = a;
+  data->action = action;
+  data->u = u;
+  data->square = *a->function_space(0) == *a->function_space(1);
+
+  // Find u in the coefficients of action
+  const FormCoefficients& coefficients = action->coeffs();
+  int u_index = -1;
+  for (int i = 0; i < coefficients.size(); ++i)
+    if (coefficients.get(i) == u)
+      u_index = i;
+  if (u_index == -1)
+  {
+    throw std::runtime_error("Cannot create matrix-free operator. Function "
+                             "is not a coefficient of the action form.");
+  }
+  data->u_offset = coefficients.offsets()[u_index];
+  data->coeffs = fem::pack_coefficients(*action);
+
+  // Mark rows and columns with Dirichlet conditions
+  auto map0 = a->function_space(0)->dofmap()->index_map();
+  auto map1 = a->function_space(1)->dofmap()->index_map();
+  const std::int32_t owned_size0 = map0->block_size() * map0->size_local();
+  std::vector<std::shared_ptr<const DirichletBC>> bcs1;
+  for (const auto& bc : bcs)
+  {
+    assert(bc);
+    if (a->function_space(0)->contains(*bc->function_space()))
+    {
+      const Eigen::Ref<const Eigen::Array<PetscInt, Eigen::Dynamic, 1>> dofs
+          = bc->dof_indices();
+      for (Eigen::Index i = 0; i < dofs.size(); ++i)
+        if (dofs[i] < owned_size0)
+          data->bc_rows.push_back(dofs[i]);
+    }
+    if (a->function_space(1)->contains(*bc->function_space()))
+    {
+      data->bc_markers1.resize(
+          map1->block_size() * (map1->size_local() + map1->num_ghosts()),
+          false);
+      bc->mark_dofs(data->bc_markers1);
+      bcs1.push_back(bc);
+    }
+  }
+  data->bc_cells1 = fem::bc_cells(bcs1);
+
+  data->y = std::make_unique<la::PETScVector>(*map0);
+
+  // Create shell matrix, which takes ownership of data
+  Mat A;
+  const MPI_Comm comm = a->mesh()->mpi_comm();
+  PetscErrorCode ierr = MatCreateShell(
+      comm, owned_size0, map1->block_size() * map1->size_local(),
+      map0->block_size() * map0->size_global(),
+      map1->block_size() * map1->size_global(), data.get(), &A);
+  if (ierr != 0)
+    la::petsc_error(ierr, __FILE__, "MatCreateShell");
+  data.release();
+
+  MatShellSetOperation(A, MATOP_MULT, (void (*)(void))mult);
+  MatShellSetOperation(A, MATOP_GET_DIAGONAL, (void (*)(void))get_diagonal);
+  MatShellSetOperation(A, MATOP_DESTROY, (void (*)(void))destroy);
+
+  return A;
+}
+} // namespace
+
+//-----------------------------------------------------------------------------
+MatrixFreeOperator::MatrixFreeOperator(
+    std::shared_ptr<const Form> a, std::shared_ptr<const Form> action,
+    std::shared_ptr<function::Function> u,
+    std::vector<std::shared_ptr<const DirichletBC>> bcs)
+    : la::PETScOperator(create_shell(a, action, u, bcs), false)
+{
+  // Do nothing
+}
+//-----------------------------------------------------------------------------
+void MatrixFreeOperator::update_coefficients()
+{
+  assert(_matA);
+  ShellData& data = *get_data(_matA);
+  data.coeffs = fem::pack_coefficients(*data.action);
+  data.diagonal.reset();
+}
+//-----------------------------------------------------------------------------
+la::PETScVector MatrixFreeOperator::diagonal() const
+{
+  assert(_matA);
+  la::PETScVector d = create_vector(0);
+  PetscErrorCode ierr = MatGetDiagonal(_matA, d.vec());
+  if (ierr != 0)
+    la::petsc_error(ierr, __FILE__, "MatGetDiagonal");
+  return d;
+}
+//-----------------------------------------------------------------------------
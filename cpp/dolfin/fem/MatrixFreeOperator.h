@@ -0,0 +1,74 @@
+// Copyright (C) 2026 agent
+//
+// This file is part of DOLFIN (https://www.fenicsproject.org)
+//
+// SPDX-License-Identifier:    LGPL-3.0-or-later
+
+#pragma once
+
+#include <dolfin/la/PETScOperator.h>
+#include <memory>
+#include <vector>
+
+namespace dolfin
+{
+namespace function
+{
+class Function;
+}
+
+namespace la
+{
+class PETScVector;
+}
+
+namespace fem
+{
+class DirichletBC;
+class Form;
+
+/// Matrix-free operator for a bilinear form a. The product y = A x is
+/// computed cell-by-cell by assembling the linear form
+/// L = action(a, u) with u = x, so the global matrix is never formed.
+/// The operator is a PETSc MATSHELL and can be used with
+/// PETScKrylovSolver in place of an assembled matrix.
+///
+/// Dirichlet boundary conditions are applied as in assemble_matrix:
+/// constrained rows and columns are zeroed and, if the test and trial
+/// spaces are the same, the diagonal entries of constrained rows are
+/// one.
+///
+/// The diagonal of the operator (MatGetDiagonal, e.g. for Jacobi
+/// preconditioning) is computed from the element tensors of a when it
+/// is first requested.
+
+class MatrixFreeOperator : public la::PETScOperator
+{
+public:
+  /// Create operator. The Function u must be the coefficient of
+  /// 'action' that a is applied to. Its vector is overwritten each time
+  /// the operator is applied.
+  MatrixFreeOperator(std::shared_ptr<const Form> a,
+                     std::shared_ptr<const Form> action,
+                     std::shared_ptr<function::Function> u,
+                     std::vector<std::shared_ptr<const DirichletBC>> bcs);
+
+  /// Move constructor
+  MatrixFreeOperator(MatrixFreeOperator&& A) = default;
+
+  /// Destructor
+  ~MatrixFreeOperator() = default;
+
+  /// Move assignment operator
+  MatrixFreeOperator& operator=(MatrixFreeOperator&& A) = default;
+
+  /// Pack the coefficients of the forms. Must be called if
+  /// coefficients of a or action (other than u) are changed after the
+  /// operator has been created.
+  void update_coefficients();
+
+  /// Return diagonal of the operator
+  la::PETScVector diagonal() const;
+};
+} // namespace fem
+} // namespace dolfin
@@ -6,6 +6,7 @@
 
 #include "PETScDMCollection.h"
 #include <Eigen/Dense>
+#include <algorithm>
 #include <dolfin/common/IndexMap.h>
 #include <dolfin/fem/CoordinateMapping.h>
 #include <dolfin/fem/FiniteElement.h>
@@ -13,141 +14,123 @@
 #include <dolfin/function/Function.h>
 #include <dolfin/function/FunctionSpace.h>
 #include <dolfin/geometry/BoundingBoxTree.h>
+#include <dolfin/geometry/utils.h>
 #include <dolfin/la/PETScMatrix.h>
-#include <dolfin/mesh/Cell.h>
-#include <dolfin/mesh/MeshIterator.h>
+#include <dolfin/mesh/Connectivity.h>
+#include <dolfin/mesh/CoordinateDofs.h>
+#include <dolfin/mesh/Mesh.h>
+#include <numeric>
 #include <petscdmshell.h>
 #include <petscmat.h>
+#include <tuple>
 
 using namespace dolfin;
 using namespace dolfin::fem;
 
 namespace
 {
-// Coordinate comparison operator
-struct lt_coordinate
+// Return coordinates of the owned dof blocks of V (one row per block).
+// All dofs in a block share a point.
+EigenRowArrayXXd tabulate_block_coordinates(const function::FunctionSpace& V)
 {
-  lt_coordinate(double tolerance) : TOL(tolerance) {}
-
-  bool operator()(const std::vector<double>& x,
-                  const std::vector<double>& y) const
-  {
-    const std::size_t n = std::max(x.size(), y.size());
-    for (std::size_t i = 0; i < n; ++i)
-    {
-      double xx = 0.0;
-      double yy = 0.0;
-      if (i < x.size())
-        xx = x[i];
-      if (i < y.size())
-        yy = y[i];
-
-      if (xx < (yy - TOL))
-        return true;
-      else if (xx > (yy + TOL))
-        return false;
-    }
-    return false;
-  }
-
-  // Tolerance
-  const double TOL;
-};
+  assert(V.dofmap());
+  const int bs = V.dofmap()->index_map()->block_size();
+  const EigenRowArrayXXd& x_dofs = V.dof_coordinates();
+  EigenRowArrayXXd x(x_dofs.rows() / bs, x_dofs.cols());
+  for (Eigen::Index i = 0; i < x.rows(); ++i)
+    x.row(i) = x_dofs.row(i * bs);
 
-std::map<std::vector<double>, std::vector<std::size_t>, lt_coordinate>
-tabulate_coordinates_to_dofs(const function::FunctionSpace& V)
+  return x;
+}
+//-----------------------------------------------------------------------------
+// Evaluate the basis functions of V at the points x, where x.row(i)
+// lies in (or is closest to) cells[i]. The global indices of the cell
+// dofs for point i are returned in cols[i*eldim:(i + 1)*eldim] and the
+// values of component k of the basis functions in
+// values[(i*value_size + k)*eldim:(i*value_size + k + 1)*eldim]. The
+// basis functions are evaluated for all points in a cell at once.
+void evaluate_basis(const function::FunctionSpace& V,
+                    const std::vector<std::int32_t>& cells,
+                    const Eigen::Ref<const EigenRowArrayXXd>& x,
+                    int value_size, std::vector<std::int64_t>& cols,
+                    std::vector<double>& values)
 {
-  std::map<std::vector<double>, std::vector<std::size_t>, lt_coordinate>
-      coords_to_dofs(lt_coordinate(1.0e-12));
-
-  // Extract mesh, dofmap and element
   assert(V.dofmap());
   assert(V.element());
   assert(V.mesh());
   const fem::GenericDofMap& dofmap = *V.dofmap();
   const fem::FiniteElement& element = *V.element();
   const mesh::Mesh& mesh = *V.mesh();
-  Eigen::Array<std::size_t, Eigen::Dynamic, 1> local_to_global
-      = dofmap.tabulate_local_to_global_dofs();
-
-  // Geometric dimension
   const int gdim = mesh.geometry().dim();
+  const int tdim = mesh.topology().dim();
+  const int eldim = element.space_dimension();
+  const Eigen::Array<std::size_t, Eigen::Dynamic, 1> local_to_global
+      = dofmap.tabulate_local_to_global_dofs();
 
-  // Get dof coordinates on reference element
-  const EigenRowArrayXXd& X = element.dof_reference_coordinates();
-
-  // Get coordinate mapping
-  if (!mesh.geometry().coord_mapping)
-  {
-    throw std::runtime_error(
-        "CoordinateMapping has not been attached to mesh.");
-  }
+  assert(mesh.geometry().coord_mapping);
   const CoordinateMapping& cmap = *mesh.geometry().coord_mapping;
 
   // Prepare cell geometry
-  const int tdim = mesh.topology().dim();
   const mesh::Connectivity& connectivity_g
       = mesh.coordinate_dofs().entity_points(tdim);
-  const Eigen::Ref<const Eigen::Array<std::int32_t, Eigen::Dynamic, 1>> pos_g
-      = connectivity_g.entity_positions();
   const Eigen::Ref<const Eigen::Array<std::int32_t, Eigen::Dynamic, 1>> cell_g
       = connectivity_g.connections();
   // FIXME: Add proper interface for num coordinate dofs
   const int num_dofs_g = connectivity_g.size(0);
-  const Eigen::Array<double, Eigen::Dynamic, 3, Eigen::RowMajor>&
-      x_g
+  const Eigen::Array<double, Eigen::Dynamic, 3, Eigen::RowMajor>& x_g
       = mesh.geometry().points();
-
-  // Loop over cells and tabulate dofs
-  EigenRowArrayXXd coordinates(element.space_dimension(), gdim);
   EigenRowArrayXXd coordinate_dofs(num_dofs_g, gdim);
-  std::vector<double> coors(gdim);
 
-  // Speed up the computations by only visiting (most) dofs once
-  const std::int64_t local_size
-      = dofmap.index_map()->size_local() * dofmap.index_map()->block_size();
-  std::vector<bool> already_visited(local_size, false);
+  // Order points by cell
+  std::vector<std::int32_t> perm(cells.size());
+  std::iota(perm.begin(), perm.end(), 0);
+  std::sort(perm.begin(), perm.end(), [&cells](auto a, auto b) {
+    return std::tie(cells[a], a) < std::tie(cells[b], b);
+  });
 
-  for (auto& cell : mesh::MeshRange<mesh::Cell>(mesh))
+  cols.resize(cells.size() * eldim);
+  values.resize(cells.size() * value_size * eldim);
+  for (std::size_t i = 0; i < perm.size();)
   {
-    // Get cell coordinates
-    const int cell_index = cell.index();
-    for (int i = 0; i < num_dofs_g; ++i)
-      for (int j = 0; j < gdim; ++j)
-        coordinate_dofs(i, j) = x_g(cell_g[pos_g[cell_index] + i], j);
-
-    // Get local-to-global map
-    auto dofs = dofmap.cell_dofs(cell.index());
-
-    // Tabulate dof coordinates on cell
-    cmap.compute_physical_coordinates(coordinates, X, coordinate_dofs);
+    // Find points in cell
+    const std::int32_t c = cells[perm[i]];
+    std::size_t end = i + 1;
+    while (end < perm.size() and cells[perm[end]] == c)
+      ++end;
+    const int num_points = end - i;
 
-    // Map dofs into coords_to_dofs
-    for (Eigen::Index i = 0; i < dofs.size(); ++i)
+    // Get cell coordinates
+    for (int j = 0; j < num_dofs_g; ++j)
+      for (int k = 0; k < gdim; ++k)
+        coordinate_dofs(j, k) = x_g(cell_g[c * num_dofs_g + j], k);
+
+    // Pull back points and evaluate basis functions
+    EigenRowArrayXXd x_cell(num_points, gdim);
+    for (int q = 0; q < num_points; ++q)
+      x_cell.row(q) = x.row(perm[i + q]);
+    EigenRowArrayXXd X(num_points, tdim);
+    Eigen::Tensor<double, 3, Eigen::RowMajor> J(num_points, gdim, tdim);
+    EigenArrayXd detJ(num_points);
+    Eigen::Tensor<double, 3, Eigen::RowMajor> K(num_points, tdim, gdim);
+    cmap.compute_reference_geometry(X, J, detJ, K, x_cell, coordinate_dofs);
+    Eigen::Tensor<double, 3, Eigen::RowMajor> phi(num_points, eldim,
+                                                  value_size);
+    element.evaluate_reference_basis(phi, X);
+
+    // Copy columns and values for each point
+    auto dofs = dofmap.cell_dofs(c);
+    for (int q = 0; q < num_points; ++q)
     {
-      const std::int64_t dof = dofs[i];
-      if (dof < local_size)
-      {
-        // Skip already checked dofs
-        if (already_visited[dof])
-          continue;
-
-        // Put coordinates in coors
-        std::copy(coordinates.row(i).data(),
-                  coordinates.row(i).data() + coordinates.row(i).size(),
-                  coors.begin());
-
-        // Add dof to list at this coord
-        const auto ins = coords_to_dofs.insert({coors, {local_to_global[dof]}});
-        if (!ins.second)
-          ins.first->second.push_back(local_to_global[dof]);
-
-        already_visited[dof] = true;
-      }
+      const std::int32_t p = perm[i + q];
+      for (int j = 0; j < eldim; ++j)
+        cols[p * eldim + j] = local_to_global[dofs[j]];
+      for (int k = 0; k < value_size; ++k)
+        for (int j = 0; j < eldim; ++j)
+          values[(p * value_size + k) * eldim + j] = phi(q, j, k);
     }
-  }
 
-  return coords_to_dofs;
+    i = end;
+  }
 }
 } // namespace
 
@@ -233,27 +216,19 @@ la::PETScMatrix PETScDMCollection::create_transfer_matrix(
     const function::FunctionSpace& coarse_space,
     const function::FunctionSpace& fine_space)
 {
-  // FIXME: refactor and split up
-
   // Get coarse mesh and dimension of the domain
   assert(coarse_space.mesh());
   const mesh::Mesh& meshc = *coarse_space.mesh();
   const int gdim = meshc.geometry().dim();
-  const int tdim = meshc.topology().dim();
 
-  // MPI communicator, size and rank
+  // MPI communicator
   const MPI_Comm mpi_comm = meshc.mpi_comm();
-  const unsigned int mpi_size = MPI::size(mpi_comm);
 
   // Initialise bounding box tree and dofmaps
   geometry::BoundingBoxTree treec(meshc, meshc.topology().dim());
   std::shared_ptr<const fem::GenericDofMap> coarsemap = coarse_space.dofmap();
   std::shared_ptr<const fem::GenericDofMap> finemap = fine_space.dofmap();
 
-  // Create map from coordinates to dofs sharing that coordinate
-  std::map<std::vector<double>, std::vector<std::size_t>, lt_coordinate>
-      coords_to_dofs = tabulate_coordinates_to_dofs(fine_space);
-
   // Global dimensions of the dofs and of the transfer matrix (M-by-N,
   // where M is the fine space dimension, N is the coarse space
   // dimension)
@@ -297,364 +272,139 @@ la::PETScMatrix PETScDMCollection::create_transfer_matrix(
   }
 
   // Number of dofs per cell for the finite element.
-  std::size_t eldim = el->space_dimension();
+  const int eldim = el->space_dimension();
 
   // Number of dofs associated with each fine point
-  unsigned int data_size = 1;
+  int data_size = 1;
   for (unsigned data_dim = 0; data_dim < el->value_rank(); data_dim++)
     data_size *= el->value_dimension(data_dim);
 
-  // The overall idea is: a fine point can be on a coarse cell in the
-  // current processor, on a coarse cell in a different processor, or
-  // outside the coarse domain.  If the point is found on the
-  // processor, evaluate basis functions, if found elsewhere, use the
-  // other processor to evaluate basis functions, if not found at all,
-  // or if found in multiple processors, use compute_closest_entity on
-  // all processors and find which coarse cell is the closest entity
-  // to the fine point amongst all processors.
-
-  // found_ids[i] contains the coarse cell id for each fine point
-  std::vector<std::size_t> found_ids;
-  found_ids.reserve((std::size_t)M / mpi_size);
-
-  // found_points[dim*i:dim*(i + 1)] contain the coordinates of the
-  // fine point i
-  std::vector<double> found_points;
-  found_points.reserve((std::size_t)gdim * M / mpi_size);
-
-  // global_row_indices[data_size*i:data_size*(i + 1)] are the rows associated
-  // with
-  // this point
-  std::vector<int> global_row_indices;
-  global_row_indices.reserve((std::size_t)data_size * M / mpi_size);
-
-  // Collect up any points which lie outside the domain
-  std::vector<double> exterior_points;
-  std::vector<int> exterior_global_indices;
-
-  // 1. Allocate all points on this process to "Bounding Boxes" based
-  // on the global BoundingBoxTree, and send them to those
-  // processes. Any points which fall outside the global BBTree are
-  // collected up separately.
-
-  std::vector<std::vector<double>> send_found(mpi_size);
-  std::vector<std::vector<int>> send_found_global_row_indices(mpi_size);
-
-  std::vector<int> proc_list;
-  std::vector<unsigned int> found_ranks;
-  // Iterate through fine points on this process
-  for (const auto& map_it : coords_to_dofs)
+  // The rows for the dofs at a fine point are computed together, with
+  // row k of a dof block taken from component k of the coarse basis
+  // functions
+  if (finemap->index_map()->block_size() != data_size)
   {
-    const std::vector<double>& _x = map_it.first;
-    Eigen::Map<const Eigen::Vector3d> curr_point(_x.data());
-
-    // Compute which processes' BBoxes contain the fine point
-    found_ranks = treec.compute_process_collisions(curr_point);
-
-    if (found_ranks.empty())
-    {
-      // Point is outside the domain
-      exterior_points.insert(exterior_points.end(), _x.begin(), _x.end());
-      exterior_global_indices.insert(exterior_global_indices.end(),
-                                     map_it.second.begin(),
-                                     map_it.second.end());
-    }
-    else
-    {
-      // Send points to candidate processes, also recording the
-      // processes they are sent to in proc_list
-      proc_list.push_back(found_ranks.size());
-      for (auto& rp : found_ranks)
-      {
-        proc_list.push_back(rp);
-        send_found[rp].insert(send_found[rp].end(), _x.begin(), _x.end());
-        // Also save the indices, but don't send yet.
-        send_found_global_row_indices[rp].insert(
-            send_found_global_row_indices[rp].end(), map_it.second.begin(),
-            map_it.second.end());
-      }
-    }
+    throw std::runtime_error(
+        "Cannot create transfer matrix. Block size of fine space dofmap ("
+        + std::to_string(finemap->index_map()->block_size())
+        + ") does not match value size ("
+        + std::to_string(data_size) + ")");
   }
-  std::vector<std::vector<double>> recv_found(mpi_size);
-  MPI::all_to_all(mpi_comm, send_found, recv_found);
-
-  // 2. On remote process, find the Cell which the point lies inside,
-  // if any.  Send back the result to the originating process. In the
-  // case that the point is found inside cells on more than one
-  // process, the originating process will arbitrate.
-  std::vector<std::vector<unsigned int>> send_ids(mpi_size);
-  for (unsigned int p = 0; p < mpi_size; ++p)
+
+  // The overall idea is: each fine point is located on the process
+  // with a coarse cell containing it, or with the closest coarse cell
+  // for points outside the coarse domain. The point is sent to that
+  // process, which evaluates the coarse basis functions and returns
+  // the matrix rows for the point.
+  const EigenRowArrayXXd x = tabulate_block_coordinates(fine_space);
+  const std::int32_t num_points = x.rows();
+  const std::vector<int> rank = geometry::locate_points(meshc, treec, x);
+  if (std::find(rank.begin(), rank.end(), -1) != rank.end())
   {
-    unsigned int n_points = recv_found[p].size() / gdim;
-    for (unsigned int i = 0; i < n_points; ++i)
-    {
-      Eigen::Map<const Eigen::Vector3d> curr_point(&recv_found[p][i * gdim]);
-      send_ids[p].push_back(
-          treec.compute_first_entity_collision(curr_point, meshc));
-    }
+    throw std::runtime_error(
+        "Cannot create transfer matrix. Coarse mesh has no cells");
   }
-  std::vector<std::vector<unsigned int>> recv_ids(mpi_size);
-  MPI::all_to_all(mpi_comm, send_ids, recv_ids);
 
-  // 3. Revisit original list of sent points in the same order as
-  // before. Now we also have the remote cell-id, if any.
-  std::vector<int> count(mpi_size, 0);
-  for (auto p = proc_list.begin(); p != proc_list.end(); p += (*p + 1))
+  // Send fine points to the processes that evaluate them
+  std::vector<std::int32_t> points(num_points);
+  std::iota(points.begin(), points.end(), 0);
+  std::vector<std::int32_t> offsets(num_points + 1);
+  std::iota(offsets.begin(), offsets.end(), 0);
+  MPI_Comm reply_comm;
+  std::vector<std::vector<std::int32_t>> sent_points;
+  std::vector<std::vector<double>> recv_x;
+  std::tie(reply_comm, sent_points, recv_x)
+      = geometry::send_points(mpi_comm, x, points, rank, offsets);
+
+  // Evaluate coarse basis functions at received points
+  std::vector<std::vector<std::int64_t>> reply_cols(recv_x.size());
+  std::vector<std::vector<double>> reply_values(recv_x.size());
+  for (std::size_t p = 0; p < recv_x.size(); ++p)
   {
-    unsigned int nprocs = *p;
-    int owner = -1;
-    // Find first process which owns a cell containing the point
-    for (unsigned int j = 1; j != (nprocs + 1); ++j)
-    {
-      const int proc = *(p + j);
-      const unsigned int id = recv_ids[proc][count[proc]];
-      if (id != std::numeric_limits<unsigned int>::max())
-      {
-        owner = proc;
-        break;
-      }
-    }
-
-    if (owner == -1)
+    std::vector<std::int32_t> cells;
+    for (std::size_t i = 0; i < recv_x[p].size(); i += gdim)
     {
-      // Point not found remotely, so add to not_found list
-      int proc = *(p + 1);
-      exterior_points.insert(exterior_points.end(),
-                             &send_found[proc][count[proc] * gdim],
-                             &send_found[proc][(count[proc] + 1) * gdim]);
-      exterior_global_indices.insert(
-          exterior_global_indices.end(),
-          &send_found_global_row_indices[proc][count[proc] * data_size],
-          &send_found_global_row_indices[proc][(count[proc] + 1) * data_size]);
+      std::int32_t cell
+          = geometry::find_cell(treec, meshc, &recv_x[p][i], false).first;
+      if (cell < 0)
+        cell = geometry::find_cell(treec, meshc, &recv_x[p][i], true).first;
+      cells.push_back(cell);
     }
-    else if (nprocs > 1)
-    {
-      // If point is found on multiple processes, send -1 as the index
-      // to the remote processes which are not the "owner"
-      for (unsigned int j = 1; j != (nprocs + 1); ++j)
-      {
-        const int proc = *(p + j);
-        if (proc != owner)
-        {
-          for (unsigned int k = 0; k != data_size; ++k)
-            send_found_global_row_indices[proc][count[proc] * data_size + k]
-                = -1;
-        }
-      }
-    }
-
-    // Move to next point
-    for (unsigned int j = 1; j != (nprocs + 1); ++j)
-      ++count[*(p + j)];
+    Eigen::Map<const EigenRowArrayXXd> x_p(recv_x[p].data(), cells.size(),
+                                           gdim);
+    evaluate_basis(coarse_space, cells, x_p, data_size, reply_cols[p],
+                   reply_values[p]);
   }
 
-  // Finally, send indices
-  std::vector<std::vector<int>> recv_found_global_row_indices(mpi_size);
-  MPI::all_to_all(mpi_comm, send_found_global_row_indices,
-                  recv_found_global_row_indices);
-
-  // Flatten results ready for insertion
-  for (unsigned int p = 0; p != mpi_size; ++p)
+  // Send columns and values back to owner of point
+  std::vector<std::vector<std::int64_t>> recv_cols;
+  std::vector<std::vector<double>> recv_values;
+  MPI::neighbour_all_to_all(reply_comm, reply_cols, recv_cols);
+  MPI::neighbour_all_to_all(reply_comm, reply_values, recv_values);
+  MPI_Comm_free(&reply_comm);
+
+  Eigen::Array<std::int64_t, Eigen::Dynamic, Eigen::Dynamic, Eigen::RowMajor>
+      cols(num_points, eldim);
+  EigenRowArrayXXd values(num_points, data_size * eldim);
+  for (std::size_t p = 0; p < sent_points.size(); ++p)
   {
-    const auto& id_p = send_ids[p];
-    const unsigned int npoints = id_p.size();
-    assert(npoints == recv_found[p].size() / gdim);
-    assert(npoints == recv_found_global_row_indices[p].size() / data_size);
-
-    Eigen::Map<const Eigen::Array<double, Eigen::Dynamic, Eigen::Dynamic,
-                                  Eigen::RowMajor>>
-        point_p(recv_found[p].data(), npoints, gdim);
-
-    Eigen::Map<const Eigen::Array<int, Eigen::Dynamic, Eigen::Dynamic,
-                                  Eigen::RowMajor>>
-        global_idx_p(recv_found_global_row_indices[p].data(), npoints,
-                     data_size);
-    for (unsigned int i = 0; i < npoints; ++i)
+    assert(recv_cols[p].size() == sent_points[p].size() * eldim);
+    for (std::size_t i = 0; i < sent_points[p].size(); ++i)
     {
-      if (id_p[i] != std::numeric_limits<unsigned int>::max()
-          and global_idx_p(i, 0) != -1)
-      {
-        found_ids.push_back(id_p[i]);
-        global_row_indices.insert(
-            global_row_indices.end(), global_idx_p.row(i).data(),
-            global_idx_p.row(i).data() + global_idx_p.cols());
-
-        found_points.insert(found_points.end(), point_p.row(i).data(),
-                            point_p.row(i).data() + point_p.cols());
-      }
+      const std::int32_t point = sent_points[p][i];
+      std::copy(recv_cols[p].begin() + i * eldim,
+                recv_cols[p].begin() + (i + 1) * eldim,
+                cols.row(point).data());
+      std::copy(recv_values[p].begin() + i * data_size * eldim,
+                recv_values[p].begin() + (i + 1) * data_size * eldim,
+                values.row(point).data());
     }
   }
 
-  // Find closest cells for points that lie outside the domain and add
-  // them to the lists
-  find_exterior_points(mpi_comm, meshc, treec, gdim, data_size, exterior_points,
-                       exterior_global_indices, global_row_indices, found_ids,
-                       found_points);
-
-  // Now every processor should have the information needed to
-  // assemble its portion of the matrix.  The ids of coarse cell owned
-  // by each processor are currently stored in found_ids and their
-  // respective global row indices are stored in global_row_indices.
-  // One last loop and we are ready to go!
-
-  // m_owned is the number of rows the current processor needs to set
-  // note that the processor might not own these rows
-  const std::size_t m_owned = global_row_indices.size();
-
-  // Initialise row and column indices and values of the transfer
-  // matrix
-  Eigen::Array<PetscInt, Eigen::Dynamic, Eigen::Dynamic, Eigen::RowMajor>
-      col_indices(m_owned, eldim);
-  Eigen::Array<PetscScalar, Eigen::Dynamic, Eigen::Dynamic, Eigen::RowMajor>
-      values(m_owned, eldim);
-  Eigen::Tensor<double, 3, Eigen::RowMajor> temp_values(1, eldim, data_size);
-
-  // Initialise global sparsity pattern: record on-process and
-  // off-process dependencies of fine dofs
-  std::vector<std::vector<PetscInt>> send_dnnz(mpi_size);
-  std::vector<std::vector<PetscInt>> send_onnz(mpi_size);
-
-  // Initialise local to global dof maps (needed to allocate the
-  // entries of the transfer matrix with the correct global indices)
-  Eigen::Array<std::size_t, Eigen::Dynamic, 1> coarse_local_to_global_dofs
-      = coarsemap->tabulate_local_to_global_dofs();
-
-  // Loop over the found coarse cells
-  Eigen::Map<const EigenRowArrayXXd> x(found_points.data(), found_ids.size(),
-                                       gdim);
-  const auto cmap = meshc.geometry().coord_mapping;
-  EigenRowArrayXXd X(1, gdim);
-  Eigen::Tensor<double, 3, Eigen::RowMajor> J(1, gdim, tdim);
-  EigenArrayXd detJ(1);
-  Eigen::Tensor<double, 3, Eigen::RowMajor> K(1, tdim, gdim);
-
-  // Prepare cell geometry
-  const mesh::Connectivity& connectivity_g
-      = meshc.coordinate_dofs().entity_points(tdim);
-  const Eigen::Ref<const Eigen::Array<std::int32_t, Eigen::Dynamic, 1>> pos_g
-      = connectivity_g.entity_positions();
-  const Eigen::Ref<const Eigen::Array<std::int32_t, Eigen::Dynamic, 1>> cell_g
-      = connectivity_g.connections();
-  // FIXME: Add proper interface for num coordinate dofs
-  const int num_dofs_g = connectivity_g.size(0);
-  const Eigen::Array<double, Eigen::Dynamic, 3, Eigen::RowMajor>&
-      x_g
-      = meshc.geometry().points();
-  EigenRowArrayXXd coordinate_dofs(num_dofs_g, gdim);
-  ; // cell dofs coordinates vector
-
-  for (unsigned int i = 0; i < found_ids.size(); ++i)
+  // Build CSR arrays for the owned rows. The rows for a point are
+  // consecutive and the column indices are sorted in each row.
+  const std::int64_t num_rows = m[1] - m[0];
+  assert(num_rows == (std::int64_t)num_points * data_size);
+  std::vector<PetscInt> row_ptr(num_rows + 1);
+  for (std::int64_t r = 0; r < num_rows + 1; ++r)
+    row_ptr[r] = r * eldim;
+  std::vector<PetscInt> col_indices(num_rows * eldim);
+  std::vector<PetscScalar> row_values(num_rows * eldim);
+  std::vector<int> perm(eldim);
+  for (std::int32_t i = 0; i < num_points; ++i)
   {
-    // Get coarse cell id and point
-    unsigned int id = found_ids[i];
-
-    // Create coarse cell
-    mesh::Cell coarse_cell(meshc, static_cast<std::size_t>(id));
-
-    // Get dofs coordinates of the coarse cell
-    const int cell_index = coarse_cell.index();
-    for (int i = 0; i < num_dofs_g; ++i)
-      for (int j = 0; j < gdim; ++j)
-        coordinate_dofs(i, j) = x_g(cell_g[pos_g[cell_index] + i], j);
-
-    // Evaluate the basis functions of the coarse cells at the fine
-    // point and store the values into temp_values
-
-    cmap->compute_reference_geometry(X, J, detJ, K, x.row(i), coordinate_dofs);
-    el->evaluate_reference_basis(temp_values, X);
-
-    // Get the coarse dofs associated with this cell
-    auto temp_dofs = coarsemap->cell_dofs(id);
-
-    // Loop over the fine dofs associated with this collision
-    for (unsigned k = 0; k < data_size; k++)
+    std::iota(perm.begin(), perm.end(), 0);
+    std::sort(perm.begin(), perm.end(),
+              [&cols, i](int a, int b) { return cols(i, a) < cols(i, b); });
+    for (int k = 0; k < data_size; ++k)
     {
-      const unsigned int fine_row = i * data_size + k;
-      const std::size_t global_fine_dof = global_row_indices[fine_row];
-      int p = finemap->index_map()->owner(global_fine_dof / data_size);
-
-      // Loop over the coarse dofs and stuff their contributions
-      for (unsigned j = 0; j < eldim; j++)
+      const std::int64_t offset = row_ptr[i * data_size + k];
+      for (int j = 0; j < eldim; ++j)
       {
-        const std::size_t coarse_dof
-            = coarse_local_to_global_dofs[temp_dofs[j]];
-
-        // Set the column
-        col_indices(fine_row, j) = coarse_dof;
-        // Set the value
-        values(fine_row, j) = temp_values(0, j, k);
-
-        int pc = coarsemap->index_map()->owner(coarse_dof / data_size);
-        if (p == pc)
-          send_dnnz[p].push_back(global_fine_dof);
-        else
-          send_onnz[p].push_back(global_fine_dof);
+        col_indices[offset + j] = cols(i, perm[j]);
+        row_values[offset + j] = values(i, k * eldim + perm[j]);
       }
     }
   }
 
-  // Communicate off-process columns nnz, and flatten to get nnz per
-  // row we also keep track of the ownership range
-  std::size_t mbegin = m[0];
-  std::size_t mend = m[1];
-  std::vector<PetscInt> recv_onnz;
-  MPI::all_to_all(mpi_comm, send_onnz, recv_onnz);
-
-  std::vector<PetscInt> onnz(m[1] - m[0], 0);
-  for (const auto& q : recv_onnz)
-  {
-    assert(q >= (PetscInt)mbegin and q < (PetscInt)mend);
-    ++onnz[q - mbegin];
-  }
-
-  // Communicate on-process columns nnz, and flatten to get nnz per
-  // row
-  std::vector<PetscInt> recv_dnnz;
-  MPI::all_to_all(mpi_comm, send_dnnz, recv_dnnz);
-  std::vector<PetscInt> dnnz(m[1] - m[0], 0);
-  for (const auto& q : recv_dnnz)
-  {
-    assert(q >= (PetscInt)mbegin and q < (PetscInt)mend);
-    ++dnnz[q - mbegin];
-  }
-
   // Initialise PETSc Mat and error code
   PetscErrorCode ierr;
   Mat I;
 
-  // Create and initialise the transfer matrix as MATMPIAIJ/MATSEQAIJ
+  // Create the transfer matrix, preallocated and filled from the CSR
+  // arrays
   ierr = MatCreate(mpi_comm, &I);
   CHKERRABORT(PETSC_COMM_WORLD, ierr);
-
-  if (mpi_size > 1)
-  {
-    ierr = MatSetType(I, MATMPIAIJ);
-    CHKERRABORT(PETSC_COMM_WORLD, ierr);
-    ierr = MatSetSizes(I, m[1] - m[0], n[1] - n[0], M, N);
-    CHKERRABORT(PETSC_COMM_WORLD, ierr);
-    ierr = MatMPIAIJSetPreallocation(I, PETSC_DEFAULT, dnnz.data(),
-                                     PETSC_DEFAULT, onnz.data());
-    CHKERRABORT(PETSC_COMM_WORLD, ierr);
-  }
-  else
-  {
-    ierr = MatSetType(I, MATSEQAIJ);
-    CHKERRABORT(PETSC_COMM_WORLD, ierr);
-    ierr = MatSetSizes(I, m[1] - m[0], n[1] - n[0], M, N);
-    CHKERRABORT(PETSC_COMM_WORLD, ierr);
-    ierr = MatSeqAIJSetPreallocation(I, PETSC_DEFAULT, dnnz.data());
-    CHKERRABORT(PETSC_COMM_WORLD, ierr);
-  }
-
-  // Setting transfer matrix values row by row
-  for (unsigned int fine_row = 0; fine_row < m_owned; ++fine_row)
-  {
-    PetscInt fine_dof = global_row_indices[fine_row];
-    ierr
-        = MatSetValues(I, 1, &fine_dof, eldim, col_indices.row(fine_row).data(),
-                       values.row(fine_row).data(), INSERT_VALUES);
-    CHKERRABORT(PETSC_COMM_WORLD, ierr);
-  }
+  ierr = MatSetSizes(I, m[1] - m[0], n[1] - n[0], M, N);
+  CHKERRABORT(PETSC_COMM_WORLD, ierr);
+  ierr = MatSetType(I, MATAIJ);
+  CHKERRABORT(PETSC_COMM_WORLD, ierr);
+  ierr = MatSeqAIJSetPreallocationCSR(I, row_ptr.data(), col_indices.data(),
+                                      row_values.data());
+  CHKERRABORT(PETSC_COMM_WORLD, ierr);
+  ierr = MatMPIAIJSetPreallocationCSR(I, row_ptr.data(), col_indices.data(),
+                                      row_values.data());
+  CHKERRABORT(PETSC_COMM_WORLD, ierr);
 
   // Assemble the transfer matrix
   ierr = MatAssemblyBegin(I, MAT_FINAL_ASSEMBLY);
@@ -665,104 +415,6 @@ la::PETScMatrix PETScDMCollection::create_transfer_matrix(
   return la::PETScMatrix(I, false);
 }
 //-----------------------------------------------------------------------------
-void PETScDMCollection::find_exterior_points(
-    MPI_Comm mpi_comm, const mesh::Mesh& meshc,
-    const geometry::BoundingBoxTree& treec, int dim, int data_size,
-    const std::vector<double>& send_points,
-    const std::vector<int>& send_indices, std::vector<int>& indices,
-    std::vector<std::size_t>& cell_ids, std::vector<double>& points)
-{
-  assert(send_indices.size() / data_size == send_points.size() / dim);
-  Eigen::Map<
-      const Eigen::Array<int, Eigen::Dynamic, Eigen::Dynamic, Eigen::RowMajor>>
-      send_indices_arr(send_indices.data(), send_indices.size() / data_size,
-                       data_size);
-  unsigned int mpi_rank = MPI::rank(mpi_comm);
-  unsigned int mpi_size = MPI::size(mpi_comm);
-
-  // Get all points on all processes
-  std::vector<std::vector<double>> recv_points(mpi_size);
-  MPI::all_gather(mpi_comm, send_points, recv_points);
-
-  unsigned int num_recv_points = 0;
-  for (auto& p : recv_points)
-    num_recv_points += p.size();
-  num_recv_points /= dim;
-
-  // Save distances and ids of nearest cells on this process
-  std::vector<double> send_distance;
-  std::vector<unsigned int> ids;
-
-  send_distance.reserve(num_recv_points);
-  ids.reserve(num_recv_points);
-  for (const auto& p : recv_points)
-  {
-    unsigned int n_points = p.size() / dim;
-    for (unsigned int i = 0; i < n_points; ++i)
-    {
-      Eigen::Map<const Eigen::Vector3d> curr_point(&p[i * dim]);
-      std::pair<unsigned int, double> find_point
-          = treec.compute_closest_entity(curr_point, meshc);
-      send_distance.push_back(find_point.second);
-      ids.push_back(find_point.first);
-    }
-  }
-
-  // All processes get the same distance information
-  std::vector<double> recv_distance(num_recv_points * mpi_size);
-  MPI::all_gather(mpi_comm, send_distance, recv_distance);
-
-  // Determine which process has closest cell for each point, and send
-  // the global indices to that process
-  int ct = 0;
-  std::vector<std::vector<unsigned int>> send_global_indices(mpi_size);
-
-  for (unsigned int p = 0; p != mpi_size; ++p)
-  {
-    unsigned int n_points = recv_points[p].size() / dim;
-
-    Eigen::Map<const Eigen::Array<double, Eigen::Dynamic, Eigen::Dynamic,
-                                  Eigen::RowMajor>>
-        point_arr(recv_points[p].data(), n_points, dim);
-    for (unsigned int i = 0; i < n_points; ++i)
-    {
-      unsigned int min_proc = 0;
-      double min_val = recv_distance[ct];
-      for (unsigned int q = 1; q != mpi_size; ++q)
-      {
-        const double val = recv_distance[q * num_recv_points + ct];
-        if (val < min_val)
-        {
-          min_val = val;
-          min_proc = q;
-        }
-      }
-
-      if (min_proc == mpi_rank)
-      {
-        // If this process has closest cell, save the information
-        points.insert(points.end(), point_arr.row(i).data(),
-                      point_arr.row(i).data() + point_arr.cols());
-        cell_ids.push_back(ids[ct]);
-      }
-      if (p == mpi_rank)
-      {
-        send_global_indices[min_proc].insert(
-            send_global_indices[min_proc].end(), send_indices_arr.row(i).data(),
-            send_indices_arr.row(i).data() + send_indices_arr.cols());
-      }
-      ++ct;
-    }
-  }
-
-  // Send out global indices for the points provided by this process
-  std::vector<unsigned int> recv_global_indices;
-  MPI::all_to_all(mpi_comm, send_global_indices, recv_global_indices);
-
-  indices.insert(indices.end(), recv_global_indices.begin(),
-                 recv_global_indices.end());
-}
-//-----------------------------------------------------------------------------
 PetscErrorCode PETScDMCollection::create_global_vector(DM dm, Vec* vec)
 {
   // Get DOLFIN FunctiobSpace from the PETSc DM object
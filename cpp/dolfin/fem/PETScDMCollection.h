@@ -16,21 +16,11 @@
 namespace dolfin
 {
 
-namespace geometry
-{
-class BoundingBoxTree;
-}
-
 namespace function
 {
 class FunctionSpace;
 }
 
-namespace mesh
-{
-class Mesh;
-}
-
 namespace fem
 {
 
@@ -65,22 +55,16 @@ public:
   void reset(int i);
 
   /// Create the interpolation matrix from the coarse to the fine
-  /// space (prolongation matrix)
+  /// space (prolongation matrix). Fine dof points are located in the
+  /// coarse mesh by sending them only to the processes whose bounding
+  /// box contains them (or, for points outside the coarse domain, to
+  /// the processes that may have the closest coarse cell). The fine
+  /// space dofmap block size must equal the value size.
   static la::PETScMatrix
   create_transfer_matrix(const function::FunctionSpace& coarse_space,
                          const function::FunctionSpace& fine_space);
 
 private:
-  // Find the nearest cells to points which lie outside the domain
-  static void find_exterior_points(MPI_Comm mpi_comm, const mesh::Mesh& meshc,
-                                   const geometry::BoundingBoxTree& treec,
-                                   int dim, int data_size,
-                                   const std::vector<double>& send_points,
-                                   const std::vector<int>& send_indices,
-                                   std::vector<int>& indices,
-                                   std::vector<std::size_t>& cell_ids,
-                                   std::vector<double>& points);
-
   // Pointers to functions that are used in PETSc DM call-backs
   static PetscErrorCode create_global_vector(DM dm, Vec* vec);
   static PetscErrorCode create_interpolation(DM dmc, DM dmf, Mat* mat,
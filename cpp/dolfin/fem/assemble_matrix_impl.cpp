@@ -7,6 +7,7 @@
 #include "assemble_matrix_impl.h"
 #include "Form.h"
 #include "GenericDofMap.h"
+#include "utils.h"
 #include <dolfin/function/Function.h>
 #include <dolfin/function/FunctionSpace.h>
 #include <dolfin/la/utils.h>
@@ -21,11 +22,44 @@ using namespace dolfin;
 //-----------------------------------------------------------------------------
 void fem::impl::assemble_matrix(Mat A, const Form& a,
                                 const std::vector<bool>& bc0,
-                                const std::vector<bool>& bc1)
+                                const std::vector<bool>& bc1,
+                                const std::vector<std::int32_t>& bc_cells)
+{
+  assert(A);
+  auto mat_set_values = [A](std::int32_t m, const PetscInt* rows,
+                            std::int32_t n, const PetscInt* cols,
+                            const PetscScalar* vals) {
+    PetscErrorCode ierr
+        = MatSetValuesLocal(A, m, rows, n, cols, vals, ADD_VALUES);
+#ifdef DEBUG
+    if (ierr != 0)
+      la::petsc_error(ierr, __FILE__, "MatSetValuesLocal");
+#endif
+    return ierr;
+  };
+  fem::impl::assemble_matrix(mat_set_values, a, bc0, bc1, bc_cells);
+}
+//-----------------------------------------------------------------------------
+void fem::impl::assemble_matrix(
+    const std::function<int(std::int32_t, const PetscInt*, std::int32_t,
+                            const PetscInt*, const PetscScalar*)>&
+        mat_set_values,
+    const Form& a, const std::vector<bool>& bc0, const std::vector<bool>& bc1,
+    const std::vector<std::int32_t>& bc_cells)
 {
   assert(a.mesh());
   const mesh::Mesh& mesh = *a.mesh();
 
+  // Mark cells with bc dofs. Element matrices on other cells are added
+  // without checking the dofs against the bc markers.
+  const int tdim = mesh.topology().dim();
+  std::vector<bool> bc_cell_markers(mesh.num_entities(tdim), false);
+  if (!bc0.empty() or !bc1.empty())
+  {
+    for (std::int32_t c : bc_cells)
+      bc_cell_markers[c] = true;
+  }
+
   // Get dofmap data
   const fem::GenericDofMap& dofmap0 = *a.function_space(0)->dofmap();
   const fem::GenericDofMap& dofmap1 = *a.function_space(1)->dofmap();
@@ -37,12 +71,10 @@ void fem::impl::assemble_matrix(Mat A, const Form& a,
   const int num_dofs_per_cell0 = dofmap0.num_element_dofs(0);
   const int num_dofs_per_cell1 = dofmap1.num_element_dofs(0);
 
-  // Prepare coefficients
-  const FormCoefficients& coefficients = a.coeffs();
-  std::vector<const function::Function*> coeff_fn(coefficients.size());
-  for (int i = 0; i < coefficients.size(); ++i)
-    coeff_fn[i] = coefficients.get(i).get();
-  std::vector<int> c_offsets = coefficients.offsets();
+  // Pack coefficients
+  const Eigen::Array<PetscScalar, Eigen::Dynamic, Eigen::Dynamic,
+                     Eigen::RowMajor>
+      coeffs = fem::pack_coefficients(a);
 
   const FormIntegrals& integrals = a.integrals();
   using type = fem::FormIntegrals::Type;
@@ -51,9 +83,10 @@ void fem::impl::assemble_matrix(Mat A, const Form& a,
     auto& fn = integrals.get_tabulate_tensor_fn_cell(i);
     const std::vector<std::int32_t>& active_cells
         = integrals.integral_domains(type::cell, i);
-    fem::impl::assemble_cells(
-        A, mesh, active_cells, dof_array0, num_dofs_per_cell0, dof_array1,
-        num_dofs_per_cell1, bc0, bc1, fn, coeff_fn, c_offsets);
+    fem::impl::assemble_cells(mat_set_values, mesh, active_cells, dof_array0,
+                              num_dofs_per_cell0, dof_array1,
+                              num_dofs_per_cell1, bc0, bc1, bc_cell_markers,
+                              fn, coeffs);
   }
 
   for (int i = 0; i < integrals.num_integrals(type::exterior_facet); ++i)
@@ -61,9 +94,9 @@ void fem::impl::assemble_matrix(Mat A, const Form& a,
     auto& fn = integrals.get_tabulate_tensor_fn_exterior_facet(i);
     const std::vector<std::int32_t>& active_facets
         = integrals.integral_domains(type::exterior_facet, i);
-    fem::impl::assemble_exterior_facets(A, mesh, active_facets, dofmap0,
-                                        dofmap1, bc0, bc1, fn, coeff_fn,
-                                        c_offsets);
+    fem::impl::assemble_exterior_facets(mat_set_values, mesh, active_facets,
+                                        dofmap0, dofmap1, bc0, bc1,
+                                        bc_cell_markers, fn, coeffs);
   }
 
   if (a.integrals().num_integrals(type::interior_facet) > 0)
@@ -74,28 +107,28 @@ void fem::impl::assemble_matrix(Mat A, const Form& a,
 }
 //-----------------------------------------------------------------------------
 void fem::impl::assemble_cells(
-    Mat A, const mesh::Mesh& mesh,
+    const std::function<int(std::int32_t, const PetscInt*, std::int32_t,
+                            const PetscInt*, const PetscScalar*)>&
+        mat_set_values,
+    const mesh::Mesh& mesh,
     const std::vector<std::int32_t>& active_cells,
     const Eigen::Ref<const Eigen::Array<PetscInt, Eigen::Dynamic, 1>> dofmap0,
     int num_dofs_per_cell0,
     const Eigen::Ref<const Eigen::Array<PetscInt, Eigen::Dynamic, 1>> dofmap1,
     int num_dofs_per_cell1, const std::vector<bool>& bc0,
-    const std::vector<bool>& bc1,
+    const std::vector<bool>& bc1, const std::vector<bool>& bc_cells,
     const std::function<void(PetscScalar*, const PetscScalar*, const double*,
                              int)>& kernel,
-    std::vector<const function::Function*> coefficients,
-    const std::vector<int>& offsets)
+    const Eigen::Ref<const Eigen::Array<PetscScalar, Eigen::Dynamic,
+                                        Eigen::Dynamic, Eigen::RowMajor>>
+        coeffs)
 {
-  assert(A);
-
   const int gdim = mesh.geometry().dim();
   const int tdim = mesh.topology().dim();
 
   // Prepare cell geometry
   const mesh::Connectivity& connectivity_g
       = mesh.coordinate_dofs().entity_points(tdim);
-  const Eigen::Ref<const Eigen::Array<std::int32_t, Eigen::Dynamic, 1>> pos_g
-      = connectivity_g.entity_positions();
   const Eigen::Ref<const Eigen::Array<std::int32_t, Eigen::Dynamic, 1>> cell_g
       = connectivity_g.connections();
   // FIXME: Add proper interface for num coordinate dofs
@@ -109,35 +142,23 @@ void fem::impl::assemble_cells(
       coordinate_dofs(num_dofs_g, gdim);
   Eigen::Matrix<PetscScalar, Eigen::Dynamic, Eigen::Dynamic, Eigen::RowMajor>
       Ae;
-  Eigen::Array<PetscScalar, Eigen::Dynamic, 1> coeff_array(offsets.back());
 
   // Iterate over active cells
-  PetscErrorCode ierr;
   for (auto& cell_index : active_cells)
   {
-    const mesh::Cell cell(mesh, cell_index);
-
-    // Check that cell is not a ghost
-    assert(!cell.is_ghost());
-
     // Get cell coordinates/geometry
     for (int i = 0; i < num_dofs_g; ++i)
       for (int j = 0; j < gdim; ++j)
-        coordinate_dofs(i, j) = x_g(cell_g[pos_g[cell_index] + i], j);
-
-    // Update coefficients
-    for (std::size_t i = 0; i < coefficients.size(); ++i)
-    {
-      coefficients[i]->restrict(coeff_array.data() + offsets[i], cell,
-                                coordinate_dofs);
-    }
+        coordinate_dofs(i, j) = x_g(cell_g[cell_index * num_dofs_g + i], j);
 
     // Tabulate tensor
     Ae.setZero(num_dofs_per_cell0, num_dofs_per_cell1);
-    kernel(Ae.data(), coeff_array.data(), coordinate_dofs.data(), 1);
+    kernel(Ae.data(), coeffs.row(cell_index).data(), coordinate_dofs.data(),
+           1);
 
-    // Zero rows/columns for essential bcs
-    if (!bc0.empty())
+    // Zero rows/columns for essential bcs. Only cells with bc dofs
+    // need to be checked.
+    if (bc_cells[cell_index] and !bc0.empty())
     {
       for (Eigen::Index i = 0; i < Ae.rows(); ++i)
       {
@@ -146,7 +167,7 @@ void fem::impl::assemble_cells(
           Ae.row(i).setZero();
       }
     }
-    if (!bc1.empty())
+    if (bc_cells[cell_index] and !bc1.empty())
     {
       for (Eigen::Index j = 0; j < Ae.cols(); ++j)
       {
@@ -156,26 +177,28 @@ void fem::impl::assemble_cells(
       }
     }
 
-    ierr = MatSetValuesLocal(
-        A, num_dofs_per_cell0, dofmap0.data() + cell_index * num_dofs_per_cell0,
-        num_dofs_per_cell1, dofmap1.data() + cell_index * num_dofs_per_cell1,
-        Ae.data(), ADD_VALUES);
-#ifdef DEBUG
-    if (ierr != 0)
-      la::petsc_error(ierr, __FILE__, "MatSetValuesLocal");
-#endif
+    mat_set_values(num_dofs_per_cell0,
+                   dofmap0.data() + cell_index * num_dofs_per_cell0,
+                   num_dofs_per_cell1,
+                   dofmap1.data() + cell_index * num_dofs_per_cell1,
+                   Ae.data());
   }
 }
 //-----------------------------------------------------------------------------
 void fem::impl::assemble_exterior_facets(
-    Mat A, const mesh::Mesh& mesh,
+    const std::function<int(std::int32_t, const PetscInt*, std::int32_t,
+                            const PetscInt*, const PetscScalar*)>&
+        mat_set_values,
+    const mesh::Mesh& mesh,
     const std::vector<std::int32_t>& active_facets,
     const GenericDofMap& dofmap0, const GenericDofMap& dofmap1,
     const std::vector<bool>& bc0, const std::vector<bool>& bc1,
+    const std::vector<bool>& bc_cells,
     const std::function<void(PetscScalar*, const PetscScalar*, const double*,
                              int, int)>& fn,
-    std::vector<const function::Function*> coefficients,
-    const std::vector<int>& offsets)
+    const Eigen::Ref<const Eigen::Array<PetscScalar, Eigen::Dynamic,
+                                        Eigen::Dynamic, Eigen::RowMajor>>
+        coeffs)
 {
   const int gdim = mesh.geometry().dim();
   const int tdim = mesh.topology().dim();
@@ -185,8 +208,6 @@ void fem::impl::assemble_exterior_facets(
   // Prepare cell geometry
   const mesh::Connectivity& connectivity_g
       = mesh.coordinate_dofs().entity_points(tdim);
-  const Eigen::Ref<const Eigen::Array<std::int32_t, Eigen::Dynamic, 1>> pos_g
-      = connectivity_g.entity_positions();
   const Eigen::Ref<const Eigen::Array<std::int32_t, Eigen::Dynamic, 1>> cell_g
       = connectivity_g.connections();
   // FIXME: Add proper interface for num coordinate dofs
@@ -200,10 +221,8 @@ void fem::impl::assemble_exterior_facets(
       coordinate_dofs(num_dofs_g, gdim);
   Eigen::Matrix<PetscScalar, Eigen::Dynamic, Eigen::Dynamic, Eigen::RowMajor>
       Ae;
-  Eigen::Array<PetscScalar, Eigen::Dynamic, 1> coeff_array(offsets.back());
 
   // Iterate over all facets
-  PetscErrorCode ierr;
   for (const auto& facet_index : active_facets)
   {
     const mesh::Facet facet(mesh, facet_index);
@@ -221,7 +240,7 @@ void fem::impl::assemble_exterior_facets(
     const int cell_index = cell.index();
     for (int i = 0; i < num_dofs_g; ++i)
       for (int j = 0; j < gdim; ++j)
-        coordinate_dofs(i, j) = x_g(cell_g[pos_g[cell_index] + i], j);
+        coordinate_dofs(i, j) = x_g(cell_g[cell_index * num_dofs_g + i], j);
 
     // Get dof maps for cell
     Eigen::Map<const Eigen::Array<PetscInt, Eigen::Dynamic, 1>> dmap0
@@ -229,19 +248,14 @@ void fem::impl::assemble_exterior_facets(
     Eigen::Map<const Eigen::Array<PetscInt, Eigen::Dynamic, 1>> dmap1
         = dofmap1.cell_dofs(cell_index);
 
-    // Update coefficients
-    for (std::size_t i = 0; i < coefficients.size(); ++i)
-    {
-      coefficients[i]->restrict(coeff_array.data() + offsets[i], cell,
-                                coordinate_dofs);
-    }
-
     // Tabulate tensor
     Ae.setZero(dmap0.size(), dmap1.size());
-    fn(Ae.data(), coeff_array.data(), coordinate_dofs.data(), local_facet, 1);
+    fn(Ae.data(), coeffs.row(cell_index).data(), coordinate_dofs.data(),
+       local_facet, 1);
 
-    // Zero rows/columns for essential bcs
-    if (!bc0.empty())
+    // Zero rows/columns for essential bcs. Only cells with bc dofs
+    // need to be checked.
+    if (bc_cells[cell_index] and !bc0.empty())
     {
       for (Eigen::Index i = 0; i < Ae.rows(); ++i)
       {
@@ -249,7 +263,7 @@ void fem::impl::assemble_exterior_facets(
           Ae.row(i).setZero();
       }
     }
-    if (!bc1.empty())
+    if (bc_cells[cell_index] and !bc1.empty())
     {
       for (Eigen::Index j = 0; j < Ae.cols(); ++j)
       {
@@ -258,12 +272,8 @@ void fem::impl::assemble_exterior_facets(
       }
     }
 
-    ierr = MatSetValuesLocal(A, dmap0.size(), dmap0.data(), dmap1.size(),
-                             dmap1.data(), Ae.data(), ADD_VALUES);
-#ifdef DEBUG
-    if (ierr != 0)
-      la::petsc_error(ierr, __FILE__, "MatSetValuesLocal");
-#endif
+    mat_set_values(dmap0.size(), dmap0.data(), dmap1.size(), dmap1.data(),
+                   Ae.data());
   }
 }
 //-----------------------------------------------------------------------------
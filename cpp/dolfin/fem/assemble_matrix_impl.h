@@ -7,6 +7,7 @@
 #pragma once
 
 #include <Eigen/Dense>
+#include <cstdint>
 #include <functional>
 #include <petscmat.h>
 #include <petscsys.h>
@@ -15,11 +16,6 @@
 namespace dolfin
 {
 
-namespace function
-{
-class Function;
-}
-
 namespace mesh
 {
 class Mesh;
@@ -37,34 +33,63 @@ namespace impl
 /// i.e. a view into a larger matrix, and assembly is performed using
 /// local indices. Rows (bc0) and columns (bc1) with Dirichlet
 /// conditions are zeroed. Markers (bc0 and bc1) can be empty if not bcs
-/// are applied. Matrix is not finalised.
+/// are applied. Rows and columns are only checked for bcs on the
+/// (sorted) cells in bc_cells, which must contain all cells with a
+/// marked dof (see DirichletBC::cells). Matrix is not finalised.
 void assemble_matrix(Mat A, const Form& a, const std::vector<bool>& bc0,
-                     const std::vector<bool>& bc1);
+                     const std::vector<bool>& bc1,
+                     const std::vector<std::int32_t>& bc_cells);
+
+/// Assemble bilinear form a, with element tensors added by
+/// mat_set_values(num_rows, rows, num_cols, cols, values) using local
+/// row and column indices and row-major values. Bcs are handled as
+/// for assemble_matrix. mat_set_values returns zero on success.
+void assemble_matrix(
+    const std::function<int(std::int32_t, const PetscInt*, std::int32_t,
+                            const PetscInt*, const PetscScalar*)>&
+        mat_set_values,
+    const Form& a, const std::vector<bool>& bc0, const std::vector<bool>& bc1,
+    const std::vector<std::int32_t>& bc_cells);
 
-/// Execute kernel over cells and accumulate result in Mat
+/// Execute kernel over cells and add element tensors with
+/// mat_set_values. Rows and columns are zeroed for bcs only on cells
+/// marked in bc_cells. Row c of coeffs holds the packed coefficients
+/// for cell c.
 void assemble_cells(
-    Mat A, const mesh::Mesh& mesh,
+    const std::function<int(std::int32_t, const PetscInt*, std::int32_t,
+                            const PetscInt*, const PetscScalar*)>&
+        mat_set_values,
+    const mesh::Mesh& mesh,
     const std::vector<std::int32_t>& active_cells,
     const Eigen::Ref<const Eigen::Array<PetscInt, Eigen::Dynamic, 1>> dofmap0,
     int num_dofs_per_cell0,
     const Eigen::Ref<const Eigen::Array<PetscInt, Eigen::Dynamic, 1>> dofmap1,
     int num_dofs_per_cell1, const std::vector<bool>& bc0,
-    const std::vector<bool>& bc1,
+    const std::vector<bool>& bc1, const std::vector<bool>& bc_cells,
     const std::function<void(PetscScalar*, const PetscScalar*, const double*,
                              int)>& kernel,
-    std::vector<const function::Function*> coefficients,
-    const std::vector<int>& offsets);
+    const Eigen::Ref<const Eigen::Array<PetscScalar, Eigen::Dynamic,
+                                        Eigen::Dynamic, Eigen::RowMajor>>
+        coeffs);
 
-/// Execute kernel over exterior facets and  accumulate result in Mat
+/// Execute kernel over exterior facets and add element tensors with
+/// mat_set_values. Rows and columns are zeroed for bcs only on facets
+/// of cells marked in bc_cells. Row c of coeffs holds the packed
+/// coefficients for cell c.
 void assemble_exterior_facets(
-    Mat A, const mesh::Mesh& mesh,
+    const std::function<int(std::int32_t, const PetscInt*, std::int32_t,
+                            const PetscInt*, const PetscScalar*)>&
+        mat_set_values,
+    const mesh::Mesh& mesh,
     const std::vector<std::int32_t>& active_facets,
     const GenericDofMap& dofmap0, const GenericDofMap& dofmap1,
     const std::vector<bool>& bc0, const std::vector<bool>& bc1,
+    const std::vector<bool>& bc_cells,
     const std::function<void(PetscScalar*, const PetscScalar*, const double*,
                              int, int)>& fn,
-    std::vector<const function::Function*> coefficients,
-    const std::vector<int>& offsets);
+    const Eigen::Ref<const Eigen::Array<PetscScalar, Eigen::Dynamic,
+                                        Eigen::Dynamic, Eigen::RowMajor>>
+        coeffs);
 
 } // namespace impl
 } // namespace fem
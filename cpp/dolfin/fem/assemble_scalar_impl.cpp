@@ -73,8 +73,6 @@ PetscScalar fem::impl::assemble_cells(
   // Prepare cell geometry
   const mesh::Connectivity& connectivity_g
       = mesh.coordinate_dofs().entity_points(tdim);
-  const Eigen::Ref<const Eigen::Array<std::int32_t, Eigen::Dynamic, 1>> pos_g
-      = connectivity_g.entity_positions();
   const Eigen::Ref<const Eigen::Array<std::int32_t, Eigen::Dynamic, 1>> cell_g
       = connectivity_g.connections();
   // FIXME: Add proper interface for num coordinate dofs
@@ -101,7 +99,7 @@ PetscScalar fem::impl::assemble_cells(
     // Get cell coordinates/geometry
     for (int i = 0; i < num_dofs_g; ++i)
       for (int j = 0; j < gdim; ++j)
-        coordinate_dofs(i, j) = x_g(cell_g[pos_g[cell_index] + i], j);
+        coordinate_dofs(i, j) = x_g(cell_g[cell_index * num_dofs_g + i], j);
 
     // Update coefficients
     for (std::size_t i = 0; i < coefficients.size(); ++i)
@@ -132,8 +130,6 @@ PetscScalar fem::impl::assemble_exterior_facets(
   // Prepare cell geometry
   const mesh::Connectivity& connectivity_g
       = mesh.coordinate_dofs().entity_points(tdim);
-  const Eigen::Ref<const Eigen::Array<std::int32_t, Eigen::Dynamic, 1>> pos_g
-      = connectivity_g.entity_positions();
   const Eigen::Ref<const Eigen::Array<std::int32_t, Eigen::Dynamic, 1>> cell_g
       = connectivity_g.connections();
   // FIXME: Add proper interface for num coordinate dofs
@@ -167,7 +163,7 @@ PetscScalar fem::impl::assemble_exterior_facets(
     const int cell_index = cell.index();
     for (int i = 0; i < num_dofs_g; ++i)
       for (int j = 0; j < gdim; ++j)
-        coordinate_dofs(i, j) = x_g(cell_g[pos_g[cell_index] + i], j);
+        coordinate_dofs(i, j) = x_g(cell_g[cell_index * num_dofs_g + i], j);
 
     // Update coefficients
     for (std::size_t i = 0; i < coefficients.size(); ++i)
@@ -0,0 +1,349 @@
+// Copyright (C) 2026 agent
+//
+// This file is part of DOLFIN (https://www.fenicsproject.org)
+//
+// SPDX-License-Identifier:    LGPL-3.0-or-later
+
+#include "assemble_system_impl.h"
+#include "Form.h"
+#include "GenericDofMap.h"
+#include <algorithm>
+#include <array>
+#include <dolfin/common/IndexMap.h>
+#include <dolfin/function/Function.h>
+#include <dolfin/function/FunctionSpace.h>
+#include <dolfin/la/PETScVector.h>
+#include <dolfin/la/utils.h>
+#include <dolfin/mesh/Connectivity.h>
+#include <dolfin/mesh/Mesh.h>
+#include <petscsys.h>
+
+using namespace dolfin;
+
+namespace
+{
+//-----------------------------------------------------------------------------
+// Return markers for the entities on which each integral of type t is
+// active
+std::vector<std::vector<bool>>
+active_entities(const fem::FormIntegrals& integrals,
+                fem::FormIntegrals::Type t, std::int32_t num_entities)
+{
+  std::vector<std::vector<bool>> active(integrals.num_integrals(t));
+  for (std::size_t i = 0; i < active.size(); ++i)
+  {
+    active[i].assign(num_entities, false);
+    for (std::int32_t e : integrals.integral_domains(t, i))
+      active[i][e] = true;
+  }
+  return active;
+}
+//-----------------------------------------------------------------------------
+} // namespace
+
+//-----------------------------------------------------------------------------
+void fem::impl::assemble_system(
+    Mat A, Eigen::Ref<Eigen::Matrix<PetscScalar, Eigen::Dynamic, 1>> b,
+    const Form& a, const Form& L, const std::vector<bool>& bc0,
+    const std::vector<bool>& bc1, const std::vector<std::int32_t>& bc_cells,
+    const Eigen::Ref<const Eigen::Matrix<PetscScalar, Eigen::Dynamic, 1>>
+        bc_values1,
+    const Eigen::Ref<const Eigen::Matrix<PetscScalar, Eigen::Dynamic, 1>> x0,
+    double scale, bool set_bc)
+{
+  assert(A);
+  assert(a.rank() == 2);
+  assert(L.rank() == 1);
+  assert(a.mesh());
+  if (a.mesh() != L.mesh())
+    throw std::runtime_error("Forms in system assembly must share a mesh.");
+  if (!(*a.function_space(0) == *L.function_space(0)))
+  {
+    throw std::runtime_error(
+        "Forms in system assembly must have the same test space.");
+  }
+
+  const mesh::Mesh& mesh = *a.mesh();
+  const int gdim = mesh.geometry().dim();
+  const int tdim = mesh.topology().dim();
+
+  const FormIntegrals& integrals_a = a.integrals();
+  const FormIntegrals& integrals_L = L.integrals();
+  using type = fem::FormIntegrals::Type;
+  if (integrals_a.num_integrals(type::interior_facet) > 0
+      or integrals_L.num_integrals(type::interior_facet) > 0)
+  {
+    throw std::runtime_error(
+        "Interior facet integrals not supported in system assembly.");
+  }
+
+  // Get dofmaps
+  const fem::GenericDofMap& dofmap0 = *a.function_space(0)->dofmap();
+  const fem::GenericDofMap& dofmap1 = *a.function_space(1)->dofmap();
+
+  // Collect the distinct Functions that are coefficients of a and L,
+  // and the position of each form coefficient in the cell array of
+  // distinct Function coefficients
+  const std::array<const Form*, 2> forms = {{&a, &L}};
+  std::vector<const function::Function*> functions;
+  std::vector<la::VecReadWrapper> function_values;
+  std::vector<int> function_offsets = {0};
+  std::array<std::vector<int>, 2> positions;
+  for (int f = 0; f < 2; ++f)
+  {
+    const FormCoefficients& coefficients = forms[f]->coeffs();
+    for (int i = 0; i < coefficients.size(); ++i)
+    {
+      const function::Function* fn = coefficients.get(i).get();
+      if (!fn)
+      {
+        throw std::runtime_error("Cannot assemble system. Coefficient \""
+                                 + coefficients.get_name(i)
+                                 + "\" has not been set");
+      }
+
+      const std::size_t pos
+          = std::find(functions.begin(), functions.end(), fn)
+            - functions.begin();
+      if (pos == functions.size())
+      {
+        functions.push_back(fn);
+        function_values.emplace_back(fn->vector().vec());
+        function_offsets.push_back(
+            function_offsets.back()
+            + fn->function_space()->element()->space_dimension());
+      }
+      positions[f].push_back(function_offsets[pos]);
+    }
+  }
+  const std::array<std::vector<int>, 2> offsets
+      = {{a.coeffs().offsets(), L.coeffs().offsets()}};
+
+  // Prepare cell geometry
+  const mesh::Connectivity& connectivity_g
+      = mesh.coordinate_dofs().entity_points(tdim);
+  const Eigen::Ref<const Eigen::Array<std::int32_t, Eigen::Dynamic, 1>> cell_g
+      = connectivity_g.connections();
+  // FIXME: Add proper interface for num coordinate dofs
+  const int num_dofs_g = connectivity_g.size(0);
+  const Eigen::Array<double, Eigen::Dynamic, 3, Eigen::RowMajor>& x_g
+      = mesh.geometry().points();
+
+  // Data structures used in assembly
+  Eigen::Array<double, Eigen::Dynamic, Eigen::Dynamic, Eigen::RowMajor>
+      coordinate_dofs(num_dofs_g, gdim);
+  Eigen::Array<PetscScalar, Eigen::Dynamic, 1> w(function_offsets.back());
+  std::array<Eigen::Array<PetscScalar, Eigen::Dynamic, 1>, 2> coeff_array
+      = {{Eigen::Array<PetscScalar, Eigen::Dynamic, 1>(offsets[0].back()),
+          Eigen::Array<PetscScalar, Eigen::Dynamic, 1>(offsets[1].back())}};
+  Eigen::Matrix<PetscScalar, Eigen::Dynamic, Eigen::Dynamic, Eigen::RowMajor>
+      Ae;
+  Eigen::Matrix<PetscScalar, Eigen::Dynamic, 1> be;
+
+  // Gather cell geometry and coefficients of both forms. Each distinct
+  // Function is gathered once.
+  auto gather = [&](std::int32_t c) {
+    for (int i = 0; i < num_dofs_g; ++i)
+      for (int j = 0; j < gdim; ++j)
+        coordinate_dofs(i, j) = x_g(cell_g[c * num_dofs_g + i], j);
+
+    for (std::size_t i = 0; i < functions.size(); ++i)
+    {
+      auto dofs = functions[i]->function_space()->dofmap()->cell_dofs(c);
+      for (Eigen::Index j = 0; j < dofs.size(); ++j)
+        w[function_offsets[i] + j] = function_values[i].x[dofs[j]];
+    }
+
+    for (int f = 0; f < 2; ++f)
+    {
+      for (std::size_t i = 0; i < positions[f].size(); ++i)
+      {
+        const int n = offsets[f][i + 1] - offsets[f][i];
+        coeff_array[f].segment(offsets[f][i], n)
+            = w.segment(positions[f][i], n);
+      }
+    }
+  };
+
+  // Mark cells with bc dofs. Cell tensors on other cells are added
+  // without checking the dofs against the bc markers.
+  std::vector<bool> bc_cell_markers(mesh.num_entities(tdim), false);
+  if (!bc0.empty() or !bc1.empty())
+  {
+    for (std::int32_t c : bc_cells)
+      bc_cell_markers[c] = true;
+  }
+
+  // Apply lifting to the cell vector, apply bcs to the cell matrix and
+  // add both to the global system
+  PetscErrorCode ierr;
+  auto add = [&](std::int32_t c) {
+    auto dmap0 = dofmap0.cell_dofs(c);
+    auto dmap1 = dofmap1.cell_dofs(c);
+
+    // Lift bcs (with the unmodified cell matrix) and zero columns
+    if (bc_cell_markers[c] and !bc1.empty())
+    {
+      for (Eigen::Index j = 0; j < Ae.cols(); ++j)
+      {
+        const PetscInt jj = dmap1[j];
+        if (bc1[jj])
+        {
+          const PetscScalar g
+              = (x0.rows() > 0) ? bc_values1[jj] - x0[jj] : bc_values1[jj];
+          be -= Ae.col(j) * scale * g;
+          Ae.col(j).setZero();
+        }
+      }
+    }
+
+    // Zero rows for essential bcs, and vector entries if bc values
+    // are set
+    if (bc_cell_markers[c] and !bc0.empty())
+    {
+      for (Eigen::Index i = 0; i < Ae.rows(); ++i)
+      {
+        if (bc0[dmap0[i]])
+        {
+          Ae.row(i).setZero();
+          if (set_bc)
+            be[i] = 0.0;
+        }
+      }
+    }
+
+    for (Eigen::Index i = 0; i < be.size(); ++i)
+      b[dmap0[i]] += be[i];
+
+    ierr = MatSetValuesLocal(A, dmap0.size(), dmap0.data(), dmap1.size(),
+                             dmap1.data(), Ae.data(), ADD_VALUES);
+#ifdef DEBUG
+    if (ierr != 0)
+      la::petsc_error(ierr, __FILE__, "MatSetValuesLocal");
+#endif
+  };
+
+  // Iterate over cells on which a cell integral of either form is
+  // active
+  const std::int32_t num_cells = mesh.num_entities(tdim);
+  const std::vector<std::vector<bool>> cells_a
+      = active_entities(integrals_a, type::cell, num_cells);
+  const std::vector<std::vector<bool>> cells_L
+      = active_entities(integrals_L, type::cell, num_cells);
+  if (!cells_a.empty() or !cells_L.empty())
+  {
+    for (std::int32_t c = 0; c < num_cells; ++c)
+    {
+      bool active = false;
+      for (const std::vector<bool>& cells : cells_a)
+        active = active or cells[c];
+      for (const std::vector<bool>& cells : cells_L)
+        active = active or cells[c];
+      if (!active)
+        continue;
+
+      gather(c);
+
+      // Tabulate tensors
+      Ae.setZero(dofmap0.num_element_dofs(c), dofmap1.num_element_dofs(c));
+      be.setZero(Ae.rows());
+      for (std::size_t i = 0; i < cells_a.size(); ++i)
+      {
+        if (cells_a[i][c])
+        {
+          integrals_a.get_tabulate_tensor_fn_cell(i)(
+              Ae.data(), coeff_array[0].data(), coordinate_dofs.data(), 1);
+        }
+      }
+      for (std::size_t i = 0; i < cells_L.size(); ++i)
+      {
+        if (cells_L[i][c])
+        {
+          integrals_L.get_tabulate_tensor_fn_cell(i)(
+              be.data(), coeff_array[1].data(), coordinate_dofs.data(), 1);
+        }
+      }
+
+      add(c);
+    }
+  }
+
+  if (integrals_a.num_integrals(type::exterior_facet) > 0
+      or integrals_L.num_integrals(type::exterior_facet) > 0)
+  {
+    // Iterate over exterior facets on which a facet integral of either
+    // form is active
+    mesh.create_entities(tdim - 1);
+    mesh.create_connectivity(tdim - 1, tdim);
+    mesh.create_connectivity(tdim, tdim - 1);
+    const mesh::Connectivity& facet_cell
+        = *mesh.topology().connectivity(tdim - 1, tdim);
+    const mesh::Connectivity& cell_facet
+        = *mesh.topology().connectivity(tdim, tdim - 1);
+    const std::int32_t num_facets = mesh.num_entities(tdim - 1);
+    const std::vector<std::vector<bool>> facets_a
+        = active_entities(integrals_a, type::exterior_facet, num_facets);
+    const std::vector<std::vector<bool>> facets_L
+        = active_entities(integrals_L, type::exterior_facet, num_facets);
+    for (std::int32_t f = 0; f < num_facets; ++f)
+    {
+      bool active = false;
+      for (const std::vector<bool>& facets : facets_a)
+        active = active or facets[f];
+      for (const std::vector<bool>& facets : facets_L)
+        active = active or facets[f];
+      if (!active)
+        continue;
+
+      // Attached cell and local index of facet with respect to the cell
+      assert(facet_cell.size(f) == 1);
+      const std::int32_t c = facet_cell.connections(f)[0];
+      const std::int32_t* facets = cell_facet.connections(c);
+      const int local_facet
+          = std::find(facets, facets + cell_facet.size(c), f) - facets;
+
+      gather(c);
+
+      // Tabulate tensors
+      Ae.setZero(dofmap0.num_element_dofs(c), dofmap1.num_element_dofs(c));
+      be.setZero(Ae.rows());
+      for (std::size_t i = 0; i < facets_a.size(); ++i)
+      {
+        if (facets_a[i][f])
+        {
+          integrals_a.get_tabulate_tensor_fn_exterior_facet(i)(
+              Ae.data(), coeff_array[0].data(), coordinate_dofs.data(),
+              local_facet, 1);
+        }
+      }
+      for (std::size_t i = 0; i < facets_L.size(); ++i)
+      {
+        if (facets_L[i][f])
+        {
+          integrals_L.get_tabulate_tensor_fn_exterior_facet(i)(
+              be.data(), coeff_array[1].data(), coordinate_dofs.data(),
+              local_facet, 1);
+        }
+      }
+
+      add(c);
+    }
+  }
+
+  // Set bc values in owned entries of b
+  if (set_bc and !bc0.empty())
+  {
+    assert(bc0.size() == bc1.size());
+    auto map0 = dofmap0.index_map();
+    const std::int32_t owned_size = map0->block_size() * map0->size_local();
+    for (std::int32_t i = 0; i < owned_size; ++i)
+    {
+      if (bc0[i])
+      {
+        b[i] = (x0.rows() > 0) ? scale * (bc_values1[i] - x0[i])
+                               : scale * bc_values1[i];
+      }
+    }
+  }
+}
+//-----------------------------------------------------------------------------
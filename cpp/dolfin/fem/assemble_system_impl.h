@@ -0,0 +1,51 @@
+// Copyright (C) 2026 agent
+//
+// This file is part of DOLFIN (https://www.fenicsproject.org)
+//
+// SPDX-License-Identifier:    LGPL-3.0-or-later
+
+#pragma once
+
+#include <Eigen/Dense>
+#include <cstdint>
+#include <petscmat.h>
+#include <petscsys.h>
+#include <vector>
+
+namespace dolfin
+{
+
+namespace fem
+{
+class Form;
+
+namespace impl
+{
+
+/// Assemble the bilinear form a into the matrix A and the linear form
+/// L into the vector b in one pass over the cells and exterior facets.
+/// The cell geometry and coefficients are gathered once for both
+/// forms, with coefficients common to a and L gathered once. Rows
+/// (bc0) and columns (bc1) of A with Dirichlet conditions are zeroed,
+/// and b is modified such that b <- b - scale * A (g - x0), where g
+/// holds the boundary values (bc_values1) for the columns. Markers can
+/// be empty if no bcs are applied, and x0 can be empty, in which case
+/// it is treated as zero. If set_bc is true (the test and trial spaces
+/// must be the same, with bc0 and bc1 the same markers), cell
+/// contributions to rows of b with bcs are dropped and the owned
+/// entries are set to scale * (g - x0), so that b is complete after
+/// accumulation of ghost contributions. Bcs are only applied to the
+/// cell tensors of the (sorted) cells in bc_cells, which must contain
+/// all cells with a marked dof. Matrix is not finalised.
+void assemble_system(
+    Mat A, Eigen::Ref<Eigen::Matrix<PetscScalar, Eigen::Dynamic, 1>> b,
+    const Form& a, const Form& L, const std::vector<bool>& bc0,
+    const std::vector<bool>& bc1, const std::vector<std::int32_t>& bc_cells,
+    const Eigen::Ref<const Eigen::Matrix<PetscScalar, Eigen::Dynamic, 1>>
+        bc_values1,
+    const Eigen::Ref<const Eigen::Matrix<PetscScalar, Eigen::Dynamic, 1>> x0,
+    double scale, bool set_bc);
+
+} // namespace impl
+} // namespace fem
+} // namespace dolfin
@@ -8,11 +8,14 @@
 #include "DirichletBC.h"
 #include "Form.h"
 #include "GenericDofMap.h"
+#include "utils.h"
+#include <algorithm>
 #include <dolfin/common/IndexMap.h>
 #include <dolfin/common/types.h>
 #include <dolfin/function/Function.h>
 #include <dolfin/function/FunctionSpace.h>
 #include <dolfin/mesh/Cell.h>
+#include <dolfin/mesh/Connectivity.h>
 #include <dolfin/mesh/Facet.h>
 #include <dolfin/mesh/Mesh.h>
 #include <dolfin/mesh/MeshIterator.h>
@@ -29,6 +32,7 @@ void _lift_bc_cells(
     const Eigen::Ref<const Eigen::Matrix<PetscScalar, Eigen::Dynamic, 1>>
         bc_values1,
     const std::vector<bool>& bc_markers1,
+    const std::vector<std::int32_t>& bc_cells,
     const Eigen::Ref<const Eigen::Matrix<PetscScalar, Eigen::Dynamic, 1>> x0,
     double scale)
 {
@@ -69,8 +73,6 @@ void _lift_bc_cells(
   const int tdim = mesh.topology().dim();
   const mesh::Connectivity& connectivity_g
       = mesh.coordinate_dofs().entity_points(tdim);
-  const Eigen::Ref<const Eigen::Array<std::int32_t, Eigen::Dynamic, 1>> pos_g
-      = connectivity_g.entity_positions();
   const Eigen::Ref<const Eigen::Array<std::int32_t, Eigen::Dynamic, 1>> cell_g
       = connectivity_g.connections();
   // FIXME: Add proper interface for num coordinate dofs
@@ -86,35 +88,23 @@ void _lift_bc_cells(
       Ae;
   Eigen::Matrix<PetscScalar, Eigen::Dynamic, 1> be;
 
-  // Iterate over all cells
-  for (const mesh::Cell& cell : mesh::MeshRange<mesh::Cell>(mesh))
+  // Iterate over (non-ghost) cells to which a bc is applied
+  const std::int32_t num_cells = mesh.topology().ghost_offset(tdim);
+  for (std::int32_t cell_index : bc_cells)
   {
-    // Check that cell is not a ghost
-    assert(!cell.is_ghost());
+    // bc_cells is sorted, with ghost cells last
+    if (cell_index >= num_cells)
+      break;
+    const mesh::Cell cell(mesh, cell_index);
 
     // Get dof maps for cell
     const Eigen::Map<const Eigen::Array<PetscInt, Eigen::Dynamic, 1>> dmap1
-        = dofmap1.cell_dofs(cell.index());
-
-    // Check if bc is applied to cell
-    bool has_bc = false;
-    for (Eigen::Index j = 0; j < dmap1.size(); ++j)
-    {
-      if (bc_markers1[dmap1[j]])
-      {
-        has_bc = true;
-        break;
-      }
-    }
-
-    if (!has_bc)
-      continue;
+        = dofmap1.cell_dofs(cell_index);
 
     // Get cell vertex coordinates
-    const int cell_index = cell.index();
     for (int i = 0; i < num_dofs_g; ++i)
       for (int j = 0; j < gdim; ++j)
-        coordinate_dofs(i, j) = x_g(cell_g[pos_g[cell_index] + i], j);
+        coordinate_dofs(i, j) = x_g(cell_g[cell_index * num_dofs_g + i], j);
 
     // Size data structure for assembly
     const Eigen::Map<const Eigen::Array<PetscInt, Eigen::Dynamic, 1>> dmap0
@@ -157,6 +147,7 @@ void _lift_bc_exterior_facets(
     const Eigen::Ref<const Eigen::Matrix<PetscScalar, Eigen::Dynamic, 1>>
         bc_values1,
     const std::vector<bool>& bc_markers1,
+    const std::vector<std::int32_t>& bc_cells,
     const Eigen::Ref<const Eigen::Matrix<PetscScalar, Eigen::Dynamic, 1>> x0,
     double scale)
 {
@@ -170,6 +161,7 @@ void _lift_bc_exterior_facets(
   const int tdim = mesh.topology().dim();
   mesh.create_entities(tdim - 1);
   mesh.create_connectivity(tdim - 1, tdim);
+  mesh.create_connectivity(tdim, tdim - 1);
 
   // Get dofmap for columns and rows of a
   assert(a.function_space(0));
@@ -200,8 +192,6 @@ void _lift_bc_exterior_facets(
   // Prepare cell geometry
   const mesh::Connectivity& connectivity_g
       = mesh.coordinate_dofs().entity_points(tdim);
-  const Eigen::Ref<const Eigen::Array<std::int32_t, Eigen::Dynamic, 1>> pos_g
-      = connectivity_g.entity_positions();
   const Eigen::Ref<const Eigen::Array<std::int32_t, Eigen::Dynamic, 1>> cell_g
       = connectivity_g.connections();
   // FIXME: Add proper interface for num coordinate dofs
@@ -217,77 +207,68 @@ void _lift_bc_exterior_facets(
       Ae;
   Eigen::Matrix<PetscScalar, Eigen::Dynamic, 1> be;
 
-  // Iterate over all cells
-  for (const mesh::Facet& facet : mesh::MeshRange<mesh::Facet>(mesh))
+  // Iterate over the (non-ghost) exterior facets of cells to which a
+  // bc is applied. An exterior facet is attached to one cell only, so
+  // each facet is visited once.
+  const std::int32_t num_facets = mesh.topology().ghost_offset(tdim - 1);
+  for (std::int32_t cell_index : bc_cells)
   {
-    if (facet.num_global_entities(tdim) != 1)
-      continue;
-
     // FIXME: sort out ghosts
 
-    // Create attached cell
-    mesh::Cell cell(mesh, facet.entities(tdim)[0]);
-
-    // Get local index of facet with respect to the cell
-    const int local_facet = cell.index(facet);
-
-    // Get dof maps for cell
-    const Eigen::Map<const Eigen::Array<PetscInt, Eigen::Dynamic, 1>> dmap1
-        = dofmap1.cell_dofs(cell.index());
-
-    // Check if bc is applied to cell
-    bool has_bc = false;
-    for (Eigen::Index j = 0; j < dmap1.size(); ++j)
+    const mesh::Cell cell(mesh, cell_index);
+    const std::int32_t* facets = cell.entities(tdim - 1);
+    for (std::size_t local_facet = 0; local_facet < cell.num_entities(tdim - 1);
+         ++local_facet)
     {
-      if (bc_markers1[dmap1[j]])
+      const mesh::Facet facet(mesh, facets[local_facet]);
+      if (facets[local_facet] >= num_facets
+          or facet.num_global_entities(tdim) != 1)
+        continue;
+
+      // Get dof maps for cell
+      const Eigen::Map<const Eigen::Array<PetscInt, Eigen::Dynamic, 1>> dmap1
+          = dofmap1.cell_dofs(cell_index);
+
+      // Get cell vertex coordinates
+      for (int i = 0; i < num_dofs_g; ++i)
+        for (int j = 0; j < gdim; ++j)
+          coordinate_dofs(i, j) = x_g(cell_g[cell_index * num_dofs_g + i], j);
+
+      // Size data structure for assembly
+      const Eigen::Map<const Eigen::Array<PetscInt, Eigen::Dynamic, 1>> dmap0
+          = dofmap0.cell_dofs(cell_index);
+
+      // TODO: Move gathering of coefficients outside of main assembly
+      // loop
+      // Update coefficients
+      for (int i = 0; i < coefficients.size(); ++i)
       {
-        has_bc = true;
-        break;
+        coefficients_ptr[i]->restrict(coeff_array.data() + n[i], cell,
+                                      coordinate_dofs);
       }
-    }
 
-    if (!has_bc)
-      continue;
-
-    // Get cell vertex coordinates
-    const int cell_index = cell.index();
-    for (int i = 0; i < num_dofs_g; ++i)
-      for (int j = 0; j < gdim; ++j)
-        coordinate_dofs(i, j) = x_g(cell_g[pos_g[cell_index] + i], j);
-
-    // Size data structure for assembly
-    const Eigen::Map<const Eigen::Array<PetscInt, Eigen::Dynamic, 1>> dmap0
-        = dofmap0.cell_dofs(cell.index());
-
-    // TODO: Move gathering of coefficients outside of main assembly
-    // loop
-    // Update coefficients
-    for (int i = 0; i < coefficients.size(); ++i)
-    {
-      coefficients_ptr[i]->restrict(coeff_array.data() + n[i], cell,
-                                    coordinate_dofs);
-    }
-
-    Ae.setZero(dmap0.size(), dmap1.size());
-    fn(Ae.data(), coeff_array.data(), coordinate_dofs.data(), local_facet, 1);
+      Ae.setZero(dmap0.size(), dmap1.size());
+      fn(Ae.data(), coeff_array.data(), coordinate_dofs.data(), local_facet,
+         1);
 
-    // Size data structure for assembly
-    be.setZero(dmap0.size());
-    for (Eigen::Index j = 0; j < dmap1.size(); ++j)
-    {
-      const PetscInt jj = dmap1[j];
-      if (bc_markers1[jj])
+      // Size data structure for assembly
+      be.setZero(dmap0.size());
+      for (Eigen::Index j = 0; j < dmap1.size(); ++j)
       {
-        const PetscScalar bc = bc_values1[jj];
-        if (x0.rows() > 0)
-          be -= Ae.col(j) * scale * (bc - x0[jj]);
-        else
-          be -= Ae.col(j) * scale * bc;
+        const PetscInt jj = dmap1[j];
+        if (bc_markers1[jj])
+        {
+          const PetscScalar bc = bc_values1[jj];
+          if (x0.rows() > 0)
+            be -= Ae.col(j) * scale * (bc - x0[jj]);
+          else
+            be -= Ae.col(j) * scale * bc;
+        }
       }
-    }
 
-    for (Eigen::Index k = 0; k < dmap0.size(); ++k)
-      b[dmap0[k]] += be[k];
+      for (Eigen::Index k = 0; k < dmap0.size(); ++k)
+        b[dmap0[k]] += be[k];
+    }
   }
 }
 } // namespace
@@ -295,6 +276,18 @@ void _lift_bc_exterior_facets(
 //-----------------------------------------------------------------------------
 void fem::impl::assemble_vector(
     Eigen::Ref<Eigen::Matrix<PetscScalar, Eigen::Dynamic, 1>> b, const Form& L)
+{
+  const Eigen::Array<PetscScalar, Eigen::Dynamic, Eigen::Dynamic,
+                     Eigen::RowMajor>
+      coeffs = fem::pack_coefficients(L);
+  fem::impl::assemble_vector(b, L, coeffs);
+}
+//-----------------------------------------------------------------------------
+void fem::impl::assemble_vector(
+    Eigen::Ref<Eigen::Matrix<PetscScalar, Eigen::Dynamic, 1>> b, const Form& L,
+    const Eigen::Ref<const Eigen::Array<PetscScalar, Eigen::Dynamic,
+                                        Eigen::Dynamic, Eigen::RowMajor>>
+        coeffs)
 {
   assert(L.mesh());
   const mesh::Mesh& mesh = *L.mesh();
@@ -306,13 +299,6 @@ void fem::impl::assemble_vector(
   // FIXME: do this right
   const int num_dofs_per_cell = dofmap.num_element_dofs(0);
 
-  // Prepare coefficients
-  const FormCoefficients& coefficients = L.coeffs();
-  std::vector<const function::Function*> coeff_fn(coefficients.size());
-  for (int i = 0; i < coefficients.size(); ++i)
-    coeff_fn[i] = coefficients.get(i).get();
-  std::vector<int> c_offsets = coefficients.offsets();
-
   const FormIntegrals& integrals = L.integrals();
   using type = fem::FormIntegrals::Type;
   for (int i = 0; i < integrals.num_integrals(type::cell); ++i)
@@ -321,7 +307,7 @@ void fem::impl::assemble_vector(
     const std::vector<std::int32_t>& active_cells
         = integrals.integral_domains(type::cell, i);
     fem::impl::assemble_cells(b, mesh, active_cells, dof_array,
-                              num_dofs_per_cell, fn, coeff_fn, c_offsets);
+                              num_dofs_per_cell, fn, coeffs);
   }
 
   for (int i = 0; i < integrals.num_integrals(type::exterior_facet); ++i)
@@ -330,7 +316,7 @@ void fem::impl::assemble_vector(
     const std::vector<std::int32_t>& active_facets
         = integrals.integral_domains(type::exterior_facet, i);
     fem::impl::assemble_exterior_facets(b, mesh, active_facets, dofmap, fn,
-                                        coeff_fn, c_offsets);
+                                        coeffs);
   }
 
   if (L.integrals().num_integrals(fem::FormIntegrals::Type::interior_facet) > 0)
@@ -344,8 +330,9 @@ void fem::impl::assemble_cells(
     int num_dofs_per_cell,
     const std::function<void(PetscScalar*, const PetscScalar*, const double*,
                              int)>& kernel,
-    std::vector<const function::Function*> coefficients,
-    const std::vector<int>& offsets)
+    const Eigen::Ref<const Eigen::Array<PetscScalar, Eigen::Dynamic,
+                                        Eigen::Dynamic, Eigen::RowMajor>>
+        coeffs)
 {
   const int gdim = mesh.geometry().dim();
   const int tdim = mesh.topology().dim();
@@ -353,8 +340,6 @@ void fem::impl::assemble_cells(
   // Prepare cell geometry
   const mesh::Connectivity& connectivity_g
       = mesh.coordinate_dofs().entity_points(tdim);
-  const Eigen::Ref<const Eigen::Array<std::int32_t, Eigen::Dynamic, 1>> pos_g
-      = connectivity_g.entity_positions();
   const Eigen::Ref<const Eigen::Array<std::int32_t, Eigen::Dynamic, 1>> cell_g
       = connectivity_g.connections();
   // FIXME: Add proper interface for num coordinate dofs
@@ -367,29 +352,19 @@ void fem::impl::assemble_cells(
   Eigen::Array<double, Eigen::Dynamic, Eigen::Dynamic, Eigen::RowMajor>
       coordinate_dofs(num_dofs_g, gdim);
   Eigen::Matrix<PetscScalar, Eigen::Dynamic, 1> be(num_dofs_per_cell);
-  Eigen::Array<PetscScalar, Eigen::Dynamic, 1> coeff_array(offsets.back());
 
   // Iterate over active cells
   for (std::int32_t cell_index : active_cells)
   {
-    const mesh::Cell cell(mesh, cell_index);
-    assert(!cell.is_ghost());
-
     // Get cell coordinates/geometry
     for (int i = 0; i < num_dofs_g; ++i)
       for (int j = 0; j < gdim; ++j)
-        coordinate_dofs(i, j) = x_g(cell_g[pos_g[cell_index] + i], j);
-
-    // FIXME: Move this outside of inner assembly loop
-    // Update coefficients
-    for (std::size_t i = 0; i < coefficients.size(); ++i)
-    {
-      coefficients[i]->restrict(coeff_array.data() + offsets[i], cell,
-                                coordinate_dofs);
-    }
+        coordinate_dofs(i, j) = x_g(cell_g[cell_index * num_dofs_g + i], j);
 
     // Tabulate vector for cell
-    kernel(be.data(), coeff_array.data(), coordinate_dofs.data(), 1);
+    be.setZero();
+    kernel(be.data(), coeffs.row(cell_index).data(), coordinate_dofs.data(),
+           1);
 
     // Add local cell vector to global vector
     for (Eigen::Index i = 0; i < num_dofs_per_cell; ++i)
@@ -403,8 +378,9 @@ void fem::impl::assemble_exterior_facets(
     const fem::GenericDofMap& dofmap,
     const std::function<void(PetscScalar*, const PetscScalar*, const double*,
                              int, int)>& fn,
-    std::vector<const function::Function*> coefficients,
-    const std::vector<int>& offsets)
+    const Eigen::Ref<const Eigen::Array<PetscScalar, Eigen::Dynamic,
+                                        Eigen::Dynamic, Eigen::RowMajor>>
+        coeffs)
 {
   const int gdim = mesh.geometry().dim();
   const int tdim = mesh.topology().dim();
@@ -414,8 +390,6 @@ void fem::impl::assemble_exterior_facets(
   // Prepare cell geometry
   const mesh::Connectivity& connectivity_g
       = mesh.coordinate_dofs().entity_points(tdim);
-  const Eigen::Ref<const Eigen::Array<std::int32_t, Eigen::Dynamic, 1>> pos_g
-      = connectivity_g.entity_positions();
   const Eigen::Ref<const Eigen::Array<std::int32_t, Eigen::Dynamic, 1>> cell_g
       = connectivity_g.connections();
   // FIXME: Add proper interface for num coordinate dofs
@@ -428,7 +402,6 @@ void fem::impl::assemble_exterior_facets(
   Eigen::Array<double, Eigen::Dynamic, Eigen::Dynamic, Eigen::RowMajor>
       coordinate_dofs(num_dofs_g, gdim);
   Eigen::Matrix<PetscScalar, Eigen::Dynamic, 1> be;
-  Eigen::Array<PetscScalar, Eigen::Dynamic, 1> coeff_array(offsets.back());
 
   for (const auto& facet_index : active_facets)
   {
@@ -448,24 +421,16 @@ void fem::impl::assemble_exterior_facets(
     const int cell_index = cell.index();
     for (int i = 0; i < num_dofs_g; ++i)
       for (int j = 0; j < gdim; ++j)
-        coordinate_dofs(i, j) = x_g(cell_g[pos_g[cell_index] + i], j);
+        coordinate_dofs(i, j) = x_g(cell_g[cell_index * num_dofs_g + i], j);
 
     // Get dof map for cell
     const Eigen::Map<const Eigen::Array<PetscInt, Eigen::Dynamic, 1>> dmap
-        = dofmap.cell_dofs(cell.index());
-
-    // TODO: Move gathering of coefficients outside of main assembly
-    // loop
-    // Update coefficients
-    for (std::size_t i = 0; i < coefficients.size(); ++i)
-    {
-      coefficients[i]->restrict(coeff_array.data() + offsets[i], cell,
-                                coordinate_dofs);
-    }
+        = dofmap.cell_dofs(cell_index);
 
     // Tabulate element vector
     be.setZero(dmap.size());
-    fn(be.data(), coeff_array.data(), coordinate_dofs.data(), local_facet, 1);
+    fn(be.data(), coeffs.row(cell_index).data(), coordinate_dofs.data(),
+       local_facet, 1);
 
     // Add element vector to global vector
     for (Eigen::Index i = 0; i < dmap.size(); ++i)
@@ -516,12 +481,16 @@ void fem::impl::apply_lifting(
         bc->mark_dofs(bc_markers1);
         bc->dof_values(bc_values1);
       }
+      const std::vector<std::int32_t> cells = bc_cells(bcs1[j]);
 
       // Modify (apply lifting) vector
       if (!x0.empty())
-        fem::impl::lift_bc(b, *a[j], bc_values1, bc_markers1, x0[j], scale);
+      {
+        fem::impl::lift_bc(b, *a[j], bc_values1, bc_markers1, cells, x0[j],
+                           scale);
+      }
       else
-        fem::impl::lift_bc(b, *a[j], bc_values1, bc_markers1, scale);
+        fem::impl::lift_bc(b, *a[j], bc_values1, bc_markers1, cells, scale);
     }
   }
 }
@@ -530,15 +499,19 @@ void fem::impl::lift_bc(
     Eigen::Ref<Eigen::Matrix<PetscScalar, Eigen::Dynamic, 1>> b, const Form& a,
     const Eigen::Ref<const Eigen::Matrix<PetscScalar, Eigen::Dynamic, 1>>
         bc_values1,
-    const std::vector<bool>& bc_markers1, double scale)
+    const std::vector<bool>& bc_markers1,
+    const std::vector<std::int32_t>& bc_cells, double scale)
 {
   // FIXME: add lifting over exterior facets
 
   const Eigen::Matrix<PetscScalar, Eigen::Dynamic, 1> x0(0);
   if (a.integrals().num_integrals(fem::FormIntegrals::Type::cell) > 0)
-    _lift_bc_cells(b, a, bc_values1, bc_markers1, x0, scale);
+    _lift_bc_cells(b, a, bc_values1, bc_markers1, bc_cells, x0, scale);
   if (a.integrals().num_integrals(fem::FormIntegrals::Type::exterior_facet) > 0)
-    _lift_bc_exterior_facets(b, a, bc_values1, bc_markers1, x0, scale);
+  {
+    _lift_bc_exterior_facets(b, a, bc_values1, bc_markers1, bc_cells, x0,
+                             scale);
+  }
 }
 //-----------------------------------------------------------------------------
 void fem::impl::lift_bc(
@@ -546,6 +519,7 @@ void fem::impl::lift_bc(
     const Eigen::Ref<const Eigen::Matrix<PetscScalar, Eigen::Dynamic, 1>>
         bc_values1,
     const std::vector<bool>& bc_markers1,
+    const std::vector<std::int32_t>& bc_cells,
     const Eigen::Ref<const Eigen::Matrix<PetscScalar, Eigen::Dynamic, 1>> x0,
     double scale)
 {
@@ -556,8 +530,11 @@ void fem::impl::lift_bc(
   }
 
   if (a.integrals().num_integrals(fem::FormIntegrals::Type::cell) > 0)
-    _lift_bc_cells(b, a, bc_values1, bc_markers1, x0, scale);
+    _lift_bc_cells(b, a, bc_values1, bc_markers1, bc_cells, x0, scale);
   if (a.integrals().num_integrals(fem::FormIntegrals::Type::exterior_facet) > 0)
-    _lift_bc_exterior_facets(b, a, bc_values1, bc_markers1, x0, scale);
+  {
+    _lift_bc_exterior_facets(b, a, bc_values1, bc_markers1, bc_cells, x0,
+                             scale);
+  }
 }
 //-----------------------------------------------------------------------------
@@ -39,7 +39,16 @@ void
     assemble_vector(Eigen::Ref<Eigen::Matrix<PetscScalar, Eigen::Dynamic, 1>> b,
                     const Form& L);
 
-/// Execute kernel over cells and accumulate result in vector
+/// Assemble linear form into an Eigen vector using coefficients packed
+/// for each cell (see fem::pack_coefficients)
+void assemble_vector(
+    Eigen::Ref<Eigen::Matrix<PetscScalar, Eigen::Dynamic, 1>> b, const Form& L,
+    const Eigen::Ref<const Eigen::Array<PetscScalar, Eigen::Dynamic,
+                                        Eigen::Dynamic, Eigen::RowMajor>>
+        coeffs);
+
+/// Execute kernel over cells and accumulate result in vector. Row c of
+/// coeffs holds the packed coefficients for cell c.
 void assemble_cells(
     Eigen::Ref<Eigen::Matrix<PetscScalar, Eigen::Dynamic, 1>> b,
     const mesh::Mesh& mesh, const std::vector<std::int32_t>& active_cells,
@@ -47,18 +56,21 @@ void assemble_cells(
     int num_dofs_per_cell,
     const std::function<void(PetscScalar*, const PetscScalar*, const double*,
                              int)>& kernel,
-    std::vector<const function::Function*> coefficients,
-    const std::vector<int>& offsets);
+    const Eigen::Ref<const Eigen::Array<PetscScalar, Eigen::Dynamic,
+                                        Eigen::Dynamic, Eigen::RowMajor>>
+        coeffs);
 
-/// Execute kernel over cells and accumulate result in vector
+/// Execute kernel over exterior facets and accumulate result in vector.
+/// Row c of coeffs holds the packed coefficients for cell c.
 void assemble_exterior_facets(
     Eigen::Ref<Eigen::Matrix<PetscScalar, Eigen::Dynamic, 1>> b,
     const mesh::Mesh& mesh, const std::vector<std::int32_t>& active_facets,
     const fem::GenericDofMap& dofmap,
     const std::function<void(PetscScalar*, const PetscScalar*, const double*,
                              int, int)>& fn,
-    std::vector<const function::Function*> coefficients,
-    const std::vector<int>& offsets);
+    const Eigen::Ref<const Eigen::Array<PetscScalar, Eigen::Dynamic,
+                                        Eigen::Dynamic, Eigen::RowMajor>>
+        coeffs);
 
 /// Assemble linear form interior facet integrals into an Eigen vector
 void assemble_interior_facets(
@@ -81,20 +93,24 @@ void apply_lifting(
         x0,
     double scale);
 
-/// Modify RHS vector to account for boundary condition b <- b - scale*Ax_bc
+/// Modify RHS vector to account for boundary condition b <- b - scale*Ax_bc.
+/// Only the (sorted) cells in bc_cells, which must contain all cells
+/// with a marked dof, are visited (see DirichletBC::cells).
 void lift_bc(
     Eigen::Ref<Eigen::Matrix<PetscScalar, Eigen::Dynamic, 1>> b, const Form& a,
     const Eigen::Ref<const Eigen::Matrix<PetscScalar, Eigen::Dynamic, 1>>
         bc_values1,
-    const std::vector<bool>& bc_markers1, double scale);
+    const std::vector<bool>& bc_markers1,
+    const std::vector<std::int32_t>& bc_cells, double scale);
 
 /// Modify RHS vector to account for boundary condition such that b <- b
-/// - scale*A (x_bc - x0)
+/// - scale*A (x_bc - x0). Only the cells in bc_cells are visited.
 void lift_bc(
     Eigen::Ref<Eigen::Matrix<PetscScalar, Eigen::Dynamic, 1>> b, const Form& a,
     const Eigen::Ref<const Eigen::Matrix<PetscScalar, Eigen::Dynamic, 1>>
         bc_values1,
     const std::vector<bool>& bc_markers1,
+    const std::vector<std::int32_t>& bc_cells,
     Eigen::Ref<const Eigen::Matrix<PetscScalar, Eigen::Dynamic, 1>> x0,
     double scale);
 
@@ -11,6 +11,7 @@
 #include "GenericDofMap.h"
 #include "assemble_matrix_impl.h"
 #include "assemble_scalar_impl.h"
+#include "assemble_system_impl.h"
 #include "assemble_vector_impl.h"
 #include "assembler.h"
 #include "utils.h"
@@ -45,6 +46,37 @@ void set_diagonal_local(
   }
 }
 //-----------------------------------------------------------------------------
+// Add diagonal to the owned rows of A for dofs with Dirichlet
+// conditions, if the test and trial spaces of a are the same
+void set_diagonal_bc(Mat A, const Form& a,
+                     const std::vector<std::shared_ptr<const DirichletBC>>& bcs,
+                     PetscScalar diagonal)
+{
+  if (!(*a.function_space(0) == *a.function_space(1)))
+    return;
+
+  auto map0 = a.function_space(0)->dofmap()->index_map();
+  for (const auto& bc : bcs)
+  {
+    assert(bc);
+    if (a.function_space(0)->contains(*bc->function_space()))
+    {
+      // FIXME: could be simpler if DirichletBC::dof_indices had
+      // options to return owned dofs only
+      const Eigen::Ref<const Eigen::Array<PetscInt, Eigen::Dynamic, 1>> dofs
+          = bc->dof_indices();
+      const int owned_size = map0->block_size() * map0->size_local();
+      auto it = std::lower_bound(dofs.data(), dofs.data() + dofs.rows(),
+                                 owned_size);
+      const Eigen::Index pos = std::distance(dofs.data(), it);
+      assert(pos <= dofs.size() and pos >= 0);
+      const Eigen::Map<const Eigen::Array<PetscInt, Eigen::Dynamic, 1>>
+          dofs_owned(dofs.data(), pos);
+      set_diagonal_local(A, dofs_owned, diagonal);
+    }
+  }
+}
+//-----------------------------------------------------------------------------
 std::vector<std::vector<std::shared_ptr<const fem::DirichletBC>>>
 bcs_rows(std::vector<const Form*> L,
          std::vector<std::shared_ptr<const fem::DirichletBC>> bcs)
@@ -395,8 +427,9 @@ void fem::assemble_matrix(Mat A, const Form& a,
   auto map0 = a.function_space(0)->dofmap()->index_map();
   auto map1 = a.function_space(1)->dofmap()->index_map();
 
-  // Build dof markers
+  // Build dof markers, and collect the bcs that are applied
   std::vector<bool> dof_marker0, dof_marker1;
+  std::vector<std::shared_ptr<const DirichletBC>> active_bcs;
   std::int32_t dim0
       = map0->block_size() * (map0->size_local() + map0->num_ghosts());
   std::int32_t dim1
@@ -405,45 +438,101 @@ void fem::assemble_matrix(Mat A, const Form& a,
   {
     assert(bcs[k]);
     assert(bcs[k]->function_space());
+    bool active = false;
     if (a.function_space(0)->contains(*bcs[k]->function_space()))
     {
       dof_marker0.resize(dim0, false);
       bcs[k]->mark_dofs(dof_marker0);
+      active = true;
     }
     if (a.function_space(1)->contains(*bcs[k]->function_space()))
     {
       dof_marker1.resize(dim1, false);
       bcs[k]->mark_dofs(dof_marker1);
+      active = true;
     }
+    if (active)
+      active_bcs.push_back(bcs[k]);
   }
 
   // Assemble
-  impl::assemble_matrix(A, a, dof_marker0, dof_marker1);
+  impl::assemble_matrix(A, a, dof_marker0, dof_marker1,
+                        bc_cells(active_bcs));
 
   // Set diagonal for boundary conditions
-  if (*a.function_space(0) == *a.function_space(1))
+  set_diagonal_bc(A, a, bcs, diagonal);
+
+  // Do not finalise assembly - matrix may be a proxy/sub-matrix with
+  // finalisation done elsewhere.
+}
+//-----------------------------------------------------------------------------
+void fem::assemble_system(Mat A, Vec b, const Form& a, const Form& L,
+                          std::vector<std::shared_ptr<const DirichletBC>> bcs,
+                          const Vec x0, double scale, double diagonal)
+{
+  // Index maps for dof ranges
+  auto map0 = a.function_space(0)->dofmap()->index_map();
+  auto map1 = a.function_space(1)->dofmap()->index_map();
+
+  // If the test and trial spaces are the same, rows and columns share
+  // a dof marker and bc values are set in b during assembly
+  const bool square = *a.function_space(0) == *a.function_space(1);
+
+  // Build dof markers, bc values for lifting and the list of applied
+  // bcs
+  std::vector<bool> dof_marker0, dof_marker1;
+  Eigen::Matrix<PetscScalar, Eigen::Dynamic, 1> bc_values1;
+  std::vector<std::shared_ptr<const DirichletBC>> active_bcs;
+  std::int32_t dim0
+      = map0->block_size() * (map0->size_local() + map0->num_ghosts());
+  std::int32_t dim1
+      = map1->block_size() * (map1->size_local() + map1->num_ghosts());
+  for (std::size_t k = 0; k < bcs.size(); ++k)
   {
-    for (const auto& bc : bcs)
+    assert(bcs[k]);
+    assert(bcs[k]->function_space());
+    bool active = false;
+    if (!square and a.function_space(0)->contains(*bcs[k]->function_space()))
     {
-      assert(bc);
-      if (a.function_space(0)->contains(*bc->function_space()))
-      {
-        // FIXME: could be simpler if DirichletBC::dof_indices had
-        // options to return owned dofs only
-        const Eigen::Ref<const Eigen::Array<PetscInt, Eigen::Dynamic, 1>> dofs
-            = bc->dof_indices();
-        const int owned_size = map0->block_size() * map0->size_local();
-        auto it = std::lower_bound(dofs.data(), dofs.data() + dofs.rows(),
-                                   owned_size);
-        const Eigen::Index pos = std::distance(dofs.data(), it);
-        assert(pos <= dofs.size() and pos >= 0);
-        const Eigen::Map<const Eigen::Array<PetscInt, Eigen::Dynamic, 1>>
-            dofs_owned(dofs.data(), pos);
-        set_diagonal_local(A, dofs_owned, diagonal);
-      }
+      dof_marker0.resize(dim0, false);
+      bcs[k]->mark_dofs(dof_marker0);
+      active = true;
+    }
+    if (a.function_space(1)->contains(*bcs[k]->function_space()))
+    {
+      dof_marker1.resize(dim1, false);
+      bcs[k]->mark_dofs(dof_marker1);
+      if (bc_values1.size() == 0)
+        bc_values1 = Eigen::Matrix<PetscScalar, Eigen::Dynamic, 1>::Zero(dim1);
+      bcs[k]->dof_values(bc_values1);
+      active = true;
     }
+    if (active)
+      active_bcs.push_back(bcs[k]);
   }
 
+  // Assemble
+  const std::vector<bool>& bc0 = square ? dof_marker1 : dof_marker0;
+  const std::vector<std::int32_t> cells = bc_cells(active_bcs);
+  la::VecWrapper _b(b);
+  if (x0)
+  {
+    la::VecReadWrapper _x0(x0);
+    impl::assemble_system(A, _b.x, a, L, bc0, dof_marker1, cells, bc_values1,
+                          _x0.x, scale, square);
+    _x0.restore();
+  }
+  else
+  {
+    impl::assemble_system(A, _b.x, a, L, bc0, dof_marker1, cells, bc_values1,
+                          Eigen::Matrix<PetscScalar, Eigen::Dynamic, 1>(0),
+                          scale, square);
+  }
+  _b.restore();
+
+  // Set diagonal for boundary conditions
+  set_diagonal_bc(A, a, bcs, diagonal);
+
   // Do not finalise assembly - matrix may be a proxy/sub-matrix with
   // finalisation done elsewhere.
 }
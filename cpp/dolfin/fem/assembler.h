@@ -93,6 +93,31 @@ void assemble_matrix(Mat A, const Form& a,
                      std::vector<std::shared_ptr<const DirichletBC>> bcs,
                      double diagonal = 1.0);
 
+// -- Systems ----------------------------------------------------------------
+
+/// Assemble bilinear form a into the matrix A and linear form L into
+/// the vector b in one pass over the mesh, e.g. for the Jacobian and
+/// residual in a Newton solver. The forms must have the same test
+/// space. Geometry and coefficients are gathered once per cell for
+/// both forms. Rows and columns of A for the Dirichlet conditions bcs
+/// are zeroed and 'diagonal' is placed on the diagonal, as in
+/// assemble_matrix. The vector is modified for the boundary conditions
+/// such that
+///
+///   b <- b - scale * A (g - x0)
+///
+/// as in apply_lifting. If x0 is not supplied, then it is treated as
+/// zero. If the test and trial spaces of a are the same, the owned
+/// entries of b for the boundary conditions are also set to
+/// scale * (g - x0) (as by set_bc), so that b is complete after
+/// VecGhostUpdateBegin/End. The matrix is not zeroed or finalised, and
+/// ghost contributions to b are not accumulated. Caller is responsible
+/// for calling VecGhostUpdateBegin/End, and set_bc if the spaces differ.
+void assemble_system(Mat A, Vec b, const Form& a, const Form& L,
+                     std::vector<std::shared_ptr<const DirichletBC>> bcs,
+                     const Vec x0 = nullptr, double scale = 1.0,
+                     double diagonal = 1.0);
+
 // -- Setting bcs ------------------------------------------------------------
 
 // FIXME: Move these function elsewhere?
@@ -18,6 +18,7 @@ namespace dolfin
 #include <dolfin/fem/FiniteElement.h>
 #include <dolfin/fem/Form.h>
 #include <dolfin/fem/GenericDofMap.h>
+#include <dolfin/fem/MatrixFreeOperator.h>
 #include <dolfin/fem/PETScDMCollection.h>
 #include <dolfin/fem/SparsityPatternBuilder.h>
 #include <dolfin/fem/assembler.h>
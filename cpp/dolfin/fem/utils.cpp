@@ -18,6 +18,9 @@
 #include <dolfin/la/PETScMatrix.h>
 #include <dolfin/la/PETScVector.h>
 #include <dolfin/la/SparsityPattern.h>
+#include <dolfin/mesh/Cell.h>
+#include <dolfin/mesh/Connectivity.h>
+#include <dolfin/mesh/CoordinateDofs.h>
 #include <dolfin/mesh/Mesh.h>
 #include <dolfin/mesh/MeshIterator.h>
 #include <dolfin/mesh/Vertex.h>
@@ -578,6 +581,62 @@ fem::get_coeffs_from_ufc_form(const ufc_form& ufc_form)
   return coeffs;
 }
 //-----------------------------------------------------------------------------
+Eigen::Array<PetscScalar, Eigen::Dynamic, Eigen::Dynamic, Eigen::RowMajor>
+fem::pack_coefficients(const Form& form)
+{
+  assert(form.mesh());
+  const mesh::Mesh& mesh = *form.mesh();
+  const int gdim = mesh.geometry().dim();
+  const int tdim = mesh.topology().dim();
+  const std::int32_t num_cells = mesh.num_entities(tdim);
+
+  const FormCoefficients& coefficients = form.coeffs();
+  const std::vector<int> offsets = coefficients.offsets();
+  std::vector<const function::Function*> coeff_fn(coefficients.size());
+  for (int i = 0; i < coefficients.size(); ++i)
+  {
+    coeff_fn[i] = coefficients.get(i).get();
+    if (!coeff_fn[i])
+    {
+      throw std::runtime_error("Cannot pack coefficients. Coefficient \""
+                               + coefficients.get_name(i)
+                               + "\" has not been set");
+    }
+  }
+
+  // Prepare cell geometry
+  const mesh::Connectivity& connectivity_g
+      = mesh.coordinate_dofs().entity_points(tdim);
+  const Eigen::Ref<const Eigen::Array<std::int32_t, Eigen::Dynamic, 1>> cell_g
+      = connectivity_g.connections();
+  const int num_dofs_g = connectivity_g.size(0);
+  const Eigen::Array<double, Eigen::Dynamic, 3, Eigen::RowMajor>& x_g
+      = mesh.geometry().points();
+  Eigen::Array<double, Eigen::Dynamic, Eigen::Dynamic, Eigen::RowMajor>
+      coordinate_dofs(num_dofs_g, gdim);
+
+  Eigen::Array<PetscScalar, Eigen::Dynamic, Eigen::Dynamic, Eigen::RowMajor>
+      c(num_cells, offsets.back());
+  if (coeff_fn.empty())
+    return c;
+
+  for (std::int32_t cell_index = 0; cell_index < num_cells; ++cell_index)
+  {
+    for (int i = 0; i < num_dofs_g; ++i)
+      for (int j = 0; j < gdim; ++j)
+        coordinate_dofs(i, j) = x_g(cell_g[cell_index * num_dofs_g + i], j);
+
+    const mesh::Cell cell(mesh, cell_index);
+    for (std::size_t i = 0; i < coeff_fn.size(); ++i)
+    {
+      coeff_fn[i]->restrict(c.row(cell_index).data() + offsets[i], cell,
+                            coordinate_dofs);
+    }
+  }
+
+  return c;
+}
+//-----------------------------------------------------------------------------
 std::shared_ptr<const fem::CoordinateMapping>
 fem::get_cmap_from_ufc_cmap(const ufc_coordinate_mapping& ufc_cmap)
 {
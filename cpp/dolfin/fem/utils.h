@@ -8,6 +8,7 @@
 
 #include "CoordinateMapping.h"
 #include "ElementDofLayout.h"
+#include <Eigen/Dense>
 #include <dolfin/common/types.h>
 #include <dolfin/la/PETScVector.h>
 #include <memory>
@@ -81,6 +82,14 @@ ElementDofLayout create_element_dof_layout(const ufc_dofmap& dofmap,
 std::vector<std::tuple<int, std::string, std::shared_ptr<function::Function>>>
 get_coeffs_from_ufc_form(const ufc_form& ufc_form);
 
+/// Pack the coefficients of a Form for each cell of the mesh,
+/// including ghost cells, which may be in the integration domains of
+/// the Form (see FormIntegrals::set_default_domains). Row i holds the
+/// expansion coefficients of all Form coefficients on cell i, laid out
+/// as given by FormCoefficients::offsets.
+Eigen::Array<PetscScalar, Eigen::Dynamic, Eigen::Dynamic, Eigen::RowMajor>
+pack_coefficients(const Form& form);
+
 /// Get dolfin::fem::CoordinateMapping from ufc
 std::shared_ptr<const fem::CoordinateMapping>
 get_cmap_from_ufc_cmap(const ufc_coordinate_mapping& ufc_cmap);
@@ -9,6 +9,7 @@
 #include "FunctionSpace.h"
 #include <algorithm>
 #include <cfloat>
+#include <cmath>
 #include <dolfin/common/IndexMap.h>
 #include <dolfin/common/Timer.h>
 #include <dolfin/common/Variable.h>
@@ -21,6 +22,7 @@
 #include <dolfin/la/utils.h>
 #include <dolfin/mesh/Mesh.h>
 #include <dolfin/mesh/MeshIterator.h>
+#include <dolfin/mesh/Partitioning.h>
 #include <dolfin/mesh/Vertex.h>
 #include <unordered_map>
 #include <unsupported/Eigen/CXX11/Tensor>
@@ -223,8 +225,6 @@ void Function::eval(
   // Prepare cell geometry
   const mesh::Connectivity& connectivity_g
       = mesh.coordinate_dofs().entity_points(tdim);
-  const Eigen::Ref<const Eigen::Array<std::int32_t, Eigen::Dynamic, 1>> pos_g
-      = connectivity_g.entity_positions();
   const Eigen::Ref<const Eigen::Array<std::int32_t, Eigen::Dynamic, 1>> cell_g
       = connectivity_g.connections();
   // FIXME: Add proper interface for num coordinate dofs
@@ -237,7 +237,7 @@ void Function::eval(
   const int cell_index = cell.index();
   for (int i = 0; i < num_dofs_g; ++i)
     for (int j = 0; j < gdim; ++j)
-      coordinate_dofs(i, j) = x_g(cell_g[pos_g[cell_index] + i], j);
+      coordinate_dofs(i, j) = x_g(cell_g[cell_index * num_dofs_g + i], j);
 
   restrict(coefficients.data(), cell, coordinate_dofs);
 
@@ -305,6 +305,57 @@ void Function::interpolate(const Expression& e)
   _function_space->interpolate(x.x, e);
 }
 //-----------------------------------------------------------------------------
+Function Function::migrate(std::shared_ptr<const FunctionSpace> V) const
+{
+  assert(_function_space);
+  assert(_function_space->mesh());
+  assert(_function_space->dofmap());
+  assert(V);
+  assert(V->mesh());
+  assert(V->dofmap());
+  assert(V->element());
+  if (!_function_space->has_element(*V->element()))
+  {
+    throw std::runtime_error(
+        "Cannot migrate function. Function spaces have different elements");
+  }
+
+  const mesh::Mesh& mesh = *_function_space->mesh();
+  const mesh::Mesh& new_mesh = *V->mesh();
+  const int tdim = mesh.topology().dim();
+  const fem::GenericDofMap& dofmap = *_function_space->dofmap();
+  const int num_cell_dofs = dofmap.max_element_dofs();
+
+  // Expansion coefficients on each owned cell
+  std::vector<PetscScalar> values(mesh.num_entities(tdim) * num_cell_dofs);
+  la::VecReadWrapper v(_vector.vec());
+  for (std::int32_t c = 0; c < mesh.topology().ghost_offset(tdim); ++c)
+  {
+    auto dofs = dofmap.cell_dofs(c);
+    for (Eigen::Index i = 0; i < dofs.size(); ++i)
+      values[c * num_cell_dofs + i] = v.x[dofs[i]];
+  }
+  v.restore();
+
+  // Send coefficients to the processes holding each cell in new mesh
+  const std::vector<PetscScalar> new_values = mesh::Partitioning::migrate(
+      mesh, new_mesh, tdim, values, num_cell_dofs);
+
+  // Set coefficients on all cells of new mesh, including ghosts
+  Function u(V);
+  const fem::GenericDofMap& new_dofmap = *V->dofmap();
+  la::VecWrapper x(u.vector().vec());
+  for (std::int64_t c = 0; c < new_mesh.num_entities(tdim); ++c)
+  {
+    auto dofs = new_dofmap.cell_dofs(c);
+    for (Eigen::Index i = 0; i < dofs.size(); ++i)
+      x.x[dofs[i]] = new_values[c * num_cell_dofs + i];
+  }
+  x.restore();
+
+  return u;
+}
+//-----------------------------------------------------------------------------
 std::size_t Function::value_rank() const
 {
   assert(_function_space);
@@ -353,6 +404,8 @@ Function::compute_point_values(const mesh::Mesh& mesh) const
 {
   assert(_function_space);
   assert(_function_space->mesh());
+  assert(_function_space->element());
+  assert(_function_space->dofmap());
 
   // Check that the mesh matches. Notice that the hash is only
   // compared if the pointers are not matching.
@@ -363,23 +416,28 @@ Function::compute_point_values(const mesh::Mesh& mesh) const
         "Cannot interpolate function values at points. Non-matching mesh");
   }
 
+  const fem::FiniteElement& element = *_function_space->element();
+  const fem::GenericDofMap& dofmap = *_function_space->dofmap();
+
   // Compute in tensor (one for scalar function, . . .)
-  const std::size_t value_size_loc = value_size();
+  const int value_size_loc = value_size();
+  const int reference_value_size = element.reference_value_size();
+  const int space_dimension = element.space_dimension();
 
   // Resize Array for holding point values
   Eigen::Array<PetscScalar, Eigen::Dynamic, Eigen::Dynamic, Eigen::RowMajor>
       point_values(mesh.geometry().num_points(), value_size_loc);
+  point_values.setZero();
 
-  const int gdim = mesh.topology().dim();
+  const int gdim = mesh.geometry().dim();
   const int tdim = mesh.topology().dim();
-  const mesh::Connectivity& cell_dofs
-      = mesh.coordinate_dofs().entity_points(tdim);
+  const std::int64_t num_cells = mesh.num_entities(tdim);
+  if (num_cells == 0)
+    return point_values;
 
   // Prepare cell geometry
   const mesh::Connectivity& connectivity_g
       = mesh.coordinate_dofs().entity_points(tdim);
-  const Eigen::Ref<const Eigen::Array<std::int32_t, Eigen::Dynamic, 1>> pos_g
-      = connectivity_g.entity_positions();
   const Eigen::Ref<const Eigen::Array<std::int32_t, Eigen::Dynamic, 1>> cell_g
       = connectivity_g.connections();
   // FIXME: Add proper interface for num coordinate dofs
@@ -388,28 +446,143 @@ Function::compute_point_values(const mesh::Mesh& mesh) const
       x_g
       = mesh.geometry().points();
 
-  // Interpolate point values on each cell (using last computed value
-  // if not continuous, e.g. discontinuous Galerkin methods)
-  EigenRowArrayXXd x(num_dofs_g, mesh.geometry().dim());
-  Eigen::Array<PetscScalar, Eigen::Dynamic, Eigen::Dynamic, Eigen::RowMajor>
-      values(num_dofs_g, value_size_loc);
-  for (auto& cell : mesh::MeshRange<mesh::Cell>(mesh, mesh::MeshRangeType::ALL))
+  // Get coordinate mapping
+  std::shared_ptr<const fem::CoordinateMapping> cmap
+      = mesh.geometry().coord_mapping;
+  if (!cmap)
   {
-    // Get coordinates for all points in cell
-    const int cell_index = cell.index();
-    for (int i = 0; i < num_dofs_g; ++i)
-      for (int j = 0; j < gdim; ++j)
-        x(i, j) = x_g(cell_g[pos_g[cell_index] + i], j);
+    throw std::runtime_error(
+        "fem::CoordinateMapping has not been attached to mesh.");
+  }
 
-    values.resize(x.rows(), value_size_loc);
+  // The geometry points of a cell are images of the same reference
+  // points on every cell, so the reference basis functions are
+  // tabulated once at the reference points (computed from the first
+  // cell)
+  EigenRowArrayXXd coordinate_dofs(num_dofs_g, gdim);
+  for (int i = 0; i < num_dofs_g; ++i)
+    for (int j = 0; j < gdim; ++j)
+      coordinate_dofs(i, j) = x_g(cell_g[i], j);
+  EigenRowArrayXXd X(num_dofs_g, tdim);
+  Eigen::Tensor<double, 3, Eigen::RowMajor> J(num_dofs_g, gdim, tdim);
+  EigenArrayXd detJ(num_dofs_g);
+  Eigen::Tensor<double, 3, Eigen::RowMajor> K(num_dofs_g, tdim, gdim);
+  cmap->compute_reference_geometry(X, J, detJ, K, coordinate_dofs,
+                                   coordinate_dofs);
+  Eigen::Tensor<double, 3, Eigen::RowMajor> basis_reference_values(
+      num_dofs_g, space_dimension, reference_value_size);
+  element.evaluate_reference_basis(basis_reference_values, X);
 
-    // Call evaluate function
-    eval(values, x, cell);
+  // Lagrange elements are not transformed by the push forward to the
+  // physical cell
+  const std::string family = element.family();
+  const bool identity_map
+      = (family == "Lagrange" or family == "Q"
+         or family == "Discontinuous Lagrange" or family == "DQ")
+        and reference_value_size == value_size_loc;
+
+  // If the element is nodal at the geometry points, the value of each
+  // component at a point is a single expansion coefficient. Find the
+  // (cell-local) dof for each point and component.
+  std::vector<int> nodal_dofs(num_dofs_g * value_size_loc, -1);
+  bool nodal = identity_map;
+  for (int i = 0; i < num_dofs_g and nodal; ++i)
+  {
+    for (int k = 0; k < value_size_loc and nodal; ++k)
+    {
+      int& dof = nodal_dofs[i * value_size_loc + k];
+      for (int j = 0; j < space_dimension and nodal; ++j)
+      {
+        const double phi = basis_reference_values(i, j, k);
+        if (std::abs(phi - 1.0) < 1.0e-10 and dof < 0)
+          dof = j;
+        else if (std::abs(phi) > 1.0e-10)
+          nodal = false;
+      }
+      nodal = nodal and dof >= 0;
+    }
+  }
 
-    // Copy values to array of point values
-    const std::int32_t* dofs = cell_dofs.connections(cell.index());
-    for (unsigned int i = 0; i < x.rows(); ++i)
-      point_values.row(dofs[i]) = values.row(i);
+  // Values on cells are copied in cell order, so the value from the
+  // last cell containing a point is used if the function is not
+  // continuous (e.g. discontinuous Galerkin methods)
+  la::VecReadWrapper v(_vector.vec());
+  Eigen::Map<const Eigen::Matrix<PetscScalar, Eigen::Dynamic, 1>> _v = v.x;
+  if (nodal)
+  {
+    // Gather expansion coefficients
+    for (std::int64_t c = 0; c < num_cells; ++c)
+    {
+      auto dofs = dofmap.cell_dofs(c);
+      for (int i = 0; i < num_dofs_g; ++i)
+      {
+        const std::int32_t p = cell_g[c * num_dofs_g + i];
+        for (int k = 0; k < value_size_loc; ++k)
+          point_values(p, k) = _v[dofs[nodal_dofs[i * value_size_loc + k]]];
+      }
+    }
+  }
+  else if (identity_map)
+  {
+    // Apply the tabulation matrix to the expansion coefficients of all
+    // cells
+    Eigen::Matrix<PetscScalar, Eigen::Dynamic, Eigen::Dynamic> T(
+        num_dofs_g * value_size_loc, space_dimension);
+    for (int i = 0; i < num_dofs_g; ++i)
+      for (int k = 0; k < value_size_loc; ++k)
+        for (int j = 0; j < space_dimension; ++j)
+          T(i * value_size_loc + k, j) = basis_reference_values(i, j, k);
+
+    Eigen::Matrix<PetscScalar, Eigen::Dynamic, Eigen::Dynamic> w(
+        space_dimension, num_cells);
+    for (std::int64_t c = 0; c < num_cells; ++c)
+    {
+      auto dofs = dofmap.cell_dofs(c);
+      for (int j = 0; j < space_dimension; ++j)
+        w(j, c) = _v[dofs[j]];
+    }
+    const Eigen::Matrix<PetscScalar, Eigen::Dynamic, Eigen::Dynamic> values
+        = T * w;
+
+    for (std::int64_t c = 0; c < num_cells; ++c)
+    {
+      for (int i = 0; i < num_dofs_g; ++i)
+      {
+        const std::int32_t p = cell_g[c * num_dofs_g + i];
+        for (int k = 0; k < value_size_loc; ++k)
+          point_values(p, k) = values(i * value_size_loc + k, c);
+      }
+    }
+  }
+  else
+  {
+    // Push the tabulated basis forward on each cell
+    Eigen::Tensor<double, 3, Eigen::RowMajor> basis_values(
+        num_dofs_g, space_dimension, value_size_loc);
+    EigenRowArrayXXd Xc(num_dofs_g, tdim);
+    for (std::int64_t c = 0; c < num_cells; ++c)
+    {
+      for (int i = 0; i < num_dofs_g; ++i)
+        for (int j = 0; j < gdim; ++j)
+          coordinate_dofs(i, j) = x_g(cell_g[c * num_dofs_g + i], j);
+      cmap->compute_reference_geometry(Xc, J, detJ, K, coordinate_dofs,
+                                       coordinate_dofs);
+      element.transform_reference_basis(basis_values, basis_reference_values,
+                                        X, J, detJ, K);
+
+      auto dofs = dofmap.cell_dofs(c);
+      for (int i = 0; i < num_dofs_g; ++i)
+      {
+        const std::int32_t p = cell_g[c * num_dofs_g + i];
+        for (int k = 0; k < value_size_loc; ++k)
+        {
+          PetscScalar value = 0.0;
+          for (int j = 0; j < space_dimension; ++j)
+            value += _v[dofs[j]] * basis_values(i, j, k);
+          point_values(p, k) = value;
+        }
+      }
+    }
   }
 
   return point_values;
@@ -117,6 +117,17 @@ public:
   ///         The expression to be interpolated.
   void interpolate(const Expression& e);
 
+  /// Return copy of function on a function space with the same
+  /// element on a redistributed mesh (e.g. created by
+  /// mesh::Partitioning::repartition). Expansion coefficients are
+  /// moved cell-by-cell, matching cells by their vertices.
+  ///
+  /// @param    V (FunctionSpace)
+  ///         The function space on the redistributed mesh.
+  /// @returns Function
+  ///         The function on V.
+  Function migrate(std::shared_ptr<const FunctionSpace> V) const;
+
   /// Return value rank
   ///
   /// @returns std::size_t
@@ -7,15 +7,20 @@
 #include "FunctionSpace.h"
 #include "Expression.h"
 #include "Function.h"
+#include "NonMatchingInterpolation.h"
 #include <dolfin/common/IndexMap.h>
 #include <dolfin/common/types.h>
 #include <dolfin/common/utils.h>
 #include <dolfin/fem/CoordinateMapping.h>
 #include <dolfin/fem/FiniteElement.h>
 #include <dolfin/fem/GenericDofMap.h>
+#include <dolfin/la/PETScVector.h>
+#include <dolfin/la/utils.h>
 #include <dolfin/mesh/Cell.h>
 #include <dolfin/mesh/Mesh.h>
 #include <dolfin/mesh/MeshIterator.h>
+#include <functional>
+#include <numeric>
 #include <vector>
 
 using namespace dolfin;
@@ -52,6 +57,7 @@ void FunctionSpace::attach(std::shared_ptr<const fem::FiniteElement> element,
 {
   _element = element;
   _dofmap = dofmap;
+  clear_interpolation_cache();
 }
 //-----------------------------------------------------------------------------
 const FunctionSpace& FunctionSpace::operator=(const FunctionSpace& V)
@@ -61,6 +67,7 @@ const FunctionSpace& FunctionSpace::operator=(const FunctionSpace& V)
   _element = V._element;
   _dofmap = V._dofmap;
   _component = V._component;
+  clear_interpolation_cache();
 
   // Call assignment operator for base class
   common::Variable::operator=(V);
@@ -105,105 +112,283 @@ void FunctionSpace::interpolate_from_any(
     const Function& v) const
 {
   assert(_mesh);
+  assert(v.function_space());
+  const FunctionSpace& V = *v.function_space();
+  if (V.mesh() != _mesh or !V.has_element(*_element))
+  {
+    // Evaluate v at interpolation points (collective)
+    NonMatchingInterpolation(V, *this).interpolate(expansion_coefficients, v);
+    return;
+  }
+
+  // Gather expansion coefficients of v
+  const std::vector<PetscInt>& map = interpolation_map(V);
+  la::VecReadWrapper v_wrapper(v.vector().vec());
+  Eigen::Map<const Eigen::Matrix<PetscScalar, Eigen::Dynamic, 1>> _v
+      = v_wrapper.x;
+  for (std::size_t i = 0; i < map.size(); ++i)
+  {
+    if (map[i] >= 0)
+      expansion_coefficients[i] = _v[map[i]];
+  }
+}
+//-----------------------------------------------------------------------------
+void FunctionSpace::interpolate_from_any(
+    Eigen::Ref<Eigen::Matrix<PetscScalar, Eigen::Dynamic, 1>>
+        expansion_coefficients,
+    const Expression& expr) const
+{
+  assert(_mesh);
+  assert(_element);
+
   const int gdim = _mesh->geometry().dim();
   const int tdim = _mesh->topology().dim();
 
-  // Initialize local arrays
-  std::vector<PetscScalar> cell_coefficients(_dofmap->max_element_dofs());
+  // Evaluate expression at interpolation points of all cells
+  const EigenRowArrayXXd& x = interpolation_points();
+  const std::vector<std::size_t> value_shape = expr.value_shape();
+  const std::size_t value_size
+      = std::accumulate(value_shape.begin(), value_shape.end(), 1,
+                        std::multiplies<std::size_t>());
+  Eigen::Array<PetscScalar, Eigen::Dynamic, Eigen::Dynamic, Eigen::RowMajor>
+      values(x.rows(), value_size);
+  expr.eval(values, x);
 
-  if (!v.function_space()->has_element(*_element))
-  {
-    throw std::runtime_error("Restricting finite elements function in "
-                             "different elements not suppoted.");
-  }
+  // Initialize local arrays
+  const int ndofs = _element->space_dimension();
+  std::vector<PetscScalar> cell_coefficients(ndofs);
 
   // Prepare cell geometry
   const mesh::Connectivity& connectivity_g
       = _mesh->coordinate_dofs().entity_points(tdim);
-  const Eigen::Ref<const Eigen::Array<std::int32_t, Eigen::Dynamic, 1>> pos_g
-      = connectivity_g.entity_positions();
   const Eigen::Ref<const Eigen::Array<std::int32_t, Eigen::Dynamic, 1>> cell_g
       = connectivity_g.connections();
   // FIXME: Add proper interface for num coordinate dofs
   const int num_dofs_g = connectivity_g.size(0);
-  const Eigen::Array<double, Eigen::Dynamic, Eigen::Dynamic, Eigen::RowMajor>&
-      x_g
+  const Eigen::Array<double, Eigen::Dynamic, 3, Eigen::RowMajor>& x_g
       = _mesh->geometry().points();
 
-  // Iterate over mesh and interpolate on each cell
+  // Map values to expansion coefficients on each (non-ghost) cell
   EigenRowArrayXXd coordinate_dofs(num_dofs_g, gdim);
-  for (auto& cell : mesh::MeshRange<mesh::Cell>(*_mesh))
+  for (std::int64_t c = 0; c < _mesh->topology().ghost_offset(tdim); ++c)
   {
-    // FIXME: Move this out
-    if (!v.function_space()->has_cell(cell))
-    {
-      throw std::runtime_error("Restricting finite elements function in "
-                               "different elements not suppoted.");
-    }
-
     // Get cell coordinate dofs
-    const int cell_index = cell.index();
     for (int i = 0; i < num_dofs_g; ++i)
       for (int j = 0; j < gdim; ++j)
-        coordinate_dofs(i, j) = x_g(cell_g[pos_g[cell_index] + i], j);
-
-    // Restrict function to cell
-    v.restrict(cell_coefficients.data(), cell, coordinate_dofs);
+        coordinate_dofs(i, j) = x_g(cell_g[c * num_dofs_g + i], j);
 
-    // Tabulate dofs
-    auto cell_dofs = _dofmap->cell_dofs(cell.index());
+    // FIXME: *do not* use UFC directly
+    // Apply a mapping to the reference element.
+    _element->transform_values(cell_coefficients.data(),
+                               values.block(c * ndofs, 0, ndofs, value_size),
+                               coordinate_dofs);
 
+    // Copy dofs to vector
+    auto cell_dofs = _dofmap->cell_dofs(c);
     for (Eigen::Index i = 0; i < cell_dofs.size(); ++i)
       expansion_coefficients[cell_dofs[i]] = cell_coefficients[i];
   }
 }
 //-----------------------------------------------------------------------------
-void FunctionSpace::interpolate_from_any(
-    Eigen::Ref<Eigen::Matrix<PetscScalar, Eigen::Dynamic, 1>>
-        expansion_coefficients,
-    const Expression& expr) const
+const EigenRowArrayXXd& FunctionSpace::interpolation_points() const
 {
   assert(_mesh);
+  assert(_element);
+
+  // Get coordinate mapping
+  if (!_mesh->geometry().coord_mapping)
+  {
+    throw std::runtime_error(
+        "CoordinateMapping has not been attached to mesh.");
+  }
+  const fem::CoordinateMapping& cmap = *_mesh->geometry().coord_mapping;
 
   const int gdim = _mesh->geometry().dim();
   const int tdim = _mesh->topology().dim();
+  const std::int64_t num_cells = _mesh->topology().ghost_offset(tdim);
+  const int ndofs = _element->space_dimension();
+  const Eigen::Array<double, Eigen::Dynamic, 3, Eigen::RowMajor>& x_g
+      = _mesh->geometry().points();
 
-  // Initialize local arrays
-  std::vector<PetscScalar> cell_coefficients(_dofmap->max_element_dofs());
+  // Return cached points if geometry is unchanged
+  update_geometry_cache();
+  if (_interpolation_points.rows() == num_cells * ndofs)
+    return _interpolation_points;
 
   // Prepare cell geometry
   const mesh::Connectivity& connectivity_g
       = _mesh->coordinate_dofs().entity_points(tdim);
-  const Eigen::Ref<const Eigen::Array<std::int32_t, Eigen::Dynamic, 1>> pos_g
-      = connectivity_g.entity_positions();
   const Eigen::Ref<const Eigen::Array<std::int32_t, Eigen::Dynamic, 1>> cell_g
       = connectivity_g.connections();
   // FIXME: Add proper interface for num coordinate dofs
   const int num_dofs_g = connectivity_g.size(0);
-  const Eigen::Array<double, Eigen::Dynamic, Eigen::Dynamic, Eigen::RowMajor>&
-      x_g
-      = _mesh->geometry().points();
 
-  // Iterate over mesh and interpolate on each cell
-  EigenRowArrayXXd coordinate_dofs(num_dofs_g, gdim);;
-  for (auto& cell : mesh::MeshRange<mesh::Cell>(*_mesh))
+  // Get dof coordinates on reference element
+  const EigenRowArrayXXd& X = _element->dof_reference_coordinates();
+
+  // Tabulate dof coordinates on each cell
+  _interpolation_points.resize(num_cells * ndofs, gdim);
+  EigenRowArrayXXd coordinate_dofs(num_dofs_g, gdim);
+  for (std::int64_t c = 0; c < num_cells; ++c)
   {
-    // Get cell coordinate dofs
-    const int cell_index = cell.index();
     for (int i = 0; i < num_dofs_g; ++i)
       for (int j = 0; j < gdim; ++j)
-        coordinate_dofs(i, j) = x_g(cell_g[pos_g[cell_index] + i], j);
+        coordinate_dofs(i, j) = x_g(cell_g[c * num_dofs_g + i], j);
+    cmap.compute_physical_coordinates(
+        _interpolation_points.block(c * ndofs, 0, ndofs, gdim), X,
+        coordinate_dofs);
+  }
 
-    // Restrict function to cell
-    expr.restrict(cell_coefficients.data(), *_element, cell, coordinate_dofs);
+  return _interpolation_points;
+}
+//-----------------------------------------------------------------------------
+const std::vector<PetscInt>&
+FunctionSpace::interpolation_map(const FunctionSpace& V) const
+{
+  assert(_mesh);
+  assert(_dofmap);
+  assert(V.dofmap());
+
+  // Return cached map if dofmap of V is unchanged
+  if (_interpolation_map_dofmap.lock() == V.dofmap())
+    return _interpolation_map;
+
+  // Map dofs of this space to dofs of V on each (non-ghost) cell
+  const common::IndexMap& index_map = *_dofmap->index_map();
+  _interpolation_map.assign(
+      (index_map.size_local() + index_map.num_ghosts())
+          * index_map.block_size(),
+      -1);
+  const int tdim = _mesh->topology().dim();
+  for (std::int64_t c = 0; c < _mesh->topology().ghost_offset(tdim); ++c)
+  {
+    auto dofs = _dofmap->cell_dofs(c);
+    auto dofs_V = V.dofmap()->cell_dofs(c);
+    assert(dofs.size() == dofs_V.size());
+    for (Eigen::Index i = 0; i < dofs.size(); ++i)
+      _interpolation_map[dofs[i]] = dofs_V[i];
+  }
+  _interpolation_map_dofmap = V.dofmap();
 
-    // Tabulate dofs
-    Eigen::Map<const Eigen::Array<PetscInt, Eigen::Dynamic, 1>> cell_dofs
-        = _dofmap->cell_dofs(cell.index());
+  return _interpolation_map;
+}
+//-----------------------------------------------------------------------------
+const EigenRowArrayXXd& FunctionSpace::dof_coordinates() const
+{
+  assert(_mesh);
+  assert(_element);
 
-    // Copy dofs to vector
-    for (Eigen::Index i = 0; i < cell_dofs.size(); ++i)
-      expansion_coefficients[cell_dofs[i]] = cell_coefficients[i];
+  if (!_component.empty())
+  {
+    throw std::runtime_error(
+        "Cannot tabulate coordinates for a FunctionSpace that is a subspace.");
+  }
+
+  // Get coordinate mapping
+  if (!_mesh->geometry().coord_mapping)
+  {
+    throw std::runtime_error(
+        "CoordinateMapping has not been attached to mesh.");
+  }
+  const fem::CoordinateMapping& cmap = *_mesh->geometry().coord_mapping;
+
+  const int gdim = _mesh->geometry().dim();
+  const int tdim = _mesh->topology().dim();
+  const Eigen::Array<double, Eigen::Dynamic, 3, Eigen::RowMajor>& x_g
+      = _mesh->geometry().points();
+
+  // Get local size
+  assert(_dofmap);
+  const int bs = _dofmap->index_map()->block_size();
+  const std::int32_t num_blocks = _dofmap->index_map()->size_local();
+
+  // Return cached coordinates if geometry is unchanged
+  update_geometry_cache();
+  if (_dof_coordinates.rows() == (Eigen::Index)bs * num_blocks)
+    return _dof_coordinates;
+
+  // Prepare cell geometry
+  const mesh::Connectivity& connectivity_g
+      = _mesh->coordinate_dofs().entity_points(tdim);
+  const Eigen::Ref<const Eigen::Array<std::int32_t, Eigen::Dynamic, 1>> cell_g
+      = connectivity_g.connections();
+  // FIXME: Add proper interface for num coordinate dofs
+  const int num_dofs_g = connectivity_g.size(0);
+
+  // Dof coordinates on reference element
+  const EigenRowArrayXXd& X = _element->dof_reference_coordinates();
+
+  // Compute the coordinates of each owned dof block once. Dofs in a
+  // block share a point, and a cell is skipped if all of its owned
+  // blocks have been computed, so the coordinate mapping is only
+  // evaluated for the reference points of new blocks.
+  std::vector<bool> computed(num_blocks, false);
+  std::int32_t num_computed = 0;
+  EigenRowArrayXXd x_blocks(num_blocks, gdim);
+  EigenRowArrayXXd coordinate_dofs(num_dofs_g, gdim);
+  EigenRowArrayXXd X_new(X.rows(), X.cols());
+  EigenRowArrayXXd x_new(X.rows(), gdim);
+  std::vector<std::int32_t> new_blocks;
+  const std::int32_t num_cells = _mesh->topology().ghost_offset(tdim);
+  for (std::int32_t c = 0; c < num_cells and num_computed < num_blocks; ++c)
+  {
+    // Collect reference points of blocks not yet computed
+    auto dofs = _dofmap->cell_dofs(c);
+    new_blocks.clear();
+    for (Eigen::Index i = 0; i < dofs.size(); ++i)
+    {
+      const std::int32_t block = dofs[i] / bs;
+      if (block < num_blocks and !computed[block])
+      {
+        computed[block] = true;
+        X_new.row(new_blocks.size()) = X.row(i);
+        new_blocks.push_back(block);
+      }
+    }
+    if (new_blocks.empty())
+      continue;
+
+    // Push forward the reference points of the new blocks
+    for (int i = 0; i < num_dofs_g; ++i)
+      for (int j = 0; j < gdim; ++j)
+        coordinate_dofs(i, j) = x_g(cell_g[c * num_dofs_g + i], j);
+    const int n = new_blocks.size();
+    cmap.compute_physical_coordinates(x_new.topRows(n), X_new.topRows(n),
+                                      coordinate_dofs);
+    for (int i = 0; i < n; ++i)
+      x_blocks.row(new_blocks[i]) = x_new.row(i);
+    num_computed += n;
+  }
+
+  // Copy block coordinates to dofs
+  _dof_coordinates.resize(bs * num_blocks, gdim);
+  for (std::int32_t i = 0; i < num_blocks; ++i)
+    for (int k = 0; k < bs; ++k)
+      _dof_coordinates.row(i * bs + k) = x_blocks.row(i);
+
+  return _dof_coordinates;
+}
+//-----------------------------------------------------------------------------
+void FunctionSpace::clear_interpolation_cache()
+{
+  _coord_mapping = nullptr;
+  _interpolation_points.resize(0, 0);
+  _dof_coordinates.resize(0, 0);
+  _interpolation_map.clear();
+  _interpolation_map_dofmap.reset();
+}
+//-----------------------------------------------------------------------------
+void FunctionSpace::update_geometry_cache() const
+{
+  assert(_mesh);
+  const mesh::Geometry& geometry = _mesh->geometry();
+  if (geometry.version() != _geometry_version
+      or geometry.coord_mapping.get() != _coord_mapping)
+  {
+    _interpolation_points.resize(0, 0);
+    _dof_coordinates.resize(0, 0);
+    _geometry_version = geometry.version();
+    _coord_mapping = geometry.coord_mapping.get();
   }
 }
 //-----------------------------------------------------------------------------
@@ -350,78 +535,7 @@ std::vector<std::size_t> FunctionSpace::component() const { return _component; }
 //-----------------------------------------------------------------------------
 EigenRowArrayXXd FunctionSpace::tabulate_dof_coordinates() const
 {
-  // Geometric dimension
-  assert(_mesh);
-  assert(_element);
-  const int gdim = _mesh->geometry().dim();
-  const int tdim = _mesh->topology().dim();
-
-  if (!_component.empty())
-  {
-    throw std::runtime_error(
-        "Cannot tabulate coordinates for a FunctionSpace that is a subspace.");
-  }
-
-  // Get local size
-  assert(_dofmap);
-  std::size_t bs = _dofmap->index_map()->block_size();
-  std::size_t local_size = bs * _dofmap->index_map()->size_local();
-
-  // Dof coordinate on reference element
-  const EigenRowArrayXXd& X = _element->dof_reference_coordinates();
-
-  // Arrray to hold coordinates and return
-  EigenRowArrayXXd x(local_size, gdim);
-
-  // Get coordinate mapping
-  if (!_mesh->geometry().coord_mapping)
-  {
-    throw std::runtime_error(
-        "CoordinateMapping has not been attached to mesh.");
-  }
-  const fem::CoordinateMapping& cmap = *_mesh->geometry().coord_mapping;
-
-  // Cell coordinates (re-allocated inside function for thread safety)
-  // Prepare cell geometry
-  const mesh::Connectivity& connectivity_g
-      = _mesh->coordinate_dofs().entity_points(tdim);
-  const Eigen::Ref<const Eigen::Array<std::int32_t, Eigen::Dynamic, 1>> pos_g
-      = connectivity_g.entity_positions();
-  const Eigen::Ref<const Eigen::Array<std::int32_t, Eigen::Dynamic, 1>> cell_g
-      = connectivity_g.connections();
-  // FIXME: Add proper interface for num coordinate dofs
-  const int num_dofs_g = connectivity_g.size(0);
-  const Eigen::Array<double, Eigen::Dynamic, Eigen::Dynamic, Eigen::RowMajor>&
-      x_g
-      = _mesh->geometry().points();
-
-  // Loop over cells and tabulate dofs
-  EigenRowArrayXXd coordinates(_element->space_dimension(), gdim);
-  EigenRowArrayXXd coordinate_dofs(num_dofs_g, gdim);
-  for (auto& cell : mesh::MeshRange<mesh::Cell>(*_mesh))
-  {
-    // Update cell
-    const int cell_index = cell.index();
-    for (int i = 0; i < num_dofs_g; ++i)
-      for (int j = 0; j < gdim; ++j)
-        coordinate_dofs(i, j) = x_g(cell_g[pos_g[cell_index] + i], j);
-
-    // Get local-to-global map
-    auto dofs = _dofmap->cell_dofs(cell.index());
-
-    // Tabulate dof coordinates on cell
-    cmap.compute_physical_coordinates(coordinates, X, coordinate_dofs);
-
-    // Copy dof coordinates into vector
-    for (Eigen::Index i = 0; i < dofs.size(); ++i)
-    {
-      const PetscInt dof = dofs[i];
-      if (dof < (PetscInt)local_size)
-        x.row(dof) = coordinates.row(i);
-    }
-  }
-
-  return x;
+  return dof_coordinates();
 }
 //-----------------------------------------------------------------------------
 void FunctionSpace::set_x(
@@ -439,8 +553,6 @@ void FunctionSpace::set_x(
   // Prepare cell geometry
   const mesh::Connectivity& connectivity_g
       = _mesh->coordinate_dofs().entity_points(tdim);
-  const Eigen::Ref<const Eigen::Array<std::int32_t, Eigen::Dynamic, 1>> pos_g
-      = connectivity_g.entity_positions();
   const Eigen::Ref<const Eigen::Array<std::int32_t, Eigen::Dynamic, 1>> cell_g
       = connectivity_g.connections();
   // FIXME: Add proper interface for num coordinate dofs
@@ -471,7 +583,7 @@ void FunctionSpace::set_x(
     const int cell_index = cell.index();
     for (int i = 0; i < num_dofs_g; ++i)
       for (int j = 0; j < gdim; ++j)
-        coordinate_dofs(i, j) = x_g(cell_g[pos_g[cell_index] + i], j);
+        coordinate_dofs(i, j) = x_g(cell_g[cell_index * num_dofs_g + i], j);
 
     // Get cell local-to-global map
     auto dofs = _dofmap->cell_dofs(cell.index());
@@ -21,6 +21,7 @@ namespace dolfin
 
 namespace fem
 {
+class CoordinateMapping;
 class GenericDofMap;
 }
 
@@ -130,7 +131,11 @@ public:
   std::int64_t dim() const;
 
   /// Interpolate function v into function space, returning the
-  /// vector of expansion coefficients
+  /// vector of expansion coefficients. The map from the dofs of the
+  /// space of v to the dofs of this space is cached, so repeated
+  /// interpolation from the same space is a gather. If v is on a
+  /// different mesh or element, it is interpolated using
+  /// NonMatchingInterpolation (collective, and not cached).
   ///
   /// @param   expansion_coefficients
   ///         The expansion coefficients.
@@ -141,7 +146,9 @@ public:
                    const Function& v) const;
 
   /// Interpolate expression into function space, returning the
-  /// vector of expansion coefficients
+  /// vector of expansion coefficients. The expression is evaluated at
+  /// the dof points of all cells in one call. The dof points are
+  /// cached and recomputed when the mesh geometry changes.
   ///
   /// @param   expansion_coefficients (_la::PETScVector_)
   ///         The expansion coefficients.
@@ -215,12 +222,24 @@ public:
   /// Tabulate the coordinates of all dofs on this process. This
   /// function is typically used by preconditioners that require the
   /// spatial coordinates of dofs, for example for re-partitioning or
-  /// nullspace computations.
+  /// nullspace computations. The coordinates are cached and are
+  /// recomputed if the mesh geometry changes (see
+  /// mesh::Geometry::set_points and mesh::Geometry::mark_modified).
   ///
   /// @returns    EigenRowArrayXXd
   ///         The dof coordinates [([0, y0], [x1, y1], . . .)
   EigenRowArrayXXd tabulate_dof_coordinates() const;
 
+  /// Return the coordinates of the owned dofs on this process, as for
+  /// tabulate_dof_coordinates, without copying. All dofs in a block
+  /// share a point (rows i*bs to (i + 1)*bs - 1 for block i). The
+  /// coordinates are cached and recomputed if the mesh geometry or
+  /// coordinate mapping has changed.
+  ///
+  /// @returns    EigenRowArrayXXd
+  ///         The dof coordinates
+  const EigenRowArrayXXd& dof_coordinates() const;
+
   /// Set dof entries in vector to value*x[i], where [x][i] is the
   /// coordinate of the dof spatial coordinate. Parallel layout of
   /// vector must be consistent with dof map range This function is
@@ -261,6 +280,25 @@ private:
           expansion_coefficients,
       const Expression& expr) const;
 
+  // Return physical coordinates of the interpolation points of all
+  // non-ghost cells (row cell*space_dimension + i is the point for cell dof i).
+  // The points are cached and recomputed if the mesh geometry or
+  // coordinate mapping has changed.
+  const EigenRowArrayXXd& interpolation_points() const;
+
+  // Return map from (process-local) dofs of this space to dofs of V
+  // on the same mesh (-1 if a dof is in no cell). The map for the last
+  // dofmap of V is cached.
+  const std::vector<PetscInt>& interpolation_map(const FunctionSpace& V) const;
+
+  // Clear cached interpolation data and dof coordinates
+  void clear_interpolation_cache();
+
+  // Clear cached data computed from the mesh geometry if the geometry
+  // (see mesh::Geometry::version) or coordinate mapping has changed
+  // since it was computed
+  void update_geometry_cache() const;
+
   // The mesh
   std::shared_ptr<const mesh::Mesh> _mesh;
 
@@ -279,6 +317,21 @@ private:
   // Cache of subspaces
   mutable std::map<std::vector<std::size_t>, std::weak_ptr<FunctionSpace>>
       _subspaces;
+
+  // Geometry version and coordinate mapping of the cached data
+  // computed from the mesh geometry
+  mutable std::size_t _geometry_version = 0;
+  mutable const fem::CoordinateMapping* _coord_mapping = nullptr;
+
+  // Cached interpolation points
+  mutable EigenRowArrayXXd _interpolation_points;
+
+  // Cached dof coordinates
+  mutable EigenRowArrayXXd _dof_coordinates;
+
+  // Cached interpolation map and the dofmap it maps to
+  mutable std::vector<PetscInt> _interpolation_map;
+  mutable std::weak_ptr<const fem::GenericDofMap> _interpolation_map_dofmap;
 };
 } // namespace function
 } // namespace dolfin
@@ -0,0 +1,322 @@
+// Copyright (C) 2026 agent
+//
+// This file is part of DOLFIN (https://www.fenicsproject.org)
+//
+// SPDX-License-Identifier:    LGPL-3.0-or-later
+
+#include "NonMatchingInterpolation.h"
+#include "Function.h"
+#include "FunctionSpace.h"
+#include <algorithm>
+#include <dolfin/common/IndexMap.h>
+#include <dolfin/common/types.h>
+#include <dolfin/fem/CoordinateMapping.h>
+#include <dolfin/fem/FiniteElement.h>
+#include <dolfin/fem/GenericDofMap.h>
+#include <dolfin/geometry/BoundingBoxTree.h>
+#include <dolfin/geometry/utils.h>
+#include <dolfin/la/PETScVector.h>
+#include <dolfin/la/utils.h>
+#include <dolfin/mesh/Connectivity.h>
+#include <dolfin/mesh/CoordinateDofs.h>
+#include <dolfin/mesh/Mesh.h>
+#include <numeric>
+#include <tuple>
+
+using namespace dolfin;
+using namespace dolfin::function;
+
+namespace
+{
+// Return coordinates of the dof blocks of V (one row per process-local
+// block, owned blocks first). All dofs in a block share a point.
+EigenRowArrayXXd tabulate_block_points(const FunctionSpace& V)
+{
+  assert(V.dofmap());
+  const common::IndexMap& index_map = *V.dofmap()->index_map();
+  const int bs = index_map.block_size();
+  const EigenRowArrayXXd& x_dofs = V.dof_coordinates();
+  const int gdim = x_dofs.cols();
+  const std::int32_t num_owned = index_map.size_local();
+
+  // Get coordinates of ghost blocks from their owners
+  std::vector<double> x_owned(num_owned * gdim);
+  for (std::int32_t i = 0; i < num_owned; ++i)
+    for (int k = 0; k < gdim; ++k)
+      x_owned[i * gdim + k] = x_dofs(i * bs, k);
+  const std::vector<double> x_ghost = index_map.scatter_fwd(x_owned, gdim);
+
+  EigenRowArrayXXd x(num_owned + index_map.num_ghosts(), gdim);
+  std::copy(x_owned.begin(), x_owned.end(), x.data());
+  std::copy(x_ghost.begin(), x_ghost.end(), x.data() + x_owned.size());
+
+  return x;
+}
+} // namespace
+
+//-----------------------------------------------------------------------------
+NonMatchingInterpolation::NonMatchingInterpolation(const FunctionSpace& V0,
+                                                   const FunctionSpace& V1)
+    : _mesh0(V0.mesh()), _element0(V0.element()), _dofmap0(V0.dofmap()),
+      _mesh1(V1.mesh()), _element1(V1.element()), _dofmap1(V1.dofmap()),
+      _comm(MPI_COMM_NULL)
+{
+  assert(_mesh0);
+  assert(_element0);
+  assert(_dofmap0);
+  assert(_mesh1);
+  assert(_element1);
+  assert(_dofmap1);
+  const mesh::Mesh& mesh0 = *_mesh0;
+  const mesh::Mesh& mesh1 = *_mesh1;
+  const MPI_Comm mpi_comm = mesh1.mpi_comm();
+
+  if (_element0->value_size() != _element1->value_size())
+  {
+    throw std::runtime_error(
+        "Cannot interpolate between function spaces. Value size of source ("
+        + std::to_string(_element0->value_size())
+        + ") does not match value size of target ("
+        + std::to_string(_element1->value_size()) + ")");
+  }
+
+  const int gdim = mesh1.geometry().dim();
+  if ((int)mesh0.geometry().dim() != gdim)
+  {
+    throw std::runtime_error("Cannot interpolate between function spaces. "
+                             "Meshes have different geometric dimensions");
+  }
+
+  // Get interpolation points of V1
+  const EigenRowArrayXXd x = tabulate_block_points(V1);
+
+  // Find the process with the source cell containing (or closest to)
+  // each point
+  const int tdim0 = mesh0.topology().dim();
+  geometry::BoundingBoxTree tree(mesh0, tdim0);
+  const std::vector<int> rank = geometry::locate_points(mesh0, tree, x);
+  if (std::find(rank.begin(), rank.end(), -1) != rank.end())
+  {
+    throw std::runtime_error("Cannot interpolate between function "
+                             "spaces. Source mesh has no cells");
+  }
+
+  // Send points to the process that will evaluate them, and keep the
+  // communicator for sending values back to owners of points
+  std::vector<std::int32_t> points(x.rows());
+  std::iota(points.begin(), points.end(), 0);
+  std::vector<std::int32_t> offsets(x.rows() + 1);
+  std::iota(offsets.begin(), offsets.end(), 0);
+  std::vector<std::vector<double>> recv_x;
+  std::tie(_comm, _blocks, recv_x)
+      = geometry::send_points(mpi_comm, x, points, rank, offsets);
+
+  // Find source cells for received points
+  _eval_offsets.assign(1, 0);
+  std::vector<double> eval_x;
+  for (std::size_t n = 0; n < recv_x.size(); ++n)
+  {
+    for (std::size_t i = 0; i < recv_x[n].size(); i += gdim)
+    {
+      std::int32_t cell
+          = geometry::find_cell(tree, mesh0, &recv_x[n][i], false).first;
+      if (cell < 0)
+        cell = geometry::find_cell(tree, mesh0, &recv_x[n][i], true).first;
+      _eval_cells.push_back(cell);
+    }
+    eval_x.insert(eval_x.end(), recv_x[n].begin(), recv_x[n].end());
+    _eval_offsets.push_back(_eval_cells.size());
+  }
+
+  // Tabulate source basis functions at received points, for all
+  // points in a cell at once
+  assert(mesh0.geometry().coord_mapping);
+  const fem::CoordinateMapping& cmap = *mesh0.geometry().coord_mapping;
+  const mesh::Connectivity& connectivity_g
+      = mesh0.coordinate_dofs().entity_points(tdim0);
+  const Eigen::Ref<const Eigen::Array<std::int32_t, Eigen::Dynamic, 1>> cell_g
+      = connectivity_g.connections();
+  // FIXME: Add proper interface for num coordinate dofs
+  const int num_dofs_g = connectivity_g.size(0);
+  const Eigen::Array<double, Eigen::Dynamic, 3, Eigen::RowMajor>& x_g
+      = mesh0.geometry().points();
+  EigenRowArrayXXd coordinate_dofs(num_dofs_g, gdim);
+
+  const int space_dimension = _element0->space_dimension();
+  const int reference_value_size = _element0->reference_value_size();
+  const int value_size = _element0->value_size();
+  _eval_basis.resize(_eval_cells.size() * space_dimension * value_size);
+
+  std::vector<std::int32_t> perm(_eval_cells.size());
+  std::iota(perm.begin(), perm.end(), 0);
+  std::sort(perm.begin(), perm.end(), [this](auto a, auto b) {
+    return std::tie(_eval_cells[a], a) < std::tie(_eval_cells[b], b);
+  });
+
+  for (std::size_t i = 0; i < perm.size();)
+  {
+    // Find points in cell
+    const std::int32_t c = _eval_cells[perm[i]];
+    std::size_t end = i + 1;
+    while (end < perm.size() and _eval_cells[perm[end]] == c)
+      ++end;
+    const int num_points = end - i;
+
+    // Get cell coordinates
+    for (int j = 0; j < num_dofs_g; ++j)
+      for (int k = 0; k < gdim; ++k)
+        coordinate_dofs(j, k) = x_g(cell_g[c * num_dofs_g + j], k);
+
+    EigenRowArrayXXd x_cell(num_points, gdim);
+    for (int q = 0; q < num_points; ++q)
+    {
+      for (int k = 0; k < gdim; ++k)
+        x_cell(q, k) = eval_x[perm[i + q] * gdim + k];
+    }
+
+    // Compute reference coordinates X, and J, detJ and K
+    EigenRowArrayXXd X(num_points, tdim0);
+    Eigen::Tensor<double, 3, Eigen::RowMajor> J(num_points, gdim, tdim0);
+    EigenArrayXd detJ(num_points);
+    Eigen::Tensor<double, 3, Eigen::RowMajor> K(num_points, tdim0, gdim);
+    cmap.compute_reference_geometry(X, J, detJ, K, x_cell, coordinate_dofs);
+
+    // Compute basis on reference element and push forward
+    Eigen::Tensor<double, 3, Eigen::RowMajor> basis_reference_values(
+        num_points, space_dimension, reference_value_size);
+    _element0->evaluate_reference_basis(basis_reference_values, X);
+    Eigen::Tensor<double, 3, Eigen::RowMajor> basis_values(
+        num_points, space_dimension, value_size);
+    _element0->transform_reference_basis(basis_values, basis_reference_values,
+                                         X, J, detJ, K);
+
+    for (int q = 0; q < num_points; ++q)
+    {
+      std::copy(basis_values.data() + q * space_dimension * value_size,
+                basis_values.data() + (q + 1) * space_dimension * value_size,
+                _eval_basis.begin()
+                    + perm[i + q] * space_dimension * value_size);
+    }
+
+    i = end;
+  }
+}
+//-----------------------------------------------------------------------------
+NonMatchingInterpolation::~NonMatchingInterpolation()
+{
+  if (_comm != MPI_COMM_NULL)
+    MPI_Comm_free(&_comm);
+}
+//-----------------------------------------------------------------------------
+void NonMatchingInterpolation::interpolate(Function& u,
+                                           const Function& v) const
+{
+  assert(u.function_space());
+  if (u.function_space()->dofmap() != _dofmap1)
+  {
+    throw std::runtime_error("Cannot interpolate function. Function is not "
+                             "in the target space of the interpolation");
+  }
+
+  la::VecWrapper x(u.vector().vec());
+  interpolate(x.x, v);
+}
+//-----------------------------------------------------------------------------
+void NonMatchingInterpolation::interpolate(
+    Eigen::Ref<Eigen::Matrix<PetscScalar, Eigen::Dynamic, 1>>
+        expansion_coefficients,
+    const Function& v) const
+{
+  assert(v.function_space());
+  if (v.function_space()->dofmap() != _dofmap0)
+  {
+    throw std::runtime_error("Cannot interpolate function. Function is not "
+                             "in the source space of the interpolation");
+  }
+
+  // Evaluate v at points located on this process
+  const int space_dimension = _element0->space_dimension();
+  const int value_size = _element0->value_size();
+  la::VecReadWrapper v_wrapper(v.vector().vec());
+  Eigen::Map<const Eigen::Matrix<PetscScalar, Eigen::Dynamic, 1>> _v
+      = v_wrapper.x;
+  std::vector<std::vector<PetscScalar>> send_values(_eval_offsets.size() - 1);
+  for (std::size_t n = 0; n < send_values.size(); ++n)
+  {
+    send_values[n].assign(
+        (_eval_offsets[n + 1] - _eval_offsets[n]) * value_size, 0.0);
+    for (std::int32_t p = _eval_offsets[n]; p < _eval_offsets[n + 1]; ++p)
+    {
+      PetscScalar* values
+          = send_values[n].data() + (p - _eval_offsets[n]) * value_size;
+      const double* basis
+          = _eval_basis.data() + p * space_dimension * value_size;
+      auto dofs = _dofmap0->cell_dofs(_eval_cells[p]);
+      for (int i = 0; i < space_dimension; ++i)
+      {
+        const PetscScalar coefficient = _v[dofs[i]];
+        for (int j = 0; j < value_size; ++j)
+          values[j] += coefficient * basis[i * value_size + j];
+      }
+    }
+  }
+
+  // Send values to owners of points
+  std::vector<std::vector<PetscScalar>> recv_values;
+  MPI::neighbour_all_to_all(_comm, send_values, recv_values);
+
+  // Values at interpolation points of V1 (one per dof block)
+  const common::IndexMap& index_map = *_dofmap1->index_map();
+  const int bs = index_map.block_size();
+  Eigen::Array<PetscScalar, Eigen::Dynamic, Eigen::Dynamic, Eigen::RowMajor>
+      point_values(index_map.size_local() + index_map.num_ghosts(),
+                   value_size);
+  for (std::size_t n = 0; n < _blocks.size(); ++n)
+  {
+    assert(recv_values[n].size() == _blocks[n].size() * value_size);
+    for (std::size_t i = 0; i < _blocks[n].size(); ++i)
+    {
+      std::copy(recv_values[n].begin() + i * value_size,
+                recv_values[n].begin() + (i + 1) * value_size,
+                point_values.row(_blocks[n][i]).data());
+    }
+  }
+
+  // Map point values to expansion coefficients on each cell
+  const mesh::Mesh& mesh1 = *_mesh1;
+  const int gdim = mesh1.geometry().dim();
+  const int tdim = mesh1.topology().dim();
+  const mesh::Connectivity& connectivity_g
+      = mesh1.coordinate_dofs().entity_points(tdim);
+  const Eigen::Ref<const Eigen::Array<std::int32_t, Eigen::Dynamic, 1>> cell_g
+      = connectivity_g.connections();
+  // FIXME: Add proper interface for num coordinate dofs
+  const int num_dofs_g = connectivity_g.size(0);
+  const Eigen::Array<double, Eigen::Dynamic, 3, Eigen::RowMajor>& x_g
+      = mesh1.geometry().points();
+  EigenRowArrayXXd coordinate_dofs(num_dofs_g, gdim);
+
+  const int ndofs = _element1->space_dimension();
+  Eigen::Array<PetscScalar, Eigen::Dynamic, Eigen::Dynamic, Eigen::RowMajor>
+      cell_values(ndofs, value_size);
+  std::vector<PetscScalar> cell_coefficients(ndofs);
+  for (std::int64_t c = 0; c < mesh1.topology().ghost_offset(tdim); ++c)
+  {
+    for (int i = 0; i < num_dofs_g; ++i)
+      for (int j = 0; j < gdim; ++j)
+        coordinate_dofs(i, j) = x_g(cell_g[c * num_dofs_g + i], j);
+
+    auto cell_dofs = _dofmap1->cell_dofs(c);
+    for (Eigen::Index i = 0; i < cell_dofs.size(); ++i)
+      cell_values.row(i) = point_values.row(cell_dofs[i] / bs);
+
+    // FIXME: *do not* use UFC directly
+    // Apply a mapping to the reference element.
+    _element1->transform_values(cell_coefficients.data(), cell_values,
+                                coordinate_dofs);
+
+    for (Eigen::Index i = 0; i < cell_dofs.size(); ++i)
+      expansion_coefficients[cell_dofs[i]] = cell_coefficients[i];
+  }
+}
+//-----------------------------------------------------------------------------
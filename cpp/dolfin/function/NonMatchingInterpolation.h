@@ -0,0 +1,103 @@
+// Copyright (C) 2026 agent
+//
+// This file is part of DOLFIN (https://www.fenicsproject.org)
+//
+// SPDX-License-Identifier:    LGPL-3.0-or-later
+
+#pragma once
+
+#include <Eigen/Dense>
+#include <cstdint>
+#include <dolfin/common/MPI.h>
+#include <memory>
+#include <petscsys.h>
+#include <vector>
+
+namespace dolfin
+{
+
+namespace fem
+{
+class FiniteElement;
+class GenericDofMap;
+} // namespace fem
+
+namespace mesh
+{
+class Mesh;
+}
+
+namespace function
+{
+class Function;
+class FunctionSpace;
+
+/// Interpolation of a Function on one mesh into a function space on
+/// another (non-matching) mesh, in parallel.
+///
+/// The interpolation points of the target space are sent to the
+/// processes whose part of the source mesh contains them, which
+/// evaluate the source basis functions at the points. Points outside
+/// the source mesh are evaluated in the closest source cell. The
+/// communication pattern and basis function values are computed when
+/// the object is created, so repeated interpolation (e.g. in a time
+/// loop) only gathers source coefficients and communicates point
+/// values. The object must be re-created if either mesh is changed.
+
+class NonMatchingInterpolation
+{
+public:
+  /// Create interpolation from functions in V0 into V1. The value
+  /// shapes of the spaces must match. This function is collective.
+  NonMatchingInterpolation(const FunctionSpace& V0, const FunctionSpace& V1);
+
+  /// Destructor
+  ~NonMatchingInterpolation();
+
+  // Copy constructor (disabled)
+  NonMatchingInterpolation(const NonMatchingInterpolation& interp) = delete;
+
+  // Assignment operator (disabled)
+  NonMatchingInterpolation&
+  operator=(const NonMatchingInterpolation& interp) = delete;
+
+  /// Interpolate v (in V0) into u (in V1). This function is
+  /// collective.
+  void interpolate(Function& u, const Function& v) const;
+
+  /// Interpolate v (in V0), returning the (process-local) expansion
+  /// coefficients for V1. This function is collective.
+  void interpolate(Eigen::Ref<Eigen::Matrix<PetscScalar, Eigen::Dynamic, 1>>
+                       expansion_coefficients,
+                   const Function& v) const;
+
+private:
+  // Source mesh, element and dofmap
+  std::shared_ptr<const mesh::Mesh> _mesh0;
+  std::shared_ptr<const fem::FiniteElement> _element0;
+  std::shared_ptr<const fem::GenericDofMap> _dofmap0;
+
+  // Target mesh, element and dofmap
+  std::shared_ptr<const mesh::Mesh> _mesh1;
+  std::shared_ptr<const fem::FiniteElement> _element1;
+  std::shared_ptr<const fem::GenericDofMap> _dofmap1;
+
+  // Communicator from processes that evaluate points to processes
+  // that own the points
+  MPI_Comm _comm;
+
+  // Source cells of points evaluated on this process, for all
+  // neighbours (points for the ith destination of _comm are
+  // [_eval_offsets[i], _eval_offsets[i + 1]))
+  std::vector<std::int32_t> _eval_cells;
+  std::vector<std::int32_t> _eval_offsets;
+
+  // Values of source basis functions at evaluated points (point,
+  // basis function, component)
+  std::vector<double> _eval_basis;
+
+  // Dof blocks of V1 of points received from the ith source of _comm
+  std::vector<std::vector<std::int32_t>> _blocks;
+};
+} // namespace function
+} // namespace dolfin
@@ -16,4 +16,5 @@ namespace dolfin
 #include <dolfin/function/Expression.h>
 #include <dolfin/function/Function.h>
 #include <dolfin/function/FunctionSpace.h>
+#include <dolfin/function/NonMatchingInterpolation.h>
 #include <dolfin/function/SpecialFunctions.h>
@@ -172,6 +172,26 @@ BoundingBoxTree::compute_process_collisions(const Eigen::Vector3d& point) const
   return collision;
 }
 //-----------------------------------------------------------------------------
+std::vector<unsigned int>
+BoundingBoxTree::compute_closest_processes(const Eigen::Vector3d& point) const
+{
+  if (!_global_tree)
+    return std::vector<unsigned int>(1, 0);
+
+  // The closest entity is no further away than the furthest point of
+  // any process bounding box, so only processes with a bounding box
+  // within the smallest such distance need to be searched
+  const BoundingBoxTree& tree = *_global_tree;
+  double R2 = std::numeric_limits<double>::max();
+  _compute_closest_bbox_bound(tree, point, tree.num_bboxes() - 1, R2);
+
+  std::vector<unsigned int> processes;
+  _compute_collisions_radius(tree, point, tree.num_bboxes() - 1, R2,
+                             processes);
+
+  return processes;
+}
+//-----------------------------------------------------------------------------
 std::pair<std::vector<unsigned int>, std::vector<unsigned int>>
 BoundingBoxTree::compute_entity_collisions(const BoundingBoxTree& tree,
                                            const mesh::Mesh& mesh_A,
@@ -604,6 +624,45 @@ void BoundingBoxTree::_compute_closest_entity(const BoundingBoxTree& tree,
   }
 }
 //-----------------------------------------------------------------------------
+void BoundingBoxTree::_compute_closest_bbox_bound(const BoundingBoxTree& tree,
+                                                  const Eigen::Vector3d& point,
+                                                  unsigned int node, double& R2)
+{
+  // Leaves below a bounding box outside radius cannot shrink it
+  if (tree.compute_squared_distance_bbox(point.data(), node) > R2)
+    return;
+
+  const BBox& bbox = tree._bboxes[node];
+  if (is_leaf(bbox, node))
+  {
+    R2 = std::min(R2, tree.compute_max_squared_distance_bbox(point.data(),
+                                                             node));
+  }
+  else
+  {
+    _compute_closest_bbox_bound(tree, point, bbox[0], R2);
+    _compute_closest_bbox_bound(tree, point, bbox[1], R2);
+  }
+}
+//-----------------------------------------------------------------------------
+void BoundingBoxTree::_compute_collisions_radius(
+    const BoundingBoxTree& tree, const Eigen::Vector3d& point,
+    unsigned int node, double R2, std::vector<unsigned int>& entities)
+{
+  // If bounding box is outside radius, then don't search further
+  if (tree.compute_squared_distance_bbox(point.data(), node) > R2)
+    return;
+
+  const BBox& bbox = tree._bboxes[node];
+  if (is_leaf(bbox, node))
+    entities.push_back(bbox[1]);
+  else
+  {
+    _compute_collisions_radius(tree, point, bbox[0], R2, entities);
+    _compute_collisions_radius(tree, point, bbox[1], R2, entities);
+  }
+}
+//-----------------------------------------------------------------------------
 void BoundingBoxTree::_compute_closest_point(const BoundingBoxTree& tree,
                                              const Eigen::Vector3d& point,
                                              unsigned int node,
@@ -843,6 +902,21 @@ double BoundingBoxTree::compute_squared_distance_point(const double* x,
   return d;
 }
 //-----------------------------------------------------------------------------
+double
+BoundingBoxTree::compute_max_squared_distance_bbox(const double* x,
+                                                   unsigned int node) const
+{
+  const double* b = _bbox_coordinates.data() + 2 * _gdim * node;
+  double r2 = 0.0;
+  for (int i = 0; i < _gdim; ++i)
+  {
+    r2 += std::max((x[i] - b[i]) * (x[i] - b[i]),
+                   (x[i] - b[i + _gdim]) * (x[i] - b[i + _gdim]));
+  }
+
+  return r2;
+}
+//-----------------------------------------------------------------------------
 double BoundingBoxTree::compute_squared_distance_bbox(const double* x,
                                                       unsigned int node) const
 {
@@ -72,6 +72,11 @@ public:
   std::vector<unsigned int>
   compute_process_collisions(const Eigen::Vector3d& point) const;
 
+  /// Compute all processes that may own the entity closest to _Point_
+  /// returning a list of process ranks
+  std::vector<unsigned int>
+  compute_closest_processes(const Eigen::Vector3d& point) const;
+
   /// Compute all collisions between entities and _BoundingBoxTree_
   std::pair<std::vector<unsigned int>, std::vector<unsigned int>>
   compute_entity_collisions(const BoundingBoxTree& tree,
@@ -184,6 +189,19 @@ private:
                                      unsigned int node,
                                      unsigned int& closest_point, double& R2);
 
+  // Compute smallest maximum squared distance between point and leaf
+  // bounding boxes (recursive)
+  static void _compute_closest_bbox_bound(const BoundingBoxTree& tree,
+                                          const Eigen::Vector3d& point,
+                                          unsigned int node, double& R2);
+
+  // Compute leaves with bounding box within squared distance R2 of
+  // point (recursive)
+  static void _compute_collisions_radius(const BoundingBoxTree& tree,
+                                         const Eigen::Vector3d& point,
+                                         unsigned int node, double R2,
+                                         std::vector<unsigned int>& entities);
+
   //--- Utility functions ---
 
   // Compute point search tree if not already done
@@ -245,6 +263,11 @@ private:
   double compute_squared_distance_bbox(const double* x,
                                        unsigned int node) const;
 
+  // Compute squared distance between point and the furthest point of
+  // bounding box
+  double compute_max_squared_distance_bbox(const double* x,
+                                           unsigned int node) const;
+
   // Compute squared distance between point and point
   double compute_squared_distance_point(const double* x,
                                         unsigned int node) const;
@@ -13,3 +13,4 @@ namespace dolfin
 
 #include <dolfin/geometry/BoundingBoxTree.h>
 #include <dolfin/geometry/CollisionPredicates.h>
+#include <dolfin/geometry/utils.h>
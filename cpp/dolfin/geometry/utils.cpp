@@ -0,0 +1,157 @@
+// Copyright (C) 2026 agent
+//
+// This file is part of DOLFIN (https://www.fenicsproject.org)
+//
+// SPDX-License-Identifier:    LGPL-3.0-or-later
+
+#include "utils.h"
+#include "BoundingBoxTree.h"
+#include <algorithm>
+#include <cassert>
+#include <dolfin/mesh/Geometry.h>
+#include <dolfin/mesh/Mesh.h>
+#include <limits>
+#include <map>
+
+using namespace dolfin;
+
+//-----------------------------------------------------------------------------
+std::pair<std::int32_t, double>
+geometry::find_cell(const BoundingBoxTree& tree, const mesh::Mesh& mesh,
+                    const double* x, bool closest)
+{
+  Eigen::Vector3d p = Eigen::Vector3d::Zero();
+  std::copy(x, x + mesh.geometry().dim(), p.data());
+  if (closest)
+    return tree.compute_closest_entity(p, mesh);
+
+  const unsigned int cell = tree.compute_first_entity_collision(p, mesh);
+  if (cell == std::numeric_limits<unsigned int>::max())
+    return {-1, -1.0};
+  else
+    return {cell, 0.0};
+}
+//-----------------------------------------------------------------------------
+std::tuple<MPI_Comm, std::vector<std::vector<std::int32_t>>,
+           std::vector<std::vector<double>>>
+geometry::send_points(MPI_Comm comm,
+                      const Eigen::Ref<const EigenRowArrayXXd>& x,
+                      const std::vector<std::int32_t>& points,
+                      const std::vector<int>& procs,
+                      const std::vector<std::int32_t>& offsets)
+{
+  const int gdim = x.cols();
+
+  // Create communicator to the destination processes
+  std::vector<int> dests(procs);
+  std::sort(dests.begin(), dests.end());
+  dests.erase(std::unique(dests.begin(), dests.end()), dests.end());
+  MPI_Comm send_comm = MPI::create_sparse_comm(comm, dests);
+  std::vector<int> sources, destinations;
+  std::tie(sources, destinations) = MPI::neighbours(send_comm);
+  std::map<int, int> dest_to_neighbour;
+  for (std::size_t i = 0; i < destinations.size(); ++i)
+    dest_to_neighbour.insert({destinations[i], i});
+
+  // Pack points for each destination process
+  std::vector<std::vector<double>> send_x(destinations.size());
+  std::vector<std::vector<std::int32_t>> sent_points(destinations.size());
+  for (std::size_t i = 0; i < points.size(); ++i)
+  {
+    for (std::int32_t j = offsets[i]; j < offsets[i + 1]; ++j)
+    {
+      const int n = dest_to_neighbour[procs[j]];
+      sent_points[n].push_back(points[i]);
+      send_x[n].insert(send_x[n].end(), x.row(points[i]).data(),
+                       x.row(points[i]).data() + gdim);
+    }
+  }
+
+  std::vector<std::vector<double>> recv_x;
+  MPI::neighbour_all_to_all(send_comm, send_x, recv_x);
+  MPI_Comm_free(&send_comm);
+
+  // Replies go from the receiving to the sending processes
+  MPI_Comm reply_comm
+      = MPI::create_neighbour_comm(comm, destinations, sources);
+
+  return std::make_tuple(reply_comm, std::move(sent_points),
+                         std::move(recv_x));
+}
+//-----------------------------------------------------------------------------
+std::vector<int>
+geometry::locate_points(const mesh::Mesh& mesh, const BoundingBoxTree& tree,
+                        const Eigen::Ref<const EigenRowArrayXXd>& x)
+{
+  const int gdim = x.cols();
+  std::vector<int> rank(x.rows(), -1);
+  std::vector<double> distance(x.rows(), -1.0);
+
+  // First send each point to the processes whose bounding box contains
+  // it, then send the points that were not found (outside the mesh) to
+  // the processes that may have the closest cell
+  for (bool closest : {false, true})
+  {
+    std::vector<std::int32_t> points;
+    std::vector<int> procs;
+    std::vector<std::int32_t> offsets(1, 0);
+    for (Eigen::Index i = 0; i < x.rows(); ++i)
+    {
+      if (rank[i] != -1)
+        continue;
+
+      Eigen::Vector3d p = Eigen::Vector3d::Zero();
+      p.head(gdim) = x.row(i).matrix().transpose();
+      const std::vector<unsigned int> ranks
+          = closest ? tree.compute_closest_processes(p)
+                    : tree.compute_process_collisions(p);
+      points.push_back(i);
+      procs.insert(procs.end(), ranks.begin(), ranks.end());
+      offsets.push_back(procs.size());
+    }
+
+    MPI_Comm reply_comm;
+    std::vector<std::vector<std::int32_t>> sent_points;
+    std::vector<std::vector<double>> recv_x;
+    std::tie(reply_comm, sent_points, recv_x)
+        = send_points(mesh.mpi_comm(), x, points, procs, offsets);
+
+    // Compute distance to cells for received points (-1 if not found)
+    std::vector<std::vector<double>> reply_distance(recv_x.size());
+    for (std::size_t n = 0; n < recv_x.size(); ++n)
+    {
+      for (std::size_t i = 0; i < recv_x[n].size(); i += gdim)
+      {
+        reply_distance[n].push_back(
+            find_cell(tree, mesh, &recv_x[n][i], closest).second);
+      }
+    }
+
+    std::vector<std::vector<double>> recv_distance;
+    MPI::neighbour_all_to_all(reply_comm, reply_distance, recv_distance);
+    // Processes the points were sent to
+    const std::vector<int> dests = MPI::neighbours(reply_comm).first;
+    MPI_Comm_free(&reply_comm);
+
+    // Keep closest process
+    for (std::size_t n = 0; n < dests.size(); ++n)
+    {
+      assert(recv_distance[n].size() == sent_points[n].size());
+      for (std::size_t i = 0; i < sent_points[n].size(); ++i)
+      {
+        const double d = recv_distance[n][i];
+        const std::int32_t p = sent_points[n][i];
+        if (d >= 0.0
+            and (rank[p] == -1 or d < distance[p]
+                 or (d == distance[p] and dests[n] < rank[p])))
+        {
+          distance[p] = d;
+          rank[p] = dests[n];
+        }
+      }
+    }
+  }
+
+  return rank;
+}
+//-----------------------------------------------------------------------------
@@ -0,0 +1,71 @@
+// Copyright (C) 2026 agent
+//
+// This file is part of DOLFIN (https://www.fenicsproject.org)
+//
+// SPDX-License-Identifier:    LGPL-3.0-or-later
+
+#pragma once
+
+#include <Eigen/Dense>
+#include <cstdint>
+#include <dolfin/common/MPI.h>
+#include <dolfin/common/types.h>
+#include <tuple>
+#include <utility>
+#include <vector>
+
+namespace dolfin
+{
+namespace mesh
+{
+class Mesh;
+}
+
+namespace geometry
+{
+class BoundingBoxTree;
+
+/// Return the cell of the mesh containing the point x (closest =
+/// false), or the closest cell (closest = true), and the distance to
+/// the cell. Returns (-1, -1) if no cell contains the point.
+/// @param[in] tree The bounding box tree of the cells of the mesh
+/// @param[in] mesh The mesh
+/// @param[in] x The coordinates (gdim values) of the point
+/// @param[in] closest Find the closest cell if true
+std::pair<std::int32_t, double> find_cell(const BoundingBoxTree& tree,
+                                          const mesh::Mesh& mesh,
+                                          const double* x, bool closest);
+
+/// Send the points x.row(points[i]) to the processes
+/// procs[offsets[i]:offsets[i + 1]]. Collective.
+/// @param[in] comm The MPI communicator
+/// @param[in] x The point coordinates (one row per point)
+/// @param[in] points The points to send
+/// @param[in] procs The destination processes of each point
+/// @param[in] offsets Offsets into procs for each point
+/// @return A neighbourhood communicator for replying to the senders of
+///   the points (the caller must free it), the points sent to each
+///   source neighbour of the reply communicator, and the coordinates
+///   (gdim per point) received from each destination neighbour of the
+///   reply communicator
+std::tuple<MPI_Comm, std::vector<std::vector<std::int32_t>>,
+           std::vector<std::vector<double>>>
+send_points(MPI_Comm comm, const Eigen::Ref<const EigenRowArrayXXd>& x,
+            const std::vector<std::int32_t>& points,
+            const std::vector<int>& procs,
+            const std::vector<std::int32_t>& offsets);
+
+/// Find the process with a cell containing each point x.row(i), or
+/// with the cell closest to the point if no cell contains it. If
+/// several processes qualify, the one with the lowest rank is chosen.
+/// Collective.
+/// @param[in] mesh The distributed mesh
+/// @param[in] tree The bounding box tree of the cells of the mesh
+/// @param[in] x The point coordinates (one row per point)
+/// @return The rank of the process for each point (-1 if the mesh has
+///   no cells)
+std::vector<int> locate_points(const mesh::Mesh& mesh,
+                               const BoundingBoxTree& tree,
+                               const Eigen::Ref<const EigenRowArrayXXd>& x);
+} // namespace geometry
+} // namespace dolfin
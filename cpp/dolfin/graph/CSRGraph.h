@@ -7,6 +7,7 @@
 #pragma once
 
 #include <dolfin/common/MPI.h>
+#include <utility>
 #include <vector>
 
 namespace dolfin
@@ -104,6 +105,16 @@ public:
     calculate_node_distribution();
   }
 
+  /// Create a CSR Graph from ParMETIS style adjacency lists, taking
+  /// ownership of the arrays
+  CSRGraph(MPI_Comm mpi_comm, std::vector<T>&& xadj, std::vector<T>&& adjncy)
+      : _edges(std::move(adjncy)), _node_offsets(std::move(xadj)),
+        _mpi_comm(mpi_comm)
+  {
+    // Compute node offsets
+    calculate_node_distribution();
+  }
+
   /// Copy constructor
   CSRGraph(const CSRGraph& g) = default;
 
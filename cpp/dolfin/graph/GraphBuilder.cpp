@@ -5,16 +5,19 @@
 // SPDX-License-Identifier:    LGPL-3.0-or-later
 
 #include "GraphBuilder.h"
+#include "CSRGraph.h"
 #include <algorithm>
-#include <boost/unordered_map.hpp>
+#include <array>
 #include <dolfin/common/MPI.h>
 #include <dolfin/common/Timer.h>
 #include <dolfin/common/log.h>
 #include <dolfin/common/types.h>
 #include <dolfin/fem/GenericDofMap.h>
-#include <dolfin/mesh/Cell.h>
-#include <dolfin/mesh/MeshIterator.h>
-#include <dolfin/mesh/Vertex.h>
+#include <dolfin/mesh/CellType.h>
+#include <dolfin/mesh/Connectivity.h>
+#include <dolfin/mesh/Mesh.h>
+#include <dolfin/mesh/Topology.h>
+#include <map>
 #include <numeric>
 #include <set>
 #include <unordered_set>
@@ -26,17 +29,18 @@ using namespace dolfin;
 namespace
 {
 
+// Facet key (sorted global vertex indices) and local cell index
+template <int N>
+using FacetCell = std::pair<std::array<std::int64_t, N>, std::int32_t>;
+
 //-----------------------------------------------------------------------------
-// Compute local part of the dual graph, and return return (local_graph,
-// facet_cell_map, number of local edges in the graph (undirected)
+// Match facets of the local cells, and return the pairs of local cells
+// that share a facet and the facets that are not matched on this
+// process (interprocess or exterior boundary facets)
 template <int N>
-std::tuple<std::vector<std::vector<std::size_t>>,
-           std::vector<std::pair<std::vector<std::size_t>, std::int32_t>>,
-           std::int32_t>
-compute_local_dual_graph_keyed(
-    const MPI_Comm mpi_comm,
-    const Eigen::Ref<const EigenRowArrayXXi64>& cell_vertices,
-    const mesh::CellType& cell_type)
+std::pair<std::vector<std::array<std::int32_t, 2>>, std::vector<FacetCell<N>>>
+match_local_facets(const Eigen::Ref<const EigenRowArrayXXi64>& cell_vertices,
+                   const mesh::CellType& cell_type)
 {
   common::Timer timer("Compute local part of mesh dual graph");
 
@@ -45,20 +49,7 @@ compute_local_dual_graph_keyed(
   const std::int8_t num_vertices_per_cell = cell_type.num_entities(0);
   const std::int8_t num_facets_per_cell = cell_type.num_entities(tdim - 1);
   const std::int8_t num_vertices_per_facet = cell_type.num_vertices(tdim - 1);
-
   assert(N == num_vertices_per_facet);
-  assert(num_local_cells == (int)cell_vertices.rows());
-  //  assert(num_vertices_per_cell == (int)cell_vertices.cols());
-
-  std::vector<std::vector<std::size_t>> local_graph(num_local_cells);
-  std::vector<std::pair<std::vector<std::size_t>, std::int32_t>> facet_cell_map;
-
-  // Compute local edges (cell-cell connections) using global
-  // (internal to this function, not the user numbering) numbering
-
-  // Get offset for this process
-  const std::int64_t cell_offset
-      = dolfin::MPI::global_offset(mpi_comm, num_local_cells, true);
 
   // Create map from cell vertices to entity vertices
   Eigen::Array<std::int32_t, Eigen::Dynamic, Eigen::Dynamic, Eigen::RowMajor>
@@ -67,230 +58,274 @@ compute_local_dual_graph_keyed(
   std::iota(v.begin(), v.end(), 0);
   cell_type.create_entities(facet_vertices, tdim - 1, v.data());
 
-  // Vector-of-arrays data structure, which is considerably faster than
-  // vector-of-vectors.
-  std::vector<std::pair<std::array<std::int32_t, N>, std::int32_t>> facets(
-      num_facets_per_cell * num_local_cells);
-
   // Iterate over all cells and build list of all facets (keyed on
-  // sorted vertex indices), with cell index attached
-  int counter = 0;
+  // sorted vertex indices), with cell index attached. Fixed-size keys
+  // are considerably faster to sort than vector-of-vectors.
+  std::vector<FacetCell<N>> facets(num_facets_per_cell * num_local_cells);
+  std::int64_t counter = 0;
   for (std::int32_t i = 0; i < num_local_cells; ++i)
   {
-    // Iterate over facets of cell
     for (std::int8_t j = 0; j < num_facets_per_cell; ++j)
     {
-      // Get list of facet vertices
       auto& facet = facets[counter].first;
       for (std::int8_t k = 0; k < N; ++k)
         facet[k] = cell_vertices(i, facet_vertices(j, k));
-
-      // Sort facet vertices
       std::sort(facet.begin(), facet.end());
-
-      // Attach local cell index
       facets[counter].second = i;
-
-      // Increment facet counter
-      counter++;
+      ++counter;
     }
   }
 
   // Sort facets
   std::sort(facets.begin(), facets.end());
 
-  // Find maching facets by comparing facet i and facet i -1
-  std::size_t num_local_edges = 0;
-  for (std::size_t i = 1; i < facets.size(); ++i)
+  // Find matching facets by comparing facet i and facet i + 1. Facets
+  // without a match are kept, in place, at the front of facets.
+  std::vector<std::array<std::int32_t, 2>> edges;
+  edges.reserve(facets.size() / 2);
+  std::size_t num_unmatched = 0;
+  for (std::size_t i = 0; i < facets.size(); ++i)
   {
-    const int ii = i;
-    const int jj = i - 1;
-
-    const auto& facet0 = facets[jj].first;
-    const auto& facet1 = facets[ii].first;
-    const int cell_index0 = facets[jj].second;
-    if (std::equal(facet1.begin(), facet1.end(), facet0.begin()))
+    if (i + 1 < facets.size() and facets[i].first == facets[i + 1].first)
     {
-      // Add edges (directed graph, so add both ways)
-      const int cell_index1 = facets[ii].second;
-      local_graph[cell_index0].push_back(cell_index1 + cell_offset);
-      local_graph[cell_index1].push_back(cell_index0 + cell_offset);
-
       // Since we've just found a matching pair, the next pair cannot be
       // matching, so advance 1
+      edges.push_back({{facets[i].second, facets[i + 1].second}});
       ++i;
-
-      // Increment number of local edges found
-      ++num_local_edges;
     }
     else
-    {
-      // No match, so add facet0 to map
-      facet_cell_map.push_back(
-          {std::vector<std::size_t>(facet0.begin(), facet0.end()),
-           cell_index0});
-    }
-  }
-
-  // Add last facet, as it's not covered by the above loop. We could
-  // check it against the preceding facet, but it's easier to just
-  // insert it here
-  if (!facets.empty())
-  {
-    const int k = facets.size() - 1;
-    const int cell_index = facets[k].second;
-    facet_cell_map.push_back({std::vector<std::size_t>(facets[k].first.begin(),
-                                                       facets[k].first.end()),
-                              cell_index});
+      facets[num_unmatched++] = facets[i];
   }
+  facets.resize(num_unmatched);
 
-  return std::make_tuple(std::move(local_graph), std::move(facet_cell_map),
-                         num_local_edges);
+  return {std::move(edges), std::move(facets)};
 }
 //-----------------------------------------------------------------------------
-// Build nonlocal part of dual graph for mesh and return number of
-// non-local edges. Note: GraphBuilder::compute_local_dual_graph should
-// be called before this function is called. Returns (ghost vertices,
-// num_nonlocal_edges)
-std::pair<std::int32_t, std::int32_t> compute_nonlocal_dual_graph(
-    const MPI_Comm mpi_comm,
-    const Eigen::Ref<const EigenRowArrayXXi64>& cell_vertices,
-    const mesh::CellType& cell_type,
-    const graph::GraphBuilder::FacetCellMap& facet_cell_map,
-    std::vector<std::vector<std::size_t>>& local_graph)
+// Return process responsible for matching a facet, computed from a hash
+// of the facet key so that facets are evenly spread over processes
+template <int N>
+int facet_owner(const std::array<std::int64_t, N>& facet, int num_processes)
+{
+  std::uint64_t h = 0;
+  for (std::int64_t v : facet)
+    h ^= (std::uint64_t)v + 0x9e3779b97f4a7c15ull + (h << 6) + (h >> 2);
+
+  // Final mixing (splitmix64)
+  h ^= h >> 30;
+  h *= 0xbf58476d1ce4e5b9ull;
+  h ^= h >> 27;
+  h *= 0x94d049bb133111ebull;
+  h ^= h >> 31;
+
+  return h % num_processes;
+}
+//-----------------------------------------------------------------------------
+// Match facets that are not matched locally with facets on other
+// processes. Facets are sent to the process given by a hash of the key,
+// which sorts the received facets to find matches and returns matches
+// to the processes of the two cells. Only processes that exchange
+// facets communicate. Returns pairs (global index of local cell, global
+// index of remote cell), flattened.
+template <int N>
+std::vector<std::int64_t>
+match_nonlocal_facets(const MPI_Comm mpi_comm,
+                      const std::vector<FacetCell<N>>& facets,
+                      std::int64_t cell_offset)
 {
   LOG(INFO) << "Build nonlocal part of mesh dual graph";
   common::Timer timer("Compute non-local part of mesh dual graph");
 
-  // Get number of MPI processes, and return if mesh is not distributed
   const int num_processes = dolfin::MPI::size(mpi_comm);
-  if (num_processes == 1)
-    return std::make_pair(0, 0);
-
-  // At this stage facet_cell map only contains facets->cells with
-  // edge facets either interprocess or external boundaries
-
-  const int tdim = cell_type.dim();
+  const int mpi_rank = dolfin::MPI::rank(mpi_comm);
 
-  // List of cell vertices
-  const std::int32_t num_local_cells = cell_vertices.rows();
-  //  const std::int8_t num_vertices_per_cell = cell_type.num_entities(0);
-  const std::int8_t num_vertices_per_facet = cell_type.num_vertices(tdim - 1);
+  // Compute matching process of each facet
+  std::vector<int> facet_dest(facets.size());
+  std::vector<int> dests;
+  for (std::size_t i = 0; i < facets.size(); ++i)
+  {
+    facet_dest[i] = facet_owner<N>(facets[i].first, num_processes);
+    dests.push_back(facet_dest[i]);
+  }
+  std::sort(dests.begin(), dests.end());
+  dests.erase(std::unique(dests.begin(), dests.end()), dests.end());
+
+  // Create communicator for sending facets to the matching processes,
+  // which also determines the processes that send facets here
+  MPI_Comm send_comm = dolfin::MPI::create_sparse_comm(mpi_comm, dests);
+  std::vector<int> sources, destinations;
+  std::tie(sources, destinations) = dolfin::MPI::neighbours(send_comm);
+
+  // Pack (facet key, global cell index, rank) for each destination
+  std::map<int, int> dest_to_neighbour;
+  for (std::size_t i = 0; i < destinations.size(); ++i)
+    dest_to_neighbour.insert({destinations[i], i});
+  const int record_size = N + 2;
+  std::vector<std::vector<std::int64_t>> send_facets(destinations.size());
+  for (std::size_t i = 0; i < facets.size(); ++i)
+  {
+    std::vector<std::int64_t>& buffer
+        = send_facets[dest_to_neighbour[facet_dest[i]]];
+    buffer.insert(buffer.end(), facets[i].first.begin(),
+                  facets[i].first.end());
+    buffer.push_back(facets[i].second + cell_offset);
+    buffer.push_back(mpi_rank);
+  }
 
-  assert(num_local_cells == (int)cell_vertices.rows());
-  //  assert(num_vertices_per_cell == (int)cell_vertices.cols());
+  std::vector<std::int64_t> recv_facets;
+  dolfin::MPI::neighbour_all_to_all(send_comm, send_facets, recv_facets);
+  MPI_Comm_free(&send_comm);
+
+  // Sort received facets by key
+  const std::int64_t num_recv = recv_facets.size() / record_size;
+  std::vector<std::int64_t> order(num_recv);
+  std::iota(order.begin(), order.end(), 0);
+  std::sort(order.begin(), order.end(),
+            [&recv_facets, record_size](std::int64_t a, std::int64_t b) {
+              const std::int64_t* fa = recv_facets.data() + a * record_size;
+              const std::int64_t* fb = recv_facets.data() + b * record_size;
+              return std::lexicographical_compare(fa, fa + N, fb, fb + N);
+            });
+
+  // Find matches and send back to the processes of both cells
+  std::map<int, int> source_to_neighbour;
+  for (std::size_t i = 0; i < sources.size(); ++i)
+    source_to_neighbour.insert({sources[i], i});
+  std::vector<std::vector<std::int64_t>> send_matches(sources.size());
+  for (std::int64_t i = 1; i < num_recv; ++i)
+  {
+    const std::int64_t* f0 = recv_facets.data() + order[i - 1] * record_size;
+    const std::int64_t* f1 = recv_facets.data() + order[i] * record_size;
+    if (std::equal(f0, f0 + N, f1))
+    {
+      const std::int64_t cell0 = f0[N];
+      const std::int64_t cell1 = f1[N];
+      std::vector<std::int64_t>& buffer0
+          = send_matches[source_to_neighbour[f0[N + 1]]];
+      buffer0.push_back(cell0);
+      buffer0.push_back(cell1);
+      std::vector<std::int64_t>& buffer1
+          = send_matches[source_to_neighbour[f1[N + 1]]];
+      buffer1.push_back(cell1);
+      buffer1.push_back(cell0);
+
+      // Next pair cannot be matching
+      ++i;
+    }
+  }
 
-  // Compute local edges (cell-cell connections) using global
-  // (internal to this function, not the user numbering) numbering
+  // Return matches along the reversed edges of the send communicator
+  MPI_Comm return_comm
+      = dolfin::MPI::create_neighbour_comm(mpi_comm, destinations, sources);
+  std::vector<std::int64_t> cell_pairs;
+  dolfin::MPI::neighbour_all_to_all(return_comm, send_matches, cell_pairs);
+  MPI_Comm_free(&return_comm);
 
-  // Get offset for this process
-  const std::int64_t offset
+  return cell_pairs;
+}
+//-----------------------------------------------------------------------------
+// Build distributed dual graph for facets with N vertices
+template <typename T, int N>
+std::pair<graph::CSRGraph<T>,
+          std::tuple<std::int32_t, std::int32_t, std::int32_t>>
+compute_dual_graph_keyed(
+    const MPI_Comm mpi_comm,
+    const Eigen::Ref<const EigenRowArrayXXi64>& cell_vertices,
+    const mesh::CellType& cell_type)
+{
+  const std::int32_t num_local_cells = cell_vertices.rows();
+  const std::int64_t cell_offset
       = dolfin::MPI::global_offset(mpi_comm, num_local_cells, true);
 
-  // Get global range of vertex indices
-  const std::int64_t num_global_vertices
-      = dolfin::MPI::max(
-            mpi_comm, (cell_vertices.rows() > 0) ? cell_vertices.maxCoeff() : 0)
-        + 1;
-
-  // Send facet-cell map to intermediary match-making processes
-  std::vector<std::vector<std::size_t>> send_buffer(num_processes);
-  std::vector<std::vector<std::size_t>> received_buffer(num_processes);
-
-  // Pack map data and send to match-maker process
-  for (auto& it : facet_cell_map)
+  // Match facets locally, and then unmatched facets across processes
+  std::vector<std::array<std::int32_t, 2>> local_edges;
+  std::vector<FacetCell<N>> unmatched_facets;
+  std::tie(local_edges, unmatched_facets)
+      = match_local_facets<N>(cell_vertices, cell_type);
+  std::vector<std::int64_t> nonlocal_edges;
+  if (dolfin::MPI::size(mpi_comm) > 1)
   {
-    // FIXME: Could use a better index? First vertex is slightly
-    //        skewed towards low values - may not be important
-
-    // Use first vertex of facet to partition into blocks
-    const int dest_proc = dolfin::MPI::index_owner(mpi_comm, (it.first)[0],
-                                                   num_global_vertices);
-
-    // Pack map into vectors to send
-    send_buffer[dest_proc].insert(send_buffer[dest_proc].end(),
-                                  it.first.begin(), it.first.end());
-
-    // Add offset to cell numbers sent off process
-    send_buffer[dest_proc].push_back(it.second + offset);
+    nonlocal_edges
+        = match_nonlocal_facets<N>(mpi_comm, unmatched_facets, cell_offset);
   }
+  unmatched_facets = std::vector<FacetCell<N>>();
 
-  // Send data
-  dolfin::MPI::all_to_all(mpi_comm, send_buffer, received_buffer);
-
-  // Clear send buffer
-  send_buffer = std::vector<std::vector<std::size_t>>(num_processes);
-
-  // Map to connect processes and cells, using facet as key
-  typedef boost::unordered_map<std::vector<std::size_t>,
-                               std::pair<std::size_t, std::size_t>>
-      MatchMap;
-  MatchMap matchmap;
-
-  // Look for matches to send back to other processes
-  std::pair<std::vector<std::size_t>, std::pair<std::size_t, std::size_t>> key;
-  key.first.resize(num_vertices_per_facet);
-  for (int p = 0; p < num_processes; ++p)
+  // Count edges of each cell
+  std::vector<T> offsets(num_local_cells + 1, 0);
+  for (const auto& e : local_edges)
   {
-    // Unpack into map
-    const std::vector<std::size_t>& data_p = received_buffer[p];
-    for (auto it = data_p.begin(); it != data_p.end();
-         it += (num_vertices_per_facet + 1))
-    {
-      // Build map key
-      std::copy(it, it + num_vertices_per_facet, key.first.begin());
-      key.second.first = p;
-      key.second.second = *(it + num_vertices_per_facet);
-
-      // Perform map insertion/look-up
-      std::pair<MatchMap::iterator, bool> data = matchmap.insert(key);
-
-      // If data is already in the map, extract data and remove from
-      // map
-      if (!data.second)
-      {
-        // Found a match of two facets - send back to owners
-        const std::size_t proc1 = data.first->second.first;
-        const std::size_t proc2 = p;
-        const std::size_t cell1 = data.first->second.second;
-        const std::size_t cell2 = key.second.second;
-        send_buffer[proc1].push_back(cell1);
-        send_buffer[proc1].push_back(cell2);
-        send_buffer[proc2].push_back(cell2);
-        send_buffer[proc2].push_back(cell1);
-
-        // Remove facet - saves memory and search time
-        matchmap.erase(data.first);
-      }
-    }
+    ++offsets[e[0] + 1];
+    ++offsets[e[1] + 1];
   }
+  for (std::size_t i = 0; i < nonlocal_edges.size(); i += 2)
+    ++offsets[nonlocal_edges[i] - cell_offset + 1];
+  std::partial_sum(offsets.begin(), offsets.end(), offsets.begin());
+
+  // Insert edges (directed graph, so add both ways), with cells in
+  // global numbering
+  std::vector<T> edges(offsets.back());
+  std::vector<T> pos(offsets.begin(), offsets.end() - 1);
+  for (const auto& e : local_edges)
+  {
+    edges[pos[e[0]]++] = e[1] + cell_offset;
+    edges[pos[e[1]]++] = e[0] + cell_offset;
+  }
+  for (std::size_t i = 0; i < nonlocal_edges.size(); i += 2)
+    edges[pos[nonlocal_edges[i] - cell_offset]++] = nonlocal_edges[i + 1];
+
+  // Count ghost nodes (remote cells connected to local cells)
+  std::vector<std::int64_t> ghost_nodes;
+  ghost_nodes.reserve(nonlocal_edges.size() / 2);
+  for (std::size_t i = 1; i < nonlocal_edges.size(); i += 2)
+    ghost_nodes.push_back(nonlocal_edges[i]);
+  std::sort(ghost_nodes.begin(), ghost_nodes.end());
+  const std::int32_t num_ghost_nodes
+      = std::unique(ghost_nodes.begin(), ghost_nodes.end())
+        - ghost_nodes.begin();
+
+  const std::int32_t num_local_edges = local_edges.size();
+  const std::int32_t num_nonlocal_edges = nonlocal_edges.size() / 2;
+  return std::make_pair(
+      graph::CSRGraph<T>(mpi_comm, std::move(offsets), std::move(edges)),
+      std::make_tuple(num_ghost_nodes, num_local_edges, num_nonlocal_edges));
+}
+//-----------------------------------------------------------------------------
+// Compute local part of the dual graph, and return (local_graph,
+// facet_cell_map, number of local edges in the graph (undirected)
+template <int N>
+std::tuple<std::vector<std::vector<std::size_t>>,
+           std::vector<std::pair<std::vector<std::size_t>, std::int32_t>>,
+           std::int32_t>
+compute_local_dual_graph_keyed(
+    const MPI_Comm mpi_comm,
+    const Eigen::Ref<const EigenRowArrayXXi64>& cell_vertices,
+    const mesh::CellType& cell_type)
+{
+  const std::int32_t num_local_cells = cell_vertices.rows();
+  const std::int64_t cell_offset
+      = dolfin::MPI::global_offset(mpi_comm, num_local_cells, true);
 
-  // Send matches to other processes
-  std::vector<std::size_t> cell_list;
-  dolfin::MPI::all_to_all(mpi_comm, send_buffer, cell_list);
-
-  // Ghost nodes
-  std::set<std::int64_t> ghost_nodes;
+  std::vector<std::array<std::int32_t, 2>> edges;
+  std::vector<FacetCell<N>> facets;
+  std::tie(edges, facets) = match_local_facets<N>(cell_vertices, cell_type);
 
-  // Insert connected cells into local map
-  std::int32_t num_nonlocal_edges = 0;
-  for (std::size_t i = 0; i < cell_list.size(); i += 2)
+  std::vector<std::vector<std::size_t>> local_graph(num_local_cells);
+  for (const auto& e : edges)
   {
-    assert((std::int64_t)cell_list[i] >= offset);
-    assert((std::int64_t)(cell_list[i] - offset)
-           < (std::int64_t)local_graph.size());
+    local_graph[e[0]].push_back(e[1] + cell_offset);
+    local_graph[e[1]].push_back(e[0] + cell_offset);
+  }
 
-    auto& edges = local_graph[cell_list[i] - offset];
-    auto it = std::find(edges.begin(), edges.end(), cell_list[i + 1]);
-    if (it == local_graph[cell_list[i] - offset].end())
-    {
-      edges.push_back(cell_list[i + 1]);
-      ++num_nonlocal_edges;
-    }
-    ghost_nodes.insert(cell_list[i + 1]);
+  std::vector<std::pair<std::vector<std::size_t>, std::int32_t>> facet_cell_map;
+  facet_cell_map.reserve(facets.size());
+  for (const auto& facet : facets)
+  {
+    facet_cell_map.push_back(
+        {std::vector<std::size_t>(facet.first.begin(), facet.first.end()),
+         facet.second});
   }
 
-  return std::make_pair(ghost_nodes.size(), num_nonlocal_edges);
+  return std::make_tuple(std::move(local_graph), std::move(facet_cell_map),
+                         (std::int32_t)edges.size());
 }
 //-----------------------------------------------------------------------------
 
@@ -309,12 +344,14 @@ dolfin::graph::GraphBuilder::local_graph(const mesh::Mesh& mesh,
   Graph graph(n);
 
   // Build graph
-  for (auto& cell : mesh::MeshRange<mesh::Cell>(mesh))
+  const std::int32_t num_cells
+      = mesh.topology().ghost_offset(mesh.topology().dim());
+  for (std::int32_t c = 0; c < num_cells; ++c)
   {
     Eigen::Map<const Eigen::Array<PetscInt, Eigen::Dynamic, 1>> dofs0
-        = dofmap0.cell_dofs(cell.index());
+        = dofmap0.cell_dofs(c);
     Eigen::Map<const Eigen::Array<PetscInt, Eigen::Dynamic, 1>> dofs1
-        = dofmap1.cell_dofs(cell.index());
+        = dofmap1.cell_dofs(c);
 
     for (Eigen::Index i = 0; i < dofs0.size(); ++i)
     {
@@ -344,12 +381,28 @@ dolfin::graph::Graph dolfin::graph::GraphBuilder::local_graph(
   const std::size_t num_vertices = mesh.num_entities(coloring_type[0]);
   Graph graph(num_vertices);
 
-  // Build graph
-  for (auto& vertex_entity :
-       mesh::MeshRange<mesh::MeshEntity>(mesh, coloring_type[0]))
+  // Get connectivity between levels (nullptr for the identity)
+  const mesh::Topology& topology = mesh.topology();
+  std::vector<const mesh::Connectivity*> connectivity(coloring_type.size(),
+                                                      nullptr);
+  for (std::size_t level = 1; level < coloring_type.size(); ++level)
   {
-    const std::size_t vertex_entity_index = vertex_entity.index();
+    if (coloring_type[level - 1] != coloring_type[level])
+    {
+      connectivity[level]
+          = topology.connectivity(coloring_type[level - 1],
+                                  coloring_type[level])
+                .get();
+      assert(connectivity[level]);
+    }
+  }
 
+  // Build graph
+  const std::int32_t num_regular_vertices
+      = topology.ghost_offset(coloring_type[0]);
+  for (std::int32_t vertex_entity_index = 0;
+       vertex_entity_index < num_regular_vertices; ++vertex_entity_index)
+  {
     std::unordered_set<std::size_t> entity_list0;
     std::unordered_set<std::size_t> entity_list1;
     entity_list0.insert(vertex_entity_index);
@@ -357,16 +410,14 @@ dolfin::graph::Graph dolfin::graph::GraphBuilder::local_graph(
     // Build list of entities, moving between levels
     for (std::size_t level = 1; level < coloring_type.size(); ++level)
     {
+      const mesh::Connectivity* c = connectivity[level];
+      if (!c)
+        continue;
       for (auto entity_index = entity_list0.cbegin();
            entity_index != entity_list0.cend(); ++entity_index)
       {
-        const mesh::MeshEntity entity(mesh, coloring_type[level - 1],
-                                      *entity_index);
-        for (auto& neighbor :
-             mesh::EntityRange<mesh::MeshEntity>(entity, coloring_type[level]))
-        {
-          entity_list1.insert(neighbor.index());
-        }
+        const std::int32_t* neighbors = c->connections(*entity_index);
+        entity_list1.insert(neighbors, neighbors + c->size(*entity_index));
       }
       entity_list0 = entity_list1;
       entity_list1.clear();
@@ -393,16 +444,22 @@ dolfin::graph::GraphBuilder::local_graph(const mesh::Mesh& mesh,
   Graph graph(num_vertices);
 
   // Build graph
-  for (auto& colored_entity : mesh::MeshRange<mesh::MeshEntity>(mesh, dim0))
+  const mesh::Topology& topology = mesh.topology();
+  assert(topology.connectivity(dim0, dim1));
+  assert(topology.connectivity(dim1, dim0));
+  const mesh::Connectivity& c01 = *topology.connectivity(dim0, dim1);
+  const mesh::Connectivity& c10 = *topology.connectivity(dim1, dim0);
+  const std::int32_t num_regular = topology.ghost_offset(dim0);
+  for (std::int32_t e0 = 0; e0 < num_regular; ++e0)
   {
-    const std::int32_t colored_entity_index = colored_entity.index();
-    for (auto& entity :
-         mesh::EntityRange<mesh::MeshEntity>(colored_entity, dim1))
+    const std::int32_t* entities = c01.connections(e0);
+    for (std::size_t i = 0; i < c01.size(e0); ++i)
     {
-      for (auto& neighbor : mesh::EntityRange<mesh::MeshEntity>(entity, dim0))
+      const std::int32_t* neighbors = c10.connections(entities[i]);
+      for (std::size_t j = 0; j < c10.size(entities[i]); ++j)
       {
-        if (colored_entity_index != neighbor.index())
-          graph[colored_entity_index].insert(neighbor.index());
+        if (e0 != neighbors[j])
+          graph[e0].insert(neighbors[j]);
       }
     }
   }
@@ -410,7 +467,8 @@ dolfin::graph::GraphBuilder::local_graph(const mesh::Mesh& mesh,
   return graph;
 }
 //-----------------------------------------------------------------------------
-std::pair<std::vector<std::vector<std::size_t>>,
+template <typename T>
+std::pair<graph::CSRGraph<T>,
           std::tuple<std::int32_t, std::int32_t, std::int32_t>>
 graph::GraphBuilder::compute_dual_graph(
     const MPI_Comm mpi_comm,
@@ -419,27 +477,23 @@ graph::GraphBuilder::compute_dual_graph(
 {
   LOG(INFO) << "Build mesh dual graph";
 
-  std::vector<std::vector<std::size_t>> local_graph;
-  std::int32_t num_ghost_nodes;
-
-  // Compute local part of dual graph
-  graph::GraphBuilder::FacetCellMap facet_cell_map;
-  std::int32_t num_local_edges;
-  std::tie(local_graph, facet_cell_map, num_local_edges)
-      = graph::GraphBuilder::compute_local_dual_graph(mpi_comm, cell_vertices,
-                                                      cell_type);
-
-  // Compute nonlocal part
-  std::int32_t num_nonlocal_edges;
-  std::tie(num_ghost_nodes, num_nonlocal_edges) = compute_nonlocal_dual_graph(
-      mpi_comm, cell_vertices, cell_type, facet_cell_map, local_graph);
-
-  // Shrink to fit
-  local_graph.shrink_to_fit();
-
-  return std::make_pair(
-      std::move(local_graph),
-      std::make_tuple(num_ghost_nodes, num_local_edges, num_nonlocal_edges));
+  const std::int8_t tdim = cell_type.dim();
+  const std::int8_t num_entity_vertices = cell_type.num_vertices(tdim - 1);
+  switch (num_entity_vertices)
+  {
+  case 1:
+    return compute_dual_graph_keyed<T, 1>(mpi_comm, cell_vertices, cell_type);
+  case 2:
+    return compute_dual_graph_keyed<T, 2>(mpi_comm, cell_vertices, cell_type);
+  case 3:
+    return compute_dual_graph_keyed<T, 3>(mpi_comm, cell_vertices, cell_type);
+  case 4:
+    return compute_dual_graph_keyed<T, 4>(mpi_comm, cell_vertices, cell_type);
+  default:
+    throw std::runtime_error(
+        "Cannot compute dual graph. Entities with "
+        + std::to_string(num_entity_vertices) + " vertices not supported");
+  }
 }
 //-----------------------------------------------------------------------------
 std::tuple<std::vector<std::vector<std::size_t>>,
@@ -479,3 +533,15 @@ dolfin::graph::GraphBuilder::compute_local_dual_graph(
   }
 }
 //-----------------------------------------------------------------------------
+// Explicit instantiation
+template std::pair<graph::CSRGraph<std::int32_t>,
+                   std::tuple<std::int32_t, std::int32_t, std::int32_t>>
+graph::GraphBuilder::compute_dual_graph<std::int32_t>(
+    const MPI_Comm, const Eigen::Ref<const EigenRowArrayXXi64>&,
+    const mesh::CellType&);
+template std::pair<graph::CSRGraph<std::int64_t>,
+                   std::tuple<std::int32_t, std::int32_t, std::int32_t>>
+graph::GraphBuilder::compute_dual_graph<std::int64_t>(
+    const MPI_Comm, const Eigen::Ref<const EigenRowArrayXXi64>&,
+    const mesh::CellType&);
+//-----------------------------------------------------------------------------
@@ -30,6 +30,9 @@ class Mesh;
 namespace graph
 {
 
+template <typename T>
+class CSRGraph;
+
 /// This class builds a Graph corresponding to various objects
 
 class GraphBuilder
@@ -53,9 +56,13 @@ public:
                            std::size_t dim1);
 
   /// Build distributed dual graph (cell-cell connections) from
-  /// minimal mesh data, and return (graph, ghost_vertices, [num local edges,
-  /// num non-local edges])
-  static std::pair<std::vector<std::vector<std::size_t>>,
+  /// minimal mesh data, and return (graph, [num ghost vertices, num
+  /// local edges, num non-local edges]). Facets that are not matched
+  /// locally are matched on the process given by a hash of the facet,
+  /// with communication only between processes that exchange facets.
+  /// Instantiated for T = std::int32_t and std::int64_t.
+  template <typename T>
+  static std::pair<CSRGraph<T>,
                    std::tuple<std::int32_t, std::int32_t, std::int32_t>>
   compute_dual_graph(const MPI_Comm mpi_comm,
                      const Eigen::Ref<const EigenRowArrayXXi64>& cell_vertices,
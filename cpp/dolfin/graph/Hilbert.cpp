@@ -0,0 +1,204 @@
+// Copyright (C) 2026 agent
+//
+// This file is part of DOLFIN (https://www.fenicsproject.org)
+//
+// SPDX-License-Identifier:    LGPL-3.0-or-later
+
+#include "Hilbert.h"
+#include <algorithm>
+#include <array>
+#include <dolfin/common/Timer.h>
+#include <dolfin/common/log.h>
+#include <limits>
+#include <numeric>
+
+using namespace dolfin;
+
+namespace
+{
+//-----------------------------------------------------------------------------
+// Compute Hilbert index from integer coordinates X (n dimensions, b
+// bits each), using the transpose algorithm of J. Skilling,
+// "Programming the Hilbert curve", AIP Conf. Proc. 707, 381 (2004)
+std::uint64_t hilbert_index(std::array<std::uint32_t, 3> X, int n, int b)
+{
+  if (n == 1)
+    return X[0];
+
+  // Inverse undo excess work
+  const std::uint32_t M = 1u << (b - 1);
+  for (std::uint32_t Q = M; Q > 1; Q >>= 1)
+  {
+    const std::uint32_t P = Q - 1;
+    for (int i = 0; i < n; ++i)
+    {
+      if (X[i] & Q)
+        X[0] ^= P;
+      else
+      {
+        const std::uint32_t t = (X[0] ^ X[i]) & P;
+        X[0] ^= t;
+        X[i] ^= t;
+      }
+    }
+  }
+
+  // Gray encode
+  for (int i = 1; i < n; ++i)
+    X[i] ^= X[i - 1];
+  std::uint32_t t = 0;
+  for (std::uint32_t Q = M; Q > 1; Q >>= 1)
+  {
+    if (X[n - 1] & Q)
+      t ^= Q - 1;
+  }
+  for (int i = 0; i < n; ++i)
+    X[i] ^= t;
+
+  // Interleave bits of the transposed index, most significant first
+  std::uint64_t key = 0;
+  for (int j = b - 1; j >= 0; --j)
+    for (int i = 0; i < n; ++i)
+      key = (key << 1) | ((X[i] >> j) & 1u);
+
+  return key;
+}
+//-----------------------------------------------------------------------------
+} // namespace
+
+//-----------------------------------------------------------------------------
+std::vector<std::uint64_t>
+graph::Hilbert::keys(const Eigen::Ref<const EigenRowArrayXXd>& x,
+                     const std::vector<double>& lower,
+                     const std::vector<double>& upper)
+{
+  const int gdim = x.cols();
+  if (gdim < 1 or gdim > 3)
+  {
+    throw std::runtime_error(
+        "Hilbert curve index is only supported for 1, 2 or 3 dimensions");
+  }
+  assert((int)lower.size() == gdim);
+  assert((int)upper.size() == gdim);
+
+  // Number of bits per direction
+  const int b = (gdim == 3) ? 21 : 32;
+  const double max_int = (double)((std::uint64_t(1) << b) - 1);
+
+  std::vector<double> scale(gdim);
+  for (int i = 0; i < gdim; ++i)
+  {
+    const double h = upper[i] - lower[i];
+    scale[i] = (h > 0.0) ? max_int / h : 0.0;
+  }
+
+  std::vector<std::uint64_t> keys(x.rows());
+  std::array<std::uint32_t, 3> X = {0, 0, 0};
+  for (Eigen::Index p = 0; p < x.rows(); ++p)
+  {
+    for (int i = 0; i < gdim; ++i)
+    {
+      const double s = (x(p, i) - lower[i]) * scale[i];
+      X[i] = (std::uint32_t)std::min(std::max(s, 0.0), max_int);
+    }
+    keys[p] = hilbert_index(X, gdim, b);
+  }
+
+  return keys;
+}
+//-----------------------------------------------------------------------------
+std::vector<int>
+graph::Hilbert::partition(MPI_Comm mpi_comm,
+                          const Eigen::Ref<const EigenRowArrayXXd>& x,
+                          const std::vector<std::int64_t>& weights)
+{
+  common::Timer timer("Compute geometric partition (Hilbert)");
+
+  const int mpi_size = dolfin::MPI::size(mpi_comm);
+  const std::int32_t num_points = x.rows();
+  const int gdim = dolfin::MPI::max(mpi_comm, (int)x.cols());
+  assert(weights.empty() or (std::int32_t)weights.size() == num_points);
+
+  // Compute global bounding box
+  std::vector<double> lower(gdim, std::numeric_limits<double>::max());
+  std::vector<double> upper(gdim, std::numeric_limits<double>::lowest());
+  if (num_points > 0)
+  {
+    for (int i = 0; i < gdim; ++i)
+    {
+      lower[i] = x.col(i).minCoeff();
+      upper[i] = x.col(i).maxCoeff();
+    }
+  }
+  MPI_Allreduce(MPI_IN_PLACE, lower.data(), gdim, MPI_DOUBLE, MPI_MIN,
+                mpi_comm);
+  MPI_Allreduce(MPI_IN_PLACE, upper.data(), gdim, MPI_DOUBLE, MPI_MAX,
+                mpi_comm);
+
+  // Sort points by Hilbert index and compute cumulative weights
+  const std::vector<std::uint64_t> point_keys = keys(x, lower, upper);
+  std::vector<std::int32_t> order(num_points);
+  std::iota(order.begin(), order.end(), 0);
+  std::sort(order.begin(), order.end(),
+            [&point_keys](std::int32_t a, std::int32_t b) {
+              return point_keys[a] < point_keys[b];
+            });
+  std::vector<std::uint64_t> sorted_keys(num_points);
+  std::vector<std::int64_t> cumulative_weight(num_points + 1, 0);
+  for (std::int32_t i = 0; i < num_points; ++i)
+  {
+    sorted_keys[i] = point_keys[order[i]];
+    cumulative_weight[i + 1]
+        = cumulative_weight[i] + (weights.empty() ? 1 : weights[order[i]]);
+  }
+
+  const std::int64_t total_weight
+      = dolfin::MPI::sum(mpi_comm, cumulative_weight.back());
+
+  // Find splitters by simultaneous bisection on the key range. The k-th
+  // splitter is the smallest key s such that the global weight of
+  // points with key <= s is at least k/mpi_size of the total weight.
+  // Each bisection step requires one reduction, and the result is the
+  // same on all processes.
+  const int num_splitters = mpi_size - 1;
+  std::vector<std::uint64_t> lo(num_splitters, 0);
+  std::vector<std::uint64_t> hi(num_splitters,
+                                std::numeric_limits<std::uint64_t>::max());
+  std::vector<std::int64_t> weight_below(num_splitters);
+  std::vector<std::uint64_t> mid(num_splitters);
+  while (lo != hi)
+  {
+    for (int k = 0; k < num_splitters; ++k)
+    {
+      mid[k] = lo[k] + (hi[k] - lo[k]) / 2;
+      const std::int32_t pos
+          = std::upper_bound(sorted_keys.begin(), sorted_keys.end(), mid[k])
+            - sorted_keys.begin();
+      weight_below[k] = cumulative_weight[pos];
+    }
+    MPI_Allreduce(MPI_IN_PLACE, weight_below.data(), num_splitters,
+                  MPI_INT64_T, MPI_SUM, mpi_comm);
+    for (int k = 0; k < num_splitters; ++k)
+    {
+      if (lo[k] == hi[k])
+        continue;
+
+      // Compare (k + 1)/mpi_size*total_weight without rounding
+      if (weight_below[k] * mpi_size >= (k + 1) * total_weight)
+        hi[k] = mid[k];
+      else
+        lo[k] = mid[k] + 1;
+    }
+  }
+
+  // Assign each point to the process owning its piece of the curve
+  std::vector<int> part(num_points);
+  for (std::int32_t i = 0; i < num_points; ++i)
+  {
+    part[i] = std::lower_bound(lo.begin(), lo.end(), point_keys[i])
+              - lo.begin();
+  }
+
+  return part;
+}
+//-----------------------------------------------------------------------------
@@ -0,0 +1,58 @@
+// Copyright (C) 2026 agent
+//
+// This file is part of DOLFIN (https://www.fenicsproject.org)
+//
+// SPDX-License-Identifier:    LGPL-3.0-or-later
+
+#pragma once
+
+#include <cstdint>
+#include <dolfin/common/MPI.h>
+#include <dolfin/common/types.h>
+#include <vector>
+
+namespace dolfin
+{
+namespace graph
+{
+
+/// Geometric partitioning of points along a Hilbert space-filling
+/// curve. Points that are close on the curve are close in space, so
+/// splitting the curve into contiguous pieces gives compact partitions
+/// without building a graph. Only global reductions are required.
+
+class Hilbert
+{
+public:
+  /// Compute the Hilbert curve index of each point. The bounding box
+  /// [lower, upper] is divided into 2^32 steps in each direction for
+  /// gdim <= 2, and 2^21 steps for gdim = 3.
+  /// @param x
+  ///   Point coordinates (one row per point, gdim <= 3)
+  /// @param lower
+  ///   Lower corner of bounding box
+  /// @param upper
+  ///   Upper corner of bounding box
+  /// @return std::vector<std::uint64_t>
+  ///   Hilbert index of each point
+  static std::vector<std::uint64_t>
+  keys(const Eigen::Ref<const EigenRowArrayXXd>& x,
+       const std::vector<double>& lower, const std::vector<double>& upper);
+
+  /// Partition distributed points into one part per process by
+  /// splitting the Hilbert curve through all points into pieces of
+  /// (nearly) equal weight
+  /// @param mpi_comm
+  ///   MPI communicator
+  /// @param x
+  ///   Local point coordinates (one row per point, gdim <= 3)
+  /// @param weights
+  ///   Weight of each local point. Unit weights are used if empty.
+  /// @return std::vector<int>
+  ///   Destination process of each local point
+  static std::vector<int> partition(MPI_Comm mpi_comm,
+                                    const Eigen::Ref<const EigenRowArrayXXd>& x,
+                                    const std::vector<std::int64_t>& weights);
+};
+} // namespace graph
+} // namespace dolfin
@@ -102,54 +102,20 @@ using namespace dolfin;
 // } // namespace
 
 //-----------------------------------------------------------------------------
-std::pair<std::vector<int>, std::map<std::int64_t, std::vector<int>>>
-dolfin::graph::ParMETIS::partition(MPI_Comm mpi_comm,
-                                   const CSRGraph<idx_t>& csr_graph)
+namespace
+{
+// Compute the processes to which each cell on the boundary of the
+// partition must be sent as a ghost (map from local cell index to
+// sharing processes, with the owner first)
+std::map<std::int64_t, std::vector<int>>
+compute_ghost_procs(MPI_Comm mpi_comm,
+                    const dolfin::graph::CSRGraph<idx_t>& csr_graph,
+                    const std::vector<idx_t>& part)
 {
   std::map<std::int64_t, std::vector<int>> ghost_procs;
 
-  common::Timer timer("Compute graph partition (ParMETIS)");
-
-  // Options for ParMETIS
-  idx_t options[3];
-  options[0] = 1;
-  options[1] = 0;
-  options[2] = 15;
-
-  // Number of partitions (one for each process)
-  idx_t nparts = dolfin::MPI::size(mpi_comm);
-
-  // Strange weight arrays needed by ParMETIS
-  idx_t ncon = 1;
-
-  // Prepare remaining arguments for ParMETIS
-  idx_t* elmwgt = NULL;
-  idx_t wgtflag = 0;
-  idx_t edgecut = 0;
-  idx_t numflag = 0;
-  std::vector<real_t> tpwgts(ncon * nparts, 1.0 / static_cast<real_t>(nparts));
-  std::vector<real_t> ubvec(ncon, 1.05);
-
-  // Note: ParMETIS is not const-correct, so we throw away const-ness
-  // and trust ParMETIS to not modify the data.
-
-  // Call ParMETIS to partition graph
-  common::Timer timer1("ParMETIS: call ParMETIS_V3_PartKway");
-  const std::int32_t num_local_cells = csr_graph.size();
-  std::vector<idx_t> part(num_local_cells);
-  assert(!part.empty());
-  int err = ParMETIS_V3_PartKway(
-      const_cast<idx_t*>(csr_graph.node_distribution().data()),
-      const_cast<idx_t*>(csr_graph.nodes().data()),
-      const_cast<idx_t*>(csr_graph.edges().data()), elmwgt, NULL, &wgtflag,
-      &numflag, &ncon, &nparts, tpwgts.data(), ubvec.data(), options, &edgecut,
-      part.data(), &mpi_comm);
-  assert(err == METIS_OK);
-  timer1.stop();
+  common::Timer timer("Compute graph halo data (ParMETIS)");
 
-  common::Timer timer2("Compute graph halo data (ParMETIS)");
-
-  // Work out halo cells for current division of dual graph
   const auto& elmdist = csr_graph.node_distribution();
   const auto& xadj = csr_graph.nodes();
   const auto& adjncy = csr_graph.edges();
@@ -250,15 +216,76 @@ dolfin::graph::ParMETIS::partition(MPI_Comm mpi_comm,
     }
   }
 
-  timer2.stop();
+  return ghost_procs;
+}
+} // namespace
+
+//-----------------------------------------------------------------------------
+std::pair<std::vector<int>, std::map<std::int64_t, std::vector<int>>>
+dolfin::graph::ParMETIS::partition(MPI_Comm mpi_comm,
+                                   const CSRGraph<idx_t>& csr_graph,
+                                   const std::vector<idx_t>& node_weights,
+                                   idx_t num_constraints)
+{
+  common::Timer timer("Compute graph partition (ParMETIS)");
+
+  // Options for ParMETIS
+  idx_t options[3];
+  options[0] = 1;
+  options[1] = 0;
+  options[2] = 15;
+
+  // Number of partitions (one for each process)
+  idx_t nparts = dolfin::MPI::size(mpi_comm);
+
+  // Strange weight arrays needed by ParMETIS
+  idx_t ncon = num_constraints;
+
+  // Prepare remaining arguments for ParMETIS
+  const std::int32_t num_local_cells = csr_graph.size();
+  idx_t* elmwgt = NULL;
+  idx_t wgtflag = 0;
+  if (!node_weights.empty())
+  {
+    assert((std::int32_t)node_weights.size() == num_local_cells * ncon);
+    elmwgt = const_cast<idx_t*>(node_weights.data());
+    wgtflag = 2;
+  }
+  else
+    ncon = 1;
+  idx_t edgecut = 0;
+  idx_t numflag = 0;
+  std::vector<real_t> tpwgts(ncon * nparts, 1.0 / static_cast<real_t>(nparts));
+  std::vector<real_t> ubvec(ncon, 1.05);
+
+  // Note: ParMETIS is not const-correct, so we throw away const-ness
+  // and trust ParMETIS to not modify the data.
+
+  // Call ParMETIS to partition graph
+  common::Timer timer1("ParMETIS: call ParMETIS_V3_PartKway");
+  std::vector<idx_t> part(num_local_cells);
+  assert(!part.empty());
+  int err = ParMETIS_V3_PartKway(
+      const_cast<idx_t*>(csr_graph.node_distribution().data()),
+      const_cast<idx_t*>(csr_graph.nodes().data()),
+      const_cast<idx_t*>(csr_graph.edges().data()), elmwgt, NULL, &wgtflag,
+      &numflag, &ncon, &nparts, tpwgts.data(), ubvec.data(), options, &edgecut,
+      part.data(), &mpi_comm);
+  assert(err == METIS_OK);
+  timer1.stop();
+
+  // Work out halo cells for current division of dual graph
+  std::map<std::int64_t, std::vector<int>> ghost_procs
+      = compute_ghost_procs(mpi_comm, csr_graph, part);
 
   return std::make_pair(std::vector<int>(part.begin(), part.end()),
                         std::move(ghost_procs));
 }
 //-----------------------------------------------------------------------------
-template <typename T>
-std::vector<int> dolfin::graph::ParMETIS::adaptive_repartition(
-    MPI_Comm mpi_comm, const CSRGraph<T>& csr_graph, double weight)
+std::pair<std::vector<int>, std::map<std::int64_t, std::vector<int>>>
+dolfin::graph::ParMETIS::adaptive_repartition(
+    MPI_Comm mpi_comm, const CSRGraph<idx_t>& csr_graph,
+    const std::vector<idx_t>& node_weights, double itr)
 {
   common::Timer timer(
       "Compute graph partition (ParMETIS Adaptive Repartition)");
@@ -273,10 +300,12 @@ std::vector<int> dolfin::graph::ParMETIS::adaptive_repartition(
   // migration if already balanced.  Try PARMETIS_PSR_UNCOUPLED for
   // better edge cut.
 
-  common::Timer timer1("ParMETIS: call ParMETIS_V3_AdaptiveRepart");
-  real_t _itr = weight;
-  std::vector<idx_t> part(csr_graph.size());
-  std::vector<idx_t> vsize(part.size(), 1);
+  // Partitioning array to be computed by ParMETIS. With uncoupled
+  // sub-domains it must hold the current partition, which is the
+  // process number.
+  const std::int32_t num_local_cells = csr_graph.size();
+  std::vector<idx_t> part(num_local_cells, dolfin::MPI::rank(mpi_comm));
+  std::vector<idx_t> vsize(num_local_cells, 1);
   assert(!part.empty());
 
   // Number of partitions (one for each process)
@@ -286,22 +315,38 @@ std::vector<int> dolfin::graph::ParMETIS::adaptive_repartition(
   idx_t ncon = 1;
   idx_t* elmwgt = NULL;
   idx_t wgtflag = 0;
+  if (!node_weights.empty())
+  {
+    assert((std::int32_t)node_weights.size() == num_local_cells);
+    elmwgt = const_cast<idx_t*>(node_weights.data());
+    wgtflag = 2;
+  }
   idx_t edgecut = 0;
   idx_t numflag = 0;
+  real_t _itr = itr;
   std::vector<real_t> tpwgts(ncon * nparts, 1.0 / static_cast<real_t>(nparts));
   std::vector<real_t> ubvec(ncon, 1.05);
 
+  // Note: ParMETIS is not const-correct, so we throw away const-ness
+  // and trust ParMETIS to not modify the data.
+
   // Call ParMETIS to repartition graph
+  common::Timer timer1("ParMETIS: call ParMETIS_V3_AdaptiveRepart");
   int err = ParMETIS_V3_AdaptiveRepart(
-      csr_graph.node_distribution().data(), csr_graph.nodes().data(),
-      csr_graph.edges().data(), elmwgt, NULL, vsize.data(), &wgtflag, &numflag,
-      &ncon, &nparts, tpwgts.data(), ubvec.data(), &_itr, options, &edgecut,
-      part.data(), &mpi_comm);
+      const_cast<idx_t*>(csr_graph.node_distribution().data()),
+      const_cast<idx_t*>(csr_graph.nodes().data()),
+      const_cast<idx_t*>(csr_graph.edges().data()), elmwgt, vsize.data(), NULL,
+      &wgtflag, &numflag, &ncon, &nparts, tpwgts.data(), ubvec.data(), &_itr,
+      options, &edgecut, part.data(), &mpi_comm);
   assert(err == METIS_OK);
   timer1.stop();
 
-  // Copy cell partition data and return
-  return std::vector<int>(part.begin(), part.end());
+  // Work out halo cells for the new partition
+  std::map<std::int64_t, std::vector<int>> ghost_procs
+      = compute_ghost_procs(mpi_comm, csr_graph, part);
+
+  return std::make_pair(std::vector<int>(part.begin(), part.end()),
+                        std::move(ghost_procs));
 }
 //-----------------------------------------------------------------------------
 template <typename T>
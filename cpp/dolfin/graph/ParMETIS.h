@@ -41,17 +41,27 @@ class ParMETIS
 {
 #ifdef HAS_PARMETIS
 public:
-  // Standard ParMETIS partition
+  /// Standard ParMETIS partition. Node weights (num_constraints per
+  /// node, node-major) are optional, and each constraint is balanced
+  /// separately.
   static std::pair<std::vector<int>, std::map<std::int64_t, std::vector<int>>>
-  partition(MPI_Comm mpi_comm, const CSRGraph<idx_t>& csr_graph);
+  partition(MPI_Comm mpi_comm, const CSRGraph<idx_t>& csr_graph,
+            const std::vector<idx_t>& node_weights = {},
+            idx_t num_constraints = 1);
 
-private:
-  // ParMETIS adaptive repartition, so has to be non-const here
-  template <typename T>
-  static std::vector<int> adaptive_repartition(MPI_Comm mpi_comm,
-                                               const CSRGraph<T>& csr_graph,
-                                               double weight = 1000);
+  /// ParMETIS adaptive repartition of a graph which is distributed
+  /// according to an existing partition (one part per process),
+  /// balancing the node weights (unit weights if empty). itr is the
+  /// ratio of inter-process communication time to data redistribution
+  /// time, and controls the trade-off between edge cut and migration.
+  /// Returns the new partition and the processes to which ghost nodes
+  /// must be sent (same format as partition).
+  static std::pair<std::vector<int>, std::map<std::int64_t, std::vector<int>>>
+  adaptive_repartition(MPI_Comm mpi_comm, const CSRGraph<idx_t>& csr_graph,
+                       const std::vector<idx_t>& node_weights,
+                       double itr = 1000);
 
+private:
   // ParMETIS refine repartition
   template <typename T>
   static std::vector<int> refine(MPI_Comm mpi_comm,
@@ -15,4 +15,5 @@ namespace dolfin
 #include <dolfin/graph/BoostGraphOrdering.h>
 #include <dolfin/graph/Graph.h>
 #include <dolfin/graph/GraphBuilder.h>
+#include <dolfin/graph/Hilbert.h>
 #include <dolfin/graph/SCOTCH.h>
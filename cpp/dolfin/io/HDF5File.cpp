@@ -20,6 +20,7 @@
 #include <dolfin/la/PETScVector.h>
 #include <dolfin/la/utils.h>
 #include <dolfin/mesh/Cell.h>
+#include <dolfin/mesh/Connectivity.h>
 #include <dolfin/mesh/DistributedMeshTools.h>
 #include <dolfin/mesh/Mesh.h>
 #include <dolfin/mesh/MeshFunction.h>
@@ -99,15 +100,25 @@ void HDF5File::write(const std::vector<Eigen::Vector3d>& points,
   assert(points.size() > 0);
   assert(_hdf5_file_id > 0);
 
-  // Pack data
-  const std::size_t n = points.size();
-  Eigen::Array<double, Eigen::Dynamic, Eigen::Dynamic, Eigen::RowMajor> x(n, 3);
-  for (std::size_t i = 0; i < n; ++i)
-    for (std::size_t j = 0; j < 3; ++j)
-      x(i, j) = points[i][j];
+  // Eigen::Vector3d has no padding, so points can be written directly
+  // as an (n x 3) array
+  static_assert(sizeof(Eigen::Vector3d) == 3 * sizeof(double),
+                "Unexpected Eigen::Vector3d layout");
+  const std::int64_t n = points.size();
+  const std::int64_t offset = MPI::global_offset(_mpi_comm.comm(), n, true);
+  const std::array<std::int64_t, 2> range = {{offset, offset + n}};
+  const std::vector<std::int64_t> global_size
+      = {(std::int64_t)MPI::sum(_mpi_comm.comm(), n), 3};
+
+  // Ensure dataset starts with '/'
+  std::string dset_name(dataset_name);
+  if (dset_name[0] != '/')
+    dset_name = "/" + dataset_name;
 
   const bool mpi_io = _mpi_comm.size() > 1 ? true : false;
-  write_data(dataset_name, x, mpi_io);
+  HDF5Interface::write_dataset(_hdf5_file_id, dset_name, points[0].data(),
+                               range, global_size, mpi_io,
+                               get_dataset_options(dset_name));
 }
 //-----------------------------------------------------------------------------
 void HDF5File::write(const std::vector<double>& values,
@@ -136,7 +147,8 @@ void HDF5File::write(const la::PETScVector& x, const std::string dataset_name)
   const std::vector<std::int64_t> global_size(1, x.size());
   const bool mpi_io = _mpi_comm.size() > 1 ? true : false;
   HDF5Interface::write_dataset(_hdf5_file_id, dataset_name, x_ptr, local_range,
-                               global_size, mpi_io, chunking);
+                               global_size, mpi_io,
+                               get_dataset_options(dataset_name));
 
   ierr = VecRestoreArrayRead(x.vec(), &x_ptr);
   if (ierr != 0)
@@ -214,17 +226,14 @@ la::PETScVector HDF5File::read_vector(MPI_Comm comm,
   // Get local range
   const std::array<std::int64_t, 2> local_range = x.local_range();
 
-  // Read data from file
-  std::vector<PetscScalar> data = HDF5Interface::read_dataset<PetscScalar>(
-      _hdf5_file_id, dataset_name, local_range);
-
-  // Set data
+  // Read data from file directly into vector
   PetscErrorCode ierr;
   PetscScalar* x_ptr = nullptr;
   ierr = VecGetArray(x.vec(), &x_ptr);
   if (ierr != 0)
     la::petsc_error(ierr, __FILE__, "VecGetArray");
-  std::copy(data.begin(), data.end(), x_ptr);
+  HDF5Interface::read_dataset(_hdf5_file_id, dataset_name, local_range, x_ptr,
+                              local_range[1] - local_range[0]);
   ierr = VecRestoreArray(x.vec(), &x_ptr);
   if (ierr != 0)
     la::petsc_error(ierr, __FILE__, "VecRestoreArray");
@@ -259,27 +268,38 @@ void HDF5File::write(const mesh::Mesh& mesh, int cell_dim,
     // Write vertex data to HDF5 file
     const std::string coord_dataset = name + "/coordinates";
 
-    // Copy coordinates and indices and remove off-process values
+    // Reorder coordinates and remove off-process values in parallel.
+    // In serial, the geometry points are written directly.
     EigenRowArrayXXd _vertex_coords;
-    if (!mpi_io)
-      _vertex_coords = mesh.geometry().points();
-    else
+    const double* x = mesh.geometry().points().data();
+    std::int64_t num_points = mesh.geometry().points().rows();
+    if (mpi_io)
     {
       _vertex_coords = mesh::DistributedMeshTools::reorder_by_global_indices(
           mesh.mpi_comm(), mesh.geometry().points(),
           mesh.geometry().global_indices());
+      assert(_vertex_coords.cols() == 3);
+      x = _vertex_coords.data();
+      num_points = _vertex_coords.rows();
     }
 
-    Eigen::Map<
-        Eigen::Array<double, Eigen::Dynamic, 3, Eigen::RowMajor>>
-        varray(_vertex_coords.data(), _vertex_coords.size() / 3, 3);
-
-    Eigen::Array<double, Eigen::Dynamic, Eigen::Dynamic, Eigen::RowMajor>
-        vertex_coords(varray.rows(), gdim);
-    vertex_coords = varray.block(0, 0, varray.rows(), gdim);
-
-    // Write coordinates out from each process
-    write_data(coord_dataset, vertex_coords, mpi_io);
+    // Compute range
+    const std::int64_t offset
+        = MPI::global_offset(_mpi_comm.comm(), num_points, true);
+    const std::array<std::int64_t, 2> range = {{offset, offset + num_points}};
+    std::int64_t num_global_points = MPI::sum(_mpi_comm.comm(), num_points);
+    std::vector<std::int64_t> global_size = {num_global_points, gdim};
+    if (gdim == 1)
+      global_size = {num_global_points};
+
+    // Write first gdim columns of (num_points x 3) coordinate array
+    // from each process
+    std::string dset_name(coord_dataset);
+    if (dset_name[0] != '/')
+      dset_name = "/" + coord_dataset;
+    HDF5Interface::write_dataset(_hdf5_file_id, dset_name, x, range,
+                                 global_size, mpi_io,
+                                 get_dataset_options(dset_name), 3);
   }
 
   // ---------- Topology
@@ -1060,14 +1080,9 @@ void HDF5File::write(const mesh::MeshValueCollection<bool>& mesh_values,
   // HDF5 does not implement bool, use int and copy
 
   mesh::MeshValueCollection<int> mvc_int(mesh_values.mesh(), mesh_values.dim());
-  const std::map<std::pair<std::size_t, std::size_t>, bool>& values
-      = mesh_values.values();
-  for (auto mesh_value_it = values.begin(); mesh_value_it != values.end();
-       ++mesh_value_it)
-  {
-    mvc_int.set_value(mesh_value_it->first.first, mesh_value_it->first.second,
-                      mesh_value_it->second ? 1 : 0);
-  }
+  const std::vector<bool>& values = mesh_values.values();
+  mvc_int.set_values(mesh_values.cells(), mesh_values.local_entities(),
+                     std::vector<int>(values.begin(), values.end()));
 
   write_mesh_value_collection(mvc_int, name);
 }
@@ -1080,15 +1095,12 @@ HDF5File::read_mvc_bool(std::shared_ptr<const mesh::Mesh> mesh,
 
   auto mvc_int = read_mesh_value_collection<int>(mesh, name);
 
-  const std::map<std::pair<std::size_t, std::size_t>, int>& values
-      = mvc_int.values();
+  const std::vector<int>& values = mvc_int.values();
   mesh::MeshValueCollection<bool> mvc(mesh, mvc_int.dim());
-  for (auto mesh_value_it = values.begin(); mesh_value_it != values.end();
-       ++mesh_value_it)
-  {
-    mvc.set_value(mesh_value_it->first.first, mesh_value_it->first.second,
-                  (mesh_value_it->second != 0));
-  }
+  std::vector<bool> bool_values(values.size());
+  std::transform(values.begin(), values.end(), bool_values.begin(),
+                 [](int v) { return v != 0; });
+  mvc.set_values(mvc_int.cells(), mvc_int.local_entities(), bool_values);
 
   return mvc;
 }
@@ -1102,34 +1114,52 @@ void HDF5File::write_mesh_value_collection(
   const std::size_t dim = mesh_values.dim();
   std::shared_ptr<const mesh::Mesh> mesh = mesh_values.mesh();
 
-  const std::map<std::pair<std::size_t, std::size_t>, T>& values
-      = mesh_values.values();
+  const std::vector<std::int32_t>& cells = mesh_values.cells();
+  const std::vector<std::int32_t>& local_entities
+      = mesh_values.local_entities();
+  const std::vector<T>& values = mesh_values.values();
 
   std::unique_ptr<mesh::CellType> entity_type(
       mesh::CellType::create(mesh->type().entity_type(dim)));
   const std::size_t num_vertices_per_entity
       = (dim == 0) ? 1 : entity_type->num_vertices();
 
-  std::vector<std::size_t> topology;
-  std::vector<T> value_data;
-  topology.reserve(values.size() * num_vertices_per_entity);
-  value_data.reserve(values.size());
-
+  // Map (cell, local entity) to entity index
   const std::size_t tdim = mesh->topology().dim();
-  mesh->create_connectivity(tdim, dim);
-  for (auto& p : values)
+  std::vector<std::int32_t> entities(cells);
+  if (dim != tdim)
+  {
+    mesh->create_connectivity(tdim, dim);
+    const mesh::Connectivity& cell_entities
+        = *mesh->topology().connectivity(tdim, dim);
+    for (std::size_t i = 0; i < cells.size(); ++i)
+      entities[i] = cell_entities.connections(cells[i])[local_entities[i]];
+  }
+
+  // Global vertex indices of each entity
+  const std::vector<std::int64_t>& global_vertices
+      = mesh->topology().global_indices(0);
+  std::vector<std::size_t> topology(values.size() * num_vertices_per_entity);
+  if (dim == 0)
   {
-    mesh::MeshEntity cell = mesh::Cell(*mesh, p.first.first);
-    if (dim != tdim)
+    for (std::size_t i = 0; i < entities.size(); ++i)
+      topology[i] = global_vertices[entities[i]];
+  }
+  else
+  {
+    mesh->create_connectivity(dim, 0);
+    const mesh::Connectivity& entity_vertices
+        = *mesh->topology().connectivity(dim, 0);
+    for (std::size_t i = 0; i < entities.size(); ++i)
     {
-      const unsigned int entity_local_idx = cell.entities(dim)[p.first.second];
-      cell = mesh::MeshEntity(*mesh, dim, entity_local_idx);
+      const std::int32_t* vertices = entity_vertices.connections(entities[i]);
+      for (std::size_t j = 0; j < num_vertices_per_entity; ++j)
+      {
+        topology[i * num_vertices_per_entity + j]
+            = global_vertices[vertices[j]];
+      }
     }
-    for (auto& v : mesh::EntityRange<mesh::Vertex>(cell))
-      topology.push_back(v.global_index());
-    value_data.push_back(p.second);
   }
-
   const bool mpi_io = _mpi_comm.size() > 1 ? true : false;
   std::vector<std::int64_t> global_size(2);
 
@@ -1139,7 +1169,7 @@ void HDF5File::write_mesh_value_collection(
   write_data(name + "/topology", topology, global_size, mpi_io);
 
   global_size[1] = 1;
-  write_data(name + "/values", value_data, global_size, mpi_io);
+  write_data(name + "/values", values, global_size, mpi_io);
   HDF5Interface::add_attribute(_hdf5_file_id, name, "dimension",
                                mesh_values.dim());
 }
@@ -1311,14 +1341,20 @@ HDF5File::read_mesh_value_collection(std::shared_ptr<const mesh::Mesh> mesh,
   MPI::all_to_all(_mpi_comm.comm(), send_entities, recv_entities);
   MPI::all_to_all(_mpi_comm.comm(), send_data, recv_data);
 
-  mesh::MeshValueCollection<T> mvc(mesh, dim);
+  std::vector<std::int32_t> entities;
+  std::vector<T> entity_values;
   for (std::size_t i = 0; i != num_processes; ++i)
   {
     assert(recv_entities[i].size() == recv_data[i].size());
-    for (std::size_t j = 0; j != recv_data[i].size(); ++j)
-      mvc.set_value(recv_entities[i][j], recv_data[i][j]);
+    entities.insert(entities.end(), recv_entities[i].begin(),
+                    recv_entities[i].end());
+    entity_values.insert(entity_values.end(), recv_data[i].begin(),
+                         recv_data[i].end());
   }
 
+  mesh::MeshValueCollection<T> mvc(mesh, dim);
+  mvc.set_values(entities, entity_values);
+
   return mvc;
 }
 //-----------------------------------------------------------------------------
@@ -1565,12 +1601,10 @@ mesh::Mesh HDF5File::read_mesh(MPI_Comm comm, const std::string topology_path,
     vertex_data_range[1] *= gdim;
   }
 
-  // Read vertex data to temporary vector
-  std::vector<double> coordinates_data = HDF5Interface::read_dataset<double>(
-      _hdf5_file_id, geometry_path, vertex_data_range);
-  assert(coordinates_data.size() == num_local_points * gdim);
-  Eigen::Map<EigenRowArrayXXd> points(coordinates_data.data(), num_local_points,
-                                      gdim);
+  // Read vertex data directly into point array
+  EigenRowArrayXXd points(num_local_points, gdim);
+  HDF5Interface::read_dataset(_hdf5_file_id, geometry_path, vertex_data_range,
+                              points.data(), points.size());
 
   t.stop();
 
@@ -1597,3 +1631,38 @@ bool HDF5File::get_mpi_atomicity() const
   return HDF5Interface::get_mpi_atomicity(_hdf5_file_id);
 }
 //-----------------------------------------------------------------------------
+void HDF5File::set_dataset_options(const std::string name,
+                                   const HDF5Interface::DatasetOptions& options)
+{
+  // Store with leading '/' and no trailing '/'
+  std::string path = (name.empty() or name[0] != '/') ? "/" + name : name;
+  if (path.size() > 1 and path.back() == '/')
+    path.pop_back();
+  _dataset_options[path] = options;
+}
+//-----------------------------------------------------------------------------
+const HDF5Interface::DatasetOptions&
+HDF5File::get_dataset_options(const std::string dataset_name) const
+{
+  if (_dataset_options.empty())
+    return dataset_options;
+
+  // Search dataset path, then parent groups up to the root
+  std::string path = (dataset_name.empty() or dataset_name[0] != '/')
+                         ? "/" + dataset_name
+                         : dataset_name;
+  while (!path.empty())
+  {
+    auto it = _dataset_options.find(path);
+    if (it != _dataset_options.end())
+      return it->second;
+
+    if (path == "/")
+      break;
+    const std::size_t pos = path.rfind('/');
+    path = (pos == 0) ? "/" : path.substr(0, pos);
+  }
+
+  return dataset_options;
+}
+//-----------------------------------------------------------------------------
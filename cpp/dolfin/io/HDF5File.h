@@ -13,6 +13,7 @@
 #include <dolfin/mesh/Mesh.h>
 #include <dolfin/mesh/MeshFunction.h>
 #include <dolfin/mesh/MeshValueCollection.h>
+#include <map>
 #include <memory>
 #include <string>
 #include <utility>
@@ -198,8 +199,15 @@ public:
   /// Get the file ID
   hid_t h5_id() const { return _hdf5_file_id; }
 
-  // FIXME: document
-  bool chunking = false;
+  /// Set storage options (chunking and compression) for the dataset
+  /// or group 'name'. Options set for a group apply to all datasets
+  /// below it, e.g. all datasets of a Function written to 'name'.
+  void set_dataset_options(const std::string name,
+                           const HDF5Interface::DatasetOptions& options);
+
+  /// Default storage options (chunking and compression) for datasets
+  /// written to this file
+  HDF5Interface::DatasetOptions dataset_options;
 
 private:
   // Friend
@@ -229,6 +237,11 @@ private:
   read_mesh_value_collection(std::shared_ptr<const mesh::Mesh> mesh,
                              const std::string name) const;
 
+  // Get storage options for a dataset, looking up the dataset path and
+  // then its parent groups before falling back to the file default
+  const HDF5Interface::DatasetOptions&
+  get_dataset_options(const std::string dataset_name) const;
+
   // Write contiguous data to HDF5 data set. Data is flattened into
   // a 1D array, e.g. [x0, y0, z0, x1, y1, z1] for a vector in 3D
   template <typename T>
@@ -246,6 +259,9 @@ private:
   // HDF5 file descriptor/handle
   hid_t _hdf5_file_id;
 
+  // Storage options for named datasets and groups
+  std::map<std::string, HDF5Interface::DatasetOptions> _dataset_options;
+
   // MPI communicator
   dolfin::MPI::Comm _mpi_comm;
 };
@@ -278,7 +294,8 @@ void HDF5File::write_data(const std::string dataset_name,
     dset_name = "/" + dataset_name;
 
   HDF5Interface::write_dataset(_hdf5_file_id, dset_name, data.data(), range,
-                               global_size, use_mpi_io, chunking);
+                               global_size, use_mpi_io,
+                               get_dataset_options(dset_name));
 }
 //-----------------------------------------------------------------------------
 template <typename T>
@@ -305,7 +322,8 @@ void HDF5File::write_data(
     global_size = {global_rows};
 
   HDF5Interface::write_dataset(_hdf5_file_id, dset_name, data.data(), range,
-                               global_size, use_mpi_io, chunking);
+                               global_size, use_mpi_io,
+                               get_dataset_options(dset_name));
 }
 //---------------------------------------------------------------------------
 } // namespace io
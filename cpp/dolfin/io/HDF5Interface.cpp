@@ -6,14 +6,48 @@
 
 #include "HDF5Interface.h"
 #include "HDF5File.h"
+#include <algorithm>
 #include <boost/filesystem.hpp>
 #include <dolfin/common/MPI.h>
 
 #define HDF5_MAXSTRLEN 80
 
+// Registered ids of the LZ4 and Zstandard HDF5 filter plugins, see
+// https://portal.hdfgroup.org/display/support/Registered+Filter+Plugins
+#define HDF5_FILTER_LZ4 32004
+#define HDF5_FILTER_ZSTD 32015
+
 using namespace dolfin;
 using namespace dolfin::io;
 
+namespace
+{
+//-----------------------------------------------------------------------------
+// Add a (possibly third-party) filter to a dataset creation property
+// list, checking that the filter is available
+void set_filter(hid_t dcpl, H5Z_filter_t filter, const std::string name,
+                const std::vector<unsigned int>& cd_values)
+{
+  const htri_t avail = H5Zfilter_avail(filter);
+  if (avail < 0)
+    throw std::runtime_error("Call to H5Zfilter_avail unsuccessful");
+  else if (avail == 0)
+  {
+    throw std::runtime_error("HDF5 filter '" + name
+                             + "' is not available. Check that the filter "
+                               "plugin is installed and on HDF5_PLUGIN_PATH.");
+  }
+
+  if (H5Pset_filter(dcpl, filter, H5Z_FLAG_MANDATORY, cd_values.size(),
+                    cd_values.data())
+      < 0)
+  {
+    throw std::runtime_error("Failed to set HDF5 filter '" + name + "'");
+  }
+}
+//-----------------------------------------------------------------------------
+} // namespace
+
 //-----------------------------------------------------------------------------
 hid_t HDF5Interface::open_file(MPI_Comm mpi_comm, const std::string filename,
                                const std::string mode, const bool use_mpi_io)
@@ -73,6 +107,143 @@ hid_t HDF5Interface::open_file(MPI_Comm mpi_comm, const std::string filename,
   return file_id;
 }
 //-----------------------------------------------------------------------------
+hid_t HDF5Interface::create_dataset_properties(
+    const std::vector<hsize_t>& dims, bool is_float, bool use_mpi_io,
+    const DatasetOptions& options)
+{
+  const std::size_t rank = dims.size();
+  assert(rank > 0);
+
+  // Chunks cannot be defined for empty datasets
+  const bool use_chunking = options.chunking or options.has_filters();
+  if (!use_chunking or dims[0] == 0)
+    return H5P_DEFAULT;
+
+  if (use_mpi_io and options.has_filters())
+  {
+#if !defined(H5_HAVE_PARALLEL) || !H5_VERSION_GE(1, 10, 2)
+    throw std::runtime_error("Writing compressed HDF5 datasets in parallel "
+                             "requires parallel HDF5 1.10.2 or later");
+#endif
+  }
+
+  // Compute chunk shape
+  std::vector<hsize_t> chunk_dims(dims.begin(), dims.end());
+  if (options.chunk_shape.empty())
+  {
+    // Default to half the rows, limited to 1k-1M rows
+    hsize_t chunk_size = dims[0] / 2;
+    if (chunk_size > 1048576)
+      chunk_size = 1048576;
+    if (chunk_size < 1024)
+      chunk_size = 1024;
+    chunk_dims[0] = chunk_size;
+  }
+  else
+  {
+    if (options.chunk_shape.size() > rank)
+      throw std::runtime_error("HDF5 chunk shape rank exceeds dataset rank");
+    for (std::size_t i = 0; i < options.chunk_shape.size(); ++i)
+    {
+      if (options.chunk_shape[i] < 1)
+        throw std::runtime_error("HDF5 chunk dimensions must be positive");
+      chunk_dims[i] = options.chunk_shape[i];
+    }
+  }
+
+  // Chunks may not be larger than a fixed-size dataset
+  for (std::size_t i = 0; i < rank; ++i)
+    chunk_dims[i] = std::max<hsize_t>(1, std::min(chunk_dims[i], dims[i]));
+
+  const hid_t dcpl = H5Pcreate(H5P_DATASET_CREATE);
+  if (dcpl < 0)
+    throw std::runtime_error("Failed to create HDF5 property list");
+
+  // Close the property list if any property cannot be set, e.g. if a
+  // filter plugin is not available
+  try
+  {
+    if (H5Pset_chunk(dcpl, rank, chunk_dims.data()) < 0)
+      throw std::runtime_error("Failed to set HDF5 chunk shape");
+
+    // Lossy scale-offset filter goes first, so that the shuffle and
+    // compression filters act on the truncated values
+    if (is_float and options.scale_offset_digits >= 0)
+    {
+      if (H5Pset_scaleoffset(dcpl, H5Z_SO_FLOAT_DSCALE,
+                             options.scale_offset_digits)
+          < 0)
+      {
+        throw std::runtime_error("Failed to set HDF5 scale-offset filter");
+      }
+    }
+
+    if (options.shuffle)
+    {
+      if (H5Pset_shuffle(dcpl) < 0)
+        throw std::runtime_error("Failed to set HDF5 shuffle filter");
+    }
+
+    switch (options.compression)
+    {
+    case Compression::none:
+      break;
+    case Compression::deflate:
+      if (H5Pset_deflate(dcpl, options.compression_level) < 0)
+        throw std::runtime_error("Failed to set HDF5 deflate filter");
+      break;
+    case Compression::lz4:
+      set_filter(dcpl, HDF5_FILTER_LZ4, "lz4", {});
+      break;
+    case Compression::zstd:
+      set_filter(dcpl, HDF5_FILTER_ZSTD, "zstd",
+                 {(unsigned int)options.compression_level});
+      break;
+    }
+  }
+  catch (...)
+  {
+    H5Pclose(dcpl);
+    throw;
+  }
+
+  return dcpl;
+}
+//-----------------------------------------------------------------------------
+hid_t HDF5Interface::create_memory_dataspace(const std::vector<hsize_t>& count,
+                                             std::int64_t row_stride)
+{
+  assert(!count.empty());
+  const hsize_t num_cols = count.size() > 1 ? count[1] : 1;
+
+  // Contiguous block
+  if (row_stride == -1 or row_stride == (std::int64_t)num_cols)
+  {
+    const hid_t memspace = H5Screate_simple(count.size(), count.data(), NULL);
+    assert(memspace != HDF5_FAIL);
+    return memspace;
+  }
+
+  if (count.size() > 2)
+  {
+    throw std::runtime_error(
+        "Strided HDF5 data is only supported for rank 1 and rank 2 datasets");
+  }
+
+  // Strided rows: select leading columns of a wider array
+  assert(row_stride > (std::int64_t)num_cols);
+  const std::array<hsize_t, 2> dims = {{count[0], (hsize_t)row_stride}};
+  const std::array<hsize_t, 2> block = {{count[0], num_cols}};
+  const std::array<hsize_t, 2> offset = {{0, 0}};
+  const hid_t memspace = H5Screate_simple(2, dims.data(), NULL);
+  assert(memspace != HDF5_FAIL);
+  herr_t status = H5Sselect_hyperslab(memspace, H5S_SELECT_SET, offset.data(),
+                                      NULL, block.data(), NULL);
+  assert(status != HDF5_FAIL);
+
+  return memspace;
+}
+//-----------------------------------------------------------------------------
 void HDF5Interface::close_file(const hid_t hdf5_file_handle)
 {
   if (H5Fclose(hdf5_file_handle) < 0)
@@ -8,6 +8,7 @@
 
 #include <cstdint>
 #include <string>
+#include <type_traits>
 #include <vector>
 
 // Note: dolfin/common/MPI.h is included before hdf5.h to avoid the
@@ -32,6 +33,52 @@ class HDF5Interface
 {
 #define HDF5_FAIL -1
 public:
+  /// Compression filter applied to chunked datasets. LZ4 and Zstd are
+  /// provided by the registered HDF5 filter plugins (filter ids 32004
+  /// and 32015) and must be available at runtime.
+  enum class Compression
+  {
+    none,
+    deflate,
+    lz4,
+    zstd
+  };
+
+  /// Storage layout and filter options used when creating a dataset
+  struct DatasetOptions
+  {
+    /// Use chunked storage. Chunking is switched on automatically if
+    /// any filter is requested.
+    bool chunking = false;
+
+    /// Chunk shape. If empty, the chunk shape is computed from the
+    /// dataset shape. The first entry is the number of rows per chunk,
+    /// and any further entries must match the dataset shape.
+    std::vector<std::int64_t> chunk_shape;
+
+    /// Compression filter
+    Compression compression = Compression::none;
+
+    /// Compression level passed to the filter (deflate: 0-9, zstd:
+    /// 1-22, ignored for lz4)
+    int compression_level = 4;
+
+    /// Apply the byte shuffle filter before compression
+    bool shuffle = false;
+
+    /// Number of decimal digits to keep with the lossy scale-offset
+    /// filter for floating-point data. Negative values disable the
+    /// filter. Ignored for integer data.
+    int scale_offset_digits = -1;
+
+    /// Return true if any filter is requested
+    bool has_filters() const
+    {
+      return compression != Compression::none or shuffle
+             or scale_offset_digits >= 0;
+    }
+  };
+
   /// Open HDF5 and return file descriptor
   static hid_t open_file(MPI_Comm mpi_comm, const std::string filename,
                          const std::string mode, const bool use_mpi_io);
@@ -52,13 +99,18 @@ public:
   /// range: the local range on this processor
   /// global_size: the global multidimensional shape of the array
   /// use_mpio: whether using MPI or not
-  /// use_chunking: whether using chunking or not
+  /// options: chunking and compression options for the dataset
+  /// row_stride: distance between the start of consecutive rows in
+  /// data (if -1, rows are contiguous). This allows
+  /// a leading block of columns of a row-major array to be written
+  /// without copying.
   template <typename T>
   static void write_dataset(const hid_t file_handle,
                             const std::string dataset_path, const T* data,
                             const std::array<std::int64_t, 2> range,
                             const std::vector<std::int64_t> global_size,
-                            bool use_mpio, bool use_chunking);
+                            bool use_mpio, const DatasetOptions& options,
+                            std::int64_t row_stride = -1);
 
   /// Read data from a HDF5 dataset "dataset_path" as defined by
   /// range blocks on each process range: the local range on this
@@ -69,6 +121,18 @@ public:
                                      const std::string dataset_path,
                                      const std::array<std::int64_t, 2> range);
 
+  /// Read data from a HDF5 dataset "dataset_path" as defined by range
+  /// blocks on each process directly into the caller-owned buffer data
+  /// of length size, without an intermediate copy. If range = {-1, -1},
+  /// then all data is read on this process. row_stride is the distance
+  /// between the start of consecutive rows in data (if -1, rows are
+  /// contiguous).
+  template <typename T>
+  static void read_dataset(const hid_t file_handle,
+                           const std::string dataset_path,
+                           const std::array<std::int64_t, 2> range, T* data,
+                           std::size_t size, std::int64_t row_stride = -1);
+
   /// Check for existence of group in HDF5 file
   static bool has_group(const hid_t hdf5_file_handle,
                         const std::string group_name);
@@ -94,6 +158,14 @@ public:
   get_dataset_shape(const hid_t hdf5_file_handle,
                     const std::string dataset_path);
 
+  /// Get byte offset in the file of the raw data of a dataset with
+  /// contiguous (unchunked, unfiltered) storage in the native layout of
+  /// type T. Returns -1 if the dataset is not stored contiguously, has
+  /// not been allocated or is stored with a different type.
+  template <typename T>
+  static std::int64_t get_contiguous_offset(const hid_t hdf5_file_handle,
+                                            const std::string dataset_path);
+
   /// Return list all datasets in named group of file
   static std::vector<std::string> dataset_list(const hid_t hdf5_file_handle,
                                                const std::string group_name);
@@ -145,6 +217,19 @@ public:
   static bool get_mpi_atomicity(const hid_t hdf5_file_handle);
 
 private:
+  // Create a dataset creation property list with chunking and filters
+  // set from options. Returns H5P_DEFAULT if the dataset is not
+  // chunked.
+  static hid_t create_dataset_properties(const std::vector<hsize_t>& dims,
+                                         bool is_float, bool use_mpi_io,
+                                         const DatasetOptions& options);
+
+  // Create a memory dataspace for a local block of shape count. If
+  // row_stride != -1, the dataspace has row_stride columns with the
+  // leading columns of the block selected.
+  static hid_t create_memory_dataspace(const std::vector<hsize_t>& count,
+                                       std::int64_t row_stride);
+
   static herr_t attribute_iteration_function(hid_t loc_id, const char* name,
                                              const H5A_info_t* info, void* str);
 
@@ -217,7 +302,8 @@ template <typename T>
 inline void HDF5Interface::write_dataset(
     const hid_t file_handle, const std::string dataset_path, const T* data,
     const std::array<std::int64_t, 2> range,
-    const std::vector<int64_t> global_size, bool use_mpi_io, bool use_chunking)
+    const std::vector<int64_t> global_size, bool use_mpi_io,
+    const DatasetOptions& options, std::int64_t row_stride)
 {
   // Data rank
   const std::size_t rank = global_size.size();
@@ -250,23 +336,9 @@ inline void HDF5Interface::write_dataset(
   const hid_t filespace0 = H5Screate_simple(rank, dimsf.data(), NULL);
   assert(filespace0 != HDF5_FAIL);
 
-  // Set chunking parameters
-  hid_t chunking_properties;
-  if (use_chunking)
-  {
-    // Set chunk size and limit to 1kB min/1MB max
-    hsize_t chunk_size = dimsf[0] / 2;
-    if (chunk_size > 1048576)
-      chunk_size = 1048576;
-    if (chunk_size < 1024)
-      chunk_size = 1024;
-
-    hsize_t chunk_dims[2] = {chunk_size, dimsf[1]};
-    chunking_properties = H5Pcreate(H5P_DATASET_CREATE);
-    H5Pset_chunk(chunking_properties, rank, chunk_dims);
-  }
-  else
-    chunking_properties = H5P_DEFAULT;
+  // Set chunking and filter parameters
+  const hid_t chunking_properties = create_dataset_properties(
+      dimsf, std::is_floating_point<T>::value, use_mpi_io, options);
 
   // Check that group exists and recursively create if required
   const std::string group_name(dataset_path, 0, dataset_path.rfind('/'));
@@ -282,9 +354,9 @@ inline void HDF5Interface::write_dataset(
   status = H5Sclose(filespace0);
   assert(status != HDF5_FAIL);
 
-  // Create a local data space
-  const hid_t memspace = H5Screate_simple(rank, count.data(), NULL);
-  assert(memspace != HDF5_FAIL);
+  // Create a local data space, selecting the leading columns if rows
+  // are strided
+  const hid_t memspace = create_memory_dataspace(count, row_stride);
 
   // Create a file dataspace within the global space - a hyperslab
   const hid_t filespace1 = H5Dget_space(dset_id);
@@ -308,7 +380,7 @@ inline void HDF5Interface::write_dataset(
   status = H5Dwrite(dset_id, h5type, memspace, filespace1, plist_id, data);
   assert(status != HDF5_FAIL);
 
-  if (use_chunking)
+  if (chunking_properties != H5P_DEFAULT)
   {
     // Close chunking properties
     status = H5Pclose(chunking_properties);
@@ -337,6 +409,32 @@ inline std::vector<T>
 HDF5Interface::read_dataset(const hid_t file_handle,
                             const std::string dataset_path,
                             const std::array<std::int64_t, 2> range)
+{
+  // Compute size of local block
+  const std::vector<std::int64_t> shape
+      = get_dataset_shape(file_handle, dataset_path);
+  assert(!shape.empty());
+  std::size_t data_size = 1;
+  for (std::size_t i = 1; i < shape.size(); ++i)
+    data_size *= shape[i];
+  if (range[0] != -1 and range[1] != -1)
+    data_size *= range[1] - range[0];
+  else
+    data_size *= shape[0];
+
+  // Create local data and read into it
+  std::vector<T> data(data_size);
+  read_dataset(file_handle, dataset_path, range, data.data(), data.size());
+
+  return data;
+}
+//---------------------------------------------------------------------------
+template <typename T>
+inline void HDF5Interface::read_dataset(const hid_t file_handle,
+                                        const std::string dataset_path,
+                                        const std::array<std::int64_t, 2> range,
+                                        T* data, std::size_t size,
+                                        std::int64_t row_stride)
 {
   // Open the dataset
   const hid_t dset_id
@@ -372,6 +470,21 @@ HDF5Interface::read_dataset(const hid_t file_handle,
   else
     offset[0] = 0;
 
+  // Check that the buffer is large enough
+  std::size_t data_size = count[0];
+  if (row_stride != -1)
+    data_size *= row_stride;
+  else
+  {
+    for (std::size_t i = 1; i < count.size(); ++i)
+      data_size *= count[i];
+  }
+  if (size < data_size)
+  {
+    throw std::runtime_error("Cannot read dataset \"" + dataset_path
+                             + "\" from HDF5 file. Buffer is too small");
+  }
+
   // Select a block in the dataset beginning at offset[], with
   // size=count[]
   herr_t status = H5Sselect_hyperslab(dataspace, H5S_SELECT_SET, offset.data(),
@@ -379,19 +492,11 @@ HDF5Interface::read_dataset(const hid_t file_handle,
   assert(status != HDF5_FAIL);
 
   // Create a memory dataspace
-  const hid_t memspace = H5Screate_simple(rank, count.data(), NULL);
-  assert(memspace != HDF5_FAIL);
-
-  // Create local data to read into
-  std::size_t data_size = 1;
-  for (std::size_t i = 0; i < count.size(); ++i)
-    data_size *= count[i];
-  std::vector<T> data(data_size);
+  const hid_t memspace = create_memory_dataspace(count, row_stride);
 
   // Read data on each process
   const hid_t h5type = hdf5_type<T>();
-  status
-      = H5Dread(dset_id, h5type, memspace, dataspace, H5P_DEFAULT, data.data());
+  status = H5Dread(dset_id, h5type, memspace, dataspace, H5P_DEFAULT, data);
   assert(status != HDF5_FAIL);
 
   // Close dataspace
@@ -405,8 +510,47 @@ HDF5Interface::read_dataset(const hid_t file_handle,
   // Close dataset
   status = H5Dclose(dset_id);
   assert(status != HDF5_FAIL);
+}
+//---------------------------------------------------------------------------
+template <typename T>
+inline std::int64_t
+HDF5Interface::get_contiguous_offset(const hid_t hdf5_file_handle,
+                                     const std::string dataset_path)
+{
+  // Open the dataset
+  const hid_t dset_id
+      = H5Dopen2(hdf5_file_handle, dataset_path.c_str(), H5P_DEFAULT);
+  assert(dset_id != HDF5_FAIL);
 
-  return data;
+  // Check storage layout
+  const hid_t dcpl = H5Dget_create_plist(dset_id);
+  assert(dcpl != HDF5_FAIL);
+  const bool contiguous = (H5Pget_layout(dcpl) == H5D_CONTIGUOUS)
+                          and (H5Pget_external_count(dcpl) == 0);
+  herr_t status = H5Pclose(dcpl);
+  assert(status != HDF5_FAIL);
+
+  // Check that data is stored with native type
+  const hid_t dtype = H5Dget_type(dset_id);
+  assert(dtype != HDF5_FAIL);
+  const bool native = H5Tequal(dtype, hdf5_type<T>()) > 0;
+  status = H5Tclose(dtype);
+  assert(status != HDF5_FAIL);
+
+  // Get offset (undefined if storage has not been allocated)
+  std::int64_t offset = -1;
+  if (contiguous and native)
+  {
+    const haddr_t addr = H5Dget_offset(dset_id);
+    if (addr != HADDR_UNDEF)
+      offset = addr;
+  }
+
+  // Close dataset
+  status = H5Dclose(dset_id);
+  assert(status != HDF5_FAIL);
+
+  return offset;
 }
 //---------------------------------------------------------------------------
 template <typename T>
@@ -0,0 +1,278 @@
+// Copyright (C) 2026 agent
+//
+// This file is part of DOLFIN (https://www.fenicsproject.org)
+//
+// SPDX-License-Identifier:    LGPL-3.0-or-later
+
+#include "HDF5MappedFile.h"
+#include <dolfin/common/MPI.h>
+#include <dolfin/common/Timer.h>
+#include <dolfin/fem/GenericDofMap.h>
+#include <dolfin/function/Function.h>
+#include <dolfin/function/FunctionSpace.h>
+#include <dolfin/la/PETScVector.h>
+#include <dolfin/la/utils.h>
+#include <dolfin/mesh/Mesh.h>
+#include <dolfin/mesh/Partitioning.h>
+#include <fcntl.h>
+#include <functional>
+#include <numeric>
+#include <petscvec.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+using namespace dolfin;
+using namespace dolfin::io;
+
+namespace
+{
+// Destroy shared pointer to the mapping held by a PetscContainer
+PetscErrorCode destroy_mapping(void* ctx)
+{
+  delete static_cast<std::shared_ptr<char>*>(ctx);
+  return 0;
+}
+} // namespace
+
+//-----------------------------------------------------------------------------
+HDF5MappedFile::HDF5MappedFile(const std::string filename)
+    : _hdf5_file_id(0), _mapped_size(0)
+{
+  // Open file with HDF5 to read metadata
+  _hdf5_file_id
+      = HDF5Interface::open_file(MPI_COMM_SELF, filename, "r", false);
+  assert(_hdf5_file_id > 0);
+
+  // Map file. Pages are mapped private and writable so that views can
+  // be handed to PETSc, with any modifications kept in memory.
+  const int fd = ::open(filename.c_str(), O_RDONLY);
+  if (fd == -1)
+    throw std::runtime_error("Unable to open file " + filename);
+  struct stat sb;
+  if (fstat(fd, &sb) == -1)
+  {
+    ::close(fd);
+    throw std::runtime_error("Unable to get size of file " + filename);
+  }
+  _mapped_size = sb.st_size;
+  void* p = mmap(nullptr, _mapped_size, PROT_READ | PROT_WRITE, MAP_PRIVATE,
+                 fd, 0);
+  ::close(fd);
+  if (p == MAP_FAILED)
+    throw std::runtime_error("Unable to map file " + filename);
+  const std::size_t size = _mapped_size;
+  _mapped_data = std::shared_ptr<char>(
+      static_cast<char*>(p), [size](char* p) { munmap(p, size); });
+}
+//-----------------------------------------------------------------------------
+HDF5MappedFile::~HDF5MappedFile()
+{
+  if (_hdf5_file_id > 0)
+    HDF5Interface::close_file(_hdf5_file_id);
+}
+//-----------------------------------------------------------------------------
+template <typename T>
+T* HDF5MappedFile::data(const std::string dataset_path,
+                        std::vector<std::int64_t>& shape) const
+{
+  if (!HDF5Interface::has_dataset(_hdf5_file_id, dataset_path))
+  {
+    throw std::runtime_error("Dataset \"" + dataset_path
+                             + "\" not found in HDF5 file");
+  }
+
+  shape = HDF5Interface::get_dataset_shape(_hdf5_file_id, dataset_path);
+  if (shape.empty() or shape.size() > 2)
+  {
+    throw std::runtime_error("Cannot map dataset \"" + dataset_path
+                             + "\". Only rank 1 and rank 2 datasets are "
+                               "supported");
+  }
+
+  const std::int64_t size
+      = std::accumulate(shape.begin(), shape.end(), std::int64_t(1),
+                        std::multiplies<std::int64_t>());
+  if (size == 0)
+    return nullptr;
+
+  const std::int64_t offset
+      = HDF5Interface::get_contiguous_offset<T>(_hdf5_file_id, dataset_path);
+  if (offset < 0)
+  {
+    throw std::runtime_error(
+        "Cannot map dataset \"" + dataset_path
+        + "\". Dataset is chunked, filtered or not of the requested type");
+  }
+  if (offset % alignof(T) != 0)
+  {
+    throw std::runtime_error("Cannot map dataset \"" + dataset_path
+                             + "\". Data is not aligned in file");
+  }
+  assert(offset + size * sizeof(T) <= _mapped_size);
+
+  return reinterpret_cast<T*>(_mapped_data.get() + offset);
+}
+//-----------------------------------------------------------------------------
+template <typename T>
+Eigen::Map<
+    const Eigen::Array<T, Eigen::Dynamic, Eigen::Dynamic, Eigen::RowMajor>>
+HDF5MappedFile::dataset(const std::string dataset_path) const
+{
+  std::vector<std::int64_t> shape;
+  const T* x = data<T>(dataset_path, shape);
+  const std::int64_t cols = shape.size() == 2 ? shape[1] : 1;
+  return Eigen::Map<const Eigen::Array<T, Eigen::Dynamic, Eigen::Dynamic,
+                                       Eigen::RowMajor>>(x, shape[0], cols);
+}
+//-----------------------------------------------------------------------------
+mesh::Mesh HDF5MappedFile::read_mesh(const std::string data_path,
+                                     const mesh::GhostMode ghost_mode) const
+{
+  common::Timer t("HDF5: read mapped mesh");
+
+  // Get cell type
+  const std::string topology_path = data_path + "/topology";
+  if (!HDF5Interface::has_attribute(_hdf5_file_id, topology_path, "celltype"))
+  {
+    throw std::runtime_error("Cannot read mesh. Cell type attribute not "
+                             "found for dataset \""
+                             + topology_path + "\"");
+  }
+  const mesh::CellType::Type cell_type
+      = mesh::CellType::string2type(HDF5Interface::get_attribute<std::string>(
+          _hdf5_file_id, topology_path, "celltype"));
+
+  // Views of topology and coordinates
+  auto cells = dataset<std::int64_t>(topology_path);
+  auto points = dataset<double>(data_path + "/coordinates");
+
+  // Global cell indices
+  std::vector<std::int64_t> global_cell_indices;
+  const std::string cell_indices_path = data_path + "/cell_indices";
+  if (HDF5Interface::has_dataset(_hdf5_file_id, cell_indices_path))
+  {
+    auto indices = dataset<std::int64_t>(cell_indices_path);
+    global_cell_indices.assign(indices.data(),
+                               indices.data() + indices.size());
+  }
+  else
+  {
+    global_cell_indices.resize(cells.rows());
+    std::iota(global_cell_indices.begin(), global_cell_indices.end(), 0);
+  }
+
+  return mesh::Partitioning::build_distributed_mesh(
+      MPI_COMM_SELF, cell_type, points, cells, global_cell_indices,
+      ghost_mode);
+}
+//-----------------------------------------------------------------------------
+la::PETScVector HDF5MappedFile::read_vector(const std::string dataset_path) const
+{
+  std::vector<std::int64_t> shape;
+  PetscScalar* x = data<PetscScalar>(dataset_path, shape);
+  if (shape.size() == 2 and shape[1] != 1)
+  {
+    throw std::runtime_error("Cannot read vector from dataset \""
+                             + dataset_path + "\". Dataset is not rank 1");
+  }
+
+  // Create vector using the mapped values as its storage
+  Vec _x;
+  PetscErrorCode ierr
+      = VecCreateSeqWithArray(PETSC_COMM_SELF, 1, shape[0], x, &_x);
+  if (ierr != 0)
+    la::petsc_error(ierr, __FILE__, "VecCreateSeqWithArray");
+
+  // Attach a shared pointer to the mapping to the vector, so that the
+  // mapping outlives this file if the vector does
+  PetscContainer container;
+  ierr = PetscContainerCreate(PETSC_COMM_SELF, &container);
+  if (ierr != 0)
+    la::petsc_error(ierr, __FILE__, "PetscContainerCreate");
+  PetscContainerSetPointer(container, new std::shared_ptr<char>(_mapped_data));
+  PetscContainerSetUserDestroy(container, destroy_mapping);
+  ierr = PetscObjectCompose((PetscObject)_x, "dolfin_mapped_file",
+                            (PetscObject)container);
+  if (ierr != 0)
+    la::petsc_error(ierr, __FILE__, "PetscObjectCompose");
+  PetscContainerDestroy(&container);
+
+  return la::PETScVector(_x, false);
+}
+//-----------------------------------------------------------------------------
+function::Function
+HDF5MappedFile::read(std::shared_ptr<const function::FunctionSpace> V,
+                     const std::string name) const
+{
+  common::Timer t("HDF5: read mapped function::Function");
+
+  assert(V);
+  assert(V->mesh());
+  assert(V->dofmap());
+  const mesh::Mesh& mesh = *V->mesh();
+  const fem::GenericDofMap& dofmap = *V->dofmap();
+  if (MPI::size(mesh.mpi_comm()) != 1)
+  {
+    throw std::runtime_error(
+        "Mapped function reading is only supported in serial");
+  }
+
+  // Views of cell dofmap, cell ordering and values
+  auto cells = dataset<std::size_t>(name + "/cells");
+  auto x_cell_dofs = dataset<std::size_t>(name + "/x_cell_dofs");
+  auto cell_dofs = dataset<PetscInt>(name + "/cell_dofs");
+  auto values = dataset<PetscScalar>(name + "/vector_0");
+
+  // Position in file of each cell (by global index)
+  const int tdim = mesh.topology().dim();
+  const std::int64_t num_cells = mesh.topology().ghost_offset(tdim);
+  if (cells.rows() != num_cells)
+  {
+    throw std::runtime_error("Cannot read function::Function from file. "
+                             "Number of cells does not match.");
+  }
+  std::vector<std::int32_t> cell_position(num_cells);
+  for (std::int64_t i = 0; i < num_cells; ++i)
+  {
+    if (cells(i, 0) >= (std::size_t)num_cells)
+    {
+      throw std::runtime_error("Cannot read function::Function from file. "
+                               "Cell index out of range.");
+    }
+    cell_position[cells(i, 0)] = i;
+  }
+
+  // Copy values into Function vector
+  function::Function u(V);
+  la::VecWrapper x(u.vector().vec());
+  const std::vector<std::int64_t>& global_cells
+      = mesh.topology().global_indices(tdim);
+  for (std::int64_t c = 0; c < num_cells; ++c)
+  {
+    const std::int32_t p = cell_position[global_cells[c]];
+    auto dofs = dofmap.cell_dofs(c);
+    const std::size_t offset = x_cell_dofs(p, 0);
+    assert((Eigen::Index)(x_cell_dofs(p + 1, 0) - offset) == dofs.size());
+    for (Eigen::Index j = 0; j < dofs.size(); ++j)
+      x.x[dofs[j]] = values(cell_dofs(offset + j, 0), 0);
+  }
+  x.restore();
+
+  return u;
+}
+//-----------------------------------------------------------------------------
+// Explicit instantiation
+template Eigen::Map<const Eigen::Array<double, Eigen::Dynamic, Eigen::Dynamic,
+                                       Eigen::RowMajor>>
+HDF5MappedFile::dataset<double>(const std::string) const;
+template Eigen::Map<const Eigen::Array<std::int64_t, Eigen::Dynamic,
+                                       Eigen::Dynamic, Eigen::RowMajor>>
+HDF5MappedFile::dataset<std::int64_t>(const std::string) const;
+template Eigen::Map<const Eigen::Array<std::size_t, Eigen::Dynamic,
+                                       Eigen::Dynamic, Eigen::RowMajor>>
+HDF5MappedFile::dataset<std::size_t>(const std::string) const;
+template Eigen::Map<
+    const Eigen::Array<int, Eigen::Dynamic, Eigen::Dynamic, Eigen::RowMajor>>
+HDF5MappedFile::dataset<int>(const std::string) const;
+//-----------------------------------------------------------------------------
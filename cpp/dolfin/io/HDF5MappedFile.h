@@ -0,0 +1,105 @@
+// Copyright (C) 2026 agent
+//
+// This file is part of DOLFIN (https://www.fenicsproject.org)
+//
+// SPDX-License-Identifier:    LGPL-3.0-or-later
+
+#pragma once
+
+#include "HDF5Interface.h"
+#include <Eigen/Dense>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace dolfin
+{
+namespace function
+{
+class Function;
+class FunctionSpace;
+} // namespace function
+
+namespace la
+{
+class PETScVector;
+}
+
+namespace mesh
+{
+class Mesh;
+enum class GhostMode : int;
+} // namespace mesh
+
+namespace io
+{
+
+/// Read-only, memory-mapped access to HDF5 files on a single process.
+///
+/// Datasets with contiguous (unchunked, uncompressed) storage are
+/// exposed as views on the mapped file, so opening a file is
+/// independent of its size and pages are only read from disk when
+/// they are accessed. Datasets written by HDF5File are contiguous
+/// unless chunking or compression has been enabled.
+///
+/// The file is mapped copy-on-write: modifying a view or a vector
+/// returned by read_vector does not change the file. Views must not be
+/// used after the HDF5MappedFile has been destroyed. Vectors returned
+/// by read_vector share ownership of the mapping and remain valid.
+
+class HDF5MappedFile
+{
+public:
+  /// Open and map file
+  HDF5MappedFile(const std::string filename);
+
+  /// Destructor
+  ~HDF5MappedFile();
+
+  // Copy constructor (disabled)
+  HDF5MappedFile(const HDF5MappedFile& file) = delete;
+
+  // Assignment operator (disabled)
+  HDF5MappedFile& operator=(const HDF5MappedFile& file) = delete;
+
+  /// Return view of a contiguous dataset with values of type T. Rank 1
+  /// datasets are returned with one column. Throws if the dataset is
+  /// not contiguous or is not stored with the native representation
+  /// of T.
+  template <typename T>
+  Eigen::Map<const Eigen::Array<T, Eigen::Dynamic, Eigen::Dynamic,
+                                Eigen::RowMajor>>
+  dataset(const std::string dataset_path) const;
+
+  /// Read Mesh written by HDF5File::write. Cell topology and
+  /// coordinates are passed to the Mesh constructor directly from the
+  /// mapped file.
+  mesh::Mesh read_mesh(const std::string data_path,
+                       const mesh::GhostMode ghost_mode) const;
+
+  /// Return vector backed by the mapped dataset (no data is copied).
+  /// The vector keeps the mapping alive until it is destroyed.
+  la::PETScVector read_vector(const std::string dataset_path) const;
+
+  /// Read Function written by HDF5File::write on a mesh read from the
+  /// same file
+  function::Function read(std::shared_ptr<const function::FunctionSpace> V,
+                          const std::string name) const;
+
+private:
+  // Return pointer to the data of a contiguous dataset and its shape
+  template <typename T>
+  T* data(const std::string dataset_path,
+          std::vector<std::int64_t>& shape) const;
+
+  // HDF5 file descriptor (for metadata)
+  hid_t _hdf5_file_id;
+
+  // Mapped file (unmapped when the file and all vectors returned by
+  // read_vector have been destroyed)
+  std::shared_ptr<char> _mapped_data;
+  std::size_t _mapped_size;
+};
+} // namespace io
+} // namespace dolfin
@@ -8,7 +8,6 @@
 #include "VTKWriter.h"
 #include "pugixml.hpp"
 #include <boost/cstdint.hpp>
-#include <boost/detail/endian.hpp>
 #include <dolfin/common/Timer.h>
 #include <dolfin/common/log.h>
 #include <dolfin/fem/FiniteElement.h>
@@ -32,14 +31,12 @@ using namespace dolfin::io;
 namespace
 {
 void write_function(const function::Function& u, const std::string filename,
-                    const std::size_t counter, double time);
+                    VTKFile::Encoding encoding, const std::size_t counter,
+                    double time);
 void write_mesh(const mesh::Mesh& mesh, const std::string filename,
-                const std::size_t counter, double time);
-std::string init(const mesh::Mesh& mesh, const std::string filename,
-                 const std::size_t counter, std::size_t dim);
-void results_write(const function::Function& u, std::string file);
-void write_point_data(const function::Function& u, const mesh::Mesh& mesh,
-                      std::string file);
+                VTKFile::Encoding encoding, const std::size_t counter,
+                double time);
+void results_write(const function::Function& u, VTKWriter& writer);
 void pvd_file_write(std::size_t step, double time, const std::string filename,
                     std::string file);
 void pvtu_write_function(std::size_t dim, std::size_t rank,
@@ -52,59 +49,16 @@ void pvtu_write_mesh(const std::string filename,
                      const std::size_t num_processes);
 void pvtu_write(const function::Function& u, const std::string filename,
                 const std::string pvtu_filename, const std::size_t counter);
-void vtk_header_open(std::size_t num_vertices, std::size_t num_cells,
-                     const std::string vtu_filename);
-void vtk_header_close(std::string file);
 std::string vtu_name(const int process, const int num_processes,
                      const int counter, const std::string filename,
                      const std::string ext);
-void clear_file(std::string file);
 template <typename T>
 void mesh_function_write(T& meshfunction, const std::string filename,
-                         const std::size_t counter, double time);
+                         VTKFile::Encoding encoding, const std::size_t counter,
+                         double time);
 std::string strip_path(const std::string filename, const std::string file);
 void pvtu_write_mesh(pugi::xml_node xml_node);
 
-//----------------------------------------------------------------------------
-void vtk_header_open(std::size_t num_vertices, std::size_t num_cells,
-                     const std::string vtu_filename)
-{
-  // Open file
-  std::ofstream file(vtu_filename.c_str(), std::ios::app);
-  file.precision(16);
-  if (!file.is_open())
-    throw std::runtime_error("Unable to open file " + vtu_filename);
-
-  // Write headers
-  file << "<?xml version=\"1.0\"?>" << std::endl;
-  file << "<VTKFile type=\"UnstructuredGrid\"  version=\"0.1\" "
-       << ">" << std::endl;
-  file << "<UnstructuredGrid>" << std::endl;
-  file << "<Piece  NumberOfPoints=\"" << num_vertices << "\" NumberOfCells=\""
-       << num_cells << "\">" << std::endl;
-
-  // Close file
-  file.close();
-}
-//----------------------------------------------------------------------------
-void vtk_header_close(std::string vtu_filename)
-{
-  // Open file
-  std::ofstream file(vtu_filename.c_str(), std::ios::app);
-  file.precision(16);
-  if (!file.is_open())
-  {
-    throw std::runtime_error("IO Error");
-  }
-
-  // Close headers
-  file << "</Piece>" << std::endl
-       << "</UnstructuredGrid>" << std::endl
-       << "</VTKFile>";
-
-  // Close file
-  file.close();
-}
 //----------------------------------------------------------------------------
 std::string vtu_name(const int process, const int num_processes,
                      const int counter, const std::string filename,
@@ -134,14 +88,6 @@ std::string vtu_name(const int process, const int num_processes,
   return newfilename.str();
 }
 //----------------------------------------------------------------------------
-void clear_file(std::string file)
-{
-  std::ofstream _file(file.c_str(), std::ios::trunc);
-  if (!_file.is_open())
-    throw std::runtime_error("IO Error");
-  _file.close();
-}
-//----------------------------------------------------------------------------
 std::string strip_path(const std::string filename, const std::string file)
 {
   std::string fname;
@@ -149,57 +95,27 @@ std::string strip_path(const std::string filename, const std::string file)
   return fname;
 }
 //----------------------------------------------------------------------------
-std::string init(const mesh::Mesh& mesh, const std::string filename,
-                 const std::size_t counter, std::size_t cell_dim)
-{
-  // Get MPI communicators
-  const MPI_Comm mpi_comm = mesh.mpi_comm();
-
-  // Get vtu file name and clear file
-  std::string vtu_filename = vtu_name(MPI::rank(mpi_comm), MPI::size(mpi_comm),
-                                      counter, filename, ".vtu");
-  clear_file(vtu_filename);
-
-  // Number of cells and vertices
-  const std::size_t num_cells = mesh.topology().ghost_offset(cell_dim);
-  const std::size_t num_vertices = mesh.topology().ghost_offset(0);
-
-  // Write headers
-  vtk_header_open(num_vertices, num_cells, vtu_filename);
-
-  return vtu_filename;
-}
-//----------------------------------------------------------------------------
 template <typename T>
 void mesh_function_write(T& meshfunction, const std::string filename,
-                         const std::size_t counter, double time)
+                         VTKFile::Encoding encoding, const std::size_t counter,
+                         double time)
 {
   const mesh::Mesh& mesh = *meshfunction.mesh();
   const std::size_t cell_dim = meshfunction.dim();
 
-  // Update vtu file name and clear file
-  std::string vtu_filename = init(mesh, filename, counter, cell_dim);
-
   // Write mesh
-  VTKWriter::write_mesh(mesh, cell_dim, vtu_filename);
-
-  // Open file to write data
-  std::ofstream fp(vtu_filename.c_str(), std::ios_base::app);
-  fp.precision(16);
-  fp << "<CellData  Scalars=\"" << meshfunction.name() << "\">" << std::endl;
-  fp << "<DataArray  type=\"Float64\"  Name=\"" << meshfunction.name()
-     << "\"  format=\"ascii\">";
+  const std::string vtu_filename
+      = vtu_name(MPI::rank(mesh.mpi_comm()), MPI::size(mesh.mpi_comm()),
+                 counter, filename, ".vtu");
+  VTKWriter writer(vtu_filename, encoding);
+  writer.write_mesh(mesh, cell_dim);
 
   // Write data
-  for (auto& cell : mesh::MeshRange<mesh::MeshEntity>(mesh, cell_dim))
-    fp << meshfunction[cell.index()] << " ";
-
-  // Write footers
-  fp << "</DataArray>" << std::endl;
-  fp << "</CellData>" << std::endl;
-
-  // Close file
-  fp.close();
+  const std::size_t num_cells = mesh.topology().ghost_offset(cell_dim);
+  std::vector<double> values(num_cells);
+  for (std::size_t i = 0; i < num_cells; ++i)
+    values[i] = meshfunction[i];
+  writer.write_cell_values(meshfunction.name(), values);
 
   // Parallel-specific files
   const std::size_t num_processes = MPI::size(mesh.mpi_comm());
@@ -214,12 +130,13 @@ void mesh_function_write(T& meshfunction, const std::string filename,
   else if (num_processes == 1)
     pvd_file_write(counter, time, filename, vtu_filename);
 
-  // Write pvd files
-  vtk_header_close(vtu_filename);
+  // Finalise vtu file
+  writer.close();
 }
 //----------------------------------------------------------------------------
 void write_function(const function::Function& u, const std::string filename,
-                    const std::size_t counter, double time)
+                    VTKFile::Encoding encoding, const std::size_t counter,
+                    double time)
 {
   assert(u.function_space()->mesh());
   const mesh::Mesh& mesh = *u.function_space()->mesh();
@@ -227,15 +144,17 @@ void write_function(const function::Function& u, const std::string filename,
   // Get MPI communicator
   const MPI_Comm mpi_comm = mesh.mpi_comm();
 
-  // Get vtu file name and initialise
-  std::string vtu_filename
-      = init(mesh, filename, counter, mesh.topology().dim());
-
-  // Write mesh
-  VTKWriter::write_mesh(mesh, mesh.topology().dim(), vtu_filename);
-
-  // Write results
-  results_write(u, vtu_filename);
+  // Write mesh and results. Second-order Lagrange functions are written
+  // on quadratic VTK cells, otherwise values are written at vertices or
+  // cells of the mesh.
+  const std::string vtu_filename = vtu_name(
+      MPI::rank(mpi_comm), MPI::size(mpi_comm), counter, filename, ".vtu");
+  VTKWriter writer(vtu_filename, encoding);
+  if (!writer.write_quadratic(u))
+  {
+    writer.write_mesh(mesh, mesh.topology().dim());
+    results_write(u, writer);
+  }
 
   // Parallel-specific files
   const std::size_t num_processes = MPI::size(mpi_comm);
@@ -248,27 +167,27 @@ void write_function(const function::Function& u, const std::string filename,
   else if (num_processes == 1)
     pvd_file_write(counter, time, filename, vtu_filename);
 
-  // Finalise and write pvd files
-  vtk_header_close(vtu_filename);
+  // Finalise vtu file
+  writer.close();
 
   DLOG(INFO) << "Saved function \"" << u.name() << "\" to file \"" << filename
              << "\" in VTK format.";
 }
 //----------------------------------------------------------------------------
 void write_mesh(const mesh::Mesh& mesh, const std::string filename,
-                const std::size_t counter, double time)
+                VTKFile::Encoding encoding, const std::size_t counter,
+                double time)
 {
   common::Timer t("Write mesh to PVD/VTK file");
 
   // Get MPI communicator
   const MPI_Comm mpi_comm = mesh.mpi_comm();
 
-  // Get vtu file name and initialise out files
-  std::string vtu_filename
-      = init(mesh, filename, counter, mesh.topology().dim());
-
   // Write local mesh to vtu file
-  VTKWriter::write_mesh(mesh, mesh.topology().dim(), vtu_filename);
+  const std::string vtu_filename = vtu_name(
+      MPI::rank(mpi_comm), MPI::size(mpi_comm), counter, filename, ".vtu");
+  VTKWriter writer(vtu_filename, encoding);
+  writer.write_mesh(mesh, mesh.topology().dim());
 
   // Parallel-specific files
   const std::size_t num_processes = MPI::size(mpi_comm);
@@ -282,12 +201,12 @@ void write_mesh(const mesh::Mesh& mesh, const std::string filename,
     pvd_file_write(counter, time, filename, vtu_filename);
 
   // Finalise
-  vtk_header_close(vtu_filename);
+  writer.close();
 
   DLOG(INFO) << "Saved mesh in VTK format to file:" << filename;
 }
 //----------------------------------------------------------------------------
-void results_write(const function::Function& u, std::string vtu_filename)
+void results_write(const function::Function& u, VTKWriter& writer)
 {
   // Get rank of function::Function
   const std::size_t rank = u.value_rank();
@@ -332,89 +251,14 @@ void results_write(const function::Function& u, std::string vtu_filename)
   assert(u.function_space()->dofmap());
   const fem::GenericDofMap& dofmap = *u.function_space()->dofmap();
   if (dofmap.max_element_dofs() == cell_based_dim)
-    VTKWriter::write_cell_data(u, vtu_filename);
+    writer.write_cell_data(u);
   else
-    write_point_data(u, mesh, vtu_filename);
-}
-//----------------------------------------------------------------------------
-void write_point_data(const function::Function& u, const mesh::Mesh& mesh,
-                      std::string vtu_filename)
-{
-  const std::size_t rank = u.value_rank();
-
-  // Get number of components
-  const std::size_t dim = u.value_size();
-
-  // Open file
-  std::ofstream fp(vtu_filename.c_str(), std::ios_base::app);
-  fp.precision(16);
-
-  // Get function values at vertices
-  auto values = u.compute_point_values(mesh);
-
-  if (rank == 0)
-  {
-    fp << "<PointData  Scalars=\"" << u.name() << "\"> " << std::endl;
-    fp << "<DataArray  type=\"Float64\"  Name=\"" << u.name() << "\"  format=\""
-       << "ascii"
-       << "\">";
-  }
-  else if (rank == 1)
-  {
-    fp << "<PointData  Vectors=\"" << u.name() << "\"> " << std::endl;
-    fp << "<DataArray  type=\"Float64\"  Name=\"" << u.name()
-       << "\"  NumberOfComponents=\"3\" format=\""
-       << "ascii"
-       << "\">";
-  }
-  else if (rank == 2)
   {
-    fp << "<PointData  Tensors=\"" << u.name() << "\"> " << std::endl;
-    fp << "<DataArray  type=\"Float64\"  Name=\"" << u.name()
-       << "\"  NumberOfComponents=\"9\" format=\""
-       << "ascii"
-       << "\">";
+    // Get function values at (regular) vertices
+    auto values = u.compute_point_values(mesh);
+    writer.write_point_data(u.name(), rank,
+                            values.topRows(mesh.topology().ghost_offset(0)));
   }
-
-  std::ostringstream ss;
-  ss << std::scientific;
-  ss << std::setprecision(16);
-  for (auto& vertex : mesh::MeshRange<mesh::Vertex>(mesh))
-  {
-    if (rank == 1 && dim == 2)
-    {
-      // Append 0.0 to 2D vectors to make them 3D
-      for (std::size_t i = 0; i < 2; i++)
-        ss << values(vertex.index(), i) << " ";
-      ss << 0.0 << "  ";
-    }
-    else if (rank == 2 && dim == 4)
-    {
-      // Pad 2D tensors with 0.0 to make them 3D
-      for (std::size_t i = 0; i < 2; i++)
-      {
-        ss << values(vertex.index(), (2 * i + 0)) << " ";
-        ss << values(vertex.index(), (2 * i + 1)) << " ";
-        ss << 0.0 << " ";
-      }
-      ss << 0.0 << " ";
-      ss << 0.0 << " ";
-      ss << 0.0 << "  ";
-    }
-    else
-    {
-      // Write all components
-      for (std::size_t i = 0; i < dim; i++)
-        ss << values(vertex.index(), i) << " ";
-      ss << " ";
-    }
-  }
-
-  // Send to file
-  fp << ss.str();
-
-  fp << "</DataArray> " << std::endl;
-  fp << "</PointData> " << std::endl;
 }
 //----------------------------------------------------------------------------
 void pvd_file_write(std::size_t step, double time, const std::string filename,
@@ -468,11 +312,11 @@ void pvtu_write_mesh(pugi::xml_node xml_node)
   pugi::xml_node cell_data_node = xml_node.append_child("PCellData");
 
   data_node = cell_data_node.append_child("PDataArray");
-  data_node.append_attribute("type") = "UInt32";
+  data_node.append_attribute("type") = "Int32";
   data_node.append_attribute("Name") = "connectivity";
 
   data_node = cell_data_node.append_child("PDataArray");
-  data_node.append_attribute("type") = "UInt32";
+  data_node.append_attribute("type") = "Int32";
   data_node.append_attribute("Name") = "offsets";
 
   data_node = cell_data_node.append_child("PDataArray");
@@ -622,7 +466,8 @@ void pvtu_write(const function::Function& u, const std::string filename,
 } // namespace
 
 //----------------------------------------------------------------------------
-VTKFile::VTKFile(const std::string filename) : _filename(filename), _counter(0)
+VTKFile::VTKFile(const std::string filename, Encoding encoding)
+    : _filename(filename), _encoding(encoding), _counter(0)
 {
   // Do nothing
 }
@@ -634,73 +479,73 @@ VTKFile::~VTKFile()
 //----------------------------------------------------------------------------
 void VTKFile::write(const mesh::Mesh& mesh)
 {
-  write_mesh(mesh, _filename, _counter, _counter);
+  write_mesh(mesh, _filename, _encoding, _counter, _counter);
   ++_counter;
 }
 //----------------------------------------------------------------------------
 void VTKFile::write(const mesh::MeshFunction<bool>& meshfunction)
 {
-  mesh_function_write(meshfunction, _filename, _counter, _counter);
+  mesh_function_write(meshfunction, _filename, _encoding, _counter, _counter);
   ++_counter;
 }
 //----------------------------------------------------------------------------
 void VTKFile::write(const mesh::MeshFunction<std::size_t>& meshfunction)
 {
-  mesh_function_write(meshfunction, _filename, _counter, _counter);
+  mesh_function_write(meshfunction, _filename, _encoding, _counter, _counter);
   ++_counter;
 }
 //----------------------------------------------------------------------------
 void VTKFile::write(const mesh::MeshFunction<int>& meshfunction)
 {
-  mesh_function_write(meshfunction, _filename, _counter, _counter);
+  mesh_function_write(meshfunction, _filename, _encoding, _counter, _counter);
   ++_counter;
 }
 //----------------------------------------------------------------------------
 void VTKFile::write(const mesh::MeshFunction<double>& meshfunction)
 {
-  mesh_function_write(meshfunction, _filename, _counter, _counter);
+  mesh_function_write(meshfunction, _filename, _encoding, _counter, _counter);
   ++_counter;
 }
 //----------------------------------------------------------------------------
 void VTKFile::write(const function::Function& u)
 {
-  write_function(u, _filename, _counter, _counter);
+  write_function(u, _filename, _encoding, _counter, _counter);
   ++_counter;
 }
 //----------------------------------------------------------------------------
 void VTKFile::write(const mesh::Mesh& mesh, double time)
 {
-  write_mesh(mesh, _filename, _counter, time);
+  write_mesh(mesh, _filename, _encoding, _counter, time);
   ++_counter;
 }
 //----------------------------------------------------------------------------
 void VTKFile::write(const mesh::MeshFunction<int>& mf, double time)
 {
-  mesh_function_write(mf, _filename, _counter, time);
+  mesh_function_write(mf, _filename, _encoding, _counter, time);
   ++_counter;
 }
 //----------------------------------------------------------------------------
 void VTKFile::write(const mesh::MeshFunction<std::size_t>& mf, double time)
 {
-  mesh_function_write(mf, _filename, _counter, time);
+  mesh_function_write(mf, _filename, _encoding, _counter, time);
   ++_counter;
 }
 //----------------------------------------------------------------------------
 void VTKFile::write(const mesh::MeshFunction<double>& mf, double time)
 {
-  mesh_function_write(mf, _filename, _counter, time);
+  mesh_function_write(mf, _filename, _encoding, _counter, time);
   ++_counter;
 }
 //----------------------------------------------------------------------------
 void VTKFile::write(const mesh::MeshFunction<bool>& mf, double time)
 {
-  mesh_function_write(mf, _filename, _counter, time);
+  mesh_function_write(mf, _filename, _encoding, _counter, time);
   ++_counter;
 }
 //----------------------------------------------------------------------------
 void VTKFile::write(const function::Function& u, double time)
 {
-  write_function(u, _filename, _counter, time);
+  write_function(u, _filename, _encoding, _counter, time);
   ++_counter;
 }
 //----------------------------------------------------------------------------
@@ -41,8 +41,19 @@ namespace io
 class VTKFile
 {
 public:
-  /// Create VTK file
-  VTKFile(const std::string filename);
+  /// Encoding of mesh and function data in VTU files
+  enum class Encoding
+  {
+    ASCII,
+    RAW,
+    ZLIB
+  };
+
+  /// Create VTK file. ASCII data is written inline, RAW data is
+  /// written as binary to the appended data section of each VTU file
+  /// and ZLIB data is written as zlib-compressed binary to the appended
+  /// data section.
+  VTKFile(const std::string filename, Encoding encoding = Encoding::ASCII);
 
   // Destructor
   ~VTKFile();
@@ -87,6 +98,9 @@ private:
 
   const std::string _filename;
 
+  // Encoding of heavy data
+  const Encoding _encoding;
+
   // Counter for the number of times various data has been written
   std::size_t _counter;
 
@@ -5,30 +5,40 @@
 // SPDX-License-Identifier:    LGPL-3.0-or-later
 
 #include "VTKWriter.h"
-#include <boost/detail/endian.hpp>
+#include <array>
+#include <boost/predef/other/endian.h>
+#include <complex>
 #include <cstdint>
+#include <dolfin/common/IndexMap.h>
+#include <dolfin/fem/CoordinateMapping.h>
 #include <dolfin/fem/FiniteElement.h>
 #include <dolfin/fem/GenericDofMap.h>
+#include <dolfin/fem/ReferenceCellTopology.h>
 #include <dolfin/function/Function.h>
 #include <dolfin/function/FunctionSpace.h>
 #include <dolfin/la/PETScVector.h>
 #include <dolfin/la/utils.h>
 #include <dolfin/mesh/Cell.h>
+#include <dolfin/mesh/CoordinateDofs.h>
 #include <dolfin/mesh/Mesh.h>
-#include <dolfin/mesh/MeshFunction.h>
 #include <dolfin/mesh/MeshIterator.h>
-#include <dolfin/mesh/Vertex.h>
-#include <fstream>
 #include <iomanip>
 #include <ostream>
 #include <sstream>
 #include <vector>
 
+#ifdef HAS_ZLIB
+#include <zlib.h>
+#endif
+
 using namespace dolfin;
 using namespace dolfin::io;
 
 namespace
 {
+// Size of uncompressed blocks for zlib-compressed data arrays
+const std::size_t zlib_block_size = 32768;
+
 //-----------------------------------------------------------------------------
 // Get VTK cell type
 std::uint8_t vtk_cell_type(const mesh::Mesh& mesh, std::size_t cell_dim)
@@ -57,131 +67,277 @@ std::uint8_t vtk_cell_type(const mesh::Mesh& mesh, std::size_t cell_dim)
 
   return vtk_cell_type;
 }
+//-----------------------------------------------------------------------------
+// VTK type names
+template <typename T>
+std::string vtk_type_name();
+template <>
+std::string vtk_type_name<double>()
+{
+  return "Float64";
+}
+template <>
+std::string vtk_type_name<std::int32_t>()
+{
+  return "Int32";
+}
+template <>
+std::string vtk_type_name<std::uint8_t>()
+{
+  return "UInt8";
+}
+//-----------------------------------------------------------------------------
+// Write values as text (std::uint8_t is written as a number, not a
+// character)
+template <typename T>
+void write_ascii(std::ostream& file, const T* data, std::size_t size)
+{
+  for (std::size_t i = 0; i < size; ++i)
+    file << data[i] << " ";
+}
+template <>
+void write_ascii(std::ostream& file, const std::uint8_t* data,
+                 std::size_t size)
+{
+  for (std::size_t i = 0; i < size; ++i)
+    file << static_cast<int>(data[i]) << " ";
+}
+//-----------------------------------------------------------------------------
+// Append bytes to a buffer
+template <typename T>
+void append_bytes(std::vector<char>& buffer, const T* data, std::size_t size)
+{
+  const char* p = reinterpret_cast<const char*>(data);
+  buffer.insert(buffer.end(), p, p + size * sizeof(T));
+}
+//-----------------------------------------------------------------------------
+
+} // namespace
+
 //----------------------------------------------------------------------------
-// Write cell data (ascii)
-std::string ascii_cell_data(const mesh::Mesh& mesh,
-                            const std::vector<std::size_t>& offset,
-                            const std::vector<PetscScalar>& values,
-                            std::size_t data_dim, std::size_t rank)
+VTKWriter::VTKWriter(const std::string filename, VTKFile::Encoding encoding)
+    : _filename(filename), _encoding(encoding)
 {
-  std::ostringstream ss;
-  ss << std::scientific;
-  ss << std::setprecision(16);
-  std::vector<std::size_t>::const_iterator cell_offset = offset.begin();
-  for (int i = 0; i < mesh.topology().ghost_offset(mesh.topology().dim()); ++i)
+#ifndef HAS_ZLIB
+  if (_encoding == VTKFile::Encoding::ZLIB)
   {
-    if (rank == 1 && data_dim == 2)
-    {
-      // Append 0.0 to 2D vectors to make them 3D
-      ss << values[*cell_offset] << "  " << values[*cell_offset + 1] << " "
-         << 0.0;
-    }
-    else if (rank == 2 && data_dim == 4)
-    {
-      // Pad with 0.0 to 2D tensors to make them 3D
-      for (std::size_t i = 0; i < 2; i++)
-      {
-        ss << values[*cell_offset + 2 * i] << " ";
-        ss << values[*cell_offset + 2 * i + 1] << " ";
-        ss << 0.0 << " ";
-      }
-      ss << 0.0 << " ";
-      ss << 0.0 << " ";
-      ss << 0.0;
-    }
-    else
+    throw std::runtime_error(
+        "Compressed VTK output requires DOLFIN to be configured with zlib");
+  }
+#endif
+
+  // Clear file and write headers
+  std::ofstream file(_filename.c_str(), std::ios::trunc);
+  if (!file.is_open())
+    throw std::runtime_error("Unable to open file " + _filename);
+
+  file << "<?xml version=\"1.0\"?>" << std::endl;
+  if (_encoding == VTKFile::Encoding::ASCII)
+  {
+    file << "<VTKFile type=\"UnstructuredGrid\"  version=\"0.1\" "
+         << ">" << std::endl;
+  }
+  else
+  {
+#if BOOST_ENDIAN_BIG_BYTE
+    const std::string byte_order = "BigEndian";
+#else
+    const std::string byte_order = "LittleEndian";
+#endif
+    file << "<VTKFile type=\"UnstructuredGrid\"  version=\"1.0\" "
+         << "byte_order=\"" << byte_order << "\" header_type=\"UInt64\"";
+    if (_encoding == VTKFile::Encoding::ZLIB)
+      file << " compressor=\"vtkZLibDataCompressor\"";
+    file << ">" << std::endl;
+  }
+  file << "<UnstructuredGrid>" << std::endl;
+}
+//----------------------------------------------------------------------------
+void VTKWriter::write_mesh(const mesh::Mesh& mesh, std::size_t cell_dim)
+{
+  const std::size_t num_cells = mesh.topology().ghost_offset(cell_dim);
+  const std::size_t num_vertices = mesh.topology().ghost_offset(0);
+  const int num_cell_vertices = mesh.type().num_vertices(cell_dim);
+
+  // Vertex indices of each cell, reordered to VTK convention if
+  // required
+  mesh.create_entities(cell_dim);
+  assert(mesh.topology().connectivity(cell_dim, 0));
+  const mesh::Connectivity& cell_vertices
+      = *mesh.topology().connectivity(cell_dim, 0);
+  std::unique_ptr<mesh::CellType> celltype(
+      mesh::CellType::create(mesh.type().entity_type(cell_dim)));
+  const std::vector<std::int8_t> perm = celltype->vtk_mapping();
+
+  const std::int32_t* connectivity = cell_vertices.connections().data();
+  std::vector<std::int32_t> connectivity_vtk;
+  if (!std::is_sorted(perm.begin(), perm.end()))
+  {
+    connectivity_vtk.resize(num_cells * num_cell_vertices);
+    for (std::size_t c = 0; c < num_cells; ++c)
     {
-      // Write all components
-      for (std::size_t i = 0; i < data_dim; i++)
-        ss << values[*cell_offset + i] << " ";
+      const std::int32_t* v = cell_vertices.connections(c);
+      for (int i = 0; i < num_cell_vertices; ++i)
+        connectivity_vtk[c * num_cell_vertices + i] = v[perm[i]];
     }
-    ss << "  ";
-    ++cell_offset;
+    connectivity = connectivity_vtk.data();
   }
 
-  return ss.str();
+  std::ofstream file = open();
+  write_piece(file, num_vertices, num_cells, mesh.geometry().points().data(),
+              connectivity, num_cell_vertices, vtk_cell_type(mesh, cell_dim));
 }
 //----------------------------------------------------------------------------
-// mesh::Mesh writer (ascii)
-void write_ascii_mesh(const mesh::Mesh& mesh, std::size_t cell_dim,
-                      std::string filename)
+bool VTKWriter::write_quadratic(const function::Function& u)
 {
-  const std::size_t num_cells = mesh.topology().ghost_offset(cell_dim);
-  const std::size_t num_cell_vertices = mesh.type().num_vertices(cell_dim);
+  assert(u.function_space());
+  const function::FunctionSpace& V = *u.function_space();
+  assert(V.mesh());
+  assert(V.element());
+  assert(V.dofmap());
+  const mesh::Mesh& mesh = *V.mesh();
+  const fem::FiniteElement& element = *V.element();
+  const fem::GenericDofMap& dofmap = *V.dofmap();
 
-  // Get VTK cell type
-  const std::size_t _vtk_cell_type = vtk_cell_type(mesh, cell_dim);
+  // VTK quadratic cell type and the cell vertices of each edge in VTK
+  // node order
+  std::uint8_t vtk_type = 0;
+  std::vector<std::array<int, 2>> vtk_edges;
+  switch (element.cell_shape())
+  {
+  case CellType::interval:
+    vtk_type = 21;
+    vtk_edges = {{{0, 1}}};
+    break;
+  case CellType::triangle:
+    vtk_type = 22;
+    vtk_edges = {{{0, 1}}, {{1, 2}}, {{2, 0}}};
+    break;
+  case CellType::tetrahedron:
+    vtk_type = 24;
+    vtk_edges = {{{0, 1}}, {{1, 2}}, {{2, 0}}, {{0, 3}}, {{1, 3}}, {{2, 3}}};
+    break;
+  default:
+    return false;
+  }
 
-  // Open file
-  std::ofstream file(filename.c_str(), std::ios::app);
-  file.precision(16);
-  if (!file.is_open())
+  // Only second-order Lagrange with one node per vertex and edge
+  if (element.degree() != 2
+      or !(element.family() == "Lagrange" or element.family() == "P"))
   {
-    throw std::runtime_error("Unable to open file:" + filename);
+    return false;
   }
 
-  // Write vertex positions
-  file << "<Points>" << std::endl;
-  file << "<DataArray  type=\"Float64\"  NumberOfComponents=\"3\"  format=\""
-       << "ascii"
-       << "\">";
-  for (auto& v : mesh::MeshRange<mesh::Vertex>(mesh))
+  // Nodes are blocks of the dofmap, with one dof per value component
+  const std::size_t value_size = u.value_size();
+  const common::IndexMap& index_map = *dofmap.index_map();
+  const int bs = index_map.block_size();
+  if (bs != (int)value_size)
+    return false;
+
+  // Dofmap and element for the first component
+  std::shared_ptr<const fem::GenericDofMap> dofmap0 = V.dofmap();
+  std::shared_ptr<const fem::FiniteElement> element0 = V.element();
+  if (bs > 1)
   {
-    Eigen::Vector3d p = v.x();
-    file << p[0] << " " << p[1] << " " << p[2] << "  ";
+    dofmap0 = dofmap.extract_sub_dofmap({0}, mesh);
+    element0 = element.extract_sub_element({0});
   }
-  file << "</DataArray>" << std::endl << "</Points>" << std::endl;
+  assert(dofmap0);
+  assert(element0);
 
-  // Write cell connectivity
-  file << "<Cells>" << std::endl;
-  file << "<DataArray  type=\"UInt32\"  Name=\"connectivity\"  format=\""
-       << "ascii"
-       << "\">";
+  // Map from VTK node order to local dof index of first component
+  const int tdim = mesh.topology().dim();
+  const int num_cell_vertices = tdim + 1;
+  std::vector<int> local_nodes;
+  for (int v = 0; v < num_cell_vertices; ++v)
+  {
+    auto dofs = dofmap0->tabulate_entity_dofs(0, v);
+    if (dofs.size() != 1)
+      return false;
+    local_nodes.push_back(dofs[0]);
+  }
 
-  std::unique_ptr<mesh::CellType> celltype(
-      mesh::CellType::create(mesh.type().entity_type(cell_dim)));
-  const std::vector<std::int8_t> perm = celltype->vtk_mapping();
-  for (auto& c : mesh::MeshRange<mesh::MeshEntity>(mesh, cell_dim))
+  const fem::ReferenceCellTopology::Edge* edge_vertices
+      = fem::ReferenceCellTopology::get_edge_vertices(element.cell_shape());
+  for (auto& edge : vtk_edges)
   {
-    for (unsigned int i = 0; i != c.num_entities(0); ++i)
-      file << c.entities(0)[perm[i]] << " ";
-    file << " ";
+    for (std::size_t e = 0; e < vtk_edges.size(); ++e)
+    {
+      if ((edge_vertices[e][0] == edge[0] and edge_vertices[e][1] == edge[1])
+          or (edge_vertices[e][0] == edge[1]
+              and edge_vertices[e][1] == edge[0]))
+      {
+        auto dofs = dofmap0->tabulate_entity_dofs(1, e);
+        if (dofs.size() != 1)
+          return false;
+        local_nodes.push_back(dofs[0]);
+        break;
+      }
+    }
   }
-  file << "</DataArray>" << std::endl;
+  assert(local_nodes.size() == (std::size_t)element0->space_dimension());
+  const int num_cell_nodes = local_nodes.size();
 
-  // Write offset into connectivity array for the end of each cell
-  file << "<DataArray  type=\"UInt32\"  Name=\"offsets\"  format=\""
-       << "ascii"
-       << "\">";
-  for (std::size_t offsets = 1; offsets <= num_cells; offsets++)
-    file << offsets * num_cell_vertices << " ";
-  file << "</DataArray>" << std::endl;
+  // Get coordinate mapping
+  if (!mesh.geometry().coord_mapping)
+  {
+    throw std::runtime_error(
+        "CoordinateMapping has not been attached to mesh.");
+  }
+  const fem::CoordinateMapping& cmap = *mesh.geometry().coord_mapping;
+  const EigenRowArrayXXd& X = element0->dof_reference_coordinates();
 
-  // Write cell type
-  file << "<DataArray  type=\"UInt8\"  Name=\"types\"  format=\""
-       << "ascii"
-       << "\">";
-  for (std::size_t types = 0; types < num_cells; types++)
-    file << _vtk_cell_type << " ";
-  file << "</DataArray>" << std::endl;
-  file << "</Cells>" << std::endl;
+  // Prepare cell geometry
+  const mesh::Connectivity& connectivity_g
+      = mesh.coordinate_dofs().entity_points(tdim);
+  const Eigen::Ref<const Eigen::Array<std::int32_t, Eigen::Dynamic, 1>> cell_g
+      = connectivity_g.connections();
+  const int num_dofs_g = connectivity_g.size(0);
+  const int gdim = mesh.geometry().dim();
+  const Eigen::Array<double, Eigen::Dynamic, 3, Eigen::RowMajor>& x_g
+      = mesh.geometry().points();
 
-  // Close file
-  file.close();
-}
-//-----------------------------------------------------------------------------
+  // Compute node coordinates and cell connectivity
+  const std::size_t num_nodes = index_map.size_local() + index_map.num_ghosts();
+  const std::size_t num_cells = mesh.topology().ghost_offset(tdim);
+  Eigen::Array<double, Eigen::Dynamic, 3, Eigen::RowMajor> points
+      = Eigen::Array<double, Eigen::Dynamic, 3, Eigen::RowMajor>::Zero(
+          num_nodes, 3);
+  std::vector<std::int32_t> connectivity(num_cells * num_cell_nodes);
+  EigenRowArrayXXd coordinates(X.rows(), gdim);
+  EigenRowArrayXXd coordinate_dofs(num_dofs_g, gdim);
+  for (std::size_t c = 0; c < num_cells; ++c)
+  {
+    for (int i = 0; i < num_dofs_g; ++i)
+      for (int j = 0; j < gdim; ++j)
+        coordinate_dofs(i, j) = x_g(cell_g[c * num_dofs_g + i], j);
+    cmap.compute_physical_coordinates(coordinates, X, coordinate_dofs);
 
-} // namespace
+    auto dofs = dofmap0->cell_dofs(c);
+    for (int i = 0; i < num_cell_nodes; ++i)
+    {
+      const std::int32_t node = dofs[local_nodes[i]] / bs;
+      connectivity[c * num_cell_nodes + i] = node;
+      points.row(node).head(gdim) = coordinates.row(local_nodes[i]);
+    }
+  }
 
-//----------------------------------------------------------------------------
-void VTKWriter::write_mesh(const mesh::Mesh& mesh, std::size_t cell_dim,
-                           std::string filename)
-{
-  write_ascii_mesh(mesh, cell_dim, filename);
+  std::ofstream file = open();
+  write_piece(file, num_nodes, num_cells, points.data(), connectivity.data(),
+              num_cell_nodes, vtk_type);
+
+  // Node values (including ghosts)
+  la::VecReadWrapper u_wrapper(u.vector().vec());
+  assert(u_wrapper.x.size() >= (Eigen::Index)(num_nodes * value_size));
+  write_data(file, "PointData", u.name(), u.value_rank(), value_size,
+             num_nodes, u_wrapper.x.data());
+  u_wrapper.restore();
+
+  return true;
 }
 //----------------------------------------------------------------------------
-void VTKWriter::write_cell_data(const function::Function& u,
-                                std::string filename)
+void VTKWriter::write_cell_data(const function::Function& u)
 {
   // For brevity
   assert(u.function_space()->mesh());
@@ -191,8 +347,6 @@ void VTKWriter::write_cell_data(const function::Function& u,
   const std::size_t tdim = mesh.topology().dim();
   const std::size_t num_cells = mesh.topology().ghost_offset(tdim);
 
-  std::string encode_string = "ascii";
-
   // Get rank of function::Function
   const std::size_t rank = u.value_rank();
   if (rank > 2)
@@ -204,71 +358,231 @@ void VTKWriter::write_cell_data(const function::Function& u,
   // Get number of components
   const std::size_t data_dim = u.value_size();
 
-  // Open file
-  std::ofstream fp(filename.c_str(), std::ios_base::app);
-  fp.precision(16);
+  // Gather cell values
+  std::vector<PetscScalar> values(num_cells * data_dim);
+  la::VecReadWrapper u_wrapper(u.vector().vec());
+  Eigen::Map<const Eigen::Matrix<PetscScalar, Eigen::Dynamic, 1>> _x
+      = u_wrapper.x;
+  for (std::size_t c = 0; c < num_cells; ++c)
+  {
+    auto dofs = dofmap.cell_dofs(c);
+    assert((std::size_t)dofs.size() == data_dim);
+    for (std::size_t i = 0; i < data_dim; ++i)
+      values[c * data_dim + i] = _x[dofs[i]];
+  }
+  u_wrapper.restore();
 
-  // Write headers
-  if (rank == 0)
+  std::ofstream file = open();
+  write_data(file, "CellData", u.name(), rank, data_dim, num_cells,
+             values.data());
+}
+//----------------------------------------------------------------------------
+void VTKWriter::write_point_data(
+    const std::string name, std::size_t rank,
+    const Eigen::Ref<const Eigen::Array<PetscScalar, Eigen::Dynamic,
+                                        Eigen::Dynamic, Eigen::RowMajor>>
+        values)
+{
+  std::ofstream file = open();
+  write_data(file, "PointData", name, rank, values.cols(), values.rows(),
+             values.data());
+}
+//----------------------------------------------------------------------------
+void VTKWriter::write_cell_values(const std::string name,
+                                  const std::vector<double>& values)
+{
+  std::ofstream file = open();
+  file << "<CellData  Scalars=\"" << name << "\">" << std::endl;
+  data_array(file, name, 1, values.data(), values.size());
+  file << "</CellData>" << std::endl;
+}
+//----------------------------------------------------------------------------
+void VTKWriter::close()
+{
+  std::ofstream file = open();
+  file << "</Piece>" << std::endl << "</UnstructuredGrid>" << std::endl;
+
+  // Binary data follows the '_' marker
+  if (_encoding != VTKFile::Encoding::ASCII)
+  {
+    file << "<AppendedData encoding=\"raw\">" << std::endl << "_";
+    file.write(_appended_data.data(), _appended_data.size());
+    file << std::endl << "</AppendedData>" << std::endl;
+    _appended_data.clear();
+  }
+
+  file << "</VTKFile>";
+}
+//----------------------------------------------------------------------------
+template <typename T>
+void VTKWriter::data_array(std::ofstream& file, const std::string name,
+                           int num_components, const T* data,
+                           std::size_t size)
+{
+  file << "<DataArray  type=\"" << vtk_type_name<T>() << "\"";
+  if (!name.empty())
+    file << "  Name=\"" << name << "\"";
+  if (num_components > 1)
+    file << "  NumberOfComponents=\"" << num_components << "\"";
+
+  if (_encoding == VTKFile::Encoding::ASCII)
   {
-    fp << "<CellData  Scalars=\"" << u.name() << "\"> " << std::endl;
-    fp << "<DataArray  type=\"Float64\"  Name=\"" << u.name() << "\"  format=\""
-       << encode_string << "\">";
+    file << "  format=\"ascii\">";
+    write_ascii(file, data, size);
+    file << "</DataArray>" << std::endl;
+    return;
+  }
+
+  file << "  format=\"appended\"  offset=\"" << _appended_data.size()
+       << "\"/>" << std::endl;
+
+  const std::uint64_t num_bytes = size * sizeof(T);
+  if (_encoding == VTKFile::Encoding::RAW)
+  {
+    // Header (number of bytes) followed by data
+    append_bytes(_appended_data, &num_bytes, 1);
+    append_bytes(_appended_data, data, size);
+  }
+  else
+  {
+#ifdef HAS_ZLIB
+    // Compress data in blocks. Header is number of blocks, uncompressed
+    // block size, uncompressed size of last block and compressed size
+    // of each block.
+    const std::uint64_t num_blocks
+        = (num_bytes + zlib_block_size - 1) / zlib_block_size;
+    std::vector<std::uint64_t> header(3 + num_blocks);
+    header[0] = num_blocks;
+    header[1] = zlib_block_size;
+    header[2] = num_bytes - (num_blocks > 0 ? (num_blocks - 1) : 0)
+                                * zlib_block_size;
+
+    const Bytef* src = reinterpret_cast<const Bytef*>(data);
+    std::vector<char> compressed;
+    std::vector<Bytef> block(compressBound(zlib_block_size));
+    for (std::uint64_t b = 0; b < num_blocks; ++b)
+    {
+      const uLong src_size = (b + 1 < num_blocks) ? zlib_block_size : header[2];
+      uLongf dest_size = block.size();
+      if (compress2(block.data(), &dest_size, src + b * zlib_block_size,
+                    src_size, Z_DEFAULT_COMPRESSION)
+          != Z_OK)
+      {
+        throw std::runtime_error("zlib error while compressing VTK data");
+      }
+      header[3 + b] = dest_size;
+      append_bytes(compressed, block.data(), dest_size);
+    }
+
+    append_bytes(_appended_data, header.data(), header.size());
+    _appended_data.insert(_appended_data.end(), compressed.begin(),
+                          compressed.end());
+#endif
   }
+}
+//----------------------------------------------------------------------------
+void VTKWriter::write_piece(std::ofstream& file, std::size_t num_points,
+                            std::size_t num_cells, const double* points,
+                            const std::int32_t* connectivity,
+                            int num_cell_points, std::uint8_t vtk_cell_type)
+{
+  file << "<Piece  NumberOfPoints=\"" << num_points << "\" NumberOfCells=\""
+       << num_cells << "\">" << std::endl;
+
+  // Write point positions
+  file << "<Points>" << std::endl;
+  data_array(file, "", 3, points, 3 * num_points);
+  file << "</Points>" << std::endl;
+
+  // Write cell connectivity
+  file << "<Cells>" << std::endl;
+  data_array(file, "connectivity", 1, connectivity,
+             num_cells * num_cell_points);
+
+  // Write offset into connectivity array for the end of each cell
+  std::vector<std::int32_t> offsets(num_cells);
+  for (std::size_t c = 0; c < num_cells; ++c)
+    offsets[c] = (c + 1) * num_cell_points;
+  data_array(file, "offsets", 1, offsets.data(), offsets.size());
+
+  // Write cell type
+  const std::vector<std::uint8_t> types(num_cells, vtk_cell_type);
+  data_array(file, "types", 1, types.data(), types.size());
+  file << "</Cells>" << std::endl;
+}
+//----------------------------------------------------------------------------
+void VTKWriter::write_data(std::ofstream& file, const std::string location,
+                           const std::string name, std::size_t rank,
+                           std::size_t value_size, std::size_t num_entities,
+                           const PetscScalar* values)
+{
+  // VTK vectors and tensors are 3D
+  std::size_t num_components = 1;
+  if (rank == 0)
+    file << "<" << location << "  Scalars=\"" << name << "\"> " << std::endl;
   else if (rank == 1)
   {
-    if (!(data_dim == 2 || data_dim == 3))
+    if (!(value_size == 2 || value_size == 3))
     {
       throw std::runtime_error(
           "Don't know how to handle vector function with dimension  "
           "other than 2 or 3");
     }
-    fp << "<CellData  Vectors=\"" << u.name() << "\"> " << std::endl;
-    fp << "<DataArray  type=\"Float64\"  Name=\"" << u.name()
-       << "\"  NumberOfComponents=\"3\" format=\"" << encode_string << "\">";
+    file << "<" << location << "  Vectors=\"" << name << "\"> " << std::endl;
+    num_components = 3;
   }
   else if (rank == 2)
   {
-    if (!(data_dim == 4 || data_dim == 9))
+    if (!(value_size == 4 || value_size == 9))
     {
       throw std::runtime_error("Don't know how to handle tensor function with "
                                "dimension other than 4 or 9");
     }
-    fp << "<CellData  Tensors=\"" << u.name() << "\"> " << std::endl;
-    fp << "<DataArray  type=\"Float64\"  Name=\"" << u.name()
-       << "\"  NumberOfComponents=\"9\" format=\"" << encode_string << "\">";
+    file << "<" << location << "  Tensors=\"" << name << "\"> " << std::endl;
+    num_components = 9;
   }
-
-  // Allocate memory for function values at cell centres
-  const std::size_t size = num_cells * data_dim;
-
-  // Build lists of dofs and create map
-  std::vector<PetscInt> dof_set;
-  std::vector<std::size_t> offset(size + 1);
-  std::vector<std::size_t>::iterator cell_offset = offset.begin();
-  for (auto& cell : mesh::MeshRange<mesh::Cell>(mesh))
+  else
   {
-    // Tabulate dofs
-    auto dofs = dofmap.cell_dofs(cell.index());
-    for (std::size_t i = 0; i < dofmap.num_element_dofs(cell.index()); ++i)
-      dof_set.push_back(dofs[i]);
-
-    // Add local dimension to cell offset and increment
-    *(cell_offset + 1) = *(cell_offset) + dofmap.num_element_dofs(cell.index());
-    ++cell_offset;
+    throw std::runtime_error("Cannot handle VTK output of rank "
+                             + std::to_string(rank));
   }
 
-  // Get  values
-  std::vector<PetscScalar> values(dof_set.size());
-  la::VecReadWrapper u_wrapper(u.vector().vec());
-  Eigen::Map<const Eigen::Matrix<PetscScalar, Eigen::Dynamic, 1>> _x
-      = u_wrapper.x;
-  for (std::size_t i = 0; i < dof_set.size(); ++i)
-    values[i] = _x[dof_set[i]];
+  // Copy (real part of) values, padding 2D vectors and tensors with
+  // zeros
+  std::vector<double> data(num_entities * num_components, 0.0);
+  for (std::size_t i = 0; i < num_entities; ++i)
+  {
+    const PetscScalar* v = values + i * value_size;
+    double* d = data.data() + i * num_components;
+    if (rank == 1 and value_size == 2)
+    {
+      d[0] = std::real(v[0]);
+      d[1] = std::real(v[1]);
+    }
+    else if (rank == 2 and value_size == 4)
+    {
+      d[0] = std::real(v[0]);
+      d[1] = std::real(v[1]);
+      d[3] = std::real(v[2]);
+      d[4] = std::real(v[3]);
+    }
+    else
+    {
+      for (std::size_t j = 0; j < value_size; ++j)
+        d[j] = std::real(v[j]);
+    }
+  }
 
-  // Get cell data
-  fp << ascii_cell_data(mesh, offset, values, data_dim, rank);
-  fp << "</DataArray> " << std::endl;
-  fp << "</CellData> " << std::endl;
+  data_array(file, name, num_components, data.data(), data.size());
+  file << "</" << location << "> " << std::endl;
+}
+//----------------------------------------------------------------------------
+std::ofstream VTKWriter::open() const
+{
+  std::ofstream file(_filename.c_str(), std::ios::app | std::ios::binary);
+  if (!file.is_open())
+    throw std::runtime_error("Unable to open file " + _filename);
+  file.precision(16);
+  return file;
 }
 //----------------------------------------------------------------------------
@@ -6,7 +6,10 @@
 
 #pragma once
 
+#include "VTKFile.h"
+#include <Eigen/Dense>
 #include <cstdint>
+#include <fstream>
 #include <petscsys.h>
 #include <string>
 #include <vector>
@@ -25,17 +28,75 @@ class Mesh;
 namespace io
 {
 
-/// Write VTK mesh::Mesh representation
+/// Write VTK mesh::Mesh representation to a VTU (XML unstructured
+/// grid) file. ASCII data is written inline. Binary data is written
+/// unencoded to the 'raw' AppendedData section at the end of the file,
+/// optionally compressed with zlib.
 
 class VTKWriter
 {
 public:
-  /// mesh::Mesh writer
-  static void write_mesh(const mesh::Mesh& mesh, std::size_t cell_dim,
-                         std::string file);
+  /// Create writer for VTU file. Any existing file is overwritten.
+  VTKWriter(const std::string filename, VTKFile::Encoding encoding);
+
+  /// Write mesh::Mesh points and cells of dimension cell_dim
+  void write_mesh(const mesh::Mesh& mesh, std::size_t cell_dim);
+
+  /// Write mesh points, cells and point values using second-order
+  /// Lagrange (VTK quadratic) cells with the nodes of the function
+  /// space of u. Returns false and writes nothing if the element of u
+  /// is not second-order Lagrange on an interval, triangle or
+  /// tetrahedron.
+  bool write_quadratic(const function::Function& u);
 
   /// Cell data writer
-  static void write_cell_data(const function::Function& u, std::string file);
+  void write_cell_data(const function::Function& u);
+
+  /// Point data writer. Values has one row per mesh vertex.
+  void write_point_data(
+      const std::string name, std::size_t rank,
+      const Eigen::Ref<const Eigen::Array<PetscScalar, Eigen::Dynamic,
+                                          Eigen::Dynamic, Eigen::RowMajor>>
+          values);
+
+  /// Write scalar cell data with one value per cell
+  void write_cell_values(const std::string name,
+                         const std::vector<double>& values);
+
+  /// Close VTU file, writing appended data if required
+  void close();
+
+private:
+  // Write DataArray element. For ascii encoding, values are written
+  // inline, otherwise they are written to the appended data buffer
+  template <typename T>
+  void data_array(std::ofstream& file, const std::string name,
+                  int num_components, const T* data, std::size_t size);
+
+  // Write Piece header and points/cells of a mesh
+  void write_piece(std::ofstream& file, std::size_t num_points,
+                   std::size_t num_cells, const double* points,
+                   const std::int32_t* connectivity,
+                   int num_cell_points, std::uint8_t vtk_cell_type);
+
+  // Write point or cell data values, padding 2D vectors and tensors to
+  // 3D
+  void write_data(std::ofstream& file, const std::string location,
+                  const std::string name, std::size_t rank,
+                  std::size_t value_size, std::size_t num_entities,
+                  const PetscScalar* values);
+
+  // Open file for appending
+  std::ofstream open() const;
+
+  // VTU filename
+  const std::string _filename;
+
+  // DataArray encoding
+  const VTKFile::Encoding _encoding;
+
+  // Binary data written to the AppendedData section
+  std::vector<char> _appended_data;
 };
 } // namespace io
 } // namespace dolfin
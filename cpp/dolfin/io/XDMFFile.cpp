@@ -927,8 +927,10 @@ void XDMFFile::write_mesh_value_collection(
   const std::int64_t num_vertices_per_cell
       = mesh->type().num_vertices(cell_dim);
 
-  const std::map<std::pair<std::size_t, std::size_t>, T>& values = mvc.values();
-  const std::int64_t num_cells = values.size();
+  const std::vector<std::int32_t>& cells = mvc.cells();
+  const std::vector<std::int32_t>& local_entities = mvc.local_entities();
+  const std::vector<T>& value_data = mvc.values();
+  const std::int64_t num_cells = value_data.size();
   const std::int64_t num_cells_global = MPI::sum(mesh->mpi_comm(), num_cells);
 
   pugi::xml_node topology_node = mvc_grid_node.append_child("Topology");
@@ -939,32 +941,40 @@ void XDMFFile::write_mesh_value_collection(
   topology_node.append_attribute("NodesPerElement")
       = std::to_string(num_vertices_per_cell).c_str();
 
-  std::vector<std::int32_t> topology_data;
-  std::vector<T> value_data;
-  topology_data.reserve(num_cells * num_vertices_per_cell);
-  value_data.reserve(num_cells);
-
-  mesh->create_connectivity(tdim, cell_dim);
-  for (auto& p : values)
+  // Map (cell, local entity) to entity index
+  std::vector<std::int32_t> entities(cells);
+  if (cell_dim != tdim)
   {
-    mesh::MeshEntity cell = mesh::Cell(*mesh, p.first.first);
-    if (cell_dim != tdim)
-    {
-      const std::int32_t entity_local_idx
-          = cell.entities(cell_dim)[p.first.second];
-      cell = mesh::MeshEntity(*mesh, cell_dim, entity_local_idx);
-    }
+    mesh->create_connectivity(tdim, cell_dim);
+    const mesh::Connectivity& cell_entities
+        = *mesh->topology().connectivity(tdim, cell_dim);
+    for (std::int64_t i = 0; i < num_cells; ++i)
+      entities[i] = cell_entities.connections(cells[i])[local_entities[i]];
+  }
 
-    // if cell is actually a vertex
-    if (cell.dim() == 0)
-      topology_data.push_back(cell.global_index());
-    else
+  // Global vertex indices of each entity
+  const std::vector<std::int64_t>& global_vertices
+      = mesh->topology().global_indices(0);
+  std::vector<std::int32_t> topology_data(num_cells * num_vertices_per_cell);
+  if (cell_dim == 0)
+  {
+    for (std::int64_t i = 0; i < num_cells; ++i)
+      topology_data[i] = global_vertices[entities[i]];
+  }
+  else
+  {
+    mesh->create_connectivity(cell_dim, 0);
+    const mesh::Connectivity& entity_vertices
+        = *mesh->topology().connectivity(cell_dim, 0);
+    for (std::int64_t i = 0; i < num_cells; ++i)
     {
-      for (auto& v : mesh::EntityRange<mesh::Vertex>(cell))
-        topology_data.push_back(v.global_index());
+      const std::int32_t* vertices = entity_vertices.connections(entities[i]);
+      std::transform(vertices, vertices + num_vertices_per_cell,
+                     topology_data.begin() + i * num_vertices_per_cell,
+                     [&global_vertices](std::int32_t v) {
+                       return global_vertices[v];
+                     });
     }
-
-    value_data.push_back(p.second);
   }
 
   const std::string mvc_dataset_name
@@ -1185,16 +1195,20 @@ XDMFFile::read_mesh_value_collection(std::shared_ptr<const mesh::Mesh> mesh,
   MPI::all_to_all(_mpi_comm.comm(), send_entities, recv_entities);
   MPI::all_to_all(_mpi_comm.comm(), send_data, recv_data);
 
-  mesh::MeshValueCollection<T> mvc(mesh, dim);
+  std::vector<std::int32_t> entities;
+  std::vector<T> entity_values;
   for (std::int32_t i = 0; i != num_processes; ++i)
   {
     assert(recv_entities[i].size() == recv_data[i].size());
-    for (std::size_t j = 0; j != recv_data[i].size(); ++j)
-    {
-      mvc.set_value(recv_entities[i][j], recv_data[i][j]);
-    }
+    entities.insert(entities.end(), recv_entities[i].begin(),
+                    recv_entities[i].end());
+    entity_values.insert(entity_values.end(), recv_data[i].begin(),
+                         recv_data[i].end());
   }
 
+  mesh::MeshValueCollection<T> mvc(mesh, dim);
+  mvc.set_values(entities, entity_values);
+
   return mvc;
 }
 //-----------------------------------------------------------------------------
@@ -12,5 +12,6 @@ namespace dolfin
 // DOLFIN io interface
 
 #include <dolfin/io/HDF5File.h>
+#include <dolfin/io/HDF5MappedFile.h>
 #include <dolfin/io/VTKFile.h>
 #include <dolfin/io/XDMFFile.h>
@@ -133,7 +133,7 @@ void add_data_item(MPI_Comm comm, pugi::xml_node& xml_node, hid_t h5_id,
 
     const bool use_mpi_io = (dolfin::MPI::size(comm) > 1);
     HDF5Interface::write_dataset(h5_id, h5_path, x.data(), local_range, shape,
-                                 use_mpi_io, false);
+                                 use_mpi_io, HDF5Interface::DatasetOptions());
 
     // Add partitioning attribute to dataset
     std::vector<std::size_t> partitions;
@@ -24,6 +24,12 @@ namespace mesh
 /// number of entities and the number of connections for each entity,
 /// which may either be equal for all entities or different, or by
 /// giving the entire (sparse) connectivity pattern.
+///
+/// When all entities have the same number of connections (e.g.
+/// cell-vertex, cell-facet and edge-vertex connectivity), no offsets
+/// are stored and the connections of entity e start at e * degree.
+/// Offsets are only stored for connectivities with a variable number
+/// of connections per entity.
 
 class Connectivity
 {
@@ -45,7 +51,8 @@ public:
   /// std::vector<<std::set<std::size_t>>, etc)
   template <typename T>
   Connectivity(const std::vector<T>& connections)
-      : _index_to_position(connections.size() + 1)
+      : _index_to_position(connections.size() + 1),
+        _num_entities(connections.size()), _degree(-1)
   {
     // Initialize offsets and compute total size
     std::int32_t size = 0;
@@ -63,6 +70,8 @@ public:
 
     _connections = Eigen::Array<std::int32_t, Eigen::Dynamic, 1>(c.size());
     std::copy(c.begin(), c.end(), _connections.data());
+
+    compress_positions();
   }
 
   /// Copy constructor
@@ -80,17 +89,47 @@ public:
   /// Move assignment
   Connectivity& operator=(Connectivity&& connectivity) = default;
 
+  /// Return number of entities
+  std::int32_t num_entities() const { return _num_entities; }
+
+  /// Return true if all entities have the same number of connections
+  bool constant_degree() const { return _degree >= 0; }
+
   /// Return number of connections for given entity
-  std::size_t size(std::int32_t entity) const;
+  std::size_t size(std::int32_t entity) const
+  {
+    if (entity >= _num_entities)
+      return 0;
+    else if (_degree >= 0)
+      return _degree;
+    else
+      return _index_to_position[entity + 1] - _index_to_position[entity];
+  }
 
   /// Return global number of connections for given entity
   std::size_t size_global(std::int32_t entity) const;
 
   /// Return array of connections for given entity
-  std::int32_t* connections(int entity);
+  std::int32_t* connections(int entity)
+  {
+    if (entity >= _num_entities)
+      return nullptr;
+    else if (_degree >= 0)
+      return _connections.data() + (std::size_t)entity * _degree;
+    else
+      return _connections.data() + _index_to_position[entity];
+  }
 
   /// Return array of connections for given entity (const version)
-  const std::int32_t* connections(int entity) const;
+  const std::int32_t* connections(int entity) const
+  {
+    if (entity >= _num_entities)
+      return nullptr;
+    else if (_degree >= 0)
+      return _connections.data() + (std::size_t)entity * _degree;
+    else
+      return _connections.data() + _index_to_position[entity];
+  }
 
   /// Return contiguous array of connections for all entities
   Eigen::Ref<Eigen::Array<std::int32_t, Eigen::Dynamic, 1>> connections();
@@ -101,12 +140,9 @@ public:
   connections() const;
 
   /// Position of first connection in connections() for each entity
-  /// (using local index)
-  Eigen::Array<std::int32_t, Eigen::Dynamic, 1>& entity_positions();
-
-  /// Position of first connection in connections() for each entity
-  /// (using local index) (const version)
-  const Eigen::Array<std::int32_t, Eigen::Dynamic, 1>& entity_positions() const;
+  /// (using local index), with num_entities() + 1 entries. The offsets
+  /// are computed on each call for constant degree connectivities.
+  Eigen::Array<std::int32_t, Eigen::Dynamic, 1> entity_positions() const;
 
   /// Set global number of connections for each local entities
   void set_global_size(const Eigen::Array<std::int32_t, Eigen::Dynamic, 1>&
@@ -115,6 +151,9 @@ public:
   /// Hash of connections
   std::size_t hash() const;
 
+  /// Return memory (bytes) used to store the connectivity
+  std::size_t memory_usage() const;
+
   /// Return informal string representation (pretty-print)
   std::string str(bool verbose) const;
 
@@ -122,9 +161,19 @@ private:
   // Connections for all entities stored as a contiguous array
   Eigen::Array<std::int32_t, Eigen::Dynamic, 1> _connections;
 
-  // Position of first connection for each entity (using local index)
+  // Drop offsets if all entities have the same number of connections
+  void compress_positions();
+
+  // Position of first connection for each entity (using local index).
+  // Empty if the number of connections is constant.
   Eigen::Array<std::int32_t, Eigen::Dynamic, 1> _index_to_position;
 
+  // Number of entities
+  std::int32_t _num_entities;
+
+  // Number of connections per entity, or -1 if not constant
+  std::int32_t _degree;
+
   // Global number of connections for each entity (possibly not
   // computed)
   Eigen::Array<std::int32_t, Eigen::Dynamic, 1> _num_global_connections;
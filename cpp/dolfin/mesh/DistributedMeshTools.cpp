@@ -16,8 +16,11 @@
 #include "dolfin/graph/Graph.h"
 #include "dolfin/graph/SCOTCH.h"
 #include <Eigen/Dense>
+#include <algorithm>
 #include <complex>
 #include <dolfin/common/log.h>
+#include <iterator>
+#include <numeric>
 
 using namespace dolfin;
 using namespace dolfin::mesh;
@@ -25,43 +28,6 @@ using namespace dolfin::mesh;
 //-----------------------------------------------------------------------------
 namespace
 {
-typedef std::vector<std::size_t> Entity;
-
-// Data structure for mesh entity data
-struct EntityData
-{
-  // Constructor
-  EntityData() : local_index(0) {}
-
-  // Move constructor
-  EntityData(EntityData&&) = default;
-
-  // Move assignment
-  EntityData& operator=(EntityData&&) = default;
-
-  // Constructor  (index is local)
-  explicit EntityData(std::int32_t index) : local_index(index) {}
-
-  // Constructor (index is local)
-  EntityData(std::int32_t index, const std::vector<std::int32_t>& procs)
-      : local_index(index), processes(procs)
-  {
-    // Do nothing
-  }
-
-  // Constructor  (index is local)
-  EntityData(std::int32_t index, std::int32_t process)
-      : local_index(index), processes(1, process)
-  {
-    // Do nothing
-  }
-
-  // Local (this process) entity index
-  std::int32_t local_index;
-
-  // Processes on which entity resides
-  std::vector<std::int32_t> processes;
-};
 //-----------------------------------------------------------------------------
 template <typename T>
 Eigen::Array<T, Eigen::Dynamic, Eigen::Dynamic, Eigen::RowMajor>
@@ -136,370 +102,124 @@ reorder_values_by_global_indices(
   return new_values;
 }
 //-----------------------------------------------------------------------------
-// Compute and return (number of global entities, process offset)
-std::pair<std::size_t, std::size_t> compute_num_global_entities(
-    const MPI_Comm mpi_comm, std::size_t num_local_entities,
-    std::size_t num_processes, std::size_t process_number)
-{
-  // Communicate number of local entities
-  std::vector<std::size_t> num_entities_to_number;
-  dolfin::MPI::all_gather(mpi_comm, num_local_entities, num_entities_to_number);
-
-  // Compute offset
-  const std::size_t offset = std::accumulate(
-      num_entities_to_number.begin(),
-      num_entities_to_number.begin() + process_number, (std::size_t)0);
-
-  // Compute number of global entities
-  const std::size_t num_global
-      = std::accumulate(num_entities_to_number.begin(),
-                        num_entities_to_number.end(), (std::size_t)0);
-
-  return {num_global, offset};
-}
-//-----------------------------------------------------------------------------
-// Check if all entity vertices are the shared vertices in overlap
-bool is_shared(
-    const Entity& entity,
-    const std::map<std::size_t, std::set<std::int32_t>>& shared_vertices)
+// Return sorted list of processes that appear in a map of shared
+// entities (local index, [sharing processes]). For shared vertices this
+// is the shared-vertex graph, which is symmetric.
+std::vector<int> compute_neighbours(
+    const std::map<std::int32_t, std::set<std::int32_t>>& shared_entities)
 {
-  // Iterate over entity vertices
-  for (auto e = entity.cbegin(); e != entity.cend(); ++e)
-  {
-    // Return false if an entity vertex is not in the list (map) of
-    // shared entities
-    if (shared_vertices.find(*e) == shared_vertices.end())
-      return false;
-  }
-
-  return true;
-}
-//-----------------------------------------------------------------------------
-// Build preliminary 'guess' of shared entities. This function does not
-// involve any inter-process communication. Returns (owned_entities,
-// entity_ownership).
-std::pair<std::vector<std::size_t>, std::array<std::map<Entity, EntityData>, 2>>
-compute_preliminary_entity_ownership(
-    const MPI_Comm mpi_comm,
-    const std::map<std::size_t, std::set<std::int32_t>>& shared_vertices,
-    const std::map<Entity, std::int32_t>& entities)
-{
-  // Create  maps
-  std::vector<std::size_t> owned_entities;
-  std::array<std::map<Entity, EntityData>, 2> shared_entities;
-
-  // Entities
-  std::map<Entity, EntityData>& owned_shared_entities = shared_entities[0];
-  std::map<Entity, EntityData>& unowned_shared_entities = shared_entities[1];
-
-  // Get my process number
-  const std::int32_t process_number = dolfin::MPI::rank(mpi_comm);
-
-  // Iterate over all local entities
-  for (auto it = entities.cbegin(); it != entities.cend(); ++it)
-  {
-    const Entity& entity = it->first;
-    const std::size_t local_entity_index = it->second;
-
-    // Compute which processes entity is shared with
-    std::vector<std::int32_t> entity_processes;
-    if (is_shared(entity, shared_vertices))
-    {
-      // Processes sharing first vertex of entity
-      std::vector<std::size_t> intersection(
-          shared_vertices.find(entity[0])->second.begin(),
-          shared_vertices.find(entity[0])->second.end());
-      std::vector<std::size_t>::iterator intersection_end = intersection.end();
-
-      // Loop over entity vertices
-      for (std::size_t i = 1; i < entity.size(); ++i)
-      {
-        // Global vertex index
-        const std::size_t v = entity[i];
-
-        // Sharing processes
-        const std::set<std::int32_t>& shared_vertices_v
-            = shared_vertices.find(v)->second;
-
-        intersection_end = std::set_intersection(
-            intersection.begin(), intersection_end, shared_vertices_v.begin(),
-            shared_vertices_v.end(), intersection.begin());
-      }
-      entity_processes
-          = std::vector<std::int32_t>(intersection.begin(), intersection_end);
-    }
-
-    // Check if entity is master, slave or shared but not owned (shared
-    // with lower ranked process)
-    bool shared_but_not_owned = false;
-    for (std::size_t i = 0; i < entity_processes.size(); ++i)
-    {
-      if (entity_processes[i] < process_number)
-      {
-        shared_but_not_owned = true;
-        break;
-      }
-    }
-
-    if (entity_processes.empty())
-    {
-      owned_entities.push_back(local_entity_index);
-    }
-    else if (shared_but_not_owned)
-    {
-      unowned_shared_entities[entity]
-          = EntityData(local_entity_index, entity_processes);
-    }
-    else
-    {
-      owned_shared_entities[entity]
-          = EntityData(local_entity_index, entity_processes);
-    }
-  }
-
-  return {std::move(owned_entities), std::move(shared_entities)};
+  std::vector<int> neighbours;
+  for (const auto& e : shared_entities)
+    neighbours.insert(neighbours.end(), e.second.begin(), e.second.end());
+  std::sort(neighbours.begin(), neighbours.end());
+  neighbours.erase(std::unique(neighbours.begin(), neighbours.end()),
+                   neighbours.end());
+  return neighbours;
 }
 //-----------------------------------------------------------------------------
-// Communicate with other processes to finalise entity ownership
-void compute_final_entity_ownership(
-    const MPI_Comm mpi_comm, std::vector<std::size_t>& owned_entities,
-    std::array<std::map<Entity, EntityData>, 2>& shared_entities)
+// Compute the entities of dimension d that may be shared with other
+// processes, i.e. the entities whose vertices are all shared, and the
+// processes that share all vertices of each such entity. Returns
+// (candidate local entity indices sorted by key, keys (sorted global
+// vertex indices, num_entity_vertices per entity), offsets into
+// processes, processes).
+std::tuple<std::vector<std::int32_t>, std::vector<std::int64_t>,
+           std::vector<std::int32_t>, std::vector<std::int32_t>>
+compute_candidate_entities(const Mesh& mesh, int d,
+                           const std::vector<bool>& exclude)
 {
-  // Entities ([entity vertices], index) to be numbered
-  std::map<Entity, EntityData>& owned_shared_entities = shared_entities[0];
-  std::map<Entity, EntityData>& unowned_shared_entities = shared_entities[1];
-
-  // Get MPI number of processes and process number
-  const std::int32_t num_processes = dolfin::MPI::size(mpi_comm);
-  const std::int32_t process_number = dolfin::MPI::rank(mpi_comm);
-
-  // Communicate common entities, starting with the entities we think
-  // are shared but not owned
-  std::vector<std::vector<std::size_t>> send_common_entity_values(
-      num_processes);
-  for (auto it = unowned_shared_entities.cbegin();
-       it != unowned_shared_entities.cend(); ++it)
-  {
-    // Get entity vertices (global vertex indices)
-    const Entity& entity = it->first;
-
-    // Get entity processes (processes that might share the entity)
-    const std::vector<std::int32_t>& entity_processes = it->second.processes;
-
-    // Prepare data for sending
-    for (std::size_t j = 0; j < entity_processes.size(); ++j)
-    {
-      const std::size_t p = entity_processes[j];
-      send_common_entity_values[p].push_back(entity.size());
-      send_common_entity_values[p].insert(send_common_entity_values[p].end(),
-                                          entity.begin(), entity.end());
-    }
-  }
-
-  // Communicate common entities, add the entities we think are owned
-  // and shared
-  for (auto it = owned_shared_entities.cbegin();
-       it != owned_shared_entities.cend(); ++it)
-  {
-    // Get entity vertices (global vertex indices)
-    const Entity& entity = it->first;
-
-    // Get entity processes (processes that might share the entity)
-    const std::vector<std::int32_t>& entity_processes = it->second.processes;
-
-    // Prepare data for sending
-    for (std::size_t j = 0; j < entity_processes.size(); ++j)
-    {
-      const std::int32_t p = entity_processes[j];
-      assert(process_number < p);
-      send_common_entity_values[p].push_back(entity.size());
-      send_common_entity_values[p].insert(send_common_entity_values[p].end(),
-                                          entity.begin(), entity.end());
-    }
-  }
-
-  // Communicate common entities
-  std::vector<std::vector<std::size_t>> received_common_entity_values;
-  dolfin::MPI::all_to_all(mpi_comm, send_common_entity_values,
-                          received_common_entity_values);
-
-  // Check if entities received are really entities
-  std::vector<std::vector<std::size_t>> send_is_entity_values(num_processes);
-  for (std::int32_t p = 0; p < num_processes; ++p)
-  {
-    for (std::size_t i = 0; i < received_common_entity_values[p].size();)
-    {
-      // Get entity
-      const std::size_t entity_size = received_common_entity_values[p][i++];
-      Entity entity;
-      for (std::size_t j = 0; j < entity_size; ++j)
-        entity.push_back(received_common_entity_values[p][i++]);
-
-      // Check if received really is an entity on this process (in which
-      // case it will be in owned or unowned entities)
-      bool is_entity = false;
-      if (unowned_shared_entities.find(entity) != unowned_shared_entities.end()
-          || owned_shared_entities.find(entity) != owned_shared_entities.end())
-      {
-        is_entity = true;
-      }
-
-      // Add information about entity (whether it's actually an entity)
-      // to send to other processes
-      send_is_entity_values[p].push_back(entity_size);
-      for (std::size_t j = 0; j < entity_size; ++j)
-        send_is_entity_values[p].push_back(entity[j]);
-      send_is_entity_values[p].push_back(is_entity);
-    }
-  }
-
-  // Send data back (list of requested entities that are really
-  // entities)
-  std::vector<std::vector<std::size_t>> received_is_entity_values;
-  dolfin::MPI::all_to_all(mpi_comm, send_is_entity_values,
-                          received_is_entity_values);
-
-  // Create map from entities to processes where it is an entity
-  std::map<Entity, std::vector<std::int32_t>> entity_processes;
-  for (std::int32_t p = 0; p < num_processes; ++p)
-  {
-    for (std::size_t i = 0; i < received_is_entity_values[p].size();)
-    {
-      const std::size_t entity_size = received_is_entity_values[p][i++];
-      Entity entity;
-      for (std::size_t j = 0; j < entity_size; ++j)
-        entity.push_back(received_is_entity_values[p][i++]);
-      const std::size_t is_entity = received_is_entity_values[p][i++];
-      if (is_entity == 1)
-      {
-        // Add entity since it is actually an entity for process p
-        entity_processes[entity].push_back(p);
-      }
-    }
-  }
-
-  // Fix the list of entities we do not own (numbered by lower ranked
-  // process)
-  std::vector<std::vector<std::size_t>> unignore_entities;
-  std::map<Entity, EntityData>::iterator entity;
-  for (entity = unowned_shared_entities.begin();
-       entity != unowned_shared_entities.end(); ++entity)
-  {
-    const Entity& entity_vertices = entity->first;
-    EntityData& entity_data = entity->second;
-    const std::int32_t local_entity_index = entity_data.local_index;
-    if (entity_processes.find(entity_vertices) != entity_processes.end())
-    {
-      const std::vector<std::int32_t>& common_processes
-          = entity_processes[entity_vertices];
-      assert(!common_processes.empty());
-      const std::int32_t min_proc = *(
-          std::min_element(common_processes.begin(), common_processes.end()));
-
-      if (process_number < min_proc)
-      {
-        // Move from unowned to owned
-        owned_shared_entities[entity_vertices]
-            = EntityData(local_entity_index, common_processes);
-
-        // Add entity to list of entities that should be removed from
-        // the unowned entity list.
-        unignore_entities.push_back(entity_vertices);
-      }
-      else
-        entity_data.processes = common_processes;
-    }
-    else
+  const Topology& topology = mesh.topology();
+  const std::int32_t num_vertices = topology.size(0);
+  const std::int32_t num_entities = topology.size(d);
+  const int num_entity_vertices = mesh.type().num_vertices(d);
+  const std::vector<std::int64_t>& global_vertex_indices
+      = topology.global_indices(0);
+
+  // Flatten processes sharing each vertex (local index, [processes])
+  const std::map<std::int32_t, std::set<std::int32_t>>& shared_vertices
+      = topology.shared_entities(0);
+  std::vector<std::int32_t> vertex_offsets(num_vertices + 1, 0);
+  for (const auto& v : shared_vertices)
+    vertex_offsets[v.first + 1] = v.second.size();
+  std::partial_sum(vertex_offsets.begin(), vertex_offsets.end(),
+                   vertex_offsets.begin());
+  std::vector<std::int32_t> vertex_procs(vertex_offsets.back());
+  for (const auto& v : shared_vertices)
+  {
+    std::copy(v.second.begin(), v.second.end(),
+              vertex_procs.begin() + vertex_offsets[v.first]);
+  }
+
+  // Find entities with all vertices shared, and intersect the sharing
+  // processes of the vertices
+  std::shared_ptr<const Connectivity> entity_vertices
+      = topology.connectivity(d, 0);
+  assert(entity_vertices);
+  std::vector<std::int32_t> entities, entity_offsets(1, 0), entity_procs;
+  std::vector<std::int64_t> entity_keys;
+  std::vector<std::int32_t> procs, tmp;
+  for (std::int32_t e = 0; e < num_entities; ++e)
+  {
+    if (exclude[e])
+      continue;
+
+    const std::int32_t* v = entity_vertices->connections(e);
+    procs.assign(vertex_procs.begin() + vertex_offsets[v[0]],
+                 vertex_procs.begin() + vertex_offsets[v[0] + 1]);
+    for (int i = 1; i < num_entity_vertices and !procs.empty(); ++i)
     {
-      // Move from unowned to owned exclusively
-      owned_entities.push_back(local_entity_index);
-
-      // Add entity to list of entities that should be removed from the
-      // shared but not owned entity list
-      unignore_entities.push_back(entity_vertices);
+      tmp.clear();
+      std::set_intersection(procs.begin(), procs.end(),
+                            vertex_procs.begin() + vertex_offsets[v[i]],
+                            vertex_procs.begin() + vertex_offsets[v[i] + 1],
+                            std::back_inserter(tmp));
+      std::swap(procs, tmp);
     }
-  }
-
-  // Remove unowned shared entities that should not be shared
-  for (std::size_t i = 0; i < unignore_entities.size(); ++i)
-    unowned_shared_entities.erase(unignore_entities[i]);
 
-  // Fix the list of entities we share
-  std::vector<std::vector<std::size_t>> unshare_entities;
-  for (std::map<Entity, EntityData>::iterator it
-       = owned_shared_entities.begin();
-       it != owned_shared_entities.end(); ++it)
-  {
-    const Entity& e = it->first;
-    const std::int32_t local_entity_index = it->second.local_index;
-    if (entity_processes.find(e) == entity_processes.end())
-    {
-      // Move from shared to owned elusively
-      owned_entities.push_back(local_entity_index);
-      unshare_entities.push_back(e);
-    }
-    else
+    if (!procs.empty())
     {
-      // Update processor list of shared entities
-      it->second.processes = entity_processes[e];
+      entities.push_back(e);
+      for (int i = 0; i < num_entity_vertices; ++i)
+        entity_keys.push_back(global_vertex_indices[v[i]]);
+      std::sort(entity_keys.end() - num_entity_vertices, entity_keys.end());
+      entity_procs.insert(entity_procs.end(), procs.begin(), procs.end());
+      entity_offsets.push_back(entity_procs.size());
     }
   }
 
-  // Remove shared entities that should not be shared
-  for (std::size_t i = 0; i < unshare_entities.size(); ++i)
-    owned_shared_entities.erase(unshare_entities[i]);
-}
-//-----------------------------------------------------------------------------
-// Compute ownership of entities ([entity vertices], data)
-//  [0]: owned exclusively (will be numbered by this process)
-//  [1]: owned and shared (will be numbered by this process, and number
-//       communicated to other processes)
-//  [2]: not owned but shared (will be numbered by another process,
-//       and number communicated to this processes)
-//  Returns (owned_entities,  shared_entities)
-std::pair<std::vector<std::size_t>, std::array<std::map<Entity, EntityData>, 2>>
-compute_entity_ownership(
-    const MPI_Comm mpi_comm,
-    const std::map<std::vector<std::size_t>, std::int32_t>& entities,
-    const std::map<std::int32_t, std::set<std::int32_t>>& shared_vertices_local,
-    const std::vector<std::int64_t>& global_vertex_indices, std::size_t d)
-
-{
-  LOG(INFO) << "Compute ownership for mesh entities of dimension " << d;
-  common::Timer timer("Compute mesh entity ownership");
-
-  // Build global-to-local indices map for shared vertices
-  std::map<std::size_t, std::set<std::int32_t>> shared_vertices;
-  for (auto v = shared_vertices_local.cbegin();
-       v != shared_vertices_local.cend(); ++v)
-  {
-    //    assert(v->first < (int)global_vertex_indices.size());
-    shared_vertices.insert({global_vertex_indices[v->first], v->second});
-  }
-
-  // Entity ownership list ([entity vertices], data):
-  //  [0]: owned and shared (will be numbered by this process, and number
-  //       communicated to other processes)
-  //  [1]: not owned but shared (will be numbered by another process, and number
-  //       communicated to this processes)
-
-  // Compute preliminary ownership lists (shared_entities) without
-  // communication
-  std::vector<std::size_t> owned_entities;
-  std::array<std::map<Entity, EntityData>, 2> shared_entities;
-  std::tie(owned_entities, shared_entities)
-      = compute_preliminary_entity_ownership(mpi_comm, shared_vertices,
-                                             entities);
-
-  // Qualify boundary entities. We need to find out if the shared
-  // (shared with lower ranked process) entities are entities of a
-  // lower ranked process.  If not, this process becomes the lower
-  // ranked process for the entity in question, and is therefore
-  // responsible for communicating values to the higher ranked
-  // processes (if any).
-  compute_final_entity_ownership(mpi_comm, owned_entities, shared_entities);
-
-  return {std::move(owned_entities), std::move(shared_entities)};
+  // Sort candidate entities by key
+  std::vector<std::int32_t> order(entities.size());
+  std::iota(order.begin(), order.end(), 0);
+  std::sort(order.begin(), order.end(),
+            [&entity_keys, num_entity_vertices](std::int32_t a,
+                                                std::int32_t b) {
+              const std::int64_t* ka
+                  = entity_keys.data() + a * num_entity_vertices;
+              const std::int64_t* kb
+                  = entity_keys.data() + b * num_entity_vertices;
+              return std::lexicographical_compare(
+                  ka, ka + num_entity_vertices, kb, kb + num_entity_vertices);
+            });
+
+  std::vector<std::int32_t> sorted_entities(entities.size());
+  std::vector<std::int64_t> sorted_keys(entity_keys.size());
+  std::vector<std::int32_t> sorted_offsets(1, 0), sorted_procs;
+  sorted_procs.reserve(entity_procs.size());
+  for (std::size_t i = 0; i < order.size(); ++i)
+  {
+    const std::int32_t j = order[i];
+    sorted_entities[i] = entities[j];
+    std::copy(entity_keys.begin() + j * num_entity_vertices,
+              entity_keys.begin() + (j + 1) * num_entity_vertices,
+              sorted_keys.begin() + i * num_entity_vertices);
+    sorted_procs.insert(sorted_procs.end(),
+                        entity_procs.begin() + entity_offsets[j],
+                        entity_procs.begin() + entity_offsets[j + 1]);
+    sorted_offsets.push_back(sorted_procs.size());
+  }
+
+  return std::make_tuple(std::move(sorted_entities), std::move(sorted_keys),
+                         std::move(sorted_offsets), std::move(sorted_procs));
 }
 //-----------------------------------------------------------------------------
 
@@ -596,154 +316,168 @@ DistributedMeshTools::number_entities(
   const MPI_Comm mpi_comm = mesh.mpi_comm();
 
   // Get number of processes and process number
-  const std::size_t num_processes = MPI::size(mpi_comm);
-  const std::size_t process_number = MPI::rank(mpi_comm);
+  const int process_number = MPI::rank(mpi_comm);
 
   // Initialize entities of dimension d locally
   mesh.create_entities(d);
+  const std::int32_t num_entities = mesh.num_entities(d);
+  const int num_entity_vertices = mesh.type().num_vertices(d);
 
   // Build list of slave entities to exclude from ownership computation
-  std::vector<bool> exclude(mesh.num_entities(d), false);
+  std::vector<bool> exclude(num_entities, false);
   for (auto s = slave_entities.cbegin(); s != slave_entities.cend(); ++s)
     exclude[s->first] = true;
 
-  // Build entity global [vertex list]-to-[local entity index] map.
-  // Exclude any slave entities.
-  std::map<std::vector<std::size_t>, std::int32_t> entities;
-  std::pair<std::vector<std::size_t>, std::int32_t> entity;
-  for (auto& e : mesh::MeshRange<MeshEntity>(mesh, d, mesh::MeshRangeType::ALL))
-  {
-    const std::size_t local_index = e.index();
-    if (!exclude[local_index])
+  // Entities that may be shared are those with all vertices shared,
+  // and can only be shared with processes sharing all their vertices.
+  // No communication is required.
+  common::Timer t0("Number mesh entities: compute candidate shared entities");
+  std::vector<std::int32_t> candidates, candidate_offsets, candidate_procs;
+  std::vector<std::int64_t> candidate_keys;
+  std::tie(candidates, candidate_keys, candidate_offsets, candidate_procs)
+      = compute_candidate_entities(mesh, d, exclude);
+  t0.stop();
+
+  // Communication is only with processes that share vertices with this
+  // process (the shared-vertex graph is symmetric)
+  common::Timer t1("Number mesh entities: exchange shared entity keys");
+  const std::vector<int> neighbours
+      = compute_neighbours(mesh.topology().shared_entities(0));
+  std::map<int, int> proc_to_neighbour;
+  for (std::size_t i = 0; i < neighbours.size(); ++i)
+    proc_to_neighbour.insert({neighbours[i], i});
+  MPI_Comm neighbour_comm = MPI::create_neighbour_comm(mpi_comm, neighbours);
+
+  // Send key of each candidate entity to the processes that may share
+  // it. Keys are sent in sorted order.
+  std::vector<std::vector<std::int64_t>> send_keys(neighbours.size());
+  for (std::size_t i = 0; i < candidates.size(); ++i)
+  {
+    for (std::int32_t j = candidate_offsets[i]; j < candidate_offsets[i + 1];
+         ++j)
     {
-      entity.second = local_index;
-      entity.first = std::vector<std::size_t>();
-      for (auto& vertex : EntityRange<Vertex>(e))
-        entity.first.push_back(vertex.global_index());
-      std::sort(entity.first.begin(), entity.first.end());
-      entities.insert(entity);
+      std::vector<std::int64_t>& keys
+          = send_keys[proc_to_neighbour[candidate_procs[j]]];
+      keys.insert(keys.end(),
+                  candidate_keys.begin() + i * num_entity_vertices,
+                  candidate_keys.begin() + (i + 1) * num_entity_vertices);
     }
   }
+  std::vector<std::vector<std::int64_t>> recv_keys;
+  MPI::neighbour_all_to_all(neighbour_comm, send_keys, recv_keys);
+  send_keys.clear();
+
+  // A candidate entity is shared with a neighbour if the neighbour sent
+  // its key (a neighbour that has the entity shares all its vertices,
+  // so sends the key). Merge sorted received keys with sorted local
+  // keys. shared_with[n] lists the candidates (by position) shared with
+  // neighbour n, in key order.
+  std::vector<std::vector<std::int32_t>> sharing_procs(candidates.size());
+  std::vector<std::vector<std::int32_t>> shared_with(neighbours.size());
+  for (std::size_t n = 0; n < neighbours.size(); ++n)
+  {
+    const std::vector<std::int64_t>& keys = recv_keys[n];
+    const std::size_t num_recv = keys.size() / num_entity_vertices;
+    std::size_t i = 0, j = 0;
+    while (i < candidates.size() and j < num_recv)
+    {
+      const std::int64_t* k0 = candidate_keys.data() + i * num_entity_vertices;
+      const std::int64_t* k1 = keys.data() + j * num_entity_vertices;
+      if (std::lexicographical_compare(k0, k0 + num_entity_vertices, k1,
+                                       k1 + num_entity_vertices))
+      {
+        ++i;
+      }
+      else if (std::lexicographical_compare(k1, k1 + num_entity_vertices, k0,
+                                            k0 + num_entity_vertices))
+      {
+        ++j;
+      }
+      else
+      {
+        sharing_procs[i].push_back(neighbours[n]);
+        shared_with[n].push_back(i);
+        ++i;
+        ++j;
+      }
+    }
+  }
+  recv_keys.clear();
+  t1.stop();
 
-  // Get vertex global indices
-  const std::vector<std::int64_t>& global_vertex_indices
-      = mesh.topology().global_indices(0);
-
-  // Get shared vertices (local index, [sharing processes])
-  const std::map<std::int32_t, std::set<std::int32_t>>& shared_vertices_local
-      = mesh.topology().shared_entities(0);
-
-  // Compute ownership of entities of dimension d ([entity vertices], data):
-  //  [0]: owned and shared (will be numbered by this process, and number
-  //       communicated to other processes)
-  //  [1]: not owned but shared (will be numbered by another process, and number
-  //       communicated to this processes)
-  std::array<std::map<Entity, EntityData>, 2> entity_ownership;
-  std::vector<std::size_t> owned_entities;
-  std::tie(owned_entities, entity_ownership) = compute_entity_ownership(
-      mpi_comm, entities, shared_vertices_local, global_vertex_indices, d);
-
-  // Split shared entities for convenience
-  const std::map<Entity, EntityData>& owned_shared_entities
-      = entity_ownership[0];
-  std::map<Entity, EntityData>& unowned_shared_entities = entity_ownership[1];
-
-  // Number of entities 'owned' by this process
-  const std::size_t num_local_entities
-      = owned_entities.size() + owned_shared_entities.size();
-
-  // Compute global number of entities and local process offset
-  const std::pair<std::size_t, std::size_t> num_global_entities
-      = compute_num_global_entities(mpi_comm, num_local_entities, num_processes,
-                                    process_number);
-
-  // Extract offset
-  std::size_t offset = num_global_entities.second;
+  // Shared entities are owned by the lowest ranked process that has
+  // them. Number owned entities in local order.
+  common::Timer t2("Number mesh entities: number owned entities");
+  std::vector<int> entity_owner(num_entities, process_number);
+  for (std::size_t i = 0; i < candidates.size(); ++i)
+  {
+    for (std::int32_t p : sharing_procs[i])
+      entity_owner[candidates[i]] = std::min(entity_owner[candidates[i]], p);
+  }
+
+  std::int64_t num_owned = 0;
+  for (std::int32_t e = 0; e < num_entities; ++e)
+  {
+    if (!exclude[e] and entity_owner[e] == process_number)
+      ++num_owned;
+  }
+  std::int64_t offset = MPI::global_offset(mpi_comm, num_owned, true);
+  const std::size_t num_global_entities = MPI::sum(mpi_comm, num_owned);
 
   // Prepare list of global entity numbers. Check later that nothing is
   // equal to -1
-  global_entity_indices = std::vector<std::int64_t>(mesh.num_entities(d), -1);
-
-  // Number exclusively owned entities
-  for (std::size_t i = 0; i < owned_entities.size(); ++i)
-    global_entity_indices[owned_entities[i]] = offset++;
-
-  // Number shared entities that this process is responsible for
-  // numbering
-  for (auto it1 = owned_shared_entities.cbegin();
-       it1 != owned_shared_entities.cend(); ++it1)
+  global_entity_indices = std::vector<std::int64_t>(num_entities, -1);
+  for (std::int32_t e = 0; e < num_entities; ++e)
   {
-    global_entity_indices[it1->second.local_index] = offset++;
+    if (!exclude[e] and entity_owner[e] == process_number)
+      global_entity_indices[e] = offset++;
   }
+  t2.stop();
 
-  // Communicate indices for shared entities (owned by this process) and
-  // get indices for shared but not owned entities
-  std::vector<std::vector<std::size_t>> send_values(num_processes);
-  std::vector<std::size_t> destinations;
-  for (auto it1 = owned_shared_entities.cbegin();
-       it1 != owned_shared_entities.cend(); ++it1)
+  // Send global indices of owned shared entities to sharing processes.
+  // Both processes list the entities they share in key order, so only
+  // indices need to be sent.
+  common::Timer t3("Number mesh entities: exchange shared entity indices");
+  std::vector<std::vector<std::int64_t>> send_indices(neighbours.size());
+  for (std::size_t n = 0; n < neighbours.size(); ++n)
   {
-    // Get entity index
-    const std::int32_t local_entity_index = it1->second.local_index;
-    const std::int64_t global_entity_index
-        = global_entity_indices[local_entity_index];
-    assert(global_entity_index != -1);
-
-    // Get entity processes (processes sharing the entity)
-    const std::vector<std::int32_t>& entity_processes = it1->second.processes;
-
-    // Get entity vertices (global vertex indices)
-    const Entity& e = it1->first;
-
-    // Prepare data for sending
-    for (std::size_t j = 0; j < entity_processes.size(); ++j)
+    for (std::int32_t i : shared_with[n])
     {
-      // Store interleaved: entity index, number of vertices, global
-      // vertex indices
-      std::size_t p = entity_processes[j];
-      send_values[p].push_back(global_entity_index);
-      send_values[p].push_back(e.size());
-      send_values[p].insert(send_values[p].end(), e.begin(), e.end());
+      const std::int32_t e = candidates[i];
+      if (entity_owner[e] == process_number)
+        send_indices[n].push_back(global_entity_indices[e]);
     }
   }
+  std::vector<std::vector<std::int64_t>> recv_indices;
+  MPI::neighbour_all_to_all(neighbour_comm, send_indices, recv_indices);
+  MPI_Comm_free(&neighbour_comm);
 
-  // Send data
-  std::vector<std::vector<std::size_t>> received_values;
-  MPI::all_to_all(mpi_comm, send_values, received_values);
-
-  // Fill in global entity indices received from lower ranked processes
-  for (std::size_t p = 0; p < num_processes; ++p)
+  // Fill in global entity indices received from owning processes
+  for (std::size_t n = 0; n < neighbours.size(); ++n)
   {
-    for (std::size_t i = 0; i < received_values[p].size();)
+    std::size_t pos = 0;
+    for (std::int32_t i : shared_with[n])
     {
-      const std::size_t global_index = received_values[p][i++];
-      const std::size_t entity_size = received_values[p][i++];
-      Entity e;
-      for (std::size_t j = 0; j < entity_size; ++j)
-        e.push_back(received_values[p][i++]);
-
-      // Access unowned entity data
-      std::map<Entity, EntityData>::const_iterator recv_entity
-          = unowned_shared_entities.find(e);
-
-      // Sanity check, should not receive an entity we don't need
-      if (recv_entity == unowned_shared_entities.end())
+      const std::int32_t e = candidates[i];
+      if (entity_owner[e] == neighbours[n])
       {
-        std::stringstream msg;
-        msg << "Process " << MPI::rank(mpi_comm)
-            << " received illegal entity given by ";
-        msg << " with global index " << global_index;
-        msg << " from process " << p;
-        throw std::runtime_error(msg.str());
+        assert(pos < recv_indices[n].size());
+        assert(global_entity_indices[e] == -1);
+        global_entity_indices[e] = recv_indices[n][pos++];
       }
-
-      const std::size_t local_entity_index = recv_entity->second.local_index;
-      assert(global_entity_indices[local_entity_index] == -1);
-      global_entity_indices[local_entity_index] = global_index;
+    }
+    if (pos != recv_indices[n].size())
+    {
+      throw std::runtime_error("Process " + std::to_string(process_number)
+                               + " received wrong number of shared entity "
+                                 "indices from process "
+                               + std::to_string(neighbours[n]));
     }
   }
+  t3.stop();
 
   // Get slave indices from master
+  if (MPI::max(mpi_comm, (int)!slave_entities.empty()))
   {
     std::vector<std::vector<std::size_t>> slave_send_buffer(
         MPI::size(mpi_comm));
@@ -789,26 +523,20 @@ DistributedMeshTools::number_entities(
     assert(global_entity_indices[i] != -1);
   }
 
-  // Build shared_entities (global index, [sharing processes])
+  // Build shared_entities (local index, [sharing processes])
   shared_entities.clear();
-  for (auto e = owned_shared_entities.cbegin();
-       e != owned_shared_entities.cend(); ++e)
-  {
-    const EntityData& ed = e->second;
-    shared_entities[ed.local_index]
-        = std::set<std::int32_t>(ed.processes.begin(), ed.processes.end());
-  }
-  for (auto e = unowned_shared_entities.cbegin();
-       e != unowned_shared_entities.cend(); ++e)
+  for (std::size_t i = 0; i < candidates.size(); ++i)
   {
-    const EntityData& ed = e->second;
-    shared_entities[ed.local_index]
-        = std::set<std::int32_t>(ed.processes.begin(), ed.processes.end());
+    if (!sharing_procs[i].empty())
+    {
+      shared_entities[candidates[i]] = std::set<std::int32_t>(
+          sharing_procs[i].begin(), sharing_procs[i].end());
+    }
   }
 
   // Return
   return std::make_tuple(std::move(global_entity_indices),
-                         std::move(shared_entities), num_global_entities.first);
+                         std::move(shared_entities), num_global_entities);
 }
 //-----------------------------------------------------------------------------
 std::map<std::size_t, std::set<std::pair<std::size_t, std::size_t>>>
@@ -965,7 +693,6 @@ DistributedMeshTools::compute_shared_entities(const Mesh& mesh, std::size_t d)
 
   // MPI communicator
   const MPI_Comm mpi_comm = mesh.mpi_comm();
-  const int comm_size = MPI::size(mpi_comm);
 
   // Return empty set if running in serial
   if (MPI::size(mpi_comm) == 1)
@@ -988,110 +715,52 @@ DistributedMeshTools::compute_shared_entities(const Mesh& mesh, std::size_t d)
   const std::vector<std::int64_t>& global_indices_map
       = mesh.topology().global_indices(d);
 
-  // Global-to-local map for each process
-  std::unordered_map<std::size_t, std::unordered_map<std::size_t, std::size_t>>
-      global_to_local;
-
-  // Pack global indices for sending to sharing processes
-  std::vector<std::vector<std::size_t>> send_indices(comm_size);
-  std::vector<std::vector<std::size_t>> local_sent_indices(comm_size);
-  for (auto shared_entity = shared_entities.cbegin();
-       shared_entity != shared_entities.cend(); ++shared_entity)
-  {
-    // Local index
-    const std::int32_t local_index = shared_entity->first;
-
-    // Global index
+  // List entities shared with each neighbour as (global index, local
+  // index), sorted by global index so that the order is the same on
+  // both processes
+  const std::vector<int> neighbours = compute_neighbours(shared_entities);
+  std::map<int, int> proc_to_neighbour;
+  for (std::size_t i = 0; i < neighbours.size(); ++i)
+    proc_to_neighbour.insert({neighbours[i], i});
+  std::vector<std::vector<std::pair<std::int64_t, std::int32_t>>> shared_with(
+      neighbours.size());
+  for (const auto& shared_entity : shared_entities)
+  {
+    const std::int32_t local_index = shared_entity.first;
     assert(local_index < (std::int32_t)global_indices_map.size());
-    std::size_t global_index = global_indices_map[local_index];
-
-    // Destination process
-    const std::set<std::int32_t>& sharing_processes = shared_entity->second;
-
-    // Pack data for sending and build global-to-local map
-    for (auto dest = sharing_processes.cbegin();
-         dest != sharing_processes.cend(); ++dest)
+    for (std::int32_t p : shared_entity.second)
     {
-      send_indices[*dest].push_back(global_index);
-      local_sent_indices[*dest].push_back(local_index);
-      global_to_local[*dest].insert({global_index, local_index});
+      shared_with[proc_to_neighbour[p]].push_back(
+          {global_indices_map[local_index], local_index});
     }
   }
 
-  std::vector<std::vector<std::size_t>> recv_entities;
-  MPI::all_to_all(mpi_comm, send_indices, recv_entities);
-
-  // Clear send data
-  send_indices.clear();
-  send_indices.resize(comm_size);
-
-  // Determine local entities indices for received global entity indices
-  for (std::size_t p = 0; p < recv_entities.size(); ++p)
+  // Send local indices to sharing processes, in global index order
+  std::vector<std::vector<std::int32_t>> send_indices(neighbours.size());
+  for (std::size_t n = 0; n < neighbours.size(); ++n)
   {
-    // Get process number of neighbour
-    const std::size_t sending_proc = p;
-
-    if (recv_entities[p].size() > 0)
-    {
-      // Get global-to-local map for neighbour process
-      std::unordered_map<
-          std::size_t,
-          std::unordered_map<std::size_t, std::size_t>>::const_iterator it
-          = global_to_local.find(sending_proc);
-      assert(it != global_to_local.end());
-      const std::unordered_map<std::size_t, std::size_t>&
-          neighbour_global_to_local
-          = it->second;
-
-      // Build vector of local indices
-      const std::vector<std::size_t>& global_indices_recv = recv_entities[p];
-      for (std::size_t i = 0; i < global_indices_recv.size(); ++i)
-      {
-        // Global index
-        const std::size_t global_index = global_indices_recv[i];
-
-        // Find local index corresponding to global index
-        std::unordered_map<std::size_t, std::size_t>::const_iterator
-            n_global_to_local
-            = neighbour_global_to_local.find(global_index);
-
-        assert(n_global_to_local != neighbour_global_to_local.end());
-        const std::size_t my_local_index = n_global_to_local->second;
-        send_indices[sending_proc].push_back(my_local_index);
-      }
-    }
+    std::sort(shared_with[n].begin(), shared_with[n].end());
+    for (const auto& e : shared_with[n])
+      send_indices[n].push_back(e.second);
   }
 
-  MPI::all_to_all(mpi_comm, send_indices, recv_entities);
+  MPI_Comm neighbour_comm = MPI::create_neighbour_comm(mpi_comm, neighbours);
+  std::vector<std::vector<std::int32_t>> recv_indices;
+  MPI::neighbour_all_to_all(neighbour_comm, send_indices, recv_indices);
+  MPI_Comm_free(&neighbour_comm);
 
   // Build map
   std::unordered_map<std::int32_t,
                      std::vector<std::pair<std::int32_t, std::int32_t>>>
       shared_local_indices_map;
-
-  // Loop over data received from each process
-  for (std::size_t p = 0; p < recv_entities.size(); ++p)
+  for (std::size_t n = 0; n < neighbours.size(); ++n)
   {
-    if (recv_entities[p].size() > 0)
+    // Check that sizes match
+    assert(recv_indices[n].size() == shared_with[n].size());
+    for (std::size_t i = 0; i < shared_with[n].size(); ++i)
     {
-      // Process that shares entities
-      const std::size_t proc = p;
-
-      // Local indices on sharing process
-      const std::vector<std::size_t>& neighbour_local_indices
-          = recv_entities[p];
-
-      // Local indices on this process
-      const std::vector<std::size_t>& my_local_indices = local_sent_indices[p];
-
-      // Check that sizes match
-      assert(my_local_indices.size() == neighbour_local_indices.size());
-
-      for (std::size_t i = 0; i < neighbour_local_indices.size(); ++i)
-      {
-        shared_local_indices_map[my_local_indices[i]].push_back(
-            {proc, neighbour_local_indices[i]});
-      }
+      shared_local_indices_map[shared_with[n][i].second].push_back(
+          {neighbours[n], recv_indices[n][i]});
     }
   }
 
@@ -54,11 +54,37 @@ Geometry::points() const
   return _coordinates;
 }
 //-----------------------------------------------------------------------------
+void Geometry::set_points(
+    const Eigen::Ref<const Eigen::Array<double, Eigen::Dynamic, Eigen::Dynamic,
+                                        Eigen::RowMajor>>& x)
+{
+  if (x.rows() != _coordinates.rows())
+  {
+    throw std::runtime_error("Cannot set geometry points. Number of points ("
+                             + std::to_string(x.rows())
+                             + ") does not match the geometry ("
+                             + std::to_string(_coordinates.rows()) + ")");
+  }
+  if (x.cols() != _dim and x.cols() != 3)
+  {
+    throw std::runtime_error("Cannot set geometry points. Number of columns ("
+                             + std::to_string(x.cols())
+                             + ") must be the geometric dimension or 3");
+  }
+
+  _coordinates.block(0, 0, x.rows(), x.cols()) = x;
+  ++_version;
+}
+//-----------------------------------------------------------------------------
+void Geometry::mark_modified() { ++_version; }
+//-----------------------------------------------------------------------------
 const std::vector<std::int64_t>& Geometry::global_indices() const
 {
   return _global_indices;
 }
 //-----------------------------------------------------------------------------
+std::size_t Geometry::version() const { return _version; }
+//-----------------------------------------------------------------------------
 std::size_t Geometry::hash() const
 {
   // Compute local hash
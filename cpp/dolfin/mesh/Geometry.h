@@ -63,7 +63,9 @@ public:
   x(std::size_t n) const;
 
   // Should this return an Eigen::Ref?
-  /// Return array of coordinates for all points
+  /// Return array of coordinates for all points. Call mark_modified()
+  /// after modifying the coordinates through the returned reference,
+  /// or use set_points().
   Eigen::Array<double, Eigen::Dynamic, 3, Eigen::RowMajor>&
   points();
 
@@ -72,9 +74,25 @@ public:
   const Eigen::Array<double, Eigen::Dynamic, 3, Eigen::RowMajor>&
   points() const;
 
+  /// Set coordinates for all points and increment version(). The
+  /// number of columns must be the geometric dimension or 3.
+  void set_points(const Eigen::Ref<const Eigen::Array<
+                      double, Eigen::Dynamic, Eigen::Dynamic,
+                      Eigen::RowMajor>>& x);
+
+  /// Increment version() after modifying the coordinates through
+  /// points()
+  void mark_modified();
+
   /// Global indices for points (const)
   const std::vector<std::int64_t>& global_indices() const;
 
+  /// Return a counter that is incremented each time the coordinates
+  /// are modified through set_points() or marked modified with
+  /// mark_modified(). Data computed from the coordinates can be cached
+  /// with the version it was computed for.
+  std::size_t version() const;
+
   /// Hash of coordinate values
   ///
   /// @returns std::size_t
@@ -101,6 +119,9 @@ private:
 
   // Global number of points (taking account of shared points)
   std::uint64_t _num_points_global;
+
+  // Modification counter for the coordinates
+  std::size_t _version = 0;
 };
 } // namespace mesh
 } // namespace dolfin
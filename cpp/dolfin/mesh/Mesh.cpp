@@ -18,6 +18,7 @@
 #include "Vertex.h"
 #include <dolfin/common/MPI.h>
 #include <dolfin/common/Timer.h>
+#include <dolfin/common/log.h>
 #include <dolfin/common/utils.h>
 
 using namespace dolfin;
@@ -300,11 +301,36 @@ void Mesh::create_connectivity(std::size_t d0, std::size_t d1) const
   if (_topology->connectivity(d0, d1))
     return;
 
+  // Time and log recomputation of released connectivity
+  std::unique_ptr<common::Timer> timer;
+  if (_topology->released(d0, d1))
+  {
+    LOG(INFO) << "Recomputing released mesh connectivity " << d0 << " - "
+              << d1;
+    timer = std::make_unique<common::Timer>(
+        "Recompute released connectivity");
+  }
+
   // Compute connectivity
   Mesh* mesh = const_cast<Mesh*>(this);
   TopologyComputation::compute_connectivity(*mesh, d0, d1);
 }
 //-----------------------------------------------------------------------------
+std::size_t Mesh::release_connectivity()
+{
+  const std::size_t budget = _topology->connectivity_budget();
+  if (budget == 0)
+    return 0;
+
+  const std::size_t bytes = _topology->release_connectivity(budget);
+  if (bytes > 0)
+  {
+    LOG(INFO) << "Released " << bytes
+              << " bytes of mesh connectivity (budget " << budget << ")";
+  }
+  return bytes;
+}
+//-----------------------------------------------------------------------------
 void Mesh::create_connectivity_all() const
 {
   // Compute all entities
@@ -197,6 +197,18 @@ public:
   /// Compute all entities and connectivity.
   void create_connectivity_all() const;
 
+  /// Release rebuildable connectivity, least recently computed first,
+  /// until the connectivity memory use is within the topology
+  /// connectivity budget (see Topology::set_connectivity_budget).
+  /// Connectivity is only released by this function, so connectivity
+  /// created by create_entities and create_connectivity stays available
+  /// until it is called. Released connectivity is recomputed by
+  /// create_connectivity.
+  ///
+  /// @return std::size_t
+  ///         Number of bytes released.
+  std::size_t release_connectivity();
+
   /// Compute global indices for entity dimension dim
   void create_global_indices(std::size_t dim) const;
 
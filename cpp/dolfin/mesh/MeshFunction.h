@@ -224,50 +224,34 @@ MeshFunction<T>::MeshFunction(std::shared_ptr<const Mesh> mesh,
   const std::size_t D = _mesh->topology().dim();
   assert(d <= D);
 
+  // Values are stored by (cell index, local entity)
+  const std::vector<std::int32_t>& cells = value_collection.cells();
+  const std::vector<std::int32_t>& local_entities
+      = value_collection.local_entities();
+  const std::vector<T>& values = value_collection.values();
+  if (d == D)
+  {
+    for (std::size_t i = 0; i < cells.size(); ++i)
+    {
+      assert(local_entities[i] == 0);
+      assert(cells[i] < (std::int32_t)_values.size());
+      _values[cells[i]] = values[i];
+    }
+    return;
+  }
+
   // Generate connectivity if it does not exist
   _mesh->create_connectivity(D, d);
   assert(_mesh->topology().connectivity(D, d));
   const Connectivity& connectivity = *_mesh->topology().connectivity(D, d);
-
-  // Iterate over all values
-  std::unordered_set<std::size_t> entities_values_set;
-  typename std::map<std::pair<std::size_t, std::size_t>, T>::const_iterator it;
-  const std::map<std::pair<std::size_t, std::size_t>, T>& values
-      = value_collection.values();
-  for (it = values.begin(); it != values.end(); ++it)
+  for (std::size_t i = 0; i < cells.size(); ++i)
   {
-    // Get value collection entry data
-    const std::size_t cell_index = it->first.first;
-    const std::size_t local_entity = it->first.second;
-    const T& value = it->second;
-
-    std::size_t entity_index = 0;
-    if (d != D)
-    {
-      // Get global (local to to process) entity index
-      assert(cell_index < _mesh->num_entities(D));
-      entity_index = connectivity.connections(cell_index)[local_entity];
-    }
-    else
-    {
-      entity_index = cell_index;
-      assert(local_entity == 0);
-    }
-
-    // Set value for entity
-    assert(entity_index < _values.size());
-    _values[entity_index] = value;
-
-    // Add entity index to set (used to check that all values are set)
-    entities_values_set.insert(entity_index);
+    assert(cells[i] < (std::int32_t)_mesh->num_entities(D));
+    const std::int32_t entity_index
+        = connectivity.connections(cells[i])[local_entities[i]];
+    assert(entity_index < (std::int32_t)_values.size());
+    _values[entity_index] = values[i];
   }
-
-  // Check that all values have been set, if not issue a debug message
-  // if (entities_values_set.size() != _values.size())
-  // {
-  //       "Mesh value collection does not contain all values for all
-  //       entities");
-  // }
 }
 //---------------------------------------------------------------------------
 template <typename T>
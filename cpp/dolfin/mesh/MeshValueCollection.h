@@ -6,14 +6,19 @@
 
 #pragma once
 
-#include "Cell.h"
+#include "Connectivity.h"
 #include "Mesh.h"
-#include "MeshEntity.h"
 #include "MeshFunction.h"
+#include "Topology.h"
+#include <algorithm>
+#include <cstdint>
 #include <dolfin/common/Variable.h>
-#include <map>
 #include <memory>
+#include <numeric>
+#include <sstream>
+#include <tuple>
 #include <utility>
+#include <vector>
 
 namespace dolfin
 {
@@ -99,7 +104,9 @@ public:
 
   // FIXME: remove
   /// Set marker value for given entity defined by a cell index and
-  /// a local entity index
+  /// a local entity index. Values are stored sorted by (cell index,
+  /// local entity), so inserting many values out of order is
+  /// O(n) per value; use set_values in that case.
   ///
   /// @param    cell_index (std::size_t)
   ///         The index of the cell.
@@ -126,6 +133,30 @@ public:
   ///         an existing value.
   bool set_value(std::size_t entity_index, const T& value);
 
+  /// Set values for entities defined by cell indices and local entity
+  /// indices. Existing values for the same entities are overwritten,
+  /// and if an entity appears more than once the last value is used.
+  ///
+  /// @param    cells (std::vector<std::int32_t>)
+  ///         The cell indices.
+  /// @param    local_entities (std::vector<std::int32_t>)
+  ///         The local indices of the entities relative to the cells.
+  /// @param    values (std::vector<T>)
+  ///         The marker values.
+  void set_values(const std::vector<std::int32_t>& cells,
+                  const std::vector<std::int32_t>& local_entities,
+                  const std::vector<T>& values);
+
+  /// Set values for entities given by entity index. Existing values
+  /// for the same entities are overwritten.
+  ///
+  /// @param    entities (std::vector<std::int32_t>)
+  ///         The entity indices.
+  /// @param    values (std::vector<T>)
+  ///         The marker values.
+  void set_values(const std::vector<std::int32_t>& entities,
+                  const std::vector<T>& values);
+
   /// Get marker value for given entity defined by a cell index and
   /// a local entity index
   ///
@@ -136,19 +167,25 @@ public:
   ///
   /// @return    marker_value (T)
   ///         The value of the marker.
-  T get_value(std::size_t cell_index, std::size_t local_entity);
+  T get_value(std::size_t cell_index, std::size_t local_entity) const;
 
-  /// Get all values
+  /// Get cell index of each value, sorted by (cell index, local entity)
   ///
-  /// @return    std::map<std::pair<std::size_t, std::size_t>, T>
-  ///         A map from positions to values.
-  std::map<std::pair<std::size_t, std::size_t>, T>& values();
+  /// @return    std::vector<std::int32_t>
+  ///         The cell indices.
+  const std::vector<std::int32_t>& cells() const;
 
-  /// Get all values (const version)
+  /// Get local entity index (relative to the cell) of each value
   ///
-  /// @return    std::map<std::pair<std::size_t, std::size_t>, T>
-  ///         A map from positions to values.
-  const std::map<std::pair<std::size_t, std::size_t>, T>& values() const;
+  /// @return    std::vector<std::int32_t>
+  ///         The local entity indices.
+  const std::vector<std::int32_t>& local_entities() const;
+
+  /// Get all values, in the order of cells() and local_entities()
+  ///
+  /// @return    std::vector<T>
+  ///         The values.
+  const std::vector<T>& values() const;
 
   /// Clear all values
   void clear();
@@ -166,11 +203,25 @@ private:
   // Associated mesh
   std::shared_ptr<const Mesh> _mesh;
 
+  // Set values from a MeshFunction
+  void assign(const MeshFunction<T>& mesh_function);
+
+  // Return position of (cell_index, local_entity) in the sorted
+  // arrays, or the position at which it would be inserted
+  std::size_t find(std::int32_t cell_index, std::int32_t local_entity) const;
+
+  // Return (cell index, local entity) of given entity
+  std::pair<std::int32_t, std::int32_t>
+  cell_entity(std::int32_t entity_index) const;
+
   // Topological dimension
   int _dim;
 
-  // The values
-  std::map<std::pair<std::size_t, std::size_t>, T> _values;
+  // Cell index, local entity index and value of each entry, sorted by
+  // (cell index, local entity)
+  std::vector<std::int32_t> _cells;
+  std::vector<std::int32_t> _local_entities;
+  std::vector<T> _values;
 };
 
 //---------------------------------------------------------------------------
@@ -190,45 +241,7 @@ MeshValueCollection<T>::MeshValueCollection(
     : common::Variable("m"), _mesh(mesh_function.mesh()),
       _dim(mesh_function.dim())
 {
-  assert(_mesh);
-  const std::size_t D = _mesh->topology().dim();
-
-  // Handle cells as a special case
-  if ((int)D == _dim)
-  {
-    for (std::size_t cell_index = 0; cell_index < mesh_function.size();
-         ++cell_index)
-    {
-      const std::pair<std::size_t, std::size_t> key(cell_index, 0);
-      _values.insert({key, mesh_function[cell_index]});
-    }
-  }
-  else
-  {
-    _mesh->create_connectivity(_dim, D);
-    const Connectivity& connectivity = _mesh->topology().connectivity(_dim, D);
-    for (std::size_t entity_index = 0; entity_index < mesh_function.size();
-         ++entity_index)
-    {
-      // Find the cell
-      assert(connectivity.size(entity_index) > 0);
-      const MeshEntity entity(*_mesh, _dim, entity_index);
-      for (std::size_t i = 0; i < entity.num_entities(D); ++i)
-      {
-        // Create cell
-        const mesh::Cell cell(*_mesh,
-                              connectivity.connections(entity_index)[i]);
-
-        // Find the local entity index
-        const std::size_t local_entity = cell.index(entity);
-
-        // Insert into map
-        const std::pair<std::size_t, std::size_t> key(cell.index(),
-                                                      local_entity);
-        _values.insert({key, mesh_function[entity_index]});
-      }
-    }
-  }
+  assign(mesh_function);
 }
 //---------------------------------------------------------------------------
 template <typename T>
@@ -237,51 +250,51 @@ operator=(const MeshFunction<T>& mesh_function)
 {
   _mesh = mesh_function.mesh();
   _dim = mesh_function.dim();
-
+  assign(mesh_function);
+  return *this;
+}
+//---------------------------------------------------------------------------
+template <typename T>
+void MeshValueCollection<T>::assign(const MeshFunction<T>& mesh_function)
+{
   assert(_mesh);
-  const std::size_t D = _mesh->topology().dim();
+  const int D = _mesh->topology().dim();
+  const std::int32_t num_cells = _mesh->topology().size(D);
 
-  // FIXME: Use iterators
+  _cells.clear();
+  _local_entities.clear();
+  _values.clear();
 
   // Handle cells as a special case
-  if ((int)D == _dim)
+  if (D == _dim)
   {
-    for (std::size_t cell_index = 0; cell_index < mesh_function.size();
-         ++cell_index)
-    {
-      const std::pair<std::size_t, std::size_t> key(cell_index, 0);
-      _values.insert({key, mesh_function[cell_index]});
-    }
+    _cells.resize(num_cells);
+    std::iota(_cells.begin(), _cells.end(), 0);
+    _local_entities.assign(num_cells, 0);
+    _values.assign(mesh_function.values(),
+                   mesh_function.values() + num_cells);
+    return;
   }
-  else
+
+  // Every (cell, local entity) pair is stored, which in cell order is
+  // sorted by construction
+  _mesh->create_connectivity(D, _dim);
+  assert(_mesh->topology().connectivity(D, _dim));
+  const Connectivity& connectivity = *_mesh->topology().connectivity(D, _dim);
+  const std::size_t size = connectivity.connections().size();
+  _cells.reserve(size);
+  _local_entities.reserve(size);
+  _values.reserve(size);
+  for (std::int32_t c = 0; c < num_cells; ++c)
   {
-    _mesh->create_connectivity(_dim, D);
-    assert(_mesh->topology().connectivity(_dim, D));
-    const Connectivity& connectivity = *_mesh->topology().connectivity(_dim, D);
-    for (std::size_t entity_index = 0; entity_index < mesh_function.size();
-         ++entity_index)
+    const std::int32_t* entities = connectivity.connections(c);
+    for (std::size_t i = 0; i < connectivity.size(c); ++i)
     {
-      // Find the cell
-      assert(connectivity.size(entity_index) > 0);
-      const MeshEntity entity(*_mesh, _dim, entity_index);
-      for (std::size_t i = 0; i < entity.num_entities(D); ++i)
-      {
-        // Create cell
-        const mesh::Cell cell(*_mesh,
-                              connectivity.connections(entity_index)[i]);
-
-        // Find the local entity index
-        const std::size_t local_entity = cell.index(entity);
-
-        // Insert into map
-        const std::pair<std::size_t, std::size_t> key(cell.index(),
-                                                      local_entity);
-        _values.insert({key, mesh_function[entity_index]});
-      }
+      _cells.push_back(c);
+      _local_entities.push_back(i);
+      _values.push_back(mesh_function[entities[i]]);
     }
   }
-
-  return *this;
 }
 //---------------------------------------------------------------------------
 template <typename T>
@@ -321,17 +334,19 @@ bool MeshValueCollection<T>::set_value(std::size_t cell_index,
         "A mesh has not been associated with this MeshValueCollection");
   }
 
-  const std::pair<std::size_t, std::size_t> pos(cell_index, local_entity);
-  std::pair<typename std::map<std::pair<std::size_t, std::size_t>, T>::iterator,
-            bool>
-      it = _values.insert({pos, value});
-
-  // If an item with same key already exists the value has not been
-  // set and we need to update it
-  if (!it.second)
-    it.first->second = value;
+  // If an item with same key already exists, update it
+  const std::size_t pos = find(cell_index, local_entity);
+  if (pos < _cells.size() and _cells[pos] == (std::int32_t)cell_index
+      and _local_entities[pos] == (std::int32_t)local_entity)
+  {
+    _values[pos] = value;
+    return false;
+  }
 
-  return it.second;
+  _cells.insert(_cells.begin() + pos, cell_index);
+  _local_entities.insert(_local_entities.begin() + pos, local_entity);
+  _values.insert(_values.begin() + pos, value);
+  return true;
 }
 //---------------------------------------------------------------------------
 template <typename T>
@@ -344,94 +359,190 @@ bool MeshValueCollection<T>::set_value(std::size_t entity_index, const T& value)
   }
 
   assert(_dim >= 0);
-
-  // Special case when d = D
-  const std::size_t D = _mesh->topology().dim();
-  if (_dim == (int)D)
+  const std::pair<std::int32_t, std::int32_t> pos = cell_entity(entity_index);
+  return set_value(pos.first, pos.second, value);
+}
+//---------------------------------------------------------------------------
+template <typename T>
+void MeshValueCollection<T>::set_values(
+    const std::vector<std::int32_t>& cells,
+    const std::vector<std::int32_t>& local_entities,
+    const std::vector<T>& values)
+{
+  assert(_dim >= 0);
+  if (!_mesh)
   {
-    // Set local entity index to zero when we mark a cell
-    const std::pair<std::size_t, std::size_t> pos(entity_index, 0);
-    std::pair<
-        typename std::map<std::pair<std::size_t, std::size_t>, T>::iterator,
-        bool>
-        it;
-    it = _values.insert({pos, value});
-
-    // If an item with same key already exists the value has not been
-    // set and we need to update it
-    if (!it.second)
-      it.first->second = value;
-
-    return it.second;
+    throw std::runtime_error(
+        "A mesh has not been associated with this MeshValueCollection");
+  }
+  if (cells.size() != local_entities.size() or cells.size() != values.size())
+  {
+    throw std::runtime_error(
+        "Cannot set MeshValueCollection values. Array sizes do not match");
   }
 
-  // Get mesh connectivity d --> D
-  _mesh->create_connectivity(_dim, D);
-  assert(_mesh->topology().connectivity(_dim, D));
-  const Connectivity& connectivity = *_mesh->topology().connectivity(_dim, D);
-
-  // Find the cell
-  assert(connectivity.size(entity_index) > 0);
-  const MeshEntity entity(*_mesh, _dim, entity_index);
-  const mesh::Cell cell(
-      *_mesh, connectivity.connections(entity_index)[0]); // choose first
-
-  // Find the local entity index
-  const std::size_t local_entity = cell.index(entity);
-
-  // Add value
-  const std::pair<std::size_t, std::size_t> pos(cell.index(), local_entity);
-  std::pair<typename std::map<std::pair<std::size_t, std::size_t>, T>::iterator,
-            bool>
-      it;
-  it = _values.insert({pos, value});
+  // Order existing entries followed by the new entries by key. The
+  // sort is stable, so the last entry of a key is the most recent.
+  const std::size_t n0 = _cells.size();
+  const std::size_t n = n0 + cells.size();
+  std::vector<std::int32_t> order(n);
+  std::iota(order.begin(), order.end(), 0);
+  auto key = [&](std::int32_t i) {
+    return (std::size_t)i < n0
+               ? std::make_pair(_cells[i], _local_entities[i])
+               : std::make_pair(cells[i - n0], local_entities[i - n0]);
+  };
+  std::stable_sort(order.begin(), order.end(),
+                   [&key](std::int32_t a, std::int32_t b) {
+                     return key(a) < key(b);
+                   });
+
+  // Build sorted arrays, keeping the last entry of each key
+  std::vector<std::int32_t> new_cells, new_local_entities;
+  std::vector<T> new_values;
+  new_cells.reserve(n);
+  new_local_entities.reserve(n);
+  new_values.reserve(n);
+  for (std::size_t j = 0; j < n; ++j)
+  {
+    const std::int32_t i = order[j];
+    if (j + 1 < n and key(order[j + 1]) == key(i))
+      continue;
+
+    const std::pair<std::int32_t, std::int32_t> k = key(i);
+    new_cells.push_back(k.first);
+    new_local_entities.push_back(k.second);
+    new_values.push_back((std::size_t)i < n0 ? _values[i] : values[i - n0]);
+  }
 
-  // If an item with same key already exists the value has not been
-  // set and we need to update it
-  if (!it.second)
-    it.first->second = value;
+  _cells = std::move(new_cells);
+  _local_entities = std::move(new_local_entities);
+  _values = std::move(new_values);
+}
+//---------------------------------------------------------------------------
+template <typename T>
+void MeshValueCollection<T>::set_values(
+    const std::vector<std::int32_t>& entities, const std::vector<T>& values)
+{
+  if (!_mesh)
+  {
+    throw std::runtime_error(
+        "A mesh has not been associated with this MeshValueCollection");
+  }
+  if (entities.size() != values.size())
+  {
+    throw std::runtime_error(
+        "Cannot set MeshValueCollection values. Array sizes do not match");
+  }
 
-  return it.second;
+  std::vector<std::int32_t> cells(entities.size()),
+      local_entities(entities.size());
+  for (std::size_t i = 0; i < entities.size(); ++i)
+    std::tie(cells[i], local_entities[i]) = cell_entity(entities[i]);
+  set_values(cells, local_entities, values);
 }
 //---------------------------------------------------------------------------
 template <typename T>
 T MeshValueCollection<T>::get_value(std::size_t cell_index,
-                                    std::size_t local_entity)
+                                    std::size_t local_entity) const
 {
   assert(_dim >= 0);
 
-  const std::pair<std::size_t, std::size_t> pos(cell_index, local_entity);
-  const typename std::map<std::pair<std::size_t, std::size_t>,
-                          T>::const_iterator it
-      = _values.find(pos);
-
-  if (it == _values.end())
+  const std::size_t pos = find(cell_index, local_entity);
+  if (pos == _cells.size() or _cells[pos] != (std::int32_t)cell_index
+      or _local_entities[pos] != (std::int32_t)local_entity)
   {
     throw std::runtime_error(
         "No value stored for cell index: " + std::to_string(cell_index)
         + " and local index: " + std::to_string(local_entity));
   }
 
-  return it->second;
+  return _values[pos];
 }
 //---------------------------------------------------------------------------
 template <typename T>
-std::map<std::pair<std::size_t, std::size_t>, T>&
-MeshValueCollection<T>::values()
+const std::vector<std::int32_t>& MeshValueCollection<T>::cells() const
 {
-  return _values;
+  return _cells;
+}
+//---------------------------------------------------------------------------
+template <typename T>
+const std::vector<std::int32_t>& MeshValueCollection<T>::local_entities() const
+{
+  return _local_entities;
 }
 //---------------------------------------------------------------------------
 template <typename T>
-const std::map<std::pair<std::size_t, std::size_t>, T>&
-MeshValueCollection<T>::values() const
+const std::vector<T>& MeshValueCollection<T>::values() const
 {
   return _values;
 }
 //---------------------------------------------------------------------------
 template <typename T>
+std::size_t MeshValueCollection<T>::find(std::int32_t cell_index,
+                                         std::int32_t local_entity) const
+{
+  // Binary search on (cell index, local entity). Appending in order is
+  // the common case, so check the end first.
+  const std::size_t n = _cells.size();
+  if (n == 0
+      or std::make_pair(_cells[n - 1], _local_entities[n - 1])
+             < std::make_pair(cell_index, local_entity))
+  {
+    return n;
+  }
+
+  std::size_t lo = 0, hi = n;
+  while (lo < hi)
+  {
+    const std::size_t mid = lo + (hi - lo) / 2;
+    if (std::make_pair(_cells[mid], _local_entities[mid])
+        < std::make_pair(cell_index, local_entity))
+    {
+      lo = mid + 1;
+    }
+    else
+      hi = mid;
+  }
+  return lo;
+}
+//---------------------------------------------------------------------------
+template <typename T>
+std::pair<std::int32_t, std::int32_t>
+MeshValueCollection<T>::cell_entity(std::int32_t entity_index) const
+{
+  // Special case when d = D: set local entity index to zero
+  const int D = _mesh->topology().dim();
+  if (_dim == D)
+    return {entity_index, 0};
+
+  // Get mesh connectivity d --> D and D --> d
+  _mesh->create_connectivity(_dim, D);
+  _mesh->create_connectivity(D, _dim);
+  assert(_mesh->topology().connectivity(_dim, D));
+  assert(_mesh->topology().connectivity(D, _dim));
+  const Connectivity& entity_cells = *_mesh->topology().connectivity(_dim, D);
+  const Connectivity& cell_entities = *_mesh->topology().connectivity(D, _dim);
+
+  // Find the cell (choose first)
+  assert(entity_cells.size(entity_index) > 0);
+  const std::int32_t c = entity_cells.connections(entity_index)[0];
+
+  // Find the local entity index
+  const std::int32_t* entities = cell_entities.connections(c);
+  const std::int32_t local_entity
+      = std::find(entities, entities + cell_entities.size(c), entity_index)
+        - entities;
+  assert(local_entity < (std::int32_t)cell_entities.size(c));
+
+  return {c, local_entity};
+}
+//---------------------------------------------------------------------------
+template <typename T>
 void MeshValueCollection<T>::clear()
 {
+  _cells.clear();
+  _local_entities.clear();
   _values.clear();
 }
 //---------------------------------------------------------------------------
@@ -6,8 +6,11 @@
 
 #include "Partitioning.h"
 #include "CellType.h"
+#include "Connectivity.h"
+#include "CoordinateDofs.h"
 #include "DistributedMeshTools.h"
 #include "Facet.h"
+#include "Geometry.h"
 #include "Mesh.h"
 #include "MeshEntity.h"
 #include "MeshFunction.h"
@@ -16,12 +19,16 @@
 #include "Topology.h"
 #include "Vertex.h"
 #include <algorithm>
+#include <cmath>
+#include <complex>
 #include <cstdint>
 #include <dolfin/common/MPI.h>
 #include <dolfin/common/Set.h>
+#include <dolfin/common/TimeLogManager.h>
 #include <dolfin/common/Timer.h>
 #include <dolfin/graph/CSRGraph.h>
 #include <dolfin/graph/GraphBuilder.h>
+#include <dolfin/graph/Hilbert.h>
 #include <dolfin/graph/ParMETIS.h>
 #include <dolfin/graph/SCOTCH.h>
 #include <iterator>
@@ -594,39 +601,280 @@ mesh::Mesh build(const MPI_Comm& comm, mesh::CellType::Type type,
   return mesh;
 }
 //-----------------------------------------------------------------------------
+// Scale cell weights (num_constraints columns, or no rows) to integers
+// in the range [1, 1000], relative to the global maximum of each
+// constraint. Returns weights in row-major order.
+std::vector<std::int64_t>
+scale_cell_weights(const MPI_Comm& mpi_comm,
+                   const Eigen::Ref<const EigenRowArrayXXd>& cell_weights,
+                   std::int32_t num_constraints)
+{
+  assert(cell_weights.rows() == 0 or cell_weights.cols() == num_constraints);
+  std::vector<double> max_weights(num_constraints, 0.0);
+  for (std::int32_t j = 0; j < num_constraints; ++j)
+  {
+    if (cell_weights.rows() > 0)
+      max_weights[j] = cell_weights.col(j).maxCoeff();
+  }
+  MPI_Allreduce(MPI_IN_PLACE, max_weights.data(), num_constraints,
+                MPI_DOUBLE, MPI_MAX, mpi_comm);
+
+  std::vector<std::int64_t> weights(cell_weights.rows() * num_constraints);
+  for (Eigen::Index i = 0; i < cell_weights.rows(); ++i)
+  {
+    for (std::int32_t j = 0; j < num_constraints; ++j)
+    {
+      const double w = (max_weights[j] > 0.0)
+                           ? cell_weights(i, j) / max_weights[j]
+                           : 1.0;
+      weights[i * num_constraints + j]
+          = std::max((std::int64_t)1, (std::int64_t)std::round(1000.0 * w));
+    }
+  }
+
+  return weights;
+}
+//-----------------------------------------------------------------------------
+// Compute the midpoint of each cell from the coordinates of its
+// vertices, which are fetched from the processes holding them
+EigenRowArrayXXd
+compute_midpoints(const MPI_Comm& mpi_comm,
+                  const Eigen::Ref<const EigenRowArrayXXi64>& cell_vertices,
+                  int num_cell_vertices,
+                  const Eigen::Ref<const EigenRowArrayXXd>& points)
+{
+  // Sorted list of vertices of the local cells
+  std::vector<std::int64_t> vertices;
+  vertices.reserve(cell_vertices.rows() * num_cell_vertices);
+  for (Eigen::Index c = 0; c < cell_vertices.rows(); ++c)
+    for (int j = 0; j < num_cell_vertices; ++j)
+      vertices.push_back(cell_vertices(c, j));
+  std::sort(vertices.begin(), vertices.end());
+  vertices.erase(std::unique(vertices.begin(), vertices.end()),
+                 vertices.end());
+
+  const EigenRowArrayXXd x
+      = Partitioning::distribute_points(mpi_comm, points, vertices).first;
+
+  EigenRowArrayXXd midpoints
+      = EigenRowArrayXXd::Zero(cell_vertices.rows(), points.cols());
+  for (Eigen::Index c = 0; c < cell_vertices.rows(); ++c)
+  {
+    for (int j = 0; j < num_cell_vertices; ++j)
+    {
+      const std::int32_t v
+          = std::lower_bound(vertices.begin(), vertices.end(),
+                             cell_vertices(c, j))
+            - vertices.begin();
+      midpoints.row(c) += x.row(v);
+    }
+  }
+  midpoints /= num_cell_vertices;
+
+  return midpoints;
+}
+//-----------------------------------------------------------------------------
+// Compute the processes that need a copy of each cell as a ghost, for a
+// partition computed without the dual graph. The destinations of the
+// cells containing each vertex are gathered on the process owning the
+// vertex (by index), and a cell is ghosted on each process that has
+// cells containing all vertices of one of its facets.
+std::map<std::int64_t, std::vector<int>>
+compute_ghost_procs(const MPI_Comm& mpi_comm, const mesh::CellType& cell_type,
+                    const Eigen::Ref<const EigenRowArrayXXi64>& cell_vertices,
+                    const std::vector<int>& part)
+{
+  const int mpi_size = dolfin::MPI::size(mpi_comm);
+  const int num_cell_vertices = cell_type.num_vertices();
+  const std::int32_t num_cells = cell_vertices.rows();
+
+  std::int64_t max_vertex = -1;
+  if (num_cells > 0)
+    max_vertex = cell_vertices.leftCols(num_cell_vertices).maxCoeff();
+  const std::int64_t num_vertices = dolfin::MPI::max(mpi_comm, max_vertex) + 1;
+
+  // Send (vertex, cell destination) to the owner of each vertex
+  std::vector<std::vector<std::int64_t>> send_data(mpi_size);
+  for (std::int32_t c = 0; c < num_cells; ++c)
+  {
+    for (int j = 0; j < num_cell_vertices; ++j)
+    {
+      const std::int64_t v = cell_vertices(c, j);
+      const int owner = dolfin::MPI::index_owner(mpi_comm, v, num_vertices);
+      send_data[owner].push_back(v);
+      send_data[owner].push_back(part[c]);
+    }
+  }
+  std::vector<std::vector<std::int64_t>> recv_data;
+  dolfin::MPI::all_to_all(mpi_comm, send_data, recv_data);
+
+  // Destinations of the cells containing each owned vertex
+  std::map<std::int64_t, std::vector<int>> vertex_procs;
+  for (const auto& data : recv_data)
+    for (std::size_t i = 0; i < data.size(); i += 2)
+      vertex_procs[data[i]].push_back(data[i + 1]);
+  for (auto& procs : vertex_procs)
+  {
+    std::sort(procs.second.begin(), procs.second.end());
+    procs.second.erase(std::unique(procs.second.begin(), procs.second.end()),
+                       procs.second.end());
+  }
+
+  // Return (number of processes, processes) for each request
+  std::vector<std::vector<std::int64_t>> send_procs(mpi_size);
+  for (int p = 0; p < mpi_size; ++p)
+  {
+    for (std::size_t i = 0; i < recv_data[p].size(); i += 2)
+    {
+      const std::vector<int>& procs = vertex_procs[recv_data[p][i]];
+      send_procs[p].push_back(procs.size());
+      send_procs[p].insert(send_procs[p].end(), procs.begin(), procs.end());
+    }
+  }
+  std::vector<std::vector<std::int64_t>> recv_procs;
+  dolfin::MPI::all_to_all(mpi_comm, send_procs, recv_procs);
+
+  // Local vertices of each facet of a cell
+  const int tdim = cell_type.dim();
+  std::vector<std::int32_t> local_vertices(num_cell_vertices);
+  std::iota(local_vertices.begin(), local_vertices.end(), 0);
+  Eigen::Array<std::int32_t, Eigen::Dynamic, Eigen::Dynamic, Eigen::RowMajor>
+      facets;
+  cell_type.create_entities(facets, tdim - 1, local_vertices.data());
+
+  // Unpack processes of each cell vertex (in the order of the requests)
+  // and intersect over the vertices of each facet
+  std::map<std::int64_t, std::vector<int>> ghost_procs;
+  std::vector<std::size_t> pos(mpi_size, 0);
+  std::vector<std::vector<int>> procs(num_cell_vertices);
+  std::vector<int> facet_procs, tmp;
+  for (std::int32_t c = 0; c < num_cells; ++c)
+  {
+    for (int j = 0; j < num_cell_vertices; ++j)
+    {
+      const int owner = dolfin::MPI::index_owner(
+          mpi_comm, cell_vertices(c, j), num_vertices);
+      const std::vector<std::int64_t>& data = recv_procs[owner];
+      const std::int64_t n = data[pos[owner]];
+      procs[j].assign(data.begin() + pos[owner] + 1,
+                      data.begin() + pos[owner] + 1 + n);
+      pos[owner] += n + 1;
+    }
+
+    std::vector<int> sharing_processes = {part[c]};
+    for (Eigen::Index f = 0; f < facets.rows(); ++f)
+    {
+      facet_procs = procs[facets(f, 0)];
+      for (Eigen::Index j = 1; j < facets.cols(); ++j)
+      {
+        const std::vector<int>& p = procs[facets(f, j)];
+        tmp.clear();
+        std::set_intersection(facet_procs.begin(), facet_procs.end(),
+                              p.begin(), p.end(), std::back_inserter(tmp));
+        std::swap(facet_procs, tmp);
+      }
+
+      for (int p : facet_procs)
+      {
+        if (std::find(sharing_processes.begin(), sharing_processes.end(), p)
+            == sharing_processes.end())
+        {
+          sharing_processes.push_back(p);
+        }
+      }
+    }
+
+    if (sharing_processes.size() > 1)
+      ghost_procs.insert({c, std::move(sharing_processes)});
+  }
+
+  return ghost_procs;
+}
+//-----------------------------------------------------------------------------
 // Compute cell partitioning from local mesh data. Returns a vector
 // 'cell -> process' vector for cells, and a map 'local cell index ->
 // processes' to which ghost cells must be sent
 PartitionData
 partition_cells(const MPI_Comm& mpi_comm, mesh::CellType::Type type,
                 const Eigen::Ref<const EigenRowArrayXXi64>& cell_vertices,
-                const std::string partitioner)
+                const Eigen::Ref<const EigenRowArrayXXd>& points,
+                const mesh::GhostMode ghost_mode,
+                const std::string partitioner,
+                const Eigen::Ref<const EigenRowArrayXXd>& cell_weights)
 {
   LOG(INFO) << "Compute partition of cells across processes";
 
   std::unique_ptr<mesh::CellType> cell_type(mesh::CellType::create(type));
   assert(cell_type);
 
-  // Compute dual graph (for this partition)
-  std::vector<std::vector<std::size_t>> local_graph;
-  std::tuple<std::int32_t, std::int32_t, std::int32_t> graph_info;
-  std::tie(local_graph, graph_info) = graph::GraphBuilder::compute_dual_graph(
-      mpi_comm, cell_vertices, *cell_type);
+  // Scale weights to integers. All processes must agree on the number
+  // of constraints, except processes without cells. The check is
+  // reduced so that all processes throw together.
+  const std::int32_t num_constraints
+      = dolfin::MPI::max(mpi_comm, (std::int32_t)cell_weights.cols());
+  const bool valid_weights
+      = num_constraints == 0
+        or (cell_weights.rows() == cell_vertices.rows()
+            and (cell_weights.rows() == 0
+                 or cell_weights.cols() == num_constraints));
+  if (dolfin::MPI::max(mpi_comm, (int)!valid_weights) > 0)
+  {
+    throw std::runtime_error("Cannot partition cells. Cell weights must have "
+                             "one row per cell and the same number of "
+                             "constraints on all processes");
+  }
+  const std::vector<std::int64_t> weights
+      = scale_cell_weights(mpi_comm, cell_weights, num_constraints);
 
-  // Compute cell partition using partitioner from parameter system
+  // Sum of the scaled constraints, for partitioners supporting a single
+  // constraint
+  std::vector<std::int64_t> summed_weights;
+  if (num_constraints > 0)
+  {
+    summed_weights.assign(cell_vertices.rows(), 0);
+    for (std::size_t i = 0; i < summed_weights.size(); ++i)
+      for (std::int32_t j = 0; j < num_constraints; ++j)
+        summed_weights[i] += weights[i * num_constraints + j];
+  }
+
+  // Compute geometric partition of cell midpoints, which avoids
+  // building the dual graph
+  if (partitioner == "Hilbert")
+  {
+    const EigenRowArrayXXd midpoints = compute_midpoints(
+        mpi_comm, cell_vertices, cell_type->num_vertices(), points);
+    const std::vector<int> part
+        = graph::Hilbert::partition(mpi_comm, midpoints, summed_weights);
+    if (ghost_mode == mesh::GhostMode::none)
+      return PartitionData(part, {});
+    else
+    {
+      return PartitionData(
+          part, compute_ghost_procs(mpi_comm, *cell_type, cell_vertices, part));
+    }
+  }
+
+  // Compute dual graph (for this partition) and cell partition using
+  // partitioner from parameter system
   if (partitioner == "SCOTCH")
   {
-    graph::CSRGraph<SCOTCH_Num> csr_graph(mpi_comm, local_graph);
-    std::vector<std::size_t> weights;
-    const std::int32_t num_ghost_nodes = std::get<0>(graph_info);
-    return PartitionData(graph::SCOTCH::partition(mpi_comm, csr_graph, weights,
-                                                  num_ghost_nodes));
+    const auto dual_graph = graph::GraphBuilder::compute_dual_graph<SCOTCH_Num>(
+        mpi_comm, cell_vertices, *cell_type);
+    const std::vector<std::size_t> node_weights(summed_weights.begin(),
+                                                summed_weights.end());
+    const std::int32_t num_ghost_nodes = std::get<0>(dual_graph.second);
+    return PartitionData(graph::SCOTCH::partition(
+        mpi_comm, dual_graph.first, node_weights, num_ghost_nodes));
   }
   else if (partitioner == "ParMETIS")
   {
 #ifdef HAS_PARMETIS
-    graph::CSRGraph<idx_t> csr_graph(mpi_comm, local_graph);
-    return PartitionData(graph::ParMETIS::partition(mpi_comm, csr_graph));
+    const auto dual_graph = graph::GraphBuilder::compute_dual_graph<idx_t>(
+        mpi_comm, cell_vertices, *cell_type);
+    const graph::CSRGraph<idx_t>& csr_graph = dual_graph.first;
+    const std::vector<idx_t> node_weights(weights.begin(), weights.end());
+    return PartitionData(graph::ParMETIS::partition(
+        mpi_comm, csr_graph, node_weights, std::max(num_constraints, 1)));
 #else
     throw std::runtime_error("ParMETIS not available");
 #endif
@@ -637,6 +885,282 @@ partition_cells(const MPI_Comm& mpi_comm, mesh::CellType::Type type,
   return PartitionData({}, {});
 }
 //-----------------------------------------------------------------------------
+// Register load imbalance (maximum over average process load) with the
+// timing system
+void register_imbalance(const std::string task,
+                        const std::vector<double>& process_loads)
+{
+  const double max_load
+      = *std::max_element(process_loads.begin(), process_loads.end());
+  const double avg_load
+      = std::accumulate(process_loads.begin(), process_loads.end(), 0.0)
+        / process_loads.size();
+  const double imbalance = (avg_load > 0.0) ? max_load / avg_load : 1.0;
+
+  LOG(INFO) << task << ": " << imbalance;
+  common::TimeLogManager::logger().register_timing(
+      task, std::make_tuple(imbalance, 0.0, 0.0));
+}
+//-----------------------------------------------------------------------------
+// Compute key for each of the given entities of dimension dim, which
+// is the sorted list of global point indices of the entity vertices.
+// The global vertex indices of higher-order meshes depend on the
+// partition, so vertices are identified by the global index of their
+// point, which is found through the cell vertices and cell points
+// (the vertices of a cell are its first points, in the same order).
+std::vector<std::int64_t> entity_keys(const mesh::Mesh& mesh, int dim,
+                                      const std::vector<std::int32_t>& entities)
+{
+  const int tdim = mesh.topology().dim();
+  const std::vector<std::int64_t>& global_points
+      = mesh.geometry().global_indices();
+  const mesh::Connectivity& cell_vertices
+      = *mesh.topology().connectivity(tdim, 0);
+  const mesh::Connectivity& cell_points
+      = mesh.coordinate_dofs().entity_points(tdim);
+  const int num_cell_vertices = mesh.type().num_vertices();
+  std::vector<std::int64_t> vertex_points(mesh.num_entities(0), -1);
+  for (std::int32_t c = 0; c < (std::int32_t)mesh.num_entities(tdim); ++c)
+  {
+    const std::int32_t* vertices = cell_vertices.connections(c);
+    const std::int32_t* points = cell_points.connections(c);
+    for (int j = 0; j < num_cell_vertices; ++j)
+      vertex_points[vertices[j]] = global_points[points[j]];
+  }
+
+  const int num_vertices = mesh.type().num_vertices(dim);
+  std::vector<std::int64_t> keys(entities.size() * num_vertices);
+  if (dim == 0)
+  {
+    for (std::size_t i = 0; i < entities.size(); ++i)
+      keys[i] = vertex_points[entities[i]];
+    return keys;
+  }
+
+  const mesh::Connectivity& connectivity
+      = *mesh.topology().connectivity(dim, 0);
+  for (std::size_t i = 0; i < entities.size(); ++i)
+  {
+    const std::int32_t* vertices = connectivity.connections(entities[i]);
+    auto key = keys.begin() + i * num_vertices;
+    for (int j = 0; j < num_vertices; ++j)
+      key[j] = vertex_points[vertices[j]];
+    std::sort(key, key + num_vertices);
+  }
+
+  return keys;
+}
+//-----------------------------------------------------------------------------
+// Create communicator to the given destination processes (which may
+// contain duplicates), and return it with the neighbour index of each
+// destination process
+std::pair<MPI_Comm, std::map<int, int>>
+create_destination_comm(MPI_Comm comm, std::vector<int> dests)
+{
+  std::sort(dests.begin(), dests.end());
+  dests.erase(std::unique(dests.begin(), dests.end()), dests.end());
+  MPI_Comm neighbour_comm = dolfin::MPI::create_sparse_comm(comm, dests);
+  const std::vector<int> destinations
+      = dolfin::MPI::neighbours(neighbour_comm).second;
+  std::map<int, int> dest_to_neighbour;
+  for (std::size_t i = 0; i < destinations.size(); ++i)
+    dest_to_neighbour.insert({destinations[i], i});
+  return {neighbour_comm, std::move(dest_to_neighbour)};
+}
+//-----------------------------------------------------------------------------
+// Compute plan for sending values on the entities of dimension dim of
+// a mesh to the matching entities of new_mesh. Entities are matched at
+// a rendezvous process determined by the lowest global point index of
+// the entity. Only processes that exchange data communicate. Returns a
+// communicator from the processes sending values to the processes
+// receiving values (to be freed by the caller), the local entities
+// whose values this process sends to each destination neighbour, and
+// the local entity in new_mesh for each value received (in the order
+// received by MPI::neighbour_all_to_all on the communicator).
+std::tuple<MPI_Comm, std::vector<std::vector<std::int32_t>>,
+           std::vector<std::int32_t>>
+compute_migration_plan(const mesh::Mesh& mesh, const mesh::Mesh& new_mesh,
+                       int dim)
+{
+  common::Timer timer("Compute mesh migration plan");
+
+  MPI_Comm mpi_comm = mesh.mpi_comm();
+  const int tdim = mesh.topology().dim();
+  const int num_vertices = mesh.type().num_vertices(dim);
+  const std::int64_t num_points_global = mesh.geometry().num_points_global();
+
+  mesh.create_entities(dim);
+  new_mesh.create_entities(dim);
+
+  // Entities of owned cells of mesh
+  std::vector<std::int32_t> entities;
+  const std::int32_t num_cells = mesh.topology().ghost_offset(tdim);
+  if (dim == tdim)
+  {
+    entities.resize(num_cells);
+    std::iota(entities.begin(), entities.end(), 0);
+  }
+  else
+  {
+    mesh.create_connectivity(tdim, dim);
+    const mesh::Connectivity& cell_entities
+        = *mesh.topology().connectivity(tdim, dim);
+    std::vector<bool> seen(mesh.num_entities(dim), false);
+    for (std::int32_t c = 0; c < num_cells; ++c)
+    {
+      const std::int32_t* e = cell_entities.connections(c);
+      for (std::size_t i = 0; i < cell_entities.size(c); ++i)
+      {
+        if (!seen[e[i]])
+        {
+          seen[e[i]] = true;
+          entities.push_back(e[i]);
+        }
+      }
+    }
+  }
+
+  // Send keys of entities in mesh and in new_mesh, with the local
+  // entity index, to the rendezvous process. Each key is sent as
+  // (0 for mesh or 1 for new_mesh, vertices, local index).
+  std::vector<std::int32_t> new_entities(new_mesh.num_entities(dim));
+  std::iota(new_entities.begin(), new_entities.end(), 0);
+  const std::vector<std::int64_t> keys = entity_keys(mesh, dim, entities);
+  const std::vector<std::int64_t> new_keys
+      = entity_keys(new_mesh, dim, new_entities);
+  const std::size_t key_size = num_vertices + 2;
+
+  std::vector<int> rendezvous(entities.size() + new_entities.size());
+  for (std::size_t i = 0; i < entities.size(); ++i)
+  {
+    rendezvous[i] = dolfin::MPI::index_owner(
+        mpi_comm, keys[i * num_vertices], num_points_global);
+  }
+  for (std::size_t i = 0; i < new_entities.size(); ++i)
+  {
+    rendezvous[entities.size() + i] = dolfin::MPI::index_owner(
+        mpi_comm, new_keys[i * num_vertices], num_points_global);
+  }
+
+  MPI_Comm key_comm;
+  std::map<int, int> dest_to_neighbour;
+  std::tie(key_comm, dest_to_neighbour)
+      = create_destination_comm(mpi_comm, rendezvous);
+  std::vector<std::vector<std::int64_t>> send_keys(dest_to_neighbour.size());
+  for (std::size_t i = 0; i < entities.size(); ++i)
+  {
+    std::vector<std::int64_t>& send
+        = send_keys[dest_to_neighbour[rendezvous[i]]];
+    const auto key = keys.begin() + i * num_vertices;
+    send.push_back(0);
+    send.insert(send.end(), key, key + num_vertices);
+    send.push_back(entities[i]);
+  }
+  for (std::size_t i = 0; i < new_entities.size(); ++i)
+  {
+    std::vector<std::int64_t>& send
+        = send_keys[dest_to_neighbour[rendezvous[entities.size() + i]]];
+    const auto key = new_keys.begin() + i * num_vertices;
+    send.push_back(1);
+    send.insert(send.end(), key, key + num_vertices);
+    send.push_back(new_entities[i]);
+  }
+
+  std::vector<std::vector<std::int64_t>> recv_keys;
+  dolfin::MPI::neighbour_all_to_all(key_comm, send_keys, recv_keys);
+  const std::vector<int> key_sources
+      = dolfin::MPI::neighbours(key_comm).first;
+  MPI_Comm_free(&key_comm);
+
+  // Map from key to (process, local index) in mesh. Shared entities
+  // are received from several processes, and any one can be used.
+  std::map<std::vector<std::int64_t>, std::pair<std::int32_t, std::int64_t>>
+      key_to_source;
+  for (std::size_t n = 0; n < recv_keys.size(); ++n)
+  {
+    for (auto it = recv_keys[n].begin(); it != recv_keys[n].end();
+         it += key_size)
+    {
+      if (*it == 0)
+      {
+        key_to_source.insert(
+            {std::vector<std::int64_t>(it + 1, it + 1 + num_vertices),
+             {key_sources[n], *(it + 1 + num_vertices)}});
+      }
+    }
+  }
+
+  // Tell the source process of each requested entity to send its
+  // value to the requesting process, as (destination, source local
+  // index, destination local index)
+  std::vector<int> request_dests;
+  std::vector<std::array<std::int64_t, 3>> requests;
+  std::vector<std::int64_t> key(num_vertices);
+  for (std::size_t n = 0; n < recv_keys.size(); ++n)
+  {
+    for (auto it = recv_keys[n].begin(); it != recv_keys[n].end();
+         it += key_size)
+    {
+      if (*it == 0)
+        continue;
+      std::copy(it + 1, it + 1 + num_vertices, key.begin());
+      auto source = key_to_source.find(key);
+      if (source == key_to_source.end())
+      {
+        throw std::runtime_error("Cannot migrate data. Meshes do not match "
+                                 "(entity not found in source mesh)");
+      }
+      request_dests.push_back(source->second.first);
+      requests.push_back(
+          {key_sources[n], source->second.second, *(it + 1 + num_vertices)});
+    }
+  }
+
+  MPI_Comm request_comm;
+  std::tie(request_comm, dest_to_neighbour)
+      = create_destination_comm(mpi_comm, request_dests);
+  std::vector<std::vector<std::int64_t>> send_requests(
+      dest_to_neighbour.size());
+  for (std::size_t i = 0; i < requests.size(); ++i)
+  {
+    std::vector<std::int64_t>& send
+        = send_requests[dest_to_neighbour[request_dests[i]]];
+    send.insert(send.end(), requests[i].begin(), requests[i].end());
+  }
+
+  std::vector<std::int64_t> recv_requests;
+  dolfin::MPI::neighbour_all_to_all(request_comm, send_requests,
+                                    recv_requests);
+  MPI_Comm_free(&request_comm);
+
+  // Build send lists, and send the destination local index to the
+  // destination process in the same order as the values will be sent
+  std::vector<int> value_dests;
+  for (auto it = recv_requests.begin(); it != recv_requests.end(); it += 3)
+    value_dests.push_back(*it);
+
+  MPI_Comm value_comm;
+  std::tie(value_comm, dest_to_neighbour)
+      = create_destination_comm(mpi_comm, value_dests);
+  std::vector<std::vector<std::int32_t>> send_entities(
+      dest_to_neighbour.size());
+  std::vector<std::vector<std::int32_t>> send_new_entities(
+      dest_to_neighbour.size());
+  for (auto it = recv_requests.begin(); it != recv_requests.end(); it += 3)
+  {
+    const int n = dest_to_neighbour[*it];
+    send_entities[n].push_back(*(it + 1));
+    send_new_entities[n].push_back(*(it + 2));
+  }
+
+  std::vector<std::int32_t> recv_entities;
+  dolfin::MPI::neighbour_all_to_all(value_comm, send_new_entities,
+                                    recv_entities);
+
+  return std::make_tuple(value_comm, std::move(send_entities),
+                         std::move(recv_entities));
+}
+//-----------------------------------------------------------------------------
 } // namespace
 
 //-----------------------------------------------------------------------------
@@ -645,10 +1169,12 @@ mesh::Mesh Partitioning::build_distributed_mesh(
     const Eigen::Ref<const EigenRowArrayXXd>& points,
     const Eigen::Ref<const EigenRowArrayXXi64>& cells,
     const std::vector<std::int64_t>& global_cell_indices,
-    const mesh::GhostMode ghost_mode, std::string graph_partitioner)
+    const mesh::GhostMode ghost_mode, std::string graph_partitioner,
+    const Eigen::Ref<const EigenRowArrayXXd>& cell_weights)
 {
   // Compute the cell partition
-  PartitionData mp = partition_cells(comm, type, cells, graph_partitioner);
+  PartitionData mp = partition_cells(comm, type, cells, points, ghost_mode,
+                                     graph_partitioner, cell_weights);
 
   // Check that we have some ghost information.
   int all_ghosts = dolfin::MPI::sum(comm, mp.num_ghosts());
@@ -668,9 +1194,229 @@ mesh::Mesh Partitioning::build_distributed_mesh(
 
   DistributedMeshTools::init_facet_cell_connections(mesh);
 
+  // Report quality of the partition. This is a collective pass over
+  // the facets, so it is only done if INFO messages are logged (the log
+  // level is assumed to be the same on all processes).
+  if (loguru::current_verbosity_cutoff() >= loguru::Verbosity_INFO)
+  {
+    const std::int64_t edge_cut = compute_edge_cut(mesh);
+    LOG(INFO) << "Partition (" << graph_partitioner << "): edge cut "
+              << edge_cut;
+    common::TimeLogManager::logger().register_timing(
+        "Partition (" + graph_partitioner + "): edge cut",
+        std::make_tuple((double)edge_cut, 0.0, 0.0));
+  }
+
   return mesh;
 }
 //-----------------------------------------------------------------------------
+std::int64_t Partitioning::compute_edge_cut(const mesh::Mesh& mesh)
+{
+  const mesh::Topology& topology = mesh.topology();
+  const int tdim = topology.dim();
+  std::shared_ptr<const mesh::Connectivity> facet_cells
+      = topology.connectivity(tdim - 1, tdim);
+  if (!facet_cells)
+  {
+    throw std::runtime_error(
+        "Cannot compute edge cut. Facet-cell connectivity has not been "
+        "computed");
+  }
+
+  const int mpi_rank = dolfin::MPI::rank(mesh.mpi_comm());
+  const std::int32_t ghost_offset = topology.ghost_offset(tdim);
+  const bool ghosted = ghost_offset < topology.size(tdim);
+  const std::vector<std::int32_t>& cell_owner = topology.cell_owner();
+  const std::map<std::int32_t, std::set<std::int32_t>>& shared_facets
+      = topology.shared_entities(tdim - 1);
+
+  // Count each facet between cells owned by different processes once,
+  // on the lowest of the two processes
+  std::int64_t num_cut = 0;
+  for (std::int32_t f = 0; f < topology.size(tdim - 1); ++f)
+  {
+    const std::int32_t* cells = facet_cells->connections(f);
+    if (facet_cells->size(f) == 2)
+    {
+      int owner[2];
+      for (int i = 0; i < 2; ++i)
+      {
+        owner[i] = (cells[i] < ghost_offset)
+                       ? mpi_rank
+                       : cell_owner[cells[i] - ghost_offset];
+      }
+      if (owner[0] != owner[1] and mpi_rank == std::min(owner[0], owner[1]))
+        ++num_cut;
+    }
+    else if (!ghosted)
+    {
+      // Without ghost cells, a facet on a process boundary is shared
+      const auto it = shared_facets.find(f);
+      if (it != shared_facets.end() and mpi_rank < *it->second.begin())
+        ++num_cut;
+    }
+  }
+
+  return dolfin::MPI::sum(mesh.mpi_comm(), num_cut);
+}
+//-----------------------------------------------------------------------------
+mesh::Mesh Partitioning::repartition(const mesh::Mesh& mesh,
+                                     const std::vector<double>& cell_weights,
+                                     double itr)
+{
+#ifdef HAS_PARMETIS
+  common::Timer timer("Repartition mesh");
+
+  MPI_Comm mpi_comm = mesh.mpi_comm();
+  const std::int32_t mpi_size = dolfin::MPI::size(mpi_comm);
+  const int tdim = mesh.topology().dim();
+  const std::int32_t num_cells = mesh.topology().ghost_offset(tdim);
+  if (!cell_weights.empty() and (std::int32_t)cell_weights.size() != num_cells)
+  {
+    throw std::runtime_error(
+        "Cannot repartition mesh. Wrong number of cell weights");
+  }
+
+  // Owned cells in global point indexing, with points in input (VTK)
+  // order
+  const mesh::Connectivity& cell_points
+      = mesh.coordinate_dofs().entity_points(tdim);
+  const std::vector<std::uint8_t>& cell_permutation
+      = mesh.coordinate_dofs().cell_permutation();
+  const std::vector<std::int64_t>& global_points
+      = mesh.geometry().global_indices();
+  const std::int32_t num_cell_points = cell_points.size(0);
+  EigenRowArrayXXi64 cells(num_cells, num_cell_points);
+  for (std::int32_t c = 0; c < num_cells; ++c)
+  {
+    const std::int32_t* points = cell_points.connections(c);
+    for (std::int32_t j = 0; j < num_cell_points; ++j)
+      cells(c, j) = global_points[points[cell_permutation[j]]];
+  }
+  const std::vector<std::int64_t>& global_cells
+      = mesh.topology().global_indices(tdim);
+  const std::vector<std::int64_t> global_cell_indices(
+      global_cells.begin(), global_cells.begin() + num_cells);
+
+  // Points distributed in global index order
+  const EigenRowArrayXXd points
+      = DistributedMeshTools::reorder_by_global_indices(
+          mpi_comm, mesh.geometry().points(), global_points);
+
+  // Compute dual graph of owned cells
+  const std::int32_t num_cell_vertices = mesh.type().num_vertices();
+  const graph::CSRGraph<idx_t> csr_graph
+      = graph::GraphBuilder::compute_dual_graph<idx_t>(
+            mpi_comm, cells.leftCols(num_cell_vertices), mesh.type())
+            .first;
+
+  // Scale cell weights to integers for ParMETIS
+  std::vector<idx_t> node_weights;
+  std::vector<double> weights(cell_weights);
+  if (weights.empty())
+    weights.assign(num_cells, 1.0);
+  else
+  {
+    const double max_weight = dolfin::MPI::max(
+        mpi_comm,
+        *std::max_element(weights.begin(), weights.end()));
+    node_weights.resize(num_cells);
+    for (std::int32_t c = 0; c < num_cells; ++c)
+    {
+      node_weights[c] = std::max(
+          (idx_t)1, (idx_t)std::round(1000.0 * weights[c] / max_weight));
+    }
+  }
+
+  // Process loads before repartitioning
+  const double load = std::accumulate(weights.begin(), weights.end(), 0.0);
+  std::vector<double> process_loads;
+  dolfin::MPI::all_gather(mpi_comm, load, process_loads);
+  register_imbalance("Repartition: load imbalance before", process_loads);
+
+  // Compute new partition
+  PartitionData mp(graph::ParMETIS::adaptive_repartition(
+      mpi_comm, csr_graph, node_weights, itr));
+
+  // Process loads after repartitioning
+  std::fill(process_loads.begin(), process_loads.end(), 0.0);
+  for (std::int32_t c = 0; c < num_cells; ++c)
+    process_loads[mp.procs(c)[0]] += weights[c];
+  MPI_Allreduce(MPI_IN_PLACE, process_loads.data(), mpi_size, MPI_DOUBLE,
+                MPI_SUM, mpi_comm);
+  register_imbalance("Repartition: load imbalance after", process_loads);
+
+  // Build mesh from owned cells and new partition
+  mesh::Mesh new_mesh
+      = build(mpi_comm, mesh.type().cell_type(), cells, points,
+              global_cell_indices, mesh.get_ghost_mode(), mp);
+  DistributedMeshTools::init_facet_cell_connections(new_mesh);
+
+  return new_mesh;
+#else
+  throw std::runtime_error("Cannot repartition mesh. ParMETIS not available");
+#endif
+}
+//-----------------------------------------------------------------------------
+template <typename T>
+std::vector<T> Partitioning::migrate(const mesh::Mesh& mesh,
+                                     const mesh::Mesh& new_mesh, int dim,
+                                     const std::vector<T>& values,
+                                     int block_size)
+{
+  common::Timer timer("Migrate mesh data");
+
+  // Compute where values are sent and received
+  MPI_Comm neighbour_comm;
+  std::vector<std::vector<std::int32_t>> send_entities;
+  std::vector<std::int32_t> recv_entities;
+  std::tie(neighbour_comm, send_entities, recv_entities)
+      = compute_migration_plan(mesh, new_mesh, dim);
+
+  // Pack and send values
+  assert(values.size() == mesh.num_entities(dim) * block_size);
+  std::vector<std::vector<T>> send_values(send_entities.size());
+  for (std::size_t p = 0; p < send_entities.size(); ++p)
+  {
+    send_values[p].reserve(send_entities[p].size() * block_size);
+    for (const std::int32_t e : send_entities[p])
+    {
+      send_values[p].insert(send_values[p].end(),
+                            values.begin() + e * block_size,
+                            values.begin() + (e + 1) * block_size);
+    }
+  }
+
+  std::vector<T> recv_values;
+  dolfin::MPI::neighbour_all_to_all(neighbour_comm, send_values, recv_values);
+  MPI_Comm_free(&neighbour_comm);
+
+  // Unpack values for entities of new_mesh
+  assert(recv_values.size() == recv_entities.size() * block_size);
+  std::vector<T> new_values(new_mesh.num_entities(dim) * block_size);
+  for (std::size_t i = 0; i < recv_entities.size(); ++i)
+  {
+    std::copy(recv_values.begin() + i * block_size,
+              recv_values.begin() + (i + 1) * block_size,
+              new_values.begin() + recv_entities[i] * block_size);
+  }
+
+  return new_values;
+}
+//-----------------------------------------------------------------------------
+template <typename T>
+mesh::MeshFunction<T>
+Partitioning::migrate(const mesh::MeshFunction<T>& f,
+                      std::shared_ptr<const mesh::Mesh> new_mesh)
+{
+  assert(f.mesh());
+  assert(new_mesh);
+  const std::vector<T> values(f.values(), f.values() + f.size());
+  mesh::MeshFunction<T> new_f(new_mesh, f.dim(), T());
+  new_f.set_values(migrate(*f.mesh(), *new_mesh, f.dim(), values, 1));
+  return new_f;
+}
+//-----------------------------------------------------------------------------
 std::tuple<std::map<std::int32_t, std::set<std::int32_t>>, EigenRowArrayXXi64,
            std::vector<std::int64_t>>
 Partitioning::reorder_cells_gps(
@@ -1046,3 +1792,32 @@ Partitioning::build_global_vertex_indices(
   return {num_vertices_global, std::move(global_vertex_indices)};
 }
 //-----------------------------------------------------------------------------
+// Explicit instantiation
+template std::vector<bool>
+Partitioning::migrate(const mesh::Mesh&, const mesh::Mesh&, int,
+                      const std::vector<bool>&, int);
+template std::vector<int>
+Partitioning::migrate(const mesh::Mesh&, const mesh::Mesh&, int,
+                      const std::vector<int>&, int);
+template std::vector<std::size_t>
+Partitioning::migrate(const mesh::Mesh&, const mesh::Mesh&, int,
+                      const std::vector<std::size_t>&, int);
+template std::vector<double>
+Partitioning::migrate(const mesh::Mesh&, const mesh::Mesh&, int,
+                      const std::vector<double>&, int);
+template std::vector<std::complex<double>>
+Partitioning::migrate(const mesh::Mesh&, const mesh::Mesh&, int,
+                      const std::vector<std::complex<double>>&, int);
+template mesh::MeshFunction<bool>
+Partitioning::migrate(const mesh::MeshFunction<bool>&,
+                      std::shared_ptr<const mesh::Mesh>);
+template mesh::MeshFunction<int>
+Partitioning::migrate(const mesh::MeshFunction<int>&,
+                      std::shared_ptr<const mesh::Mesh>);
+template mesh::MeshFunction<std::size_t>
+Partitioning::migrate(const mesh::MeshFunction<std::size_t>&,
+                      std::shared_ptr<const mesh::Mesh>);
+template mesh::MeshFunction<double>
+Partitioning::migrate(const mesh::MeshFunction<double>&,
+                      std::shared_ptr<const mesh::Mesh>);
+//-----------------------------------------------------------------------------
@@ -10,6 +10,7 @@
 #include <cstdint>
 #include <dolfin/common/types.h>
 #include <map>
+#include <memory>
 #include <set>
 #include <string>
 #include <tuple>
@@ -67,13 +68,91 @@ public:
   ///     Global index for each cell
   /// @param ghost_mode
   ///     Ghost mode
-  static mesh::Mesh
-  build_distributed_mesh(const MPI_Comm& comm, mesh::CellType::Type type,
-                         const Eigen::Ref<const EigenRowArrayXXd>& points,
-                         const Eigen::Ref<const EigenRowArrayXXi64>& cells,
-                         const std::vector<std::int64_t>& global_cell_indices,
-                         const mesh::GhostMode ghost_mode,
-                         std::string graph_partitioner = "SCOTCH");
+  /// @param graph_partitioner
+  ///     Partitioner ("SCOTCH", "ParMETIS" or "Hilbert"). "Hilbert"
+  ///     partitions the cell midpoints along a Hilbert curve without
+  ///     building the dual graph, which is faster but usually gives a
+  ///     larger edge cut. If INFO messages are logged, the edge cut
+  ///     of the partition is logged and registered with the timing
+  ///     system (see compute_edge_cut).
+  /// @param cell_weights
+  ///     Weights of each cell in cells, with one column per constraint
+  ///     (e.g. computational cost and memory). Unit weights are used
+  ///     if empty on all processes. Processes without cells may pass
+  ///     an empty array. ParMETIS balances each constraint separately. SCOTCH
+  ///     and Hilbert support a single constraint, so balance the sum
+  ///     of the constraints, each scaled by its global maximum.
+  static mesh::Mesh build_distributed_mesh(
+      const MPI_Comm& comm, mesh::CellType::Type type,
+      const Eigen::Ref<const EigenRowArrayXXd>& points,
+      const Eigen::Ref<const EigenRowArrayXXi64>& cells,
+      const std::vector<std::int64_t>& global_cell_indices,
+      const mesh::GhostMode ghost_mode,
+      std::string graph_partitioner = "SCOTCH",
+      const Eigen::Ref<const EigenRowArrayXXd>& cell_weights
+      = EigenRowArrayXXd());
+
+  /// Compute the number of facets between cells that are owned by
+  /// different processes (the edge cut of the cell partition). Requires
+  /// facet-cell connectivity.
+  /// @param mesh
+  ///     Distributed mesh
+  /// @return
+  ///     Global number of cut facets
+  static std::int64_t compute_edge_cut(const mesh::Mesh& mesh);
+
+  /// Repartition an existing distributed mesh to balance the cell
+  /// weights across processes, using ParMETIS adaptive repartitioning
+  /// (which limits the number of cells that are moved). Cells keep
+  /// their global indices, and points their global indices in the
+  /// geometry, so data can be moved to the new mesh with migrate. The
+  /// load imbalance (maximum over average process load) before and
+  /// after repartitioning is registered with the timing system.
+  /// @param mesh
+  ///     Distributed mesh
+  /// @param cell_weights
+  ///     Weight of each owned cell of mesh. Unit weights are used if
+  ///     empty.
+  /// @param itr
+  ///     Ratio of inter-process communication time to redistribution
+  ///     time. Larger values allow more migration to reduce edge cut.
+  /// @return
+  ///     Repartitioned mesh
+  static mesh::Mesh repartition(const mesh::Mesh& mesh,
+                                const std::vector<double>& cell_weights,
+                                double itr = 1000);
+
+  /// Transfer values attached to mesh entities of dimension dim to the
+  /// matching entities of new_mesh, which must describe the same global
+  /// mesh with the same global point indices (e.g. a mesh created by
+  /// repartition). Entities are matched by the global indices of their
+  /// vertices.
+  /// @param mesh
+  ///     Source mesh
+  /// @param new_mesh
+  ///     Destination mesh
+  /// @param dim
+  ///     Topological dimension of entities
+  /// @param values
+  ///     Values for all entities of dimension dim in mesh, block_size
+  ///     values per entity. Only values on entities of owned cells are
+  ///     used.
+  /// @param block_size
+  ///     Number of values per entity
+  /// @return
+  ///     Values for all entities of dimension dim in new_mesh
+  template <typename T>
+  static std::vector<T> migrate(const mesh::Mesh& mesh,
+                                const mesh::Mesh& new_mesh, int dim,
+                                const std::vector<T>& values,
+                                int block_size = 1);
+
+  /// Transfer MeshFunction to new_mesh, which must describe the same
+  /// global mesh with the same global point indices (e.g. a mesh
+  /// created by repartition)
+  template <typename T>
+  static MeshFunction<T> migrate(const MeshFunction<T>& f,
+                                 std::shared_ptr<const Mesh> new_mesh);
 
   /// Redistribute points to the processes that need them.
   /// @param mpi_comm
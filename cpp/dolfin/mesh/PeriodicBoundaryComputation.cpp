@@ -10,9 +10,15 @@
 #include "Mesh.h"
 #include "MeshIterator.h"
 #include "SubDomain.h"
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <dolfin/common/MPI.h>
+#include <dolfin/common/Timer.h>
 #include <dolfin/common/types.h>
 #include <limits>
 #include <map>
+#include <tuple>
 #include <unordered_map>
 #include <utility>
 #include <vector>
@@ -20,51 +26,140 @@
 using namespace dolfin;
 using namespace dolfin::mesh;
 
-// Comparison operator for hashing coordinates. Note that two
-// coordinates are considered equal if equal to within specified
-// tolerance.
 namespace
 {
 //-----------------------------------------------------------------------------
-struct lt_coordinate
+// Spatial hash grid over a set of points, used to find a point that is
+// equal to a query point to within a tolerance in each coordinate.
+// Points are stored in flat arrays sorted by the hash of their grid
+// cell. The grid cells are at least twice the tolerance wide, so a
+// matching point lies in the cell of the query point or in one of its
+// neighbours.
+class PointGrid
 {
-  lt_coordinate(double tolerance) : TOL(tolerance) {}
+public:
+  PointGrid(const EigenRowArrayXXd& points, double tol)
+      : _points(points), _tol(tol), _lower(points.cols()), _h(1.0)
+  {
+    const int gdim = points.cols();
+    const Eigen::Index num_points = points.rows();
+    if (num_points == 0)
+      return;
+
+    // Choose cell size such that cells hold a few points on average
+    // for points on a (gdim - 1)-dimensional boundary
+    _lower = points.colwise().minCoeff().transpose();
+    const double extent
+        = (points.colwise().maxCoeff().transpose() - _lower).maxCoeff();
+    const double n = std::pow((double)num_points, 1.0 / std::max(gdim - 1, 1));
+    _h = std::max(2.0 * tol, extent / n);
+    if (_h <= 0.0)
+      _h = 1.0;
+
+    // Sort points by cell key
+    std::vector<std::pair<std::uint64_t, std::int32_t>> keyed(num_points);
+    std::array<std::int64_t, 3> cell;
+    for (Eigen::Index i = 0; i < num_points; ++i)
+    {
+      compute_cell(points.row(i).data(), cell);
+      keyed[i] = {key(cell), i};
+    }
+    std::sort(keyed.begin(), keyed.end());
+
+    _keys.resize(num_points);
+    _rows.resize(num_points);
+    for (Eigen::Index i = 0; i < num_points; ++i)
+    {
+      _keys[i] = keyed[i].first;
+      _rows[i] = keyed[i].second;
+    }
+  }
+
+  // Return row of a point that matches x to within the tolerance, or
+  // -1 if there is no matching point
+  std::int32_t find(const double* x) const
+  {
+    if (_keys.empty())
+      return -1;
+
+    const int gdim = _points.cols();
+    std::array<std::int64_t, 3> cell0, cell;
+    compute_cell(x, cell0);
+
+    // Visit the 3^gdim cells around the cell of x
+    int num_cells = 1;
+    for (int i = 0; i < gdim; ++i)
+      num_cells *= 3;
+    for (int c = 0; c < num_cells; ++c)
+    {
+      int offset = c;
+      cell = cell0;
+      for (int i = 0; i < gdim; ++i)
+      {
+        cell[i] = cell0[i] + (offset % 3) - 1;
+        offset /= 3;
+      }
+
+      const auto range
+          = std::equal_range(_keys.begin(), _keys.end(), key(cell));
+      for (auto it = range.first; it != range.second; ++it)
+      {
+        const std::int32_t row = _rows[it - _keys.begin()];
+        const double* p = _points.row(row).data();
+        bool match = true;
+        for (int i = 0; i < gdim; ++i)
+          match = match and std::abs(p[i] - x[i]) <= _tol;
+        if (match)
+          return row;
+      }
+    }
+
+    return -1;
+  }
+
+private:
+  // Compute integer grid cell of point x
+  void compute_cell(const double* x, std::array<std::int64_t, 3>& cell) const
+  {
+    cell.fill(0);
+    for (int i = 0; i < _points.cols(); ++i)
+      cell[i] = std::floor((x[i] - _lower[i]) / _h);
+  }
 
-  bool operator()(const std::vector<double>& x,
-                  const std::vector<double>& y) const
+  // Hash grid cell. Collisions only add candidates to the search.
+  static std::uint64_t key(const std::array<std::int64_t, 3>& cell)
   {
-    std::size_t n = std::max(x.size(), y.size());
-    for (std::size_t i = 0; i < n; ++i)
+    std::uint64_t k = 0;
+    for (std::int64_t c : cell)
     {
-      double xx = 0.0;
-      double yy = 0.0;
-      if (i < x.size())
-        xx = x[i];
-      if (i < y.size())
-        yy = y[i];
-
-      if (xx < (yy - TOL))
-        return true;
-      else if (xx > (yy + TOL))
-        return false;
+      std::uint64_t z = (std::uint64_t)c + 0x9e3779b97f4a7c15ULL + (k << 6)
+                        + (k >> 2);
+      z = (z ^ (z >> 30)) * 0xbf58476d1ce4e5b9ULL;
+      z = (z ^ (z >> 27)) * 0x94d049bb133111ebULL;
+      k ^= z ^ (z >> 31);
     }
-    return false;
+    return k;
   }
 
-  // Tolerance
-  const double TOL;
+  // Points (one per row)
+  const EigenRowArrayXXd& _points;
+
+  // Matching tolerance
+  const double _tol;
+
+  // Lower corner of grid and cell size
+  EigenArrayXd _lower;
+  double _h;
+
+  // Cell key of each point, sorted, and corresponding point row
+  std::vector<std::uint64_t> _keys;
+  std::vector<std::int32_t> _rows;
 };
 //-----------------------------------------------------------------------------
-bool in_bounding_box(const std::vector<double>& point,
-                     const std::vector<double>& bounding_box, const double tol)
+bool in_bounding_box(const double* point, const double* bounding_box,
+                     const int gdim, const double tol)
 {
-  // Return false if bounding box is empty
-  if (bounding_box.empty())
-    return false;
-
-  const std::size_t gdim = point.size();
-  assert(bounding_box.size() == 2 * gdim);
-  for (std::size_t i = 0; i < gdim; ++i)
+  for (int i = 0; i < gdim; ++i)
   {
     if (!(point[i] >= (bounding_box[i] - tol)
           && point[i] <= (bounding_box[gdim + i] + tol)))
@@ -84,200 +179,214 @@ PeriodicBoundaryComputation::compute_periodic_pairs(const Mesh& mesh,
                                                     const SubDomain& sub_domain,
                                                     const std::size_t dim)
 {
+  common::Timer timer("Compute periodic boundary pairs");
+
   // MPI communication
   const MPI_Comm mpi_comm = mesh.mpi_comm();
 
   // Get geometric and topological dimensions
-  const std::size_t gdim = mesh.geometry().dim();
+  const int gdim = mesh.geometry().dim();
   const std::size_t tdim = mesh.topology().dim();
-
-  // Arrays used for mapping coordinates
-  std::vector<double> x(gdim);
-  std::vector<double> y(gdim);
-
-  // Wrap x and y (view of x and y)
-  Eigen::Map<EigenArrayXd> _x(x.data(), gdim);
-  Eigen::Map<EigenArrayXd> _y(y.data(), gdim);
-
-  std::vector<std::size_t> slave_entities;
-  std::vector<std::vector<double>> slave_mapped_coords;
-
-  // Min/max coordinates of facet midpoints [min_x, max_x]. Used to
-  // build bounding box of all master entity midpoints on this process
-  std::vector<double> x_min_max;
-
-  // Map from master entity midpoint coordinate to local facet index
-  std::map<std::vector<double>, std::int32_t, lt_coordinate>
-      master_coord_to_entity_index((lt_coordinate(sub_domain.map_tolerance)));
+  const double tol = sub_domain.map_tolerance;
 
   // Initialise facet-cell connectivity
   mesh.create_connectivity(tdim - 1, tdim);
   mesh.create_entities(dim);
   mesh.create_connectivity(tdim - 1, dim);
 
+  // Collect entities of exterior facets
+  std::vector<std::int32_t> boundary_entities;
   std::vector<bool> visited(mesh.num_entities(dim), false);
   for (auto& f : MeshRange<Facet>(mesh))
   {
     // Consider boundary entities only
-    const bool global_exterior_facet = (f.num_global_entities(tdim) == 1);
-    if (global_exterior_facet)
+    if (f.num_global_entities(tdim) != 1)
+      continue;
+
+    for (auto& e : EntityRange<MeshEntity>(f, dim))
     {
-      for (auto& e : EntityRange<MeshEntity>(f, dim))
+      // Avoid visiting entities more than once
+      if (!visited[e.index()])
       {
-        // Avoid visiting entities more than once
-        if (visited[e.index()])
-          continue;
-        else
-          visited[e.index()] = true;
-
-        // Copy entity coordinate
-        const Eigen::Vector3d midpoint = e.midpoint();
-        std::copy(midpoint.data(), midpoint.data() + gdim, x.begin());
-
-        // Check if entity lies on a 'master' or 'slave' boundary
-        if (sub_domain.inside(_x, true)[0])
-        {
-          // Build bounding box data for master entity midpoints
-          if (x_min_max.empty())
-          {
-            x_min_max = x;
-            x_min_max.insert(x_min_max.end(), x.begin(), x.end());
-          }
-
-          for (std::size_t i = 0; i < gdim; ++i)
-          {
-            x_min_max[i] = std::min(x_min_max[i], x[i]);
-            x_min_max[gdim + i] = std::max(x_min_max[gdim + i], x[i]);
-          }
-
-          // Insert (midpoint coordinates, local index) into map
-          master_coord_to_entity_index.insert({x, e.index()});
-        }
-        else
+        visited[e.index()] = true;
+        boundary_entities.push_back(e.index());
+      }
+    }
+  }
+
+  // Midpoints of boundary entities
+  EigenRowArrayXXd x(boundary_entities.size(), gdim);
+  for (std::size_t i = 0; i < boundary_entities.size(); ++i)
+  {
+    const MeshEntity e(mesh, dim, boundary_entities[i]);
+    const Eigen::Vector3d midpoint = e.midpoint();
+    for (int j = 0; j < gdim; ++j)
+      x(i, j) = midpoint[j];
+  }
+
+  // Check which entities lie on the 'master' boundary (one call for
+  // all entities)
+  const EigenArrayXb is_master = boundary_entities.empty()
+                                     ? EigenArrayXb()
+                                     : sub_domain.inside(x, true);
+
+  // Split into master entities and mapped midpoints of the remaining
+  // entities
+  std::vector<std::int32_t> master_entities, mapped_entities;
+  EigenRowArrayXXd x_master(boundary_entities.size(), gdim);
+  EigenRowArrayXXd y(boundary_entities.size(), gdim);
+  EigenArrayXd _x(gdim), _y(gdim);
+  for (std::size_t i = 0; i < boundary_entities.size(); ++i)
+  {
+    if (is_master[i])
+    {
+      x_master.row(master_entities.size()) = x.row(i);
+      master_entities.push_back(boundary_entities[i]);
+    }
+    else
+    {
+      // Let's check the user is going to map all coordinates
+      _x = x.row(i).transpose();
+      _y = std::numeric_limits<double>::quiet_NaN();
+
+      // Get mapped midpoint (y) of entity
+      sub_domain.map(_x, _y);
+
+      // Check for NaNs after the map
+      for (int j = 0; j < gdim; ++j)
+      {
+        if (std::isnan(_y[j]))
         {
-          // Let's check the user is going to map all coordinates
-          for (size_t i = 0; i < y.size(); i++)
-          {
-            y[i] = std::numeric_limits<double>::quiet_NaN();
-          }
-
-          // Get mapped midpoint (y) of slave entity
-          sub_domain.map(_x, _y);
-
-          // Check for NaNs after the map
-          for (size_t i = 0; i < y.size(); i++)
-          {
-            if (std::isnan(y[i]))
-            {
-              throw std::runtime_error(
-                  "periodic boundary mapping not set.  Need to set coordinate "
-                  + std::to_string(i) + " in sub_domain.map");
-            }
-          }
-
-          // Check if entity lies on a 'slave' boundary
-          if (sub_domain.inside(_y, true)[0])
-          {
-            // Store slave local index and midpoint coordinates
-            slave_entities.push_back(e.index());
-            slave_mapped_coords.push_back(y);
-          }
+          throw std::runtime_error(
+              "periodic boundary mapping not set.  Need to set coordinate "
+              + std::to_string(j) + " in sub_domain.map");
         }
       }
+
+      y.row(mapped_entities.size()) = _y.transpose();
+      mapped_entities.push_back(boundary_entities[i]);
     }
   }
+  x_master.conservativeResize(master_entities.size(), gdim);
+  y.conservativeResize(mapped_entities.size(), gdim);
+
+  // Check which mapped entities lie on the 'master' boundary, in
+  // which case the entity is a slave
+  const EigenArrayXb is_slave = mapped_entities.empty()
+                                    ? EigenArrayXb()
+                                    : sub_domain.inside(y, true);
+
+  // Bounding box [min_x, max_x] of master entity midpoints on this
+  // process (empty box if there are no master entities)
+  std::vector<double> x_min_max(2 * gdim);
+  for (int i = 0; i < gdim; ++i)
+  {
+    x_min_max[i] = master_entities.empty()
+                       ? std::numeric_limits<double>::max()
+                       : x_master.col(i).minCoeff();
+    x_min_max[gdim + i] = master_entities.empty()
+                              ? std::numeric_limits<double>::lowest()
+                              : x_master.col(i).maxCoeff();
+  }
 
   // Communicate bounding boxes for master entities
-  std::vector<std::vector<double>> bounding_boxes;
+  std::vector<double> bounding_boxes;
   MPI::all_gather(mpi_comm, x_min_max, bounding_boxes);
 
-  // Number of MPI processes
-  std::size_t num_processes = MPI::size(mpi_comm);
-
-  // Build send buffer of mapped slave midpoint coordinate to
-  // processes that may own the master entity
-  std::vector<std::vector<double>> slave_mapped_coords_send(num_processes);
-  std::vector<std::vector<std::int32_t>> sent_slave_indices(num_processes);
-  for (std::size_t i = 0; i < slave_entities.size(); ++i)
+  // Find processes whose master bounding box contains a mapped slave
+  // midpoint
+  const int num_processes = MPI::size(mpi_comm);
+  std::vector<std::vector<int>> slave_procs(mapped_entities.size());
+  std::vector<int> dests;
+  for (std::size_t i = 0; i < mapped_entities.size(); ++i)
   {
-    for (std::size_t p = 0; p < num_processes; ++p)
+    if (!is_slave[i])
+      continue;
+    for (int p = 0; p < num_processes; ++p)
     {
-      // Slave mapped coordinates from process p
-      std::vector<double>& slave_mapped_coords_send_p
-          = slave_mapped_coords_send[p];
-
-      // Check if mapped slave falls within master entity bounding box
-      // on process p
-      if (in_bounding_box(slave_mapped_coords[i], bounding_boxes[p],
-                          sub_domain.map_tolerance))
+      if (in_bounding_box(y.row(i).data(), &bounding_boxes[2 * gdim * p],
+                          gdim, tol))
       {
-        sent_slave_indices[p].push_back(slave_entities[i]);
-        slave_mapped_coords_send_p.insert(slave_mapped_coords_send_p.end(),
-                                          slave_mapped_coords[i].begin(),
-                                          slave_mapped_coords[i].end());
+        slave_procs[i].push_back(p);
+        dests.push_back(p);
       }
     }
   }
+  std::sort(dests.begin(), dests.end());
+  dests.erase(std::unique(dests.begin(), dests.end()), dests.end());
+
+  // Create communicator to processes that may own the master entity
+  MPI_Comm send_comm = MPI::create_sparse_comm(mpi_comm, dests);
+  std::vector<int> sources, destinations;
+  std::tie(sources, destinations) = MPI::neighbours(send_comm);
+  std::map<int, int> dest_to_neighbour;
+  for (std::size_t i = 0; i < destinations.size(); ++i)
+    dest_to_neighbour.insert({destinations[i], i});
+
+  // Pack mapped slave midpoints for each destination
+  std::vector<std::vector<double>> slave_mapped_coords_send(
+      destinations.size());
+  std::vector<std::vector<std::int32_t>> sent_slave_indices(
+      destinations.size());
+  for (std::size_t i = 0; i < mapped_entities.size(); ++i)
+  {
+    for (int p : slave_procs[i])
+    {
+      const int n = dest_to_neighbour[p];
+      sent_slave_indices[n].push_back(mapped_entities[i]);
+      slave_mapped_coords_send[n].insert(slave_mapped_coords_send[n].end(),
+                                         y.row(i).data(),
+                                         y.row(i).data() + gdim);
+    }
+  }
 
   // Send slave midpoints to possible owners of corresponding master
   // entity
   std::vector<std::vector<double>> slave_mapped_coords_recv;
-  MPI::all_to_all(mpi_comm, slave_mapped_coords_send, slave_mapped_coords_recv);
-  assert(slave_mapped_coords_recv.size() == num_processes);
-
-  // Check if this process owns the master facet for a received (mapped)
-  // slave
-  std::vector<double> coordinates(gdim);
-  std::vector<std::vector<std::int32_t>> master_local_entity(num_processes);
-  for (std::size_t p = 0; p < num_processes; ++p)
+  MPI::neighbour_all_to_all(send_comm, slave_mapped_coords_send,
+                            slave_mapped_coords_recv);
+  MPI_Comm_free(&send_comm);
+
+  // Check if this process owns the master entity for a received
+  // (mapped) slave, sending -1 if not
+  const PointGrid master_grid(x_master, tol);
+  std::vector<std::vector<std::int32_t>> master_local_entity(sources.size());
+  for (std::size_t n = 0; n < sources.size(); ++n)
   {
-    const std::vector<double>& slave_mapped_coords_p
-        = slave_mapped_coords_recv[p];
-    for (std::size_t i = 0; i < slave_mapped_coords_p.size(); i += gdim)
+    const std::vector<double>& coords = slave_mapped_coords_recv[n];
+    for (std::size_t i = 0; i < coords.size(); i += gdim)
     {
-      // Unpack received mapped slave midpoint coordinate
-      std::copy(&slave_mapped_coords_p[i], &slave_mapped_coords_p[i] + gdim,
-                coordinates.begin());
-
-      // Check is this process has a master entity that is paired with
-      // a received slave entity
-      std::map<std::vector<double>, std::int32_t>::const_iterator it
-          = master_coord_to_entity_index.find(coordinates);
-
-      // If this process owns the master, insert master entity index,
-      // else insert std::numeric_limits<std::int32_t>::max()
-      if (it != master_coord_to_entity_index.end())
-        master_local_entity[p].push_back(it->second);
-      else
-        master_local_entity[p].push_back(
-            std::numeric_limits<std::int32_t>::max());
+      const std::int32_t row = master_grid.find(&coords[i]);
+      master_local_entity[n].push_back(row < 0 ? -1 : master_entities[row]);
     }
   }
 
   // Send local index of master entity back to owner of slave entity
+  MPI_Comm reply_comm
+      = MPI::create_neighbour_comm(mpi_comm, destinations, sources);
   std::vector<std::vector<std::int32_t>> master_entity_local_index_recv;
-  MPI::all_to_all(mpi_comm, master_local_entity,
-                  master_entity_local_index_recv);
+  MPI::neighbour_all_to_all(reply_comm, master_local_entity,
+                            master_entity_local_index_recv);
+  MPI_Comm_free(&reply_comm);
 
-  // Build map from slave facets on this process to master facet (local
-  // facet index, process owner)
+  // Build map from slave entities on this process to master entity
+  // (process owner, local index). If more than one process has the
+  // master, the lowest rank is used.
   std::map<std::int32_t, std::pair<std::int32_t, std::int32_t>>
       slave_to_master_entity;
-  std::size_t num_local_slave_entities = 0;
-  for (std::size_t p = 0; p < num_processes; ++p)
+  for (std::size_t n = 0; n < destinations.size(); ++n)
   {
-    const std::vector<std::int32_t> master_entity_index_p
-        = master_entity_local_index_recv[p];
-    const std::vector<std::int32_t> sent_slaves_p = sent_slave_indices[p];
-    assert(master_entity_index_p.size() == sent_slaves_p.size());
+    const std::vector<std::int32_t>& master_entity_index
+        = master_entity_local_index_recv[n];
+    const std::vector<std::int32_t>& sent_slaves = sent_slave_indices[n];
+    assert(master_entity_index.size() == sent_slaves.size());
 
-    for (std::size_t i = 0; i < master_entity_index_p.size(); ++i)
+    for (std::size_t i = 0; i < master_entity_index.size(); ++i)
     {
-      if (master_entity_index_p[i] < std::numeric_limits<std::int32_t>::max())
+      if (master_entity_index[i] >= 0)
       {
-        ++num_local_slave_entities;
         slave_to_master_entity.insert(
-            {sent_slaves_p[i], {p, master_entity_index_p[i]}});
+            {sent_slaves[i], {destinations[n], master_entity_index[i]}});
       }
     }
   }
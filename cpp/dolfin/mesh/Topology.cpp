@@ -7,6 +7,7 @@
 #include "Topology.h"
 #include "Connectivity.h"
 #include <dolfin/common/utils.h>
+#include <algorithm>
 #include <numeric>
 #include <sstream>
 
@@ -19,7 +20,8 @@ Topology::Topology(std::size_t dim, std::int32_t num_vertices,
     : _num_vertices(num_vertices), _ghost_offset_index(dim + 1, 0),
       _global_num_entities(dim + 1, -1), _global_indices(dim + 1),
       _connectivity(dim + 1,
-                    std::vector<std::shared_ptr<Connectivity>>(dim + 1))
+                    std::vector<std::shared_ptr<Connectivity>>(dim + 1)),
+      _connectivity_budget(0)
 {
   assert(!_global_num_entities.empty());
   _global_num_entities[0] = num_vertices_global;
@@ -41,7 +43,7 @@ std::int32_t Topology::size(int dim) const
                              + " have not been created.");
   }
 
-  return c->entity_positions().rows() - 1;
+  return c->num_entities();
 }
 //-----------------------------------------------------------------------------
 std::int64_t Topology::size_global(int dim) const
@@ -71,6 +73,12 @@ void Topology::clear(int d0, int d1)
   assert(d0 < (int)_connectivity.size());
   assert(d1 < (int)_connectivity[d0].size());
   _connectivity[d0][d1].reset();
+
+  const std::pair<std::size_t, std::size_t> key(d0, d1);
+  _release_queue.erase(
+      std::remove(_release_queue.begin(), _release_queue.end(), key),
+      _release_queue.end());
+  _released.erase(key);
 }
 //-----------------------------------------------------------------------------
 void Topology::set_num_entities_global(int dim, std::int64_t global_size)
@@ -154,6 +162,72 @@ void Topology::set_connectivity(std::shared_ptr<Connectivity> c, std::size_t d0,
   assert(d0 < _connectivity.size());
   assert(d1 < _connectivity[d0].size());
   _connectivity[d0][d1] = c;
+
+  // Move to back of release queue (most recently computed)
+  const std::pair<std::size_t, std::size_t> key(d0, d1);
+  _release_queue.erase(
+      std::remove(_release_queue.begin(), _release_queue.end(), key),
+      _release_queue.end());
+  if (c and rebuildable(d0, d1))
+    _release_queue.push_back(key);
+  _released.erase(key);
+}
+//-----------------------------------------------------------------------------
+bool Topology::rebuildable(std::size_t d0, std::size_t d1) const
+{
+  // Cell-entity and entity-vertex connectivity define the entities.
+  // Facet-cell connectivity carries the global number of cells of
+  // facets on process boundaries, which a local rebuild loses.
+  const std::size_t tdim = _connectivity.size() - 1;
+  if (d0 == tdim or (d1 == 0 and d0 > 0))
+    return false;
+  else if (tdim > 0 and d0 == tdim - 1 and d1 == tdim)
+    return false;
+  else
+    return true;
+}
+//-----------------------------------------------------------------------------
+bool Topology::released(std::size_t d0, std::size_t d1) const
+{
+  return _released.find({d0, d1}) != _released.end();
+}
+//-----------------------------------------------------------------------------
+std::size_t Topology::connectivity_memory_usage() const
+{
+  std::size_t bytes = 0;
+  for (auto& c_d0 : _connectivity)
+    for (auto& c : c_d0)
+      if (c)
+        bytes += c->memory_usage();
+  return bytes;
+}
+//-----------------------------------------------------------------------------
+void Topology::set_connectivity_budget(std::size_t bytes)
+{
+  _connectivity_budget = bytes;
+}
+//-----------------------------------------------------------------------------
+std::size_t Topology::connectivity_budget() const
+{
+  return _connectivity_budget;
+}
+//-----------------------------------------------------------------------------
+std::size_t Topology::release_connectivity(std::size_t max_bytes)
+{
+  const std::size_t bytes0 = connectivity_memory_usage();
+  std::size_t bytes = bytes0;
+  auto it = _release_queue.begin();
+  for (; it != _release_queue.end() and bytes > max_bytes; ++it)
+  {
+    std::shared_ptr<Connectivity>& c = _connectivity[it->first][it->second];
+    assert(c);
+    bytes -= c->memory_usage();
+    c.reset();
+    _released.insert(*it);
+  }
+  _release_queue.erase(_release_queue.begin(), it);
+
+  return bytes0 - bytes;
 }
 //-----------------------------------------------------------------------------
 const std::map<std::int32_t, std::set<std::int32_t>>&
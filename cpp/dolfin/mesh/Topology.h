@@ -10,6 +10,7 @@
 #include <map>
 #include <memory>
 #include <set>
+#include <utility>
 #include <vector>
 
 namespace dolfin
@@ -120,6 +121,35 @@ public:
   void set_connectivity(std::shared_ptr<Connectivity> c, std::size_t d0,
                         std::size_t d1);
 
+  /// Return true if connectivity (d0, d1) can be recomputed from the
+  /// cell-entity (tdim, d) and entity-vertex (d, 0) connectivity, which
+  /// define the entity numbering and are never released. Facet-cell
+  /// connectivity (tdim - 1, tdim) is not rebuildable since it holds
+  /// the global number of cells attached to facets in parallel.
+  bool rebuildable(std::size_t d0, std::size_t d1) const;
+
+  /// Return true if connectivity (d0, d1) has been released to stay
+  /// within the connectivity memory budget and not yet recomputed
+  bool released(std::size_t d0, std::size_t d1) const;
+
+  /// Return memory (bytes) used by all connectivity
+  std::size_t connectivity_memory_usage() const;
+
+  /// Set memory budget (bytes) for connectivity.
+  /// Mesh::release_connectivity releases rebuildable connectivity,
+  /// least recently computed first, until memory use is within the
+  /// budget. A budget of zero (default) means no limit. Connectivity is
+  /// never released when new connectivity is computed.
+  void set_connectivity_budget(std::size_t bytes);
+
+  /// Return memory budget (bytes) for connectivity
+  std::size_t connectivity_budget() const;
+
+  /// Release rebuildable connectivity, least recently computed first,
+  /// until memory use is at most max_bytes or no rebuildable
+  /// connectivity remains. Returns the number of bytes released.
+  std::size_t release_connectivity(std::size_t max_bytes);
+
   /// Return hash based on the hash of cell-vertex connectivity
   size_t hash() const;
 
@@ -154,6 +184,15 @@ private:
 
   // Connectivity for pairs of topological dimensions
   std::vector<std::vector<std::shared_ptr<Connectivity>>> _connectivity;
+
+  // Rebuildable connectivity pairs (d0, d1), in the order they were set
+  std::vector<std::pair<std::size_t, std::size_t>> _release_queue;
+
+  // Connectivity pairs that have been released and not yet recomputed
+  std::set<std::pair<std::size_t, std::size_t>> _released;
+
+  // Memory budget (bytes) for connectivity (0 for no limit)
+  std::size_t _connectivity_budget;
 }; // namespace mesh
 } // namespace mesh
 } // namespace dolfin
@@ -5,11 +5,9 @@
 // SPDX-License-Identifier:    LGPL-3.0-or-later
 
 #include "TopologyComputation.h"
-#include "Cell.h"
 #include "CellType.h"
 #include "Connectivity.h"
 #include "Mesh.h"
-#include "MeshIterator.h"
 #include "Topology.h"
 #include <Eigen/Dense>
 #include <algorithm>
@@ -100,15 +98,18 @@ compute_entities_by_key_matching(const Mesh& mesh, int dim)
       keyed_entities(num_entities * mesh.num_entities(tdim));
 
   // Loop over cells to build list of keyed (by vertices) entities
+  assert(topology.connectivity(tdim, 0));
+  const Connectivity& cell_vertices = *topology.connectivity(tdim, 0);
+  const std::int32_t num_cells = topology.size(tdim);
+  const std::int32_t ghost_offset = topology.ghost_offset(tdim);
   int entity_counter = 0;
-  for (auto& c : MeshRange<Cell>(mesh, MeshRangeType::ALL))
+  for (std::int32_t cell_index = 0; cell_index < num_cells; ++cell_index)
   {
     // Get vertices from cell
-    const std::int32_t* vertices = c.entities(0);
+    const std::int32_t* vertices = cell_vertices.connections(cell_index);
     assert(vertices);
 
     // Iterate over entities of cell
-    const int cell_index = c.index();
     for (std::int8_t i = 0; i < num_entities; ++i)
     {
       // Get entity vertices
@@ -124,7 +125,7 @@ compute_entities_by_key_matching(const Mesh& mesh, int dim)
       // Attach (local index, cell index), making local_index negative
       // if it is not a ghost cell. This ensures that non-ghosts come
       // before ghosts when sorted. The index is corrected later.
-      if (!c.is_ghost())
+      if (cell_index < ghost_offset)
         std::get<1>(keyed_entities[entity_counter]) = {-i - 1, cell_index};
       else
         std::get<1>(keyed_entities[entity_counter]) = {i, cell_index};
@@ -242,10 +243,15 @@ Connectivity compute_from_transpose(const Mesh& mesh, int d0, int d1)
     throw std::runtime_error("Missing required connectivity d1-d0.");
 
   // Compute number of connections for each e0
+  const Connectivity& c10 = *topology.connectivity(d1, d0);
+  const std::int32_t num_entities1 = topology.size(d1);
   std::vector<std::int32_t> num_connections(topology.size(d0), 0);
-  for (auto& e1 : MeshRange<MeshEntity>(mesh, d1, MeshRangeType::ALL))
-    for (auto& e0 : EntityRange<MeshEntity>(e1, d0))
-      num_connections[e0.index()]++;
+  for (std::int32_t e1 = 0; e1 < num_entities1; ++e1)
+  {
+    const std::int32_t* e0 = c10.connections(e1);
+    for (std::size_t i = 0; i < c10.size(e1); ++i)
+      num_connections[e0[i]]++;
+  }
 
   // Compute offsets
   std::vector<std::int32_t> offsets(num_connections.size() + 1, 0);
@@ -254,9 +260,12 @@ Connectivity compute_from_transpose(const Mesh& mesh, int d0, int d1)
 
   std::vector<std::int32_t> counter(num_connections.size(), 0);
   std::vector<std::int32_t> connections(offsets.back());
-  for (auto& e1 : MeshRange<MeshEntity>(mesh, d1, MeshRangeType::ALL))
-    for (auto& e0 : EntityRange<MeshEntity>(e1, d0))
-      connections[offsets[e0.index()] + counter[e0.index()]++] = e1.index();
+  for (std::int32_t e1 = 0; e1 < num_entities1; ++e1)
+  {
+    const std::int32_t* e0 = c10.connections(e1);
+    for (std::size_t i = 0; i < c10.size(e1); ++i)
+      connections[offsets[e0[i]] + counter[e0[i]]++] = e1;
+  }
 
   return Connectivity(connections, offsets);
 }
@@ -275,13 +284,20 @@ Connectivity compute_from_map(const Mesh& mesh, int d0, int d1)
   boost::unordered_map<std::vector<std::int32_t>, std::int32_t> entity_to_index;
   entity_to_index.reserve(mesh.num_entities(d1));
 
+  const Topology& topology = mesh.topology();
+  assert(topology.connectivity(d0, 0));
+  assert(topology.connectivity(d1, 0));
+  const Connectivity& c0 = *topology.connectivity(d0, 0);
+  const Connectivity& c1 = *topology.connectivity(d1, 0);
+
   const std::size_t num_verts_d1 = mesh.type().num_vertices(d1);
+  const std::int32_t num_entities1 = topology.size(d1);
   std::vector<std::int32_t> key(num_verts_d1);
-  for (auto& e : MeshRange<MeshEntity>(mesh, d1, MeshRangeType::ALL))
+  for (std::int32_t e = 0; e < num_entities1; ++e)
   {
-    std::partial_sort_copy(e.entities(0), e.entities(0) + num_verts_d1,
-                           key.begin(), key.end());
-    entity_to_index.insert({key, e.index()});
+    const std::int32_t* v = c1.connections(e);
+    std::partial_sort_copy(v, v + num_verts_d1, key.begin(), key.end());
+    entity_to_index.insert({key, e});
   }
 
   Eigen::Array<std::int32_t, Eigen::Dynamic, Eigen::Dynamic, Eigen::RowMajor>
@@ -291,10 +307,10 @@ Connectivity compute_from_map(const Mesh& mesh, int d0, int d1)
   std::vector<std::int32_t> entities;
   Eigen::Array<std::int32_t, Eigen::Dynamic, Eigen::Dynamic, Eigen::RowMajor>
       keys;
-  for (auto& e : MeshRange<MeshEntity>(mesh, d0, MeshRangeType::ALL))
+  for (std::int32_t e = 0; e < connections.rows(); ++e)
   {
     entities.clear();
-    cell_type->create_entities(keys, d1, e.entities(0));
+    cell_type->create_entities(keys, d1, c0.connections(e));
     for (Eigen::Index i = 0; i < keys.rows(); ++i)
     {
       std::partial_sort_copy(keys.row(i).data(),
@@ -305,7 +321,7 @@ Connectivity compute_from_map(const Mesh& mesh, int d0, int d1)
       entities.push_back(it->second);
     }
     for (std::size_t k = 0; k < entities.size(); ++k)
-      connections(e.index(), k) = entities[k];
+      connections(e, k) = entities[k];
   }
 
   return Connectivity(connections);
@@ -415,10 +431,11 @@ void TopologyComputation::compute_connectivity(Mesh& mesh, int d0, int d1)
   if (d0 == d1)
   {
     // For d0-d1, use indentity connecticity
-    std::vector<std::vector<std::size_t>> connectivity_dd(
-        topology.size(d0), std::vector<std::size_t>(1));
-    for (auto& e : MeshRange<MeshEntity>(mesh, d0, MeshRangeType::ALL))
-      connectivity_dd[e.index()][0] = e.index();
+    Eigen::Array<std::int32_t, Eigen::Dynamic, Eigen::Dynamic,
+                 Eigen::RowMajor>
+        connectivity_dd(topology.size(d0), 1);
+    std::iota(connectivity_dd.data(),
+              connectivity_dd.data() + connectivity_dd.rows(), 0);
     auto connectivity = std::make_shared<Connectivity>(connectivity_dd);
     topology.set_connectivity(connectivity, d0, d1);
   }
@@ -6,7 +6,10 @@
 
 #include "NewtonSolver.h"
 #include "NonlinearProblem.h"
+#include <algorithm>
+#include <cmath>
 #include <dolfin/common/MPI.h>
+#include <dolfin/common/Timer.h>
 #include <dolfin/common/log.h>
 #include <dolfin/la/PETScKrylovSolver.h>
 #include <dolfin/la/PETScMatrix.h>
@@ -19,7 +22,8 @@ using namespace dolfin;
 //-----------------------------------------------------------------------------
 nls::NewtonSolver::NewtonSolver(MPI_Comm comm)
     : _krylov_iterations(0), _residual(0.0), _residual0(0.0), _solver(comm),
-      _dx(nullptr), _mpi_comm(comm)
+      _dx(nullptr), _x0(nullptr), _A(nullptr), _P(nullptr), _jacobian_age(0),
+      _preconditioner_age(0), _mpi_comm(comm)
 {
   // Create linear solver if not already created. Default to LU.
   _solver.set_options_prefix("nls_solve_");
@@ -35,23 +39,54 @@ nls::NewtonSolver::~NewtonSolver()
 {
   if (_dx)
     VecDestroy(&_dx);
+  if (_x0)
+    VecDestroy(&_x0);
 }
 //-----------------------------------------------------------------------------
 std::pair<int, bool>
 dolfin::nls::NewtonSolver::solve(NonlinearProblem& nonlinear_problem, Vec x)
 {
+  if (jacobian_lag < 1 or preconditioner_lag < 1 or line_search_max_it < 1)
+  {
+    throw std::runtime_error(
+        "Newton solver lags and line search iterations must be positive.");
+  }
+
   // Reset iteration counts
   int newton_iteration = 0;
   _krylov_iterations = 0;
 
+  // Compute the Jacobian and preconditioner at the first iteration,
+  // unless they are kept from the previous solve
+  if (!lag_across_solves)
+  {
+    _A = nullptr;
+    _P = nullptr;
+  }
+
   // Compute F(u) (assembled into _b)
-  Mat A(nullptr), P(nullptr);
   Vec b = nullptr;
-
-  nonlinear_problem.form(x);
-  b = nonlinear_problem.F(x);
+  {
+    common::Timer timer("Newton: assemble residual");
+    nonlinear_problem.form(x);
+    b = nonlinear_problem.F(x);
+  }
   assert(b);
 
+  // Residual norm, for the forcing terms and line search
+  PetscReal rnorm = 0.0;
+  if (eisenstat_walker or line_search)
+    VecNorm(b, NORM_2, &rnorm);
+  PetscReal rnorm_prev = rnorm;
+
+  // Linear solver tolerances (restored after the solve if changed by
+  // the forcing terms)
+  KSP ksp = _solver.ksp();
+  PetscReal ksp_rtol, ksp_atol, ksp_dtol;
+  PetscInt ksp_max_it;
+  KSPGetTolerances(ksp, &ksp_rtol, &ksp_atol, &ksp_dtol, &ksp_max_it);
+  double eta = eisenstat_walker_eta0;
+
   // Check convergence
   bool newton_converged = false;
   if (convergence_criterion == "residual")
@@ -71,36 +106,104 @@ dolfin::nls::NewtonSolver::solve(NonlinearProblem& nonlinear_problem, Vec x)
   // Start iterations
   while (!newton_converged and newton_iteration < max_it)
   {
-    // Compute Jacobian
-    A = nonlinear_problem.J(x);
-    assert(A);
-    P = nonlinear_problem.P(x);
-    if (!P)
-      P = A;
+    // Compute Jacobian and preconditioner, unless lagged
+    const bool update_jacobian = !_A or _jacobian_age >= jacobian_lag;
+    const bool update_preconditioner
+        = update_jacobian
+          and (!_P or _preconditioner_age >= preconditioner_lag);
+    if (update_jacobian)
+    {
+      {
+        common::Timer timer("Newton: assemble Jacobian");
+        _A = nonlinear_problem.J(x);
+        assert(_A);
+        if (update_preconditioner)
+        {
+          _P = nonlinear_problem.P(x);
+          if (!_P)
+            _P = _A;
+        }
+      }
+      _jacobian_age = 0;
+      if (update_preconditioner)
+        _preconditioner_age = 0;
+
+      // Set operators, keeping the preconditioner if it is lagged
+      KSPSetReusePreconditioner(ksp, update_preconditioner ? PETSC_FALSE
+                                                           : PETSC_TRUE);
+      _solver.set_operators(_A, _P);
+    }
 
     if (!_dx)
-      MatCreateVecs(A, &_dx, nullptr);
+      MatCreateVecs(_A, &_dx, nullptr);
 
-    // FIXME: check that this is efficient if A and/or P are unchanged
-    // Set operators
-    _solver.set_operators(A, P);
+    // Set linear solver tolerance from the forcing term
+    if (eisenstat_walker)
+    {
+      if (newton_iteration > 0)
+      {
+        const double eta_safe
+            = eisenstat_walker_gamma * std::pow(eta, eisenstat_walker_alpha);
+        eta = eisenstat_walker_gamma
+              * std::pow(rnorm / rnorm_prev, eisenstat_walker_alpha);
+        if (eta_safe > 0.1)
+          eta = std::max(eta, eta_safe);
+        eta = std::min(eta, eisenstat_walker_eta_max);
+      }
+      KSPSetTolerances(ksp, eta, ksp_atol, ksp_dtol, ksp_max_it);
+    }
 
     // Perform linear solve and update total number of Krylov iterations
-    _krylov_iterations += _solver.solve(_dx, b);
+    {
+      common::Timer timer("Newton: linear solve");
+      _krylov_iterations += _solver.solve(_dx, b);
+    }
 
-    // Update solution
-    update_solution(x, _dx, relaxation_parameter, nonlinear_problem,
-                    newton_iteration);
+    // Update solution and compute F. With line search, the step is
+    // halved until the residual norm is sufficiently decreased.
+    rnorm_prev = rnorm;
+    if (line_search)
+    {
+      if (!_x0)
+        VecDuplicate(x, &_x0);
+      VecCopy(x, _x0);
+    }
+    double step = 1.0;
+    for (int i = 0;; ++i)
+    {
+      {
+        common::Timer timer("Newton: update solution");
+        update_solution(x, _dx, step * relaxation_parameter,
+                        nonlinear_problem, newton_iteration);
+      }
 
-    // Increment iteration count
-    ++newton_iteration;
+      // FIXME: This step is not needed if residual is based on dx and
+      //        this has converged.
+      // FIXME: But, this function call may update internal variables, etc.
+      // Compute F
+      {
+        common::Timer timer("Newton: assemble residual");
+        nonlinear_problem.form(x);
+        b = nonlinear_problem.F(x);
+      }
+      if (eisenstat_walker or line_search)
+        VecNorm(b, NORM_2, &rnorm);
 
-    // FIXME: This step is not needed if residual is based on dx and
-    //        this has converged.
-    // FIXME: But, this function call may update internal variables, etc.
-    // Compute F
-    nonlinear_problem.form(x);
-    b = nonlinear_problem.F(x);
+      if (!line_search or i + 1 == line_search_max_it
+          or rnorm <= (1.0 - 1.0e-4 * step) * rnorm_prev)
+      {
+        break;
+      }
+
+      // Backtrack
+      step *= 0.5;
+      VecCopy(_x0, x);
+    }
+
+    // Increment iteration counts
+    ++newton_iteration;
+    ++_jacobian_age;
+    ++_preconditioner_age;
 
     // Test for convergence
     if (convergence_criterion == "residual")
@@ -116,6 +219,10 @@ dolfin::nls::NewtonSolver::solve(NonlinearProblem& nonlinear_problem, Vec x)
       throw std::runtime_error("Unknown convergence criterion string.");
   }
 
+  // Restore linear solver tolerance
+  if (eisenstat_walker)
+    KSPSetTolerances(ksp, ksp_rtol, ksp_atol, ksp_dtol, ksp_max_it);
+
   if (newton_converged)
   {
     if (_mpi_comm.rank() == 0)
@@ -146,6 +253,11 @@ dolfin::nls::NewtonSolver::solve(NonlinearProblem& nonlinear_problem, Vec x)
 //-----------------------------------------------------------------------------
 int nls::NewtonSolver::krylov_iterations() const { return _krylov_iterations; }
 //-----------------------------------------------------------------------------
+la::PETScKrylovSolver& nls::NewtonSolver::get_krylov_solver()
+{
+  return _solver;
+}
+//-----------------------------------------------------------------------------
 double nls::NewtonSolver::residual() const { return _residual; }
 //-----------------------------------------------------------------------------
 double nls::NewtonSolver::residual0() const { return _residual0; }
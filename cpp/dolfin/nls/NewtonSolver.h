@@ -58,6 +58,13 @@ public:
   ///         The number of iterations.
   int krylov_iterations() const;
 
+  /// Return the linear solver, e.g. to change the Krylov method or
+  /// preconditioner. It defaults to LU.
+  ///
+  /// @returns _la::PETScKrylovSolver_
+  ///         The linear solver.
+  la::PETScKrylovSolver& get_krylov_solver();
+
   /// Return current residual
   ///
   /// @returns double
@@ -92,6 +99,43 @@ public:
   /// Relaxation parameter
   double relaxation_parameter = 1.0;
 
+  /// Number of Newton iterations between Jacobian evaluations (1
+  /// re-computes the Jacobian at every iteration). Between
+  /// evaluations the last Jacobian is re-used.
+  int jacobian_lag = 1;
+
+  /// Number of Newton iterations between preconditioner updates. The
+  /// preconditioner is only updated when the Jacobian is re-computed,
+  /// so it is updated at most every jacobian_lag iterations.
+  int preconditioner_lag = 1;
+
+  /// Keep the Jacobian and preconditioner, and the iteration counts
+  /// for lagging, between calls to solve (e.g. for time stepping).
+  /// The NonlinearProblem must return the same matrices from J and P
+  /// for all calls.
+  bool lag_across_solves = false;
+
+  /// Set the relative tolerance of the linear solver at each
+  /// iteration by the Eisenstat-Walker forcing terms (choice 2), for
+  /// inexact Newton with iterative linear solvers
+  bool eisenstat_walker = false;
+
+  /// Eisenstat-Walker parameters: initial and maximum relative
+  /// tolerance, and gamma and alpha in
+  /// eta_k = gamma*(|F(x_k)|/|F(x_{k-1})|)^alpha
+  double eisenstat_walker_eta0 = 0.3;
+  double eisenstat_walker_eta_max = 0.9;
+  double eisenstat_walker_gamma = 1.0;
+  double eisenstat_walker_alpha = 1.618033988749895;
+
+  /// Use a backtracking line search on the residual norm. The step
+  /// is halved until the residual norm is sufficiently decreased. The
+  /// line search evaluates only residuals, not Jacobians.
+  bool line_search = false;
+
+  /// Maximum number of line search steps
+  int line_search_max_it = 10;
+
 protected:
   /// Convergence test. It may be overloaded using virtual inheritance and
   /// this base criterion may be called from derived, both in C++ and Python.
@@ -140,6 +184,16 @@ private:
   // Solution vector
   Vec _dx;
 
+  // Solution before the Newton step (for line search)
+  Vec _x0;
+
+  // Current Jacobian and preconditioner matrices
+  Mat _A, _P;
+
+  // Number of Newton iterations since the Jacobian and preconditioner
+  // were last computed
+  int _jacobian_age, _preconditioner_age;
+
   // MPI communicator
   dolfin::MPI::Comm _mpi_comm;
 };
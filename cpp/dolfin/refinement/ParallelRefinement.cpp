@@ -14,7 +14,7 @@
 #include <dolfin/mesh/MeshFunction.h>
 #include <dolfin/mesh/MeshIterator.h>
 #include <dolfin/mesh/Partitioning.h>
-#include <map>
+#include <algorithm>
 #include <vector>
 
 using namespace dolfin;
@@ -25,10 +25,36 @@ ParallelRefinement::ParallelRefinement(const mesh::Mesh& mesh)
     : _mesh(mesh),
       _shared_edges(
           mesh::DistributedMeshTools::compute_shared_entities(_mesh, 1)),
-      _marked_edges(mesh.num_entities(1), false),
-      _marked_for_update(MPI::size(mesh.mpi_comm()))
+      _marked_edges(mesh.num_entities(1), false)
 {
-  // Do nothing
+  // Collect processes which share edges with this process
+  for (const auto& shared_edge : _shared_edges)
+    for (const auto& proc_edge : shared_edge.second)
+      _neighbours.push_back(proc_edge.first);
+  std::sort(_neighbours.begin(), _neighbours.end());
+  _neighbours.erase(std::unique(_neighbours.begin(), _neighbours.end()),
+                    _neighbours.end());
+
+  // Replace process ranks by neighbour index, so marker updates can be
+  // sent with neighbourhood collectives
+  for (auto& shared_edge : _shared_edges)
+  {
+    for (auto& proc_edge : shared_edge.second)
+    {
+      proc_edge.first = std::lower_bound(_neighbours.begin(), _neighbours.end(),
+                                         proc_edge.first)
+                        - _neighbours.begin();
+    }
+  }
+
+  _neighbour_comm
+      = MPI::create_neighbour_comm(_mesh.mpi_comm(), _neighbours);
+  _marked_for_update.resize(_neighbours.size());
+}
+//-----------------------------------------------------------------------------
+ParallelRefinement::~ParallelRefinement()
+{
+  MPI_Comm_free(&_neighbour_comm);
 }
 //-----------------------------------------------------------------------------
 const mesh::Mesh& ParallelRefinement::mesh() const { return _mesh; }
@@ -63,7 +89,7 @@ void ParallelRefinement::mark_all()
   _marked_edges.assign(_mesh.num_entities(1), true);
 }
 //-----------------------------------------------------------------------------
-const std::map<std::size_t, std::size_t>&
+const std::vector<std::int64_t>&
 ParallelRefinement::edge_to_new_vertex() const
 {
   return _local_edge_to_new_vertex;
@@ -104,30 +130,39 @@ ParallelRefinement::marked_edge_list(const mesh::MeshEntity& cell) const
   return result;
 }
 //-----------------------------------------------------------------------------
-void ParallelRefinement::update_logical_edgefunction()
+std::vector<std::int32_t> ParallelRefinement::update_logical_edgefunction()
 {
-  const std::size_t mpi_size = MPI::size(_mesh.mpi_comm());
-
-  // Send all shared edges marked for update and receive from other
-  // processes
-  std::vector<std::size_t> received_values;
-  MPI::all_to_all(_mesh.mpi_comm(), _marked_for_update, received_values);
+  // Send all shared edges marked for update and receive from
+  // neighbouring processes
+  std::vector<std::int32_t> received_values;
+  MPI::neighbour_all_to_all(_neighbour_comm, _marked_for_update,
+                            received_values);
 
   // Clear marked_for_update vectors
-  _marked_for_update = std::vector<std::vector<std::size_t>>(mpi_size);
+  for (auto& edges : _marked_for_update)
+    edges.clear();
 
-  // Flatten received values and set edges mesh::MeshFunction true at
-  // each index received
+  // Set edges true at each index received, and return those which
+  // were not already marked
+  std::vector<std::int32_t> new_edges;
   for (auto const& local_index : received_values)
-    _marked_edges[local_index] = true;
+  {
+    if (!_marked_edges[local_index])
+    {
+      _marked_edges[local_index] = true;
+      new_edges.push_back(local_index);
+    }
+  }
+
+  return new_edges;
 }
 //-----------------------------------------------------------------------------
 void ParallelRefinement::create_new_vertices()
 {
   // Take marked_edges and use to create new vertices
 
-  const std::int32_t mpi_size = MPI::size(_mesh.mpi_comm());
   const std::int32_t mpi_rank = MPI::rank(_mesh.mpi_comm());
+  const std::int32_t num_edges = _mesh.num_entities(1);
 
   // Copy over existing mesh vertices
   _new_vertex_coordinates = std::vector<double>(
@@ -136,8 +171,9 @@ void ParallelRefinement::create_new_vertices()
 
   // Tally up unshared marked edges, and shared marked edges which are
   // owned on this process.  Index them sequentially from zero.
-  std::size_t n = 0;
-  for (std::int32_t local_i = 0; local_i < _mesh.num_entities(1); ++local_i)
+  _local_edge_to_new_vertex.assign(num_edges, -1);
+  std::int64_t n = 0;
+  for (std::int32_t local_i = 0; local_i < num_edges; ++local_i)
   {
     if (_marked_edges[local_i] == true)
     {
@@ -151,7 +187,7 @@ void ParallelRefinement::create_new_vertices()
         // check if any other sharing process has a lower rank
         for (auto const& proc_edge : shared_edge_i->second)
         {
-          if (proc_edge.first < mpi_rank)
+          if (_neighbours[proc_edge.first] < mpi_rank)
             owner = false;
         }
       }
@@ -169,39 +205,43 @@ void ParallelRefinement::create_new_vertices()
   }
 
   // Calculate global range for new local vertices
-  const std::size_t num_new_vertices = n;
-  const std::size_t global_offset
+  const std::int64_t num_new_vertices = n;
+  const std::int64_t global_offset
       = MPI::global_offset(_mesh.mpi_comm(), num_new_vertices, true)
         + _mesh.num_entities_global(0);
 
   // If they are shared, then the new global vertex index needs to be
   // sent off-process.  Add offset to map, and collect up any shared
   // new vertices that need to send the new index off-process
-  std::vector<std::vector<std::size_t>> values_to_send(mpi_size);
-  for (auto& local_edge : _local_edge_to_new_vertex)
+  std::vector<std::vector<std::int64_t>> values_to_send(_neighbours.size());
+  for (std::int32_t local_i = 0; local_i < num_edges; ++local_i)
   {
+    std::int64_t& new_vertex = _local_edge_to_new_vertex[local_i];
+    if (new_vertex < 0)
+      continue;
+
     // Add global_offset to map, to get new global index of new
     // vertices
-    local_edge.second += global_offset;
+    new_vertex += global_offset;
 
-    const std::size_t local_i = local_edge.first;
     // shared, but locally owned : remote owned are not in list.
     auto shared_edge_i = _shared_edges.find(local_i);
     if (shared_edge_i != _shared_edges.end())
     {
-      for (auto const& remote_process_edge : _shared_edges[local_i])
+      for (auto const& remote_process_edge : shared_edge_i->second)
       {
-        const std::size_t remote_proc_num = remote_process_edge.first;
-        // send mapping from remote local edge index to new global vertex index
-        values_to_send[remote_proc_num].push_back(remote_process_edge.second);
-        values_to_send[remote_proc_num].push_back(local_edge.second);
+        // send mapping from remote local edge index to new global vertex
+        // index
+        const std::int32_t p = remote_process_edge.first;
+        values_to_send[p].push_back(remote_process_edge.second);
+        values_to_send[p].push_back(new_vertex);
       }
     }
   }
 
-  // Send new vertex indices to remote processes and receive
-  std::vector<std::size_t> received_values;
-  MPI::all_to_all(_mesh.mpi_comm(), values_to_send, received_values);
+  // Send new vertex indices to neighbouring processes and receive
+  std::vector<std::int64_t> received_values;
+  MPI::neighbour_all_to_all(_neighbour_comm, values_to_send, received_values);
 
   // Add received remote global vertex indices to map
   for (auto q = received_values.begin(); q != received_values.end(); q += 2)
@@ -211,7 +251,7 @@ void ParallelRefinement::create_new_vertices()
   // them across processes into this order
 
   std::vector<std::int64_t> global_indices(_mesh.topology().global_indices(0));
-  for (std::size_t i = 0; i < num_new_vertices; i++)
+  for (std::int64_t i = 0; i < num_new_vertices; i++)
     global_indices.push_back(i + global_offset);
 
   Eigen::Map<EigenRowArrayXXd> old_tmp(_new_vertex_coordinates.data(),
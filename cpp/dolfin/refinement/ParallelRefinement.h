@@ -7,7 +7,7 @@
 #pragma once
 
 #include <cstdint>
-#include <map>
+#include <dolfin/common/MPI.h>
 #include <unordered_map>
 #include <vector>
 
@@ -38,7 +38,13 @@ public:
   ParallelRefinement(const mesh::Mesh& mesh);
 
   /// Destructor
-  ~ParallelRefinement() = default;
+  ~ParallelRefinement();
+
+  // Copy constructor (disabled)
+  ParallelRefinement(const ParallelRefinement& p) = delete;
+
+  // Assignment operator (disabled)
+  ParallelRefinement& operator=(const ParallelRefinement& p) = delete;
 
   /// Original mesh associated with this refinement
   const mesh::Mesh& mesh() const;
@@ -69,17 +75,21 @@ public:
   /// @param cell (const _mesh::MeshEntity_)
   std::vector<std::size_t> marked_edge_list(const mesh::MeshEntity& cell) const;
 
-  /// Transfer marked edges between processes
-  void update_logical_edgefunction();
+  /// Transfer marked edges between neighbouring processes
+  /// @returns std::vector<std::int32_t>
+  ///   Local indices of edges that have been marked by other processes
+  ///   and were not previously marked on this process
+  std::vector<std::int32_t> update_logical_edgefunction();
 
   /// Add new vertex for each marked edge, and create
   /// new_vertex_coordinates and global_edge->new_vertex mapping.
   /// Communicate new vertices with MPI to all affected processes.
   void create_new_vertices();
 
-  /// Mapping of old edge (to be removed) to new global vertex number.
-  /// Useful for forming new topology
-  const std::map<std::size_t, std::size_t>& edge_to_new_vertex() const;
+  /// Mapping of old edge (to be removed) to new global vertex number,
+  /// indexed by local edge index. The value is -1 for edges which are
+  /// not marked. Useful for forming new topology
+  const std::vector<std::int64_t>& edge_to_new_vertex() const;
 
   /// Add new cells with vertex indices
   /// @param idx (const std::vector<std::size_t>)
@@ -98,14 +108,21 @@ private:
   // mesh::Mesh reference
   const mesh::Mesh& _mesh;
 
-  // Shared edges between processes. In R^2, vector size is 1
+  // Shared edges between processes, as pairs of (index into
+  // _neighbours, remote local edge index). In R^2, vector size is 1
   std::unordered_map<std::int32_t,
                      std::vector<std::pair<std::int32_t, std::int32_t>>>
       _shared_edges;
 
+  // Processes sharing edges with this process (sorted by rank)
+  std::vector<int> _neighbours;
+
+  // Communicator connecting this process to its neighbours
+  MPI_Comm _neighbour_comm;
+
   // Mapping from old local edge index to new global vertex, needed to
   // create new topology
-  std::map<std::size_t, std::size_t> _local_edge_to_new_vertex;
+  std::vector<std::int64_t> _local_edge_to_new_vertex;
 
   // New storage for all coordinates when creating new vertices
   std::vector<double> _new_vertex_coordinates;
@@ -116,8 +133,9 @@ private:
   // Management of marked edges
   std::vector<bool> _marked_edges;
 
-  // Temporary storage for edges that have been recently marked
-  std::vector<std::vector<std::size_t>> _marked_for_update;
+  // Temporary storage for edges that have been recently marked, for
+  // each neighbour
+  std::vector<std::vector<std::int32_t>> _marked_for_update;
 };
 } // namespace refinement
 } // namespace dolfin
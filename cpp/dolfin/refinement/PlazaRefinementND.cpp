@@ -8,13 +8,16 @@
 #include "ParallelRefinement.h"
 #include <dolfin/common/Timer.h>
 #include <dolfin/mesh/Cell.h>
+#include <dolfin/mesh/Connectivity.h>
 #include <dolfin/mesh/Edge.h>
 #include <dolfin/mesh/Face.h>
 #include <dolfin/mesh/Mesh.h>
 #include <dolfin/mesh/MeshIterator.h>
+#include <dolfin/mesh/Topology.h>
 #include <dolfin/mesh/Vertex.h>
+#include <algorithm>
 #include <limits>
-#include <map>
+#include <unordered_map>
 #include <vector>
 
 using namespace dolfin;
@@ -30,29 +33,47 @@ void enforce_rules(ParallelRefinement& p_ref, const mesh::Mesh& mesh,
   common::Timer t0("PLAZA: Enforce rules");
 
   // Enforce rule, that if any edge of a face is marked, longest edge
-  // must also be marked
+  // must also be marked. Only faces attached to edges that were marked
+  // in the previous round need to be checked, so the work in each
+  // round is proportional to the number of new markers.
 
+  mesh.create_connectivity(1, 2);
+  const mesh::Connectivity& edge_to_face = *mesh.topology().connectivity(1, 2);
+  const std::int32_t num_faces = mesh.topology().ghost_offset(2);
+
+  // Start from all currently marked edges
+  std::vector<std::int32_t> edges;
+  for (std::int32_t e = 0; e < mesh.num_entities(1); ++e)
+    if (p_ref.is_marked(e))
+      edges.push_back(e);
+
+  std::vector<std::int32_t> new_edges;
   std::int32_t update_count = 1;
   while (update_count != 0)
   {
-    update_count = 0;
-    p_ref.update_logical_edgefunction();
+    const std::vector<std::int32_t> received_edges
+        = p_ref.update_logical_edgefunction();
+    edges.insert(edges.end(), received_edges.begin(), received_edges.end());
 
-    for (const auto& f : mesh::MeshRange<mesh::Face>(mesh))
+    new_edges.clear();
+    for (const std::int32_t e : edges)
     {
-      const std::int32_t long_e = long_edge[f.index()];
-      if (p_ref.is_marked(long_e))
-        continue;
-      bool any_marked = false;
-      for (const auto& e : mesh::EntityRange<mesh::Edge>(f))
-        any_marked |= p_ref.is_marked(e.index());
-      if (any_marked)
+      const std::int32_t* faces = edge_to_face.connections(e);
+      for (std::size_t i = 0; i < edge_to_face.size(e); ++i)
       {
-        p_ref.mark(long_e);
-        ++update_count;
+        if (faces[i] >= num_faces)
+          continue;
+        const std::int32_t long_e = long_edge[faces[i]];
+        if (!p_ref.is_marked(long_e))
+        {
+          p_ref.mark(long_e);
+          new_edges.push_back(long_e);
+        }
       }
     }
-    update_count = dolfin::MPI::sum(mesh.mpi_comm(), update_count);
+    edges.swap(new_edges);
+
+    update_count = dolfin::MPI::sum(mesh.mpi_comm(), (std::int32_t)edges.size());
   }
 }
 //-----------------------------------------------------------------------------
@@ -65,87 +86,91 @@ mesh::Mesh compute_refinement(const mesh::Mesh& mesh, ParallelRefinement& p_ref,
   const std::int32_t tdim = mesh.topology().dim();
   const std::int32_t num_cell_edges = tdim * 3 - 3;
   const std::int32_t num_cell_vertices = tdim + 1;
+  const std::int32_t num_cell_faces = (tdim == 3) ? 4 : 1;
 
   // Make new vertices in parallel
   p_ref.create_new_vertices();
-  const std::map<std::size_t, std::size_t>& new_vertex_map
-      = p_ref.edge_to_new_vertex();
+  const std::vector<std::int64_t>& new_vertex_map = p_ref.edge_to_new_vertex();
+  const std::vector<std::int64_t>& global_vertices
+      = mesh.topology().global_indices(0);
+
+  // Subdivision patterns, keyed by the marked edges, the longest edge
+  // of each face (cell local indexing) and the uniform flag. There are
+  // only a few distinct patterns in a mesh, so each is computed once.
+  std::unordered_map<std::uint32_t, std::vector<std::int32_t>>
+      simplex_patterns;
 
-  std::vector<std::size_t> parent_cell;
   std::vector<std::int64_t> indices(num_cell_vertices + num_cell_edges);
-  std::vector<std::size_t> marked_edge_list;
-  std::vector<std::int32_t> simplex_set;
+  std::vector<bool> markers(num_cell_edges);
+  std::vector<std::int32_t> longest_edge(num_cell_faces);
+  std::vector<std::int64_t> simplex_set_global;
 
   for (const auto& cell : mesh::MeshRange<mesh::Cell>(mesh))
   {
+    const std::int32_t* cell_vertices = cell.entities(0);
+    const std::int32_t* cell_edges = cell.entities(1);
+
     // Create vector of indices in the order [vertices][edges], 3+3 in
     // 2D, 4+6 in 3D
-    std::int32_t j = 0;
-    for (const auto& v : mesh::EntityRange<mesh::Vertex>(cell))
-      indices[j++] = v.global_index();
+    for (std::int32_t j = 0; j < num_cell_vertices; ++j)
+      indices[j] = global_vertices[cell_vertices[j]];
 
-    marked_edge_list = p_ref.marked_edge_list(cell);
-    if (marked_edge_list.size() == 0)
+    // Get the marked edge indices for new vertices and make bool
+    // vector of marked edges
+    std::uint32_t key = 0;
+    for (std::int32_t p = 0; p < num_cell_edges; ++p)
     {
-      // Copy over existing Cell to new topology
-      std::vector<std::int64_t> cell_topology;
-      for (const auto& v : mesh::EntityRange<mesh::Vertex>(cell))
-        cell_topology.push_back(v.global_index());
-      p_ref.new_cells(cell_topology);
-      parent_cell.push_back(cell.index());
-    }
-    else
-    {
-      // Get the marked edge indices for new vertices and make bool
-      // vector of marked edges
-      std::vector<bool> markers(num_cell_edges, false);
-      for (auto& p : marked_edge_list)
-      {
-        markers[p] = true;
-        const std::int32_t edge_index = cell.entities(1)[p];
-
-        auto it = new_vertex_map.find(edge_index);
-        assert(it != new_vertex_map.end());
-        indices[num_cell_vertices + p] = it->second;
-      }
-
-      // Need longest edges of each facet in cell local indexing
-      std::vector<std::int32_t> longest_edge;
-      for (const auto& f : mesh::EntityRange<mesh::Face>(cell))
-        longest_edge.push_back(long_edge[f.index()]);
-
-      // Convert to cell local index
-      for (auto& p : longest_edge)
+      markers[p] = p_ref.is_marked(cell_edges[p]);
+      if (markers[p])
       {
-        int i = 0;
-        for (const auto& ej : mesh::EntityRange<mesh::Edge>(cell))
-        {
-          if (p == ej.index())
-          {
-            p = i;
-            break;
-          }
-          ++i;
-        }
+        key |= 1 << p;
+        assert(new_vertex_map[cell_edges[p]] >= 0);
+        indices[num_cell_vertices + p] = new_vertex_map[cell_edges[p]];
       }
+    }
 
-      const bool uniform = (tdim == 2) ? edge_ratio_ok[cell.index()] : false;
+    if (key == 0)
+    {
+      // Copy over existing Cell to new topology
+      simplex_set_global.assign(indices.begin(),
+                                indices.begin() + num_cell_vertices);
+      p_ref.new_cells(simplex_set_global);
+      continue;
+    }
 
-      // FIXME: this has an expensive dynamic memory allocation
-      simplex_set = PlazaRefinementND::get_simplices(markers, longest_edge,
-                                                     tdim, uniform);
+    // Need longest edges of each facet in cell local indexing
+    const std::int32_t* cell_faces
+        = (tdim == 3) ? cell.entities(2) : nullptr;
+    for (std::int32_t f = 0; f < num_cell_faces; ++f)
+    {
+      const std::int32_t e
+          = long_edge[(tdim == 3) ? cell_faces[f] : cell.index()];
+      const std::int32_t* it
+          = std::find(cell_edges, cell_edges + num_cell_edges, e);
+      assert(it != cell_edges + num_cell_edges);
+      longest_edge[f] = it - cell_edges;
+      key |= longest_edge[f] << (num_cell_edges + 3 * f);
+    }
 
-      // Save parent index
-      const std::int32_t ncells = simplex_set.size() / num_cell_vertices;
-      for (std::int32_t i = 0; i != ncells; ++i)
-        parent_cell.push_back(cell.index());
+    const bool uniform = (tdim == 2) ? edge_ratio_ok[cell.index()] : false;
+    if (uniform)
+      key |= 1u << 31;
 
-      // Convert from cell local index to mesh index and add to cells
-      std::vector<std::int64_t> simplex_set_global(simplex_set.size());
-      for (std::size_t i = 0; i < simplex_set_global.size(); ++i)
-        simplex_set_global[i] = indices[simplex_set[i]];
-      p_ref.new_cells(simplex_set_global);
+    auto pattern = simplex_patterns.find(key);
+    if (pattern == simplex_patterns.end())
+    {
+      pattern = simplex_patterns
+                    .emplace(key, PlazaRefinementND::get_simplices(
+                                      markers, longest_edge, tdim, uniform))
+                    .first;
     }
+    const std::vector<std::int32_t>& simplex_set = pattern->second;
+
+    // Convert from cell local index to mesh index and add to cells
+    simplex_set_global.resize(simplex_set.size());
+    for (std::size_t i = 0; i < simplex_set_global.size(); ++i)
+      simplex_set_global[i] = indices[simplex_set[i]];
+    p_ref.new_cells(simplex_set_global);
   }
 
   const bool serial = (dolfin::MPI::size(mesh.mpi_comm()) == 1);
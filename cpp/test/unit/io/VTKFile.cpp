@@ -0,0 +1,283 @@
+// Copyright (C) 2026 agent
+//
+// This file is part of DOLFIN (https://www.fenicsproject.org)
+//
+// SPDX-License-Identifier:    LGPL-3.0-or-later
+//
+// Unit tests for VTK output
+
+#include "vtk_p1.h"
+#include "vtk_p2.h"
+#include <catch.hpp>
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+#include <dolfin/common/IndexMap.h>
+#include <dolfin/common/MPI.h>
+#include <dolfin/common/SubSystemsManager.h>
+#include <dolfin/fem/DofMap.h>
+#include <dolfin/fem/FiniteElement.h>
+#include <dolfin/fem/Form.h>
+#include <dolfin/function/Function.h>
+#include <dolfin/function/FunctionSpace.h>
+#include <dolfin/generation/RectangleMesh.h>
+#include <dolfin/io/VTKFile.h>
+#include <dolfin/la/PETScVector.h>
+#include <dolfin/mesh/Mesh.h>
+#include <dolfin/mesh/Partitioning.h>
+#include <fstream>
+#include <iterator>
+#include <regex>
+#include <sstream>
+#include <string>
+#include <vector>
+
+using namespace dolfin;
+
+namespace
+{
+// Create function on mesh from the generated space and form
+std::shared_ptr<function::Function>
+create_function(std::shared_ptr<mesh::Mesh> mesh,
+                ufc_function_space* (*create_space)(void),
+                ufc_form* (*create_a)(void))
+{
+  ufc_function_space* space = create_space();
+  ufc_dofmap* ufc_map = space->create_dofmap();
+  ufc_finite_element* ufc_element = space->create_element();
+  auto V = std::make_shared<function::FunctionSpace>(
+      mesh, std::make_shared<fem::FiniteElement>(*ufc_element),
+      std::make_shared<fem::DofMap>(*ufc_map, *mesh));
+  std::free(ufc_element);
+  std::free(ufc_map);
+  std::free(space);
+
+  ufc_form* bilinear_form = create_a();
+  fem::Form a(
+      *bilinear_form,
+      std::initializer_list<std::shared_ptr<const function::FunctionSpace>>{V,
+                                                                            V});
+  std::free(bilinear_form);
+  mesh->geometry().coord_mapping = a.coordinate_mapping();
+
+  auto u = std::make_shared<function::Function>(V);
+  u->rename("u");
+  VecSet(u->vector().vec(), 1.0);
+  return u;
+}
+//-----------------------------------------------------------------------------
+// Return name of the VTU file written by this process for the first
+// output to the PVD file with the given base name
+std::string vtu_filename(const std::string base)
+{
+  std::string filename = base;
+  const int size = dolfin::MPI::size(MPI_COMM_WORLD);
+  if (size > 1)
+  {
+    filename += "_p" + std::to_string(dolfin::MPI::rank(MPI_COMM_WORLD))
+                + "_";
+  }
+  return filename + "000000.vtu";
+}
+//-----------------------------------------------------------------------------
+// Return size in bytes of a VTK data type
+std::size_t vtk_type_size(const std::string type)
+{
+  if (type == "Float64")
+    return 8;
+  else if (type == "Int32")
+    return 4;
+  else if (type == "UInt8")
+    return 1;
+  else
+    throw std::runtime_error("Unexpected VTK type " + type);
+}
+//-----------------------------------------------------------------------------
+// Return value of attribute in an XML start tag ("" if not present)
+std::string attribute(const std::string tag, const std::string name)
+{
+  std::smatch m;
+  if (std::regex_search(tag, m, std::regex("\\b" + name + "=\"([^\"]*)\"")))
+    return m[1];
+  else
+    return "";
+}
+//-----------------------------------------------------------------------------
+// Read an unsigned 64-bit header entry from the appended data
+std::uint64_t read_header(const std::string& data, std::size_t pos)
+{
+  std::uint64_t value = 0;
+  REQUIRE(pos + sizeof(value) <= data.size());
+  std::memcpy(&value, data.data() + pos, sizeof(value));
+  return value;
+}
+//-----------------------------------------------------------------------------
+// Write u to a VTK file with the encoding and check the VTU headers and
+// the (decoded) sizes of the points, cells and point values
+void check_vtu(const function::Function& u, io::VTKFile::Encoding encoding,
+               const std::string base, std::size_t num_points,
+               std::size_t num_cells, int num_cell_points,
+               int vtk_cell_type)
+{
+  io::VTKFile file(base + ".pvd", encoding);
+  file.write(u);
+
+  std::ifstream in(vtu_filename(base), std::ios::binary);
+  REQUIRE(in.is_open());
+  const std::string vtu((std::istreambuf_iterator<char>(in)),
+                        std::istreambuf_iterator<char>());
+
+  // Split XML from appended binary data, which follows the '_' marker
+  const std::size_t appended = vtu.find("<AppendedData encoding=\"raw\">");
+  const std::string xml = vtu.substr(0, appended);
+  std::string data;
+  if (encoding == io::VTKFile::Encoding::ASCII)
+    CHECK(appended == std::string::npos);
+  else
+  {
+    REQUIRE(appended != std::string::npos);
+    const std::size_t start = vtu.find('_', appended) + 1;
+    const std::size_t end = vtu.rfind("</AppendedData>");
+    REQUIRE(end > start);
+    data = vtu.substr(start, end - start);
+  }
+
+  // File header
+  std::smatch m;
+  REQUIRE(std::regex_search(xml, m, std::regex("<VTKFile[^>]*>")));
+  const std::string header = m[0];
+  CHECK(attribute(header, "type") == "UnstructuredGrid");
+  if (encoding == io::VTKFile::Encoding::ASCII)
+    CHECK(attribute(header, "header_type").empty());
+  else
+  {
+    CHECK(attribute(header, "header_type") == "UInt64");
+    CHECK(!attribute(header, "byte_order").empty());
+  }
+  CHECK((attribute(header, "compressor") == "vtkZLibDataCompressor")
+        == (encoding == io::VTKFile::Encoding::ZLIB));
+
+  // Piece header
+  REQUIRE(std::regex_search(xml, m, std::regex("<Piece[^>]*>")));
+  CHECK(attribute(m[0], "NumberOfPoints") == std::to_string(num_points));
+  CHECK(attribute(m[0], "NumberOfCells") == std::to_string(num_cells));
+
+  // Expected number of values of points, connectivity, offsets, types
+  // and point values
+  const std::vector<std::size_t> sizes
+      = {3 * num_points, num_cells * num_cell_points, num_cells, num_cells,
+         num_points};
+
+  // Check data arrays
+  const std::regex data_array("<DataArray([^>]*?)(/>|>([^<]*)</DataArray>)");
+  std::size_t i = 0;
+  for (auto it = std::sregex_iterator(xml.begin(), xml.end(), data_array);
+       it != std::sregex_iterator(); ++it, ++i)
+  {
+    REQUIRE(i < sizes.size());
+    const std::string tag = (*it)[1];
+    const std::size_t type_size = vtk_type_size(attribute(tag, "type"));
+    if (encoding == io::VTKFile::Encoding::ASCII)
+    {
+      CHECK(attribute(tag, "format") == "ascii");
+      std::istringstream values((*it)[3]);
+      std::vector<std::string> tokens{
+          std::istream_iterator<std::string>(values),
+          std::istream_iterator<std::string>()};
+      CHECK(tokens.size() == sizes[i]);
+      if (attribute(tag, "Name") == "types")
+      {
+        for (auto& t : tokens)
+          CHECK(t == std::to_string(vtk_cell_type));
+      }
+    }
+    else
+    {
+      CHECK(attribute(tag, "format") == "appended");
+      const std::size_t offset = std::stoul(attribute(tag, "offset"));
+      std::uint64_t num_bytes = 0;
+      if (encoding == io::VTKFile::Encoding::RAW)
+      {
+        num_bytes = read_header(data, offset);
+        REQUIRE(offset + 8 + num_bytes <= data.size());
+        if (attribute(tag, "Name") == "types")
+        {
+          for (std::size_t c = 0; c < num_bytes; ++c)
+            CHECK((int)(std::uint8_t)data[offset + 8 + c] == vtk_cell_type);
+        }
+      }
+      else
+      {
+        // Number of blocks, block size, size of last block and
+        // compressed size of each block
+        const std::uint64_t num_blocks = read_header(data, offset);
+        const std::uint64_t block_size = read_header(data, offset + 8);
+        const std::uint64_t last_size = read_header(data, offset + 16);
+        if (num_blocks > 0)
+        {
+          num_bytes = (num_blocks - 1) * block_size + last_size;
+          std::uint64_t compressed = 0;
+          for (std::uint64_t b = 0; b < num_blocks; ++b)
+            compressed += read_header(data, offset + 24 + 8 * b);
+          CHECK(offset + 8 * (3 + num_blocks) + compressed <= data.size());
+        }
+      }
+      CHECK(num_bytes == sizes[i] * type_size);
+    }
+  }
+  CHECK(i == sizes.size());
+}
+//-----------------------------------------------------------------------------
+void vtk_output(io::VTKFile::Encoding encoding, const std::string name)
+{
+  common::SubSystemsManager::init_petsc();
+
+  std::array<Eigen::Vector3d, 2> pt{Eigen::Vector3d(0.0, 0.0, 0.0),
+                                    Eigen::Vector3d(1.0, 1.0, 0.0)};
+  auto mesh = std::make_shared<mesh::Mesh>(generation::RectangleMesh::create(
+      MPI_COMM_WORLD, pt, {{4, 3}}, mesh::CellType::Type::triangle,
+      mesh::GhostMode::none));
+  const std::size_t num_cells = mesh->topology().ghost_offset(2);
+
+  // P1 output is written on linear cells with values at vertices
+  auto u1 = create_function(mesh, vtk_p1_functionspace_create,
+                            vtk_p1_bilinearform_create);
+  check_vtu(*u1, encoding, "vtk_" + name + "_p1",
+            mesh->topology().ghost_offset(0), num_cells, 3, 5);
+
+  // P2 output is written on quadratic cells with values at the nodes
+  auto u2 = create_function(mesh, vtk_p2_functionspace_create,
+                            vtk_p2_bilinearform_create);
+  const common::IndexMap& index_map = *u2->function_space()->dofmap()
+                                           ->index_map();
+  check_vtu(*u2, encoding, "vtk_" + name + "_p2",
+            index_map.size_local() + index_map.num_ghosts(), num_cells, 6,
+            22);
+}
+//-----------------------------------------------------------------------------
+void vtk_output_zlib()
+{
+  try
+  {
+    vtk_output(io::VTKFile::Encoding::ZLIB, "zlib");
+  }
+  catch (const std::runtime_error& e)
+  {
+    // zlib is an optional dependency
+    if (std::string(e.what()).find("configured with zlib")
+        == std::string::npos)
+    {
+      throw;
+    }
+    WARN("DOLFIN not configured with zlib, skipping zlib output test");
+  }
+}
+} // namespace
+
+//-----------------------------------------------------------------------------
+TEST_CASE("VTK output", "[vtk_output]")
+{
+  CHECK_NOTHROW(vtk_output(io::VTKFile::Encoding::ASCII, "ascii"));
+  CHECK_NOTHROW(vtk_output(io::VTKFile::Encoding::RAW, "raw"));
+  CHECK_NOTHROW(vtk_output_zlib());
+}
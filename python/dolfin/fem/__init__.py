@@ -9,7 +9,8 @@
 from dolfin.fem.assemble import (assemble_scalar, assemble_vector_block,
                                  assemble_vector_nest, assemble_matrix,
                                  assemble_matrix_nest, assemble_matrix_block,
-                                 set_bc, assemble_vector, apply_lifting)
+                                 set_bc, assemble_vector, apply_lifting,
+                                 assemble_system)
 from dolfin.fem.coordinatemapping import create_coordinate_map
 from dolfin.fem.dirichletbc import DirichletBC
 from dolfin.fem.dofmap import DofMap
@@ -17,6 +18,7 @@ from dolfin.fem.form import Form
 from dolfin.fem.formmanipulations import (derivative, adjoint, increase_order,
                                           tear)
 from dolfin.fem.interpolation import interpolate
+from dolfin.fem.matrixfree import MatrixFreeOperator
 from dolfin.fem.projection import project
 from dolfin.fem.solving import solve
 
@@ -25,7 +27,7 @@ __all__ = [
     "apply_lifting", "assemble_scalar", "assemble_vector",
     "assemble_vector_block", "assemble_vector_nest",
     "assemble_matrix_block", "assemble_matrix_nest",
-    "assemble_matrix", "set_bc", "create_coordinate_map",
+    "assemble_matrix", "assemble_system", "set_bc", "create_coordinate_map",
     "DirichletBC", "DofMap", "Form", "derivative", "adjoint", "increase_order",
-    "tear", "interpolate", "project", "solve"
+    "tear", "interpolate", "MatrixFreeOperator", "project", "solve"
 ]
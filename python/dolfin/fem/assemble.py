@@ -175,6 +175,29 @@ def assemble_matrix_block(a,
     return A
 
 
+# -- System assembly ----------------------------------------------------------
+
+def assemble_system(A: PETSc.Mat,
+                    b: PETSc.Vec,
+                    a: typing.Union[Form, cpp.fem.Form],
+                    L: typing.Union[Form, cpp.fem.Form],
+                    bcs: typing.List[DirichletBC] = [],
+                    x0: typing.Optional[PETSc.Vec] = None,
+                    scale: float = 1.0,
+                    diagonal: float = 1.0) -> None:
+    """Assemble bilinear form into a matrix and linear form into a
+    vector in one pass over the mesh, with lifting of Dirichlet
+    boundary conditions applied to the vector. If the test and trial
+    spaces are the same, boundary condition values are also set in the
+    vector. The matrix and vector are not zeroed or finalised, i.e.
+    ghost values are not accumulated.
+
+    """
+    a_cpp = _create_cpp_form(a)
+    L_cpp = _create_cpp_form(L)
+    cpp.fem.assemble_system(A, b, a_cpp, L_cpp, bcs, x0, scale, diagonal)
+
+
 # -- Modifiers for Dirichlet conditions ---------------------------------------
 
 # FIXME: Explain in docstring order of calling this function and
@@ -0,0 +1,32 @@
+# -*- coding: utf-8 -*-
+# Copyright (C) 2026 agent
+#
+# This file is part of DOLFIN (https://www.fenicsproject.org)
+#
+# SPDX-License-Identifier:    LGPL-3.0-or-later
+"""Matrix-free operators for bilinear forms"""
+
+import typing
+
+import ufl
+from dolfin import cpp, function
+from dolfin.fem.assemble import _create_cpp_form
+from dolfin.fem.dirichletbc import DirichletBC
+
+
+class MatrixFreeOperator(cpp.fem.MatrixFreeOperator):
+    def __init__(self, a: ufl.Form, bcs: typing.List[DirichletBC] = []):
+        """Matrix-free operator for the bilinear form a. The product
+        y = A x is computed by assembling the action of a on a Function
+        holding x, so the matrix is never formed. Use mat() to get the
+        PETSc shell matrix.
+
+        If coefficients of a are changed after the operator has been
+        created, update_coefficients() must be called.
+
+        """
+        _, trial = a.arguments()
+        self._u = function.Function(trial.ufl_function_space())
+        a_cpp = _create_cpp_form(a)
+        L_cpp = _create_cpp_form(ufl.action(a, self._u))
+        super().__init__(a_cpp, L_cpp, self._u._cpp_object, bcs)
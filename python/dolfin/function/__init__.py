@@ -11,6 +11,7 @@ from dolfin.function.expression import Expression
 from dolfin.function.function import Function
 from dolfin.function.functionspace import (FunctionSpace, VectorFunctionSpace,
                                            TensorFunctionSpace)
+from dolfin.function.nonmatching import NonMatchingInterpolation
 from dolfin.function.specialfunctions import (
     CellDiameter, CellNormal, CellVolume,
     Circumradius, SpatialCoordinate, MinCellEdgeLength, MaxCellEdgeLength,
@@ -20,7 +21,8 @@ __all__ = [
     "TestFunction", "TrialFunction", "Argument", "TestFunctions",
     "TrialFunctions",
     "Expression", "Function", "FunctionSpace", "VectorFunctionSpace",
-    "TensorFunctionSpace", "compile_expression", "jit_generate",
+    "TensorFunctionSpace", "NonMatchingInterpolation", "compile_expression",
+    "jit_generate",
     "CellDiameter", "CellNormal", "CellVolume",
     "Circumradius", "SpatialCoordinate", "MinCellEdgeLength",
     "MaxCellEdgeLength", "MinFacetEdgeLength", "MaxFacetEdgeLength",
@@ -119,6 +119,15 @@ class Function(ufl.Coefficient):
         else:
             return self._cpp_object.compute_point_values()
 
+    def migrate(self, V):
+        """Return a copy of the Function on a function space with the same
+        element on a redistributed mesh, e.g. a mesh created by
+        ``cpp.mesh.Partitioning.repartition``.
+
+        """
+        u = self._cpp_object.migrate(V._cpp_object)
+        return function.Function(V, u.vector().copy())
+
     def copy(self):
         """Return a copy of the Function. The FunctionSpace is shared and the
         degree-of-freedom vector is copied.
@@ -0,0 +1,28 @@
+# -*- coding: utf-8 -*-
+# Copyright (C) 2026 agent
+#
+# This file is part of DOLFIN (https://www.fenicsproject.org)
+#
+# SPDX-License-Identifier:    LGPL-3.0-or-later
+"""Interpolation between function spaces on non-matching meshes"""
+
+from dolfin import cpp
+from dolfin.function.function import Function
+from dolfin.function.functionspace import FunctionSpace
+
+
+class NonMatchingInterpolation:
+    """Interpolation of Functions in V0 into V1, where V0 and V1 are on
+    different meshes. The communication pattern and basis function
+    values are computed on creation, so repeated interpolation is
+    cheap. The object must be re-created if either mesh is changed.
+
+    """
+
+    def __init__(self, V0: FunctionSpace, V1: FunctionSpace):
+        self._cpp_object = cpp.function.NonMatchingInterpolation(
+            V0._cpp_object, V1._cpp_object)
+
+    def interpolate(self, u: Function, v: Function) -> None:
+        """Interpolate v (in V0) into u (in V1)"""
+        self._cpp_object.interpolate(u._cpp_object, v._cpp_object)
@@ -8,7 +8,13 @@
 
 from dolfin import cpp, fem, function
 
-__all__ = ["HDF5File", "XDMFFile"]
+__all__ = [
+    "HDF5File", "HDF5MappedFile", "HDF5DatasetOptions", "HDF5Compression",
+    "XDMFFile"
+]
+
+HDF5DatasetOptions = cpp.io.HDF5DatasetOptions
+HDF5Compression = cpp.io.HDF5Compression
 
 
 class HDF5File:
@@ -47,6 +53,31 @@ class HDF5File:
         """Close file"""
         self._cpp_object.close()
 
+    @property
+    def dataset_options(self) -> HDF5DatasetOptions:
+        """Default chunking and compression options for datasets written to
+        the file"""
+        return self._cpp_object.dataset_options
+
+    @dataset_options.setter
+    def dataset_options(self, options: HDF5DatasetOptions) -> None:
+        self._cpp_object.dataset_options = options
+
+    def set_dataset_options(self, name: str,
+                            options: HDF5DatasetOptions) -> None:
+        """Set chunking and compression options for a dataset, or for all
+        datasets in a group
+
+        Parameters
+        ----------
+        name
+            Path of the dataset or group
+        options
+            Storage options
+
+        """
+        self._cpp_object.set_dataset_options(name, options)
+
     def write(self, o, name, t=None) -> None:
         """Write object to file"""
         o_cpp = getattr(o, "_cpp_object", o)
@@ -115,6 +146,35 @@ class HDF5File:
         return function.Function(V, u_cpp.vector())
 
 
+class HDF5MappedFile:
+    """Read-only, memory-mapped access to a HDF5 file on a single
+    process. Datasets must have been written without chunking or
+    compression.
+
+    """
+
+    def __init__(self, filename: str):
+        self._cpp_object = cpp.io.HDF5MappedFile(filename)
+
+    def read_mesh(self, data_path: str, ghost_mode):
+        """Read Mesh written by HDF5File"""
+        mesh = self._cpp_object.read_mesh(data_path, ghost_mode)
+        mesh.geometry.coord_mapping = fem.create_coordinate_map(mesh)
+        return mesh
+
+    def read_vector(self, data_path: str):
+        """Read Vector backed by the mapped file. The vector remains
+        valid after this file object has been destroyed."""
+        return self._cpp_object.read_vector(data_path)
+
+    def read_function(self, V, name: str):
+        """Read finite element Function written by HDF5File on a mesh
+        read from the same file"""
+        V_cpp = getattr(V, "_cpp_object", V)
+        u_cpp = self._cpp_object.read(V_cpp, name)
+        return function.Function(V, u_cpp.vector())
+
+
 class XDMFFile:
     """Interface to XDMF files"""
 
@@ -14,6 +14,7 @@
 #include <dolfin/fem/DofMap.h>
 #include <dolfin/fem/FiniteElement.h>
 #include <dolfin/fem/Form.h>
+#include <dolfin/fem/MatrixFreeOperator.h>
 #include <dolfin/fem/PETScDMCollection.h>
 #include <dolfin/fem/assembler.h>
 #include <dolfin/fem/utils.h>
@@ -241,6 +242,12 @@ void fem(py::module& m)
         py::arg("A"), py::arg("a"), py::arg("bcs"), py::arg("diagonal"),
         py::arg("use_nest_extract") = true,
         "Re-assemble bilinear forms over mesh into blocked matrix");
+  // Systems
+  m.def("assemble_system", &dolfin::fem::assemble_system, py::arg("A"),
+        py::arg("b"), py::arg("a"), py::arg("L"), py::arg("bcs"),
+        py::arg("x0"), py::arg("scale"), py::arg("diagonal"),
+        "Assemble bilinear and linear forms over mesh into matrix and "
+        "vector in one pass");
   // BC modifiers
   m.def("apply_lifting", &dolfin::fem::apply_lifting,
         "Modify vector for lifted boundary conditions");
@@ -297,6 +304,19 @@ void fem(py::module& m)
       .def("function_space", &dolfin::fem::Form::function_space)
       .def("coordinate_mapping", &dolfin::fem::Form::coordinate_mapping);
 
+  // dolfin::fem::MatrixFreeOperator
+  py::class_<dolfin::fem::MatrixFreeOperator,
+             std::shared_ptr<dolfin::fem::MatrixFreeOperator>>(
+      m, "MatrixFreeOperator", "Matrix-free operator for a bilinear form")
+      .def(py::init<
+           std::shared_ptr<const dolfin::fem::Form>,
+           std::shared_ptr<const dolfin::fem::Form>,
+           std::shared_ptr<dolfin::function::Function>,
+           std::vector<std::shared_ptr<const dolfin::fem::DirichletBC>>>())
+      .def("mat", &dolfin::fem::MatrixFreeOperator::mat)
+      .def("update_coefficients",
+           &dolfin::fem::MatrixFreeOperator::update_coefficients);
+
   // dolfin::fem::PETScDMCollection
   py::class_<dolfin::fem::PETScDMCollection,
              std::shared_ptr<dolfin::fem::PETScDMCollection>>(
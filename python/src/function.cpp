@@ -11,6 +11,7 @@
 #include <dolfin/function/Expression.h>
 #include <dolfin/function/Function.h>
 #include <dolfin/function/FunctionSpace.h>
+#include <dolfin/function/NonMatchingInterpolation.h>
 #include <dolfin/function/SpecialFunctions.h>
 #include <dolfin/geometry/BoundingBoxTree.h>
 #include <dolfin/la/PETScVector.h>
@@ -81,6 +82,7 @@ void function(py::module& m)
            py::overload_cast<const dolfin::function::Expression&>(
                &dolfin::function::Function::interpolate),
            py::arg("expr"))
+      .def("migrate", &dolfin::function::Function::migrate, py::arg("V"))
       .def("vector",
            [](const dolfin::function::Function& self) {
              return self.vector().vec();
@@ -157,5 +159,20 @@ void function(py::module& m)
       .def("sub", &dolfin::function::FunctionSpace::sub)
       .def("tabulate_dof_coordinates",
            &dolfin::function::FunctionSpace::tabulate_dof_coordinates);
+
+  // dolfin::function::NonMatchingInterpolation
+  py::class_<dolfin::function::NonMatchingInterpolation,
+             std::shared_ptr<dolfin::function::NonMatchingInterpolation>>(
+      m, "NonMatchingInterpolation",
+      "Interpolation of Functions between non-matching meshes")
+      .def(py::init<const dolfin::function::FunctionSpace&,
+                    const dolfin::function::FunctionSpace&>(),
+           py::arg("V0"), py::arg("V1"))
+      .def("interpolate",
+           py::overload_cast<dolfin::function::Function&,
+                             const dolfin::function::Function&>(
+               &dolfin::function::NonMatchingInterpolation::interpolate,
+               py::const_),
+           py::arg("u"), py::arg("v"));
 }
 } // namespace dolfin_wrappers
@@ -6,12 +6,16 @@
 
 #include <dolfin/graph/Graph.h>
 #include <dolfin/graph/GraphBuilder.h>
+#include <dolfin/graph/Hilbert.h>
 #include <dolfin/mesh/Mesh.h>
 #include <memory>
+#include <pybind11/eigen.h>
 #include <pybind11/pybind11.h>
 #include <pybind11/stl.h>
 #include <vector>
 
+#include "casters.h"
+
 namespace py = pybind11;
 
 namespace dolfin_wrappers
@@ -36,5 +40,18 @@ void graph(py::module& m)
                                     std::size_t dim0, std::size_t dim1) {
         return dolfin::graph::GraphBuilder::local_graph(mesh, dim0, dim1);
       });
+
+  // dolfin::graph::Hilbert
+  py::class_<dolfin::graph::Hilbert>(m, "Hilbert")
+      .def_static("keys", &dolfin::graph::Hilbert::keys)
+      .def_static("partition",
+                  [](const MPICommWrapper comm,
+                     const Eigen::Ref<const dolfin::EigenRowArrayXXd> x,
+                     const std::vector<std::int64_t>& weights) {
+                    return dolfin::graph::Hilbert::partition(comm.get(), x,
+                                                             weights);
+                  },
+                  py::arg("comm"), py::arg("x"),
+                  py::arg("weights") = std::vector<std::int64_t>());
 }
 } // namespace dolfin_wrappers
@@ -8,6 +8,7 @@
 #include <dolfin/function/Function.h>
 #include <dolfin/function/FunctionSpace.h>
 #include <dolfin/io/HDF5File.h>
+#include <dolfin/io/HDF5MappedFile.h>
 #include <dolfin/io/XDMFFile.h>
 #include <dolfin/la/PETScVector.h>
 #include <dolfin/mesh/Mesh.h>
@@ -27,6 +28,49 @@ namespace dolfin_wrappers
 
 void io(py::module& m)
 {
+  // dolfin::io::HDF5Interface::Compression enums
+  py::enum_<dolfin::io::HDF5Interface::Compression>(m, "HDF5Compression")
+      .value("none", dolfin::io::HDF5Interface::Compression::none)
+      .value("deflate", dolfin::io::HDF5Interface::Compression::deflate)
+      .value("lz4", dolfin::io::HDF5Interface::Compression::lz4)
+      .value("zstd", dolfin::io::HDF5Interface::Compression::zstd);
+
+  // dolfin::io::HDF5Interface::DatasetOptions
+  py::class_<dolfin::io::HDF5Interface::DatasetOptions>(m,
+                                                        "HDF5DatasetOptions")
+      .def(py::init<>())
+      .def_readwrite("chunking",
+                     &dolfin::io::HDF5Interface::DatasetOptions::chunking)
+      .def_readwrite("chunk_shape",
+                     &dolfin::io::HDF5Interface::DatasetOptions::chunk_shape)
+      .def_readwrite("compression",
+                     &dolfin::io::HDF5Interface::DatasetOptions::compression)
+      .def_readwrite(
+          "compression_level",
+          &dolfin::io::HDF5Interface::DatasetOptions::compression_level)
+      .def_readwrite("shuffle",
+                     &dolfin::io::HDF5Interface::DatasetOptions::shuffle)
+      .def_readwrite(
+          "scale_offset_digits",
+          &dolfin::io::HDF5Interface::DatasetOptions::scale_offset_digits);
+
+  // dolfin::io::HDF5MappedFile
+  py::class_<dolfin::io::HDF5MappedFile,
+             std::shared_ptr<dolfin::io::HDF5MappedFile>>(m, "HDF5MappedFile")
+      .def(py::init<const std::string>(), py::arg("filename"))
+      .def("read_mesh", &dolfin::io::HDF5MappedFile::read_mesh,
+           py::arg("data_path"), py::arg("ghost_mode"))
+      .def("read", &dolfin::io::HDF5MappedFile::read, py::arg("V"),
+           py::arg("name"))
+      .def("read_vector",
+           [](dolfin::io::HDF5MappedFile& self, const std::string data_path) {
+             auto x = self.read_vector(data_path);
+             Vec _x = x.vec();
+             PetscObjectReference((PetscObject)_x);
+             return _x;
+           },
+           py::return_value_policy::take_ownership, py::arg("data_path"));
+
   // dolfin::io::HDF5File
   py::class_<dolfin::io::HDF5File, std::shared_ptr<dolfin::io::HDF5File>>(
       m, "HDF5File", py::dynamic_attr())
@@ -134,7 +178,10 @@ void io(py::module& m)
            py::arg("u"), py::arg("name"), py::arg("t"))
       .def("set_mpi_atomicity", &dolfin::io::HDF5File::set_mpi_atomicity)
       .def("get_mpi_atomicity", &dolfin::io::HDF5File::get_mpi_atomicity)
-      .def_readwrite("chunking", &dolfin::io::HDF5File::chunking)
+      .def_readwrite("dataset_options",
+                     &dolfin::io::HDF5File::dataset_options)
+      .def("set_dataset_options", &dolfin::io::HDF5File::set_dataset_options,
+           py::arg("name"), py::arg("options"))
       // others
       .def("has_dataset", &dolfin::io::HDF5File::has_dataset);
 
@@ -81,7 +81,7 @@ void mesh(py::module& m)
                  = self.entity_points(dim);
              Eigen::Ref<const Eigen::Array<std::int32_t, Eigen::Dynamic, 1>>
                  connections = connectivity.connections();
-             const int num_entities = connectivity.entity_positions().size();
+             const int num_entities = connectivity.num_entities();
 
              // FIXME: mesh::CoordinateDofs should know its dimension
              // (entity_size) to handle empty case on a process.
@@ -106,11 +106,12 @@ void mesh(py::module& m)
            py::return_value_policy::reference_internal,
            "Return coordinates of a point")
       .def_property(
-          "points", py::overload_cast<>(&dolfin::mesh::Geometry::points),
-          [](dolfin::mesh::Geometry& self, dolfin::EigenRowArrayXXd values) {
-            self.points() = values;
-          },
-          "Return coordinates of all points")
+          "points",
+          py::overload_cast<>(&dolfin::mesh::Geometry::points, py::const_),
+          &dolfin::mesh::Geometry::set_points,
+          "Coordinates of all points (read-only view, modify by assignment)")
+      .def("mark_modified", &dolfin::mesh::Geometry::mark_modified)
+      .def("version", &dolfin::mesh::Geometry::version)
       .def_readwrite("coord_mapping", &dolfin::mesh::Geometry::coord_mapping);
 
   // dolfin::mesh::Topology class
@@ -123,6 +124,15 @@ void mesh(py::module& m)
                &dolfin::mesh::Topology::connectivity, py::const_))
       .def("size", &dolfin::mesh::Topology::size)
       .def("hash", &dolfin::mesh::Topology::hash)
+      .def("rebuildable", &dolfin::mesh::Topology::rebuildable)
+      .def("released", &dolfin::mesh::Topology::released)
+      .def("connectivity_memory_usage",
+           &dolfin::mesh::Topology::connectivity_memory_usage)
+      .def_property("connectivity_budget",
+                    &dolfin::mesh::Topology::connectivity_budget,
+                    &dolfin::mesh::Topology::set_connectivity_budget)
+      .def("release_connectivity",
+           &dolfin::mesh::Topology::release_connectivity)
       .def("have_global_indices", &dolfin::mesh::Topology::have_global_indices)
       .def("ghost_offset", &dolfin::mesh::Topology::ghost_offset)
       .def("cell_owner",
@@ -170,6 +180,7 @@ void mesh(py::module& m)
       .def("create_global_indices", &dolfin::mesh::Mesh::create_global_indices)
       .def("create_entities", &dolfin::mesh::Mesh::create_entities)
       .def("create_connectivity", &dolfin::mesh::Mesh::create_connectivity)
+      .def("release_connectivity", &dolfin::mesh::Mesh::release_connectivity)
       .def("create_connectivity_all",
            &dolfin::mesh::Mesh::create_connectivity_all)
       .def("mpi_comm",
@@ -206,7 +217,7 @@ void mesh(py::module& m)
            py::overload_cast<>(&dolfin::mesh::Connectivity::connections),
            "Return all connectivities")
       .def("pos",
-           py::overload_cast<>(&dolfin::mesh::Connectivity::entity_positions),
+           &dolfin::mesh::Connectivity::entity_positions,
            "Index to each entity in the connectivity array")
       .def("size", &dolfin::mesh::Connectivity::size);
 
@@ -414,12 +425,29 @@ void mesh(py::module& m)
            (bool (dolfin::mesh::MeshValueCollection<SCALAR>::*)(               \
                std::size_t, std::size_t, const SCALAR&))                       \
                & dolfin::mesh::MeshValueCollection<SCALAR>::set_value)         \
+      .def("set_values",                                                       \
+           py::overload_cast<const std::vector<std::int32_t>&,                 \
+                             const std::vector<std::int32_t>&,                 \
+                             const std::vector<SCALAR>&>(                      \
+               &dolfin::mesh::MeshValueCollection<SCALAR>::set_values))        \
+      .def("set_values",                                                       \
+           py::overload_cast<const std::vector<std::int32_t>&,                 \
+                             const std::vector<SCALAR>&>(                      \
+               &dolfin::mesh::MeshValueCollection<SCALAR>::set_values))        \
+      .def("cells", &dolfin::mesh::MeshValueCollection<SCALAR>::cells)         \
+      .def("local_entities",                                                   \
+           &dolfin::mesh::MeshValueCollection<SCALAR>::local_entities)         \
       .def("values",                                                           \
-           (std::map<                                                          \
-                std::pair<std::size_t, std::size_t>,                           \
-                SCALAR> & (dolfin::mesh::MeshValueCollection<SCALAR>::*)())    \
-               & dolfin::mesh::MeshValueCollection<SCALAR>::values,            \
-           py::return_value_policy::reference)                                 \
+           [](const dolfin::mesh::MeshValueCollection<SCALAR>& self) {         \
+             std::map<std::pair<std::size_t, std::size_t>, SCALAR> values;     \
+             for (std::size_t i = 0; i < self.size(); ++i)                     \
+             {                                                                 \
+               values.insert(values.end(),                                     \
+                             {{self.cells()[i], self.local_entities()[i]},     \
+                              self.values()[i]});                              \
+             }                                                                 \
+             return values;                                                    \
+           })                                                                  \
       .def("assign",                                                           \
            [](dolfin::mesh::MeshValueCollection<SCALAR>& self,                 \
               const dolfin::mesh::MeshFunction<SCALAR>& mf) { self = mf; })    \
@@ -502,5 +530,44 @@ void mesh(py::module& m)
           &dolfin::mesh::PeriodicBoundaryComputation::compute_periodic_pairs)
       .def_static("masters_slaves",
                   &dolfin::mesh::PeriodicBoundaryComputation::masters_slaves);
+
+  // dolfin::mesh::Partitioning
+  py::class_<dolfin::mesh::Partitioning>(m, "Partitioning")
+      .def_static(
+          "build_distributed_mesh",
+          [](const MPICommWrapper comm, dolfin::mesh::CellType::Type type,
+             const Eigen::Ref<const dolfin::EigenRowArrayXXd> points,
+             const Eigen::Ref<const dolfin::EigenRowArrayXXi64> cells,
+             const std::vector<std::int64_t>& global_cell_indices,
+             const dolfin::mesh::GhostMode ghost_mode,
+             std::string graph_partitioner,
+             const Eigen::Ref<const dolfin::EigenRowArrayXXd> cell_weights) {
+            return dolfin::mesh::Partitioning::build_distributed_mesh(
+                comm.get(), type, points, cells, global_cell_indices,
+                ghost_mode, graph_partitioner, cell_weights);
+          },
+          py::arg("comm"), py::arg("type"), py::arg("points"),
+          py::arg("cells"), py::arg("global_cell_indices"),
+          py::arg("ghost_mode"), py::arg("graph_partitioner") = "SCOTCH",
+          py::arg("cell_weights") = dolfin::EigenRowArrayXXd())
+      .def_static("repartition", &dolfin::mesh::Partitioning::repartition,
+                  py::arg("mesh"), py::arg("cell_weights"),
+                  py::arg("itr") = 1000.0)
+      .def_static("compute_edge_cut",
+                  &dolfin::mesh::Partitioning::compute_edge_cut);
+
+#define PARTITIONING_MIGRATE_MACRO(SCALAR)                                     \
+  m.def("migrate",                                                             \
+        [](const dolfin::mesh::MeshFunction<SCALAR>& f,                        \
+           std::shared_ptr<const dolfin::mesh::Mesh> mesh) {                   \
+          return dolfin::mesh::Partitioning::migrate(f, mesh);                 \
+        },                                                                     \
+        py::arg("f"), py::arg("mesh"));
+
+  PARTITIONING_MIGRATE_MACRO(bool);
+  PARTITIONING_MIGRATE_MACRO(int);
+  PARTITIONING_MIGRATE_MACRO(double);
+  PARTITIONING_MIGRATE_MACRO(std::size_t);
+#undef PARTITIONING_MIGRATE_MACRO
 } // namespace dolfin_wrappers
 } // namespace dolfin_wrappers
@@ -58,13 +58,34 @@ void nls(py::module& m)
         return std::make_unique<PyNewtonSolver>(comm.get());
       }))
       .def("solve", &dolfin::nls::NewtonSolver::solve)
+      .def("krylov_iterations", &dolfin::nls::NewtonSolver::krylov_iterations)
+      .def("get_krylov_solver", &dolfin::nls::NewtonSolver::get_krylov_solver,
+           py::return_value_policy::reference_internal)
       .def("converged", &PyPublicNewtonSolver::converged)
       .def("update_solution", &PyPublicNewtonSolver::update_solution)
       .def_readwrite("atol", &dolfin::nls::NewtonSolver::atol)
       .def_readwrite("rtol", &dolfin::nls::NewtonSolver::rtol)
       .def_readwrite("max_it", &dolfin::nls::NewtonSolver::max_it)
       .def_readwrite("convergence_criterion",
-                     &dolfin::nls::NewtonSolver::convergence_criterion);
+                     &dolfin::nls::NewtonSolver::convergence_criterion)
+      .def_readwrite("jacobian_lag", &dolfin::nls::NewtonSolver::jacobian_lag)
+      .def_readwrite("preconditioner_lag",
+                     &dolfin::nls::NewtonSolver::preconditioner_lag)
+      .def_readwrite("lag_across_solves",
+                     &dolfin::nls::NewtonSolver::lag_across_solves)
+      .def_readwrite("eisenstat_walker",
+                     &dolfin::nls::NewtonSolver::eisenstat_walker)
+      .def_readwrite("eisenstat_walker_eta0",
+                     &dolfin::nls::NewtonSolver::eisenstat_walker_eta0)
+      .def_readwrite("eisenstat_walker_eta_max",
+                     &dolfin::nls::NewtonSolver::eisenstat_walker_eta_max)
+      .def_readwrite("eisenstat_walker_gamma",
+                     &dolfin::nls::NewtonSolver::eisenstat_walker_gamma)
+      .def_readwrite("eisenstat_walker_alpha",
+                     &dolfin::nls::NewtonSolver::eisenstat_walker_alpha)
+      .def_readwrite("line_search", &dolfin::nls::NewtonSolver::line_search)
+      .def_readwrite("line_search_max_it",
+                     &dolfin::nls::NewtonSolver::line_search_max_it);
 
   // dolfin::NonlinearProblem 'trampoline' for overloading from
   // Python
@@ -90,6 +111,12 @@ void nls(py::module& m)
           "Tried to call pure virtual function dolfin::NonlinearProblem::F");
     }
 
+    Mat P(const Vec x) override
+    {
+      PYBIND11_OVERLOAD_INT(Mat, dolfin::nls::NonlinearProblem, "P", x);
+      return dolfin::nls::NonlinearProblem::P(x);
+    }
+
     void form(Vec x) override
     {
       PYBIND11_OVERLOAD_INT(void, dolfin::nls::NonlinearProblem, "form", x);
@@ -129,6 +129,48 @@ def test_assembly_bcs():
     assert (f - b_bc).norm() == pytest.approx(0.0, rel=1e-12, abs=1e-12)
 
 
+def test_assemble_system():
+    mesh = dolfin.generation.UnitSquareMesh(dolfin.MPI.comm_world, 12, 12)
+    V = dolfin.FunctionSpace(mesh, ("Lagrange", 1))
+    u, v = dolfin.TrialFunction(V), dolfin.TestFunction(V)
+
+    f = dolfin.Function(V)
+    with f.vector().localForm() as f_local:
+        f_local.set(10.0)
+    a = inner(f * u, v) * dx + inner(u, v) * ds
+    L = inner(f, v) * dx + inner(2.0, v) * ds
+
+    def boundary(x):
+        return numpy.logical_or(x[:, 0] < 1.0e-6, x[:, 0] > 1.0 - 1.0e-6)
+
+    u_bc = dolfin.function.Function(V)
+    with u_bc.vector().localForm() as u_local:
+        u_local.set(1.0)
+    bc = dolfin.fem.dirichletbc.DirichletBC(V, u_bc, boundary)
+
+    # Assemble matrix and vector separately
+    A0 = dolfin.fem.assemble_matrix(a, [bc])
+    A0.assemble()
+    b0 = dolfin.fem.assemble_vector(L)
+    dolfin.fem.apply_lifting(b0, [a], [[bc]])
+    b0.ghostUpdate(addv=PETSc.InsertMode.ADD, mode=PETSc.ScatterMode.REVERSE)
+    dolfin.fem.set_bc(b0, [bc])
+
+    # Assemble matrix and vector in one pass (bc values are set in the
+    # vector during assembly)
+    A1 = A0.duplicate()
+    A1.zeroEntries()
+    b1 = b0.duplicate()
+    with b1.localForm() as b_local:
+        b_local.set(0.0)
+    dolfin.fem.assemble_system(A1, b1, a, L, [bc])
+    A1.assemble()
+    b1.ghostUpdate(addv=PETSc.InsertMode.ADD, mode=PETSc.ScatterMode.REVERSE)
+
+    assert (A1 - A0).norm() == pytest.approx(0.0, abs=1e-12)
+    assert (b1 - b0).norm() == pytest.approx(0.0, abs=1e-12)
+
+
 def test_matrix_assembly_block():
     """Test assembly of block matrices and vectors into (a) monolithic
     blocked structures, PETSc Nest structures, and monolithic structures.
@@ -516,3 +558,38 @@ def test_projection():
 
     integral_analytic = 1.0 / 3
     assert integral == pytest.approx(integral_analytic, rel=1.e-6, abs=1.e-12)
+
+
+@pytest.mark.parametrize("mode", [
+    dolfin.cpp.mesh.GhostMode.none,
+    dolfin.cpp.mesh.GhostMode.shared_facet,
+    dolfin.cpp.mesh.GhostMode.shared_vertex
+])
+def test_matrix_free_operator(mode):
+    mesh = dolfin.generation.UnitSquareMesh(dolfin.MPI.comm_world, 8, 8,
+                                            ghost_mode=mode)
+    V = dolfin.FunctionSpace(mesh, ("Lagrange", 2))
+    u, v = dolfin.TrialFunction(V), dolfin.TestFunction(V)
+    a = inner(ufl.grad(u), ufl.grad(v)) * dx + inner(u, v) * ds
+
+    def boundary(x):
+        return x[:, 0] < 1.0e-6
+
+    u_bc = dolfin.function.Function(V)
+    bc = dolfin.fem.dirichletbc.DirichletBC(V, u_bc, boundary)
+
+    A = dolfin.fem.assemble_matrix(a, [bc])
+    A.assemble()
+
+    A_mf = dolfin.fem.MatrixFreeOperator(a, [bc])
+
+    x, y = A.createVecs()
+    x.setRandom()
+    A.mult(x, y)
+    y_mf = y.duplicate()
+    A_mf.mat().mult(x, y_mf)
+    assert (y - y_mf).norm() == pytest.approx(0.0, abs=1.0e-10)
+
+    d = A.getDiagonal()
+    d_mf = A_mf.mat().getDiagonal()
+    assert (d - d_mf).norm() == pytest.approx(0.0, abs=1.0e-10)
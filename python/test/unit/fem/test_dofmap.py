@@ -131,7 +131,7 @@ def test_tabulate_dofs(mesh_factory):
 def test_tabulate_coord_periodic(mesh_factory):
     class PeriodicBoundary2(SubDomain):
         def inside(self, x, on_boundary):
-            return x[0] < np.finfo(float).eps
+            return x[:, 0] < np.finfo(float).eps
 
         def map(self, x, y):
             y[0] = x[0] - 1.0
@@ -183,7 +183,7 @@ def test_tabulate_coord_periodic(mesh_factory):
 def test_tabulate_dofs_periodic(mesh_factory):
     class PeriodicBoundary2(SubDomain):
         def inside(self, x, on_boundary):
-            return x[0] < np.finfo(float).eps
+            return x[:, 0] < np.finfo(float).eps
 
         def map(self, x, y):
             y[0] = x[0] - 1.0
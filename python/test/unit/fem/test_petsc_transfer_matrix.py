@@ -43,7 +43,7 @@ def test_scalar_p1():
 def test_scalar_p1_scaled_mesh():
     # Make coarse mesh smaller than fine mesh
     meshc = UnitCubeMesh(MPI.comm_world, 2, 2, 2)
-    meshc.geometry.points *= 0.9
+    meshc.geometry.points = 0.9 * meshc.geometry.points
 
     meshf = UnitCubeMesh(MPI.comm_world, 3, 4, 5)
 
@@ -69,7 +69,7 @@ def test_scalar_p1_scaled_mesh():
     assert diff.norm() < 1.0e-12
 
     # Now make coarse mesh larger than fine mesh
-    meshc.geometry.points *= 1.5
+    meshc.geometry.points = 1.5 * meshc.geometry.points
 
     uc = interpolate(u, Vc)
 
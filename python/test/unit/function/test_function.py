@@ -72,6 +72,30 @@ def test_compute_point_values(V, W, mesh):
     assert all(u_values == u_values2)
 
 
+def test_compute_point_values_elements(mesh):
+    @function.expression.numba_eval
+    def linear_eval(values, x, t):
+        values[:, 0] = x[:, 0] + 2.0 * x[:, 1] - x[:, 2]
+
+    @function.expression.numba_eval
+    def constant_eval(values, x, t):
+        values[:, 0] = 1.0
+        values[:, 1] = 2.0
+        values[:, 2] = 3.0
+
+    x = mesh.geometry.points
+    f = Expression(linear_eval, shape=())
+    for element in [('CG', 2), ('CR', 1)]:
+        u = interpolate(f, FunctionSpace(mesh, element))
+        u_values = u.compute_point_values(mesh)
+        assert np.allclose(u_values[:, 0], x[:, 0] + 2.0 * x[:, 1] - x[:, 2])
+
+    g = Expression(constant_eval, shape=(3,))
+    u = interpolate(g, FunctionSpace(mesh, ('N1curl', 1)))
+    u_values = u.compute_point_values(mesh)
+    assert np.allclose(u_values, [1.0, 2.0, 3.0])
+
+
 @pytest.mark.skip
 def test_assign(V, W):
     for V0, V1, vector_space in [(V, W, False), (W, V, True)]:
@@ -280,6 +304,92 @@ def test_interpolation_rank0(V):
         assert (x[:] == 2.0).all()
 
 
+def test_interpolation_geometry_change():
+    mesh = UnitCubeMesh(MPI.comm_world, 3, 3, 3)
+    V = FunctionSpace(mesh, ('CG', 1))
+
+    @function.expression.numba_eval
+    def expr_eval(values, x, t):
+        values[:, 0] = x[:, 0]
+
+    f = Expression(expr_eval, shape=())
+    w0 = interpolate(f, V)
+
+    # Interpolation points must be recomputed after moving the mesh
+    x = mesh.geometry.points.copy()
+    x[:, 0] *= 2.0
+    mesh.geometry.points = x
+    w1 = interpolate(f, V)
+    with w0.vector().localForm() as x0, w1.vector().localForm() as x1:
+        assert np.allclose(x1[:], 2.0 * x0[:])
+
+    # Interpolation from a Function uses the cached dof map
+    v = Function(V)
+    v.interpolate(w1)
+    v.interpolate(w1)
+    with v.vector().localForm() as x, w1.vector().localForm() as x1:
+        assert np.allclose(x[:], x1[:])
+
+
+def test_tabulate_dof_coordinates_geometry_change():
+    mesh = UnitCubeMesh(MPI.comm_world, 3, 3, 3)
+    V = VectorFunctionSpace(mesh, ('CG', 2))
+    x0 = V.tabulate_dof_coordinates()
+    assert np.allclose(x0[0::3], x0[1::3])
+    assert np.allclose(x0[0::3], x0[2::3])
+
+    # Coordinates cannot be modified through the points view, which
+    # would not invalidate cached coordinates
+    x = mesh.geometry.points
+    with pytest.raises(ValueError):
+        x[:, 0] *= 2.0
+
+    # Coordinates must be recomputed after moving the mesh, repeatedly
+    for i in range(1, 3):
+        x = mesh.geometry.points.copy()
+        x[:, 0] *= 2.0
+        mesh.geometry.points = x
+        x1 = V.tabulate_dof_coordinates()
+        assert np.allclose(x1[:, 0], 2.0**i * x0[:, 0])
+        assert np.allclose(x1[:, 1:], x0[:, 1:])
+
+
+def test_interpolation_non_matching():
+    mesh0 = UnitCubeMesh(MPI.comm_world, 3, 3, 3)
+    mesh1 = UnitCubeMesh(MPI.comm_world, 4, 5, 6)
+
+    # Target mesh extends outside the source mesh
+    mesh1.geometry.points = 1.1 * mesh1.geometry.points
+
+    @function.expression.numba_eval
+    def expr_eval(values, x, t):
+        values[:, 0] = x[:, 0] * x[:, 1] + 2.0 * x[:, 2]
+        values[:, 1] = x[:, 2] * x[:, 2]
+        values[:, 2] = 3.0 * x[:, 0]
+
+    f = Expression(expr_eval, shape=(3, ))
+    V0 = VectorFunctionSpace(mesh0, ('CG', 2))
+    V1 = VectorFunctionSpace(mesh1, ('CG', 1))
+    u0 = interpolate(f, V0)
+    u1_exact = interpolate(f, V1)
+
+    # Interpolation through Function::interpolate
+    u1 = interpolate(u0, V1)
+    with u1.vector().localForm() as x, u1_exact.vector().localForm() as y:
+        assert np.allclose(x[:], y[:])
+
+    # Reuse interpolation for repeated transfers
+    interp = function.NonMatchingInterpolation(V0, V1)
+    u1 = Function(V1)
+    for scale in (1.0, 2.0):
+        u0.vector().scale(scale)
+        interp.interpolate(u1, u0)
+        u0.vector().scale(1.0 / scale)
+        with u1.vector().localForm() as x, \
+                u1_exact.vector().localForm() as y:
+            assert np.allclose(x[:], scale * y[:])
+
+
 @skip_in_parallel
 def test_near_evaluations(R, mesh):
     # Test that we allow point evaluation that are slightly outside
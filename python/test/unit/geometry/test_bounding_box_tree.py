@@ -85,8 +85,7 @@ def test_compute_collisions_tree_1d():
         mesh_A = UnitIntervalMesh(MPI.comm_world, 16)
         mesh_B = UnitIntervalMesh(MPI.comm_world, 16)
 
-        bgeom = mesh_B.geometry.points
-        bgeom += point[0]
+        mesh_B.geometry.points = mesh_B.geometry.points + point[0]
 
         tree_A = BoundingBoxTree(mesh_A, mesh_A.topology.dim)
         tree_B = BoundingBoxTree(mesh_B, mesh_B.topology.dim)
@@ -111,8 +110,7 @@ def test_compute_collisions_tree_2d():
         mesh_A = UnitSquareMesh(MPI.comm_world, 4, 4)
         mesh_B = UnitSquareMesh(MPI.comm_world, 4, 4)
 
-        bgeom = mesh_B.geometry.points
-        bgeom += point
+        mesh_B.geometry.points = mesh_B.geometry.points + point
 
         tree_A = BoundingBoxTree(mesh_A, mesh_A.topology.dim)
         tree_B = BoundingBoxTree(mesh_B, mesh_B.topology.dim)
@@ -142,8 +140,7 @@ def test_compute_collisions_tree_3d():
         mesh_A = UnitCubeMesh(MPI.comm_world, 2, 2, 2)
         mesh_B = UnitCubeMesh(MPI.comm_world, 2, 2, 2)
 
-        bgeom = mesh_B.geometry.points
-        bgeom += point
+        mesh_B.geometry.points = mesh_B.geometry.points + point
 
         tree_A = BoundingBoxTree(mesh_A, mesh_A.topology.dim)
         tree_B = BoundingBoxTree(mesh_B, mesh_B.topology.dim)
@@ -204,8 +201,7 @@ def test_compute_entity_collisions_tree_1d():
         mesh_A = UnitIntervalMesh(MPI.comm_world, 16)
         mesh_B = UnitIntervalMesh(MPI.comm_world, 16)
 
-        bgeom = mesh_B.geometry.points
-        bgeom += point[0]
+        mesh_B.geometry.points = mesh_B.geometry.points + point[0]
 
         tree_A = BoundingBoxTree(mesh_A, mesh_A.topology.dim)
         tree_B = BoundingBoxTree(mesh_B, mesh_B.topology.dim)
@@ -229,8 +225,7 @@ def test_compute_entity_collisions_tree_2d():
         mesh_A = UnitSquareMesh(MPI.comm_world, 4, 4)
         mesh_B = UnitSquareMesh(MPI.comm_world, 4, 4)
 
-        bgeom = mesh_B.geometry.points
-        bgeom += point
+        mesh_B.geometry.points = mesh_B.geometry.points + point
 
         tree_A = BoundingBoxTree(mesh_A, mesh_A.topology.dim)
         tree_B = BoundingBoxTree(mesh_B, mesh_B.topology.dim)
@@ -256,8 +251,7 @@ def test_compute_entity_collisions_tree_3d():
         mesh_A = UnitCubeMesh(MPI.comm_world, 2, 2, 2)
         mesh_B = UnitCubeMesh(MPI.comm_world, 2, 2, 2)
 
-        bgeom = mesh_B.geometry.points
-        bgeom += point
+        mesh_B.geometry.points = mesh_B.geometry.points + point
 
         tree_A = BoundingBoxTree(mesh_A, mesh_A.topology.dim)
         tree_B = BoundingBoxTree(mesh_B, mesh_B.topology.dim)
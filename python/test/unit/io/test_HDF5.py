@@ -6,15 +6,17 @@
 
 import os
 
+import numpy
 from petsc4py import PETSc
 
 from dolfin import (MPI, Cell, Expression, Function, FunctionSpace,
                     MeshEntities, MeshEntity, MeshFunction,
                     MeshValueCollection, UnitCubeMesh, UnitSquareMesh, cpp,
                     function)
-from dolfin.io import HDF5File
+from dolfin.io import (HDF5Compression, HDF5DatasetOptions, HDF5File,
+                       HDF5MappedFile)
 from dolfin_utils.test.fixtures import tempdir
-from dolfin_utils.test.skips import xfail_if_complex
+from dolfin_utils.test.skips import skip_in_parallel, xfail_if_complex
 
 assert (tempdir)
 
@@ -185,6 +187,85 @@ def test_save_and_read_function(tempdir):
     hdf5_file.close()
 
 
+@skip_in_parallel
+def test_save_and_read_mapped(tempdir):
+    filename = os.path.join(tempdir, "mapped.h5")
+
+    mesh0 = UnitSquareMesh(MPI.comm_self, 8, 8)
+    Q0 = FunctionSpace(mesh0, ("CG", 2))
+    F0 = Function(Q0)
+
+    @function.expression.numba_eval
+    def expr_eval(values, x, cell_idx):
+        values[:, 0] = x[:, 0] + 2.0 * x[:, 1]
+
+    F0.interpolate(Expression(expr_eval))
+
+    with HDF5File(mesh0.mpi_comm(), filename, "w") as hdf5_file:
+        hdf5_file.write(mesh0, "/mesh")
+        hdf5_file.write(F0, "/function")
+
+    mapped_file = HDF5MappedFile(filename)
+    mesh1 = mapped_file.read_mesh("/mesh", cpp.mesh.GhostMode.none)
+    assert mesh1.num_entities_global(2) == mesh0.num_entities_global(2)
+    assert numpy.allclose(
+        numpy.sort(mesh1.geometry.points, axis=0),
+        numpy.sort(mesh0.geometry.points, axis=0))
+
+    Q1 = FunctionSpace(mesh1, ("CG", 2))
+    F1 = mapped_file.read_function(Q1, "/function")
+    assert abs(F1.vector().sum() - F0.vector().sum()) < 1.0e-12
+
+    # Vector backed by the mapping remains valid after the file object
+    # has been destroyed
+    x = mapped_file.read_vector("/function/vector_0")
+    del mapped_file
+    assert x.getSize() == F0.vector().getSize()
+    assert abs(x.sum() - F0.vector().sum()) < 1.0e-12
+    x.scale(2.0)
+    assert abs(x.sum() - 2.0 * F0.vector().sum()) < 1.0e-12
+
+
+@xfail_if_complex
+def test_save_and_read_function_compressed(tempdir):
+    filename = os.path.join(tempdir, "function_compressed.h5")
+
+    mesh = UnitSquareMesh(MPI.comm_world, 10, 10)
+    Q = FunctionSpace(mesh, ("CG", 2))
+    F0 = Function(Q)
+
+    @function.expression.numba_eval
+    def expr_eval(values, x, cell_idx):
+        values[:, 0] = x[:, 0]
+
+    F0.interpolate(Expression(expr_eval))
+
+    # Lossless compression for the whole file, lossy scale-offset for
+    # one function
+    with HDF5File(mesh.mpi_comm(), filename, "w") as hdf5_file:
+        options = HDF5DatasetOptions()
+        options.compression = HDF5Compression.deflate
+        options.compression_level = 6
+        options.shuffle = True
+        options.chunk_shape = [64]
+        hdf5_file.dataset_options = options
+        hdf5_file.write(F0, "/lossless")
+
+        lossy = HDF5DatasetOptions()
+        lossy.scale_offset_digits = 3
+        hdf5_file.set_dataset_options("/lossy", lossy)
+        hdf5_file.write(F0, "/lossy")
+
+    with HDF5File(mesh.mpi_comm(), filename, "r") as hdf5_file:
+        F1 = hdf5_file.read_function(Q, "/lossless")
+        F1.vector().axpy(-1.0, F0.vector())
+        assert F1.vector().norm() < 1.0e-12
+
+        F2 = hdf5_file.read_function(Q, "/lossy")
+        F2.vector().axpy(-1.0, F0.vector())
+        assert F2.vector().norm(PETSc.NormType.NORM_INFINITY) < 1.0e-3
+
+
 def test_save_and_read_mesh_2D(tempdir):
     filename = os.path.join(tempdir, "mesh2d.h5")
 
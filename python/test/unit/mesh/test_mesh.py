@@ -12,8 +12,10 @@ import pytest
 
 import dolfin
 import FIAT
-from dolfin import (MPI, BoxMesh, Cell, Cells, CellType, MeshEntities,
-                    MeshEntity, MeshFunction, RectangleMesh,
+import ufl
+from dolfin import (MPI, BoxMesh, Cell, Cells, CellType, Facets,
+                    MeshEntities, MeshEntity, MeshFunction,
+                    MeshValueCollection, RectangleMesh,
                     UnitCubeMesh, UnitIntervalMesh, UnitSquareMesh, Vertex,
                     cpp)
 from dolfin.io import XDMFFile
@@ -25,7 +27,9 @@ from dolfin_utils.test.skips import skip_in_parallel
 def mesh1d():
     # Create 1D mesh with degenerate cell
     mesh1d = UnitIntervalMesh(MPI.comm_world, 4)
-    mesh1d.geometry.points[4] = mesh1d.geometry.points[3]
+    x = mesh1d.geometry.points.copy()
+    x[4] = x[3]
+    mesh1d.geometry.points = x
     return mesh1d
 
 
@@ -36,7 +40,9 @@ def mesh2d():
         MPI.comm_world, [numpy.array([0.0, 0.0, 0.0]),
                          numpy.array([1., 1., 0.0])], [1, 1],
         CellType.Type.triangle, cpp.mesh.GhostMode.none, 'left')
-    mesh2d.geometry.points[3, :2] += 0.5 * (sqrt(3.0) - 1.0)
+    x = mesh2d.geometry.points.copy()
+    x[3, :2] += 0.5 * (sqrt(3.0) - 1.0)
+    mesh2d.geometry.points = x
     return mesh2d
 
 
@@ -44,8 +50,10 @@ def mesh2d():
 def mesh3d():
     # Create 3D mesh with regular tetrahedron and degenerate cells
     mesh3d = UnitCubeMesh(MPI.comm_world, 1, 1, 1)
-    mesh3d.geometry.points[6][0] = 1.0
-    mesh3d.geometry.points[3][1] = 0.0
+    x = mesh3d.geometry.points.copy()
+    x[6][0] = 1.0
+    x[3][1] = 0.0
+    mesh3d.geometry.points = x
     return mesh3d
 
 
@@ -463,3 +471,87 @@ def test_mesh_topology_lifetime():
     assert sys.getrefcount(mesh) == rc + 1
     del topology
     assert sys.getrefcount(mesh) == rc
+
+
+def test_connectivity_budget():
+    """Check that rebuildable connectivity is released when over budget"""
+    mesh = UnitCubeMesh(MPI.comm_world, 3, 3, 3)
+    topology = mesh.topology
+    mesh.create_connectivity(1, 2)
+    assert not topology.rebuildable(3, 1)
+    assert not topology.rebuildable(1, 0)
+    assert topology.rebuildable(1, 2)
+
+    # Connectivity is not released when new connectivity is computed
+    topology.connectivity_budget = 1
+    mesh.create_connectivity(1, 3)
+    assert topology.connectivity(1, 2) is not None
+    assert topology.connectivity(1, 3) is not None
+
+    # Budget smaller than the cell-entity and entity-vertex
+    # connectivity releases all rebuildable connectivity
+    assert mesh.release_connectivity() > 0
+    assert topology.connectivity(1, 2) is None
+    assert topology.released(1, 2)
+    assert topology.connectivity(1, 3) is None
+    assert topology.connectivity(3, 1) is not None
+
+    # Released connectivity is recomputed on request
+    mesh.create_connectivity(1, 2)
+    assert topology.connectivity(1, 2) is not None
+    assert not topology.released(1, 2)
+
+    # Explicit release
+    memory = topology.connectivity_memory_usage()
+    released = topology.release_connectivity(0)
+    assert released > 0
+    assert topology.connectivity_memory_usage() == memory - released
+    assert topology.connectivity(3, 0) is not None
+
+    # Facet-cell connectivity holds the global number of cells of
+    # facets on process boundaries, and is not released
+    topology.connectivity_budget = 0
+    mesh.create_connectivity(2, 3)
+    assert not topology.rebuildable(2, 3)
+
+    def num_exterior_facets():
+        n = sum(1 for f in Facets(mesh) if f.exterior())
+        return MPI.sum(mesh.mpi_comm(), n)
+
+    assert num_exterior_facets() == 6 * 3 * 3 * 2
+
+    # Release all rebuildable connectivity, and recompute some
+    topology.release_connectivity(0)
+    topology.connectivity_budget = 1
+    mesh.create_connectivity(1, 2)
+    mesh.create_connectivity(2, 3)
+    assert topology.connectivity(2, 3) is not None
+    assert not topology.released(2, 3)
+    assert num_exterior_facets() == 6 * 3 * 3 * 2
+
+
+def test_connectivity_budget_library():
+    """Check that library functions creating several connectivities work
+    with a tiny connectivity budget"""
+    mesh = UnitCubeMesh(MPI.comm_world, 3, 3, 3)
+    topology = mesh.topology
+    topology.connectivity_budget = 1
+
+    def check_all():
+        dolfin.cpp.graph.GraphBuilder.local_graph(mesh, 1, 2)
+        assert topology.connectivity(1, 2) is not None
+        assert topology.connectivity(2, 1) is not None
+
+        f = MeshValueCollection("int", mesh, 1)
+        for e in range(mesh.num_entities(1)):
+            f.set_value(e, 1)
+        assert f.size() == mesh.num_entities(1)
+
+        area = dolfin.fem.assemble_scalar(1.0 * ufl.ds(mesh))
+        assert MPI.sum(mesh.mpi_comm(), area) == pytest.approx(6.0)
+
+    check_all()
+
+    # Run again after releasing, which recomputes released connectivity
+    assert mesh.release_connectivity() > 0
+    check_all()
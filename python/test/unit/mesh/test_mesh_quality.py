@@ -38,8 +38,9 @@ def test_radius_ratio_triangle_min_max():
     rmin, rmax = MeshQuality.radius_ratio_min_max(mesh)
     assert rmax <= rmax
 
-    x = mesh.geometry.points
+    x = mesh.geometry.points.copy()
     x[:, 0] *= 0.0
+    mesh.geometry.points = x
     rmin, rmax = MeshQuality.radius_ratio_min_max(mesh)
     assert round(rmin - 0.0, 7) == 0
     assert round(rmax - 0.0, 7) == 0
@@ -53,8 +54,9 @@ def test_radius_ratio_tetrahedron_min_max():
     rmin, rmax = MeshQuality.radius_ratio_min_max(mesh)
     assert rmax <= rmax
 
-    x = mesh.geometry.points
+    x = mesh.geometry.points.copy()
     x[:, 0] *= 0.0
+    mesh.geometry.points = x
     rmin, rmax = MeshQuality.radius_ratio_min_max(mesh)
     assert round(rmax - 0.0, 7) == 0
     assert round(rmax - 0.0, 7) == 0
@@ -63,22 +65,25 @@ def test_radius_ratio_tetrahedron_min_max():
 @skip_in_parallel
 def test_radius_ratio_min_radius_ratio_max():
     mesh1d = UnitIntervalMesh(MPI.comm_self, 4)
-    x = mesh1d.geometry.points
-    x[4] = mesh1d.geometry.points[3]
+    x = mesh1d.geometry.points.copy()
+    x[4] = x[3]
+    mesh1d.geometry.points = x
 
     # Create 2D mesh with one equilateral triangle
     mesh2d = RectangleMesh(
         MPI.comm_world, [numpy.array([0.0, 0.0, 0.0]),
                          numpy.array([1.0, 1.0, 0.0])], [1, 1],
         CellType.Type.triangle, cpp.mesh.GhostMode.none, 'left')
-    x = mesh2d.geometry.points
+    x = mesh2d.geometry.points.copy()
     x[3, :2] += 0.5 * (sqrt(3.0) - 1.0)
+    mesh2d.geometry.points = x
 
     # Create 3D mesh with regular tetrahedron and degenerate cells
     mesh3d = UnitCubeMesh(MPI.comm_self, 1, 1, 1)
-    x = mesh3d.geometry.points
+    x = mesh3d.geometry.points.copy()
     x[6][0] = 1.0
     x[3][1] = 0.0
+    mesh3d.geometry.points = x
     rmin, rmax = MeshQuality.radius_ratio_min_max(mesh1d)
     assert round(rmin - 0.0, 7) == 0
     assert round(rmax - 1.0, 7) == 0
@@ -152,3 +152,23 @@ def test_mesh_function_assign_2D_vertices():
         for i, vert in enumerate(VertexRange(cell)):
             assert 25 == g.get_value(cell.index(), i)
             assert f2[vert] == g.get_value(cell.index(), i)
+
+
+def test_set_values_2D_facets():
+    mesh = UnitSquareMesh(MPI.comm_world, 3, 3)
+    ncells = mesh.num_cells()
+    f = MeshValueCollection("int", mesh, 1)
+    f.set_value(0, 0, -1)
+
+    # Insert in reverse order, with a repeated entry
+    cells = [c for c in reversed(range(ncells)) for i in range(3)] + [0]
+    local_entities = [i for c in range(ncells) for i in range(3)] + [0]
+    values = [10 * c + i for c, i in zip(cells, local_entities)]
+    values[-1] = 7
+    f.set_values(cells, local_entities, values)
+    assert ncells * 3 == f.size()
+    assert f.cells() == sorted(f.cells())
+    assert f.get_value(0, 0) == 7
+    for c in range(ncells):
+        for i in range(1, 3):
+            assert 10 * c + i == f.get_value(c, i)
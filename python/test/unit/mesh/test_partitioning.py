@@ -0,0 +1,143 @@
+# Copyright (C) 2026 agent
+#
+# This file is part of DOLFIN (https://www.fenicsproject.org)
+#
+# SPDX-License-Identifier:    LGPL-3.0-or-later
+
+import numpy
+import pytest
+
+from dolfin import (MPI, Cells, Expression, Function, FunctionSpace,
+                    MeshEntities, MeshFunction, UnitSquareMesh, cpp, fem,
+                    function, has_parmetis)
+
+skip_if_no_parmetis = pytest.mark.skipif(not has_parmetis,
+                                         reason="ParMETIS not available")
+
+
+@skip_if_no_parmetis
+def test_repartition_and_migrate():
+    mesh = UnitSquareMesh(MPI.comm_world, 12, 12)
+    tdim = mesh.topology.dim
+
+    # Make cells on the left of the domain expensive
+    weights = [10.0 if c.midpoint()[0] < 0.5 else 1.0 for c in Cells(mesh)]
+    new_mesh = cpp.mesh.Partitioning.repartition(mesh, weights)
+    new_mesh.geometry.coord_mapping = fem.create_coordinate_map(new_mesh)
+    assert new_mesh.num_entities_global(tdim) == mesh.num_entities_global(tdim)
+    assert new_mesh.num_entities_global(0) == mesh.num_entities_global(0)
+
+    # Cell function holding global cell index
+    f = MeshFunction("size_t", mesh, tdim, 0)
+    for c in Cells(mesh):
+        f[c] = c.global_index()
+    g = cpp.mesh.migrate(f, new_mesh)
+    for c in Cells(new_mesh):
+        assert g[c] == c.global_index()
+
+    # Vertex and edge functions holding a grid index computed from the
+    # entity midpoint, which identifies the entity on any partition
+    def grid_index(e):
+        x = e.midpoint()
+        return int(round(24 * x[0])) + 25 * int(round(24 * x[1]))
+
+    for dim in (0, 1):
+        f = MeshFunction("size_t", mesh, dim, 0)
+        for e in MeshEntities(mesh, dim):
+            f[e] = grid_index(e)
+        g = cpp.mesh.migrate(f, new_mesh)
+        for e in MeshEntities(new_mesh, dim):
+            assert g[e] == grid_index(e)
+
+    # Function values should be unchanged
+    @function.expression.numba_eval
+    def expr_eval(values, x, t):
+        values[:, 0] = x[:, 0] + 2.0 * x[:, 1]
+
+    V = FunctionSpace(mesh, ("Lagrange", 1))
+    u = Function(V)
+    u.interpolate(Expression(expr_eval))
+    W = FunctionSpace(new_mesh, ("Lagrange", 1))
+    w = u.migrate(W)
+    assert numpy.isclose(w.vector().norm(), u.vector().norm())
+    w0 = Function(W)
+    w0.interpolate(Expression(expr_eval))
+    assert numpy.allclose(w.vector().getArray(), w0.vector().getArray())
+
+
+def _rank0_mesh_data(comm, n):
+    """Points and triangles of an n x n square mesh on process 0, and
+    no cells on other processes"""
+    if MPI.rank(comm) > 0:
+        return numpy.zeros((0, 2)), numpy.zeros((0, 3), dtype=numpy.int64)
+    x = numpy.array([[i / n, j / n] for j in range(n + 1)
+                     for i in range(n + 1)])
+    cells = []
+    for j in range(n):
+        for i in range(n):
+            v0 = j * (n + 1) + i
+            v2 = v0 + n + 1
+            cells += [[v0, v0 + 1, v2 + 1], [v0, v2, v2 + 1]]
+    return x, numpy.array(cells, dtype=numpy.int64)
+
+
+def test_build_distributed_mesh_cell_weights():
+    comm = MPI.comm_world
+    n = 8
+    x, cells = _rank0_mesh_data(comm, n)
+
+    # Two constraints, with cells on the left of the domain expensive.
+    # Processes without cells pass an empty array.
+    if len(cells) > 0:
+        midpoints = x[cells].mean(axis=1)
+        weights = numpy.ones((len(cells), 2))
+        weights[midpoints[:, 0] < 0.5, 0] = 10.0
+    else:
+        weights = numpy.zeros((0, 0))
+
+    mesh = cpp.mesh.Partitioning.build_distributed_mesh(
+        comm, cpp.mesh.CellType.Type.triangle, x, cells,
+        list(range(len(cells))), cpp.mesh.GhostMode.none, "SCOTCH", weights)
+    assert mesh.num_entities_global(2) == 2 * n * n
+
+    # Weights with the wrong number of rows raise on all processes
+    if len(cells) > 0:
+        weights = numpy.ones((len(cells) - 1, 2))
+    with pytest.raises(RuntimeError):
+        cpp.mesh.Partitioning.build_distributed_mesh(
+            comm, cpp.mesh.CellType.Type.triangle, x, cells,
+            list(range(len(cells))), cpp.mesh.GhostMode.none, "SCOTCH",
+            weights)
+
+
+def test_edge_cut():
+    mesh = UnitSquareMesh(MPI.comm_world, 12, 12)
+    edge_cut = cpp.mesh.Partitioning.compute_edge_cut(mesh)
+    if MPI.size(mesh.mpi_comm()) == 1:
+        assert edge_cut == 0
+    else:
+        assert edge_cut > 0
+
+
+def test_hilbert_keys():
+    # Consecutive points along the curve should be neighbours on a grid
+    n = 8
+    x = numpy.array([[(i + 0.5) / n, (j + 0.5) / n] for i in range(n)
+                     for j in range(n)])
+    keys = cpp.graph.Hilbert.keys(x, [0.0, 0.0], [1.0, 1.0])
+    x = x[numpy.argsort(keys)]
+    d = numpy.linalg.norm(x[1:] - x[:-1], axis=1)
+    assert numpy.allclose(d, 1.0 / n)
+
+
+def test_hilbert_partition():
+    comm = MPI.comm_world
+    size = MPI.size(comm)
+    x = numpy.random.RandomState(MPI.rank(comm)).rand(100, 3)
+    part = cpp.graph.Hilbert.partition(comm, x)
+    assert min(part) >= 0 and max(part) < size
+
+    # Number of points on each process should be (nearly) equal
+    counts = numpy.bincount(part, minlength=size)
+    counts = [MPI.sum(comm, float(c)) for c in counts]
+    assert max(counts) - min(counts) <= 2
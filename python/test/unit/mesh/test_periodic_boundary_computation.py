@@ -6,7 +6,7 @@
 
 import numpy as np
 
-from dolfin import MPI, SubDomain, UnitSquareMesh
+from dolfin import MPI, SubDomain, UnitCubeMesh, UnitSquareMesh
 from dolfin.cpp.mesh import PeriodicBoundaryComputation
 from dolfin_utils.test.fixtures import fixture
 from dolfin_utils.test.skips import skip_in_parallel
@@ -16,7 +16,7 @@ from dolfin_utils.test.skips import skip_in_parallel
 def periodic_boundary():
     class PeriodicBoundary(SubDomain):
         def inside(self, x, on_boundary):
-            return x[0] < np.finfo(float).eps
+            return x[:, 0] < np.finfo(float).eps
 
         def map(self, x, y):
             y[0] = x[0] - 1.0
@@ -51,3 +51,27 @@ def test_MastersSlaves(periodic_boundary, mesh):
     mf = PeriodicBoundaryComputation.masters_slaves(mesh, periodic_boundary, 1)
     assert len(np.where(mf.array() == 1)[0]) == 4
     assert len(np.where(mf.array() == 2)[0]) == 4
+
+
+@skip_in_parallel
+def test_ComputePeriodicPairs3D():
+    class PeriodicBoundary(SubDomain):
+        def inside(self, x, on_boundary):
+            return x[:, 0] < np.finfo(float).eps
+
+        def map(self, x, y):
+            y[0] = x[0] - 1.0
+            y[1] = x[1]
+            y[2] = x[2]
+
+    # Each vertex on the x = 1 face is paired with the vertex on the
+    # x = 0 face with the same (y, z) coordinates
+    mesh = UnitCubeMesh(MPI.comm_world, 3, 4, 5)
+    vertices = PeriodicBoundaryComputation.compute_periodic_pairs(
+        mesh, PeriodicBoundary(), 0)
+    assert len(vertices) == 5 * 6
+    x = mesh.geometry.points
+    for slave, (process, master) in vertices.items():
+        assert process == 0
+        assert np.isclose(x[slave][0], 1.0)
+        assert np.allclose(x[master], x[slave] - [1.0, 0.0, 0.0])
@@ -160,6 +160,104 @@ def test_nonlinear_pde():
     assert n < 6
 
 
+def create_counting_nonlinear_pde_problem():
+    """Create the nonlinear PDE problem of test_nonlinear_pde, counting
+    the Jacobian and preconditioner assemblies"""
+    mesh = dolfin.generation.UnitSquareMesh(dolfin.MPI.comm_world, 12, 5)
+    V = dolfin.function.FunctionSpace(mesh, ("Lagrange", 1))
+    u = dolfin.function.Function(V)
+    v = function.TestFunction(V)
+    F = inner(5.0, v) * dx - ufl.sqrt(u * u) * inner(
+        grad(u), grad(v)) * dx - inner(u, v) * dx
+
+    def boundary(x):
+        """Define Dirichlet boundary (x = 0 or x = 1)."""
+        return np.logical_or(x[:, 0] < 1.0e-8, x[:, 0] > 1.0 - 1.0e-8)
+
+    u_bc = function.Function(V)
+    u_bc.vector().set(1.0)
+    u_bc.vector().ghostUpdate(addv=PETSc.InsertMode.INSERT, mode=PETSc.ScatterMode.FORWARD)
+    bc = fem.DirichletBC(V, u_bc, boundary)
+
+    class CountingNonlinearPDEProblem(NonlinearPDEProblem):
+        def __init__(self, F, u, bc):
+            super().__init__(F, u, bc)
+            self.num_J, self.num_P = 0, 0
+
+        def J(self, x):
+            self.num_J += 1
+            return super().J(x)
+
+        def P(self, x):
+            self.num_P += 1
+            return self._J
+
+    u.vector().set(0.9)
+    u.vector().ghostUpdate(addv=PETSc.InsertMode.INSERT, mode=PETSc.ScatterMode.FORWARD)
+    return CountingNonlinearPDEProblem(F, u, bc), u, u_bc
+
+
+def test_nonlinear_pde_lagged():
+    """Test Newton solver with lagged Jacobian and line search"""
+    # Reference solve, assembling the Jacobian at every iteration
+    problem, u, u_bc = create_counting_nonlinear_pde_problem()
+    solver = dolfin.cpp.nls.NewtonSolver(dolfin.MPI.comm_world)
+    n, converged = solver.solve(problem, u.vector())
+    assert converged
+    assert problem.num_J == n
+    assert problem.num_P == n
+
+    # Assemble the Jacobian every second iteration
+    problem, u, u_bc = create_counting_nonlinear_pde_problem()
+    solver = dolfin.cpp.nls.NewtonSolver(dolfin.MPI.comm_world)
+    solver.jacobian_lag = 2
+    solver.lag_across_solves = True
+    solver.line_search = True
+    n0, converged = solver.solve(problem, u.vector())
+    assert converged
+    assert n0 < 12
+    assert problem.num_J == (n0 + 1) // 2
+    assert problem.num_J < n0
+
+    # Solve again, re-using the Jacobian from the previous solve. The
+    # Jacobian age carries over, so the count continues every second
+    # iteration across both solves.
+    u_bc.vector().set(0.5)
+    u_bc.vector().ghostUpdate(addv=PETSc.InsertMode.INSERT, mode=PETSc.ScatterMode.FORWARD)
+    n1, converged = solver.solve(problem, u.vector())
+    assert converged
+    assert n1 < 12
+    assert problem.num_J == (n0 + n1 + 1) // 2
+    assert problem.num_J < n0 + n1
+    assert problem.num_P == problem.num_J
+
+
+def test_nonlinear_pde_krylov():
+    """Test Newton solver with a Krylov solver, lagged preconditioner and
+    Eisenstat-Walker forcing terms"""
+    its = {}
+    for eisenstat_walker in (False, True):
+        problem, u, u_bc = create_counting_nonlinear_pde_problem()
+        solver = dolfin.cpp.nls.NewtonSolver(dolfin.MPI.comm_world)
+        ksp = solver.get_krylov_solver().ksp()
+        ksp.setType("gmres")
+        ksp.getPC().setType("jacobi")
+        ksp.setTolerances(rtol=1.0e-10, max_it=1000)
+        solver.eisenstat_walker = eisenstat_walker
+        solver.preconditioner_lag = 2
+        n, converged = solver.solve(problem, u.vector())
+        assert converged
+        assert problem.num_J == n
+        assert problem.num_P == (n + 1) // 2
+
+        # The linear solver tolerance is restored after the solve
+        assert ksp.getTolerances()[0] == 1.0e-10
+        its[eisenstat_walker] = solver.krylov_iterations()
+
+    # Inexact linear solves take fewer Krylov iterations in total
+    assert its[True] < its[False]
+
+
 def test_nonlinear_pde_snes():
     """Test Newton solver for a simple nonlinear PDE"""
     # Create mesh and function space